@@ -11,6 +11,7 @@
 
 #include "AudioMixer.h"
 
+#include <algorithm>
 #include <thread>
 
 #include <QtCore/QJsonArray>
@@ -23,6 +24,7 @@
 #include <NodeList.h>
 #include <Node.h>
 #include <OctreeConstants.h>
+#include <Profile.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
 #include <udt/PacketHeaders.h>
@@ -30,6 +32,7 @@
 #include <StDev.h>
 #include <UUID.h>
 #include <CPUDetect.h>
+#include <GLMHelpers.h>
 
 #include "AudioLogging.h"
 #include "AudioHelpers.h"
@@ -271,8 +274,15 @@ void AudioMixer::sendStatsPacket() {
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
     statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
 
+    statsObject["avg_listeners_(silent_mix)_per_frame"] = (float)_stats.sumListenersSilentMixes / (float)_numStatFrames;
+
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
+    // encodes of identical mixes are shared between listeners with a stateless codec
+    statsObject["encodes_per_frame"] = (float)_stats.encodes / (float)_numStatFrames;
+    int totalEncodes = _stats.encodes + _stats.sharedEncodes;
+    statsObject["encode_dedup_ratio"] = totalEncodes > 0 ? (float)_stats.sharedEncodes / (float)totalEncodes : 0.0f;
+
     // timing stats
     QJsonObject timingStats;
 
@@ -288,9 +298,17 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_sleepTiming, "sleep");
     addTiming(_frameTiming, "frame");
     addTiming(_packetsTiming, "packets");
+    addTiming(_decodeTiming, "decode");
     addTiming(_mixTiming, "mix");
+    addTiming(_farFieldTiming, "far_field");
     addTiming(_eventsTiming, "events");
 
+    // decode time summed over slave threads, compare against us_per_decode for the parallel speedup
+    timingStats["us_per_decode_cpu"] = (qint64)(_stats.decodeTime / _numStatFrames);
+
+    timingStats["deadline_misses"] = _numDeadlineMisses;
+    _numDeadlineMisses = 0;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
 #endif
@@ -298,16 +316,52 @@ void AudioMixer::sendStatsPacket() {
     // call it "avg_..." to keep it higher in the display, sorted alphabetically
     statsObject["avg_timing_stats"] = timingStats;
 
+    // latency distributions, of each frame stage and of each node within the slave stages
+    QJsonObject histogramStats;
+
+    auto histogramStatsObject = [](const AudioMixerHistogram& histogram) {
+        QJsonObject stageStats;
+        stageStats["us_p50"] = (qint64)histogram.percentile(50.0f);
+        stageStats["us_p95"] = (qint64)histogram.percentile(95.0f);
+        stageStats["us_p99"] = (qint64)histogram.percentile(99.0f);
+        stageStats["us_max"] = (qint64)histogram.max();
+        return stageStats;
+    };
+
+    auto addFrameHistogram = [&](Timer& timer, string name) {
+        QJsonObject stageStats = histogramStatsObject(timer.getHistogram());
+        stageStats["deadline_overruns"] = timer.overruns;
+        histogramStats[("frame_" + name).c_str()] = stageStats;
+        timer.resetHistogram();
+    };
+
+    addFrameHistogram(_frameTiming, "total");
+    addFrameHistogram(_packetsTiming, "packets");
+    addFrameHistogram(_eventsTiming, "events");
+    addFrameHistogram(_decodeTiming, "decode");
+    addFrameHistogram(_farFieldTiming, "far_field");
+    addFrameHistogram(_mixTiming, "mix");
+
+    histogramStats["node_decode"] = histogramStatsObject(_stats.decodeHistogram);
+    histogramStats["node_mix"] = histogramStatsObject(_stats.mixHistogram);
+    histogramStats["node_encode"] = histogramStatsObject(_stats.encodeHistogram);
+    histogramStats["node_send"] = histogramStatsObject(_stats.sendHistogram);
+
+    statsObject["avg_timing_histograms"] = histogramStats;
+
     // mix stats
     QJsonObject mixStats;
 
     mixStats["%_hrtf_mixes"] = percentageForMixStats(_stats.hrtfRenders);
     mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_stats.manualStereoMixes);
     mixStats["%_manual_echo_mixes"] = percentageForMixStats(_stats.manualEchoMixes);
+    mixStats["%_far_field_mixes"] = percentageForMixStats(_stats.farFieldStreams);
 
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_far_field_renders"] = (int)(_stats.farFieldRenders / (float)_numStatFrames);
+    mixStats["1_far_field_cluster_mixes"] = (int)(_stats.farFieldClusterMixes / (float)_numStatFrames);
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
@@ -413,6 +467,7 @@ void AudioMixer::start() {
 
         // process (node-isolated) audio packets across slave threads
         {
+            PROFILE_RANGE(audio, "packets");
             auto packetsTimer = _packetsTiming.timer();
 
             // first clear the concurrent vector of added streams that the slaves will add to when they process packets
@@ -425,6 +480,7 @@ void AudioMixer::start() {
 
         // process queued events (networking, global audio packets, &c.)
         {
+            PROFILE_RANGE(audio, "events");
             auto eventsTimer = _eventsTiming.timer();
 
             // clear removed nodes and removed streams before we process events that will setup the new set
@@ -435,13 +491,34 @@ void AudioMixer::start() {
             QCoreApplication::processEvents();
         }
 
+        // parse the queued stream packets and pop a frame from each stream, across slave threads
+        {
+            PROFILE_RANGE(audio, "decode");
+            auto decodeTimer = _decodeTiming.timer();
+
+            nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+                _slavePool.decode(cbegin, cend);
+            });
+        }
+
+        // mix the far-field clusters shared by all listeners
+        {
+            PROFILE_RANGE(audio, "far_field");
+            auto farFieldTimer = _farFieldTiming.timer();
+            prepareFarFieldClusters();
+        }
+
         int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
         if (_throttlingRatio > EPSILON) {
             numToRetain = nodeList->size() * (1.0f - _throttlingRatio);
         }
+        // mixes encoded in the last frame can't be shared with this one
+        _workerSharedData.encodedMixes.clear();
+
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // mix across slave threads
+            PROFILE_RANGE(audio, "mix");
             auto mixTimer = _mixTiming.timer();
             _slavePool.mix(cbegin, cend, frame, numToRetain);
         });
@@ -452,6 +529,18 @@ void AudioMixer::start() {
             slave.stats.reset();
         });
 
+        // blame a missed deadline on the longest stage of the frame
+        if (frameTimer.elapsed() > (uint64_t)AudioConstants::NETWORK_FRAME_USECS) {
+            Timer* stages[] = { &_packetsTiming, &_eventsTiming, &_decodeTiming, &_farFieldTiming, &_mixTiming };
+            auto longestStage = *std::max_element(std::begin(stages), std::end(stages), [](Timer* a, Timer* b) {
+                return a->getLast() < b->getLast();
+            });
+            ++longestStage->overruns;
+            ++_numDeadlineMisses;
+
+            PROFILE_INSTANT(audio, "deadline_miss");
+        }
+
         ++frame;
         ++_numStatFrames;
 
@@ -527,6 +616,47 @@ void AudioMixer::throttle(chrono::microseconds duration, int frame) {
     }
 }
 
+void AudioMixer::prepareFarFieldClusters() {
+    auto& clusters = _workerSharedData.farFieldClusters;
+    auto& clusterIndices = _workerSharedData.farFieldClusterIndices;
+    const auto& settings = _workerSharedData.farFieldSettings;
+
+    clusters.clear(settings.clusterSize);
+    clusterIndices.clear();
+
+    if (!settings.enabled) {
+        return;
+    }
+
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!data) {
+            return;
+        }
+
+        for (auto& stream : data->getAudioStreams()) {
+            // only mono streams that have audio this frame can be mixed in the bed
+            if (stream->isStereo() || !stream->lastPopSucceeded() || stream->getLastPopOutputLoudness() == 0.0f) {
+                continue;
+            }
+
+            float gain = 1.0f;
+            if (stream->getType() == PositionalAudioStream::Injector) {
+                gain *= static_cast<const InjectedAudioStream*>(stream.get())->getAttenuationRatio();
+            }
+
+            // only avatars get off-axis attenuation, see computeGain
+            bool isMicrophone = (stream->getType() == PositionalAudioStream::Microphone);
+            glm::vec3 forward = stream->getOrientation() * Vectors::UNIT_NEG_Z;
+
+            clusterIndices[stream.get()] = clusters.addSource(stream->getDecodedFrame(), gain, stream->getPosition(),
+                                                              forward, isMicrophone);
+        }
+    });
+
+    clusters.finish();
+}
+
 void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
@@ -535,6 +665,7 @@ void AudioMixer::clearDomainSettings() {
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _workerSharedData.farFieldSettings = AudioFarFieldBed::Settings();
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -570,6 +701,25 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         }
 
         qCDebug(audio) << "Throttle Start:" << _throttleStartTarget << "Throttle Backoff:" << _throttleBackoffTarget;
+
+        const QString FAR_FIELD_BED_KEY = "far_field_bed";
+        const QString FAR_FIELD_DISTANCE_KEY = "far_field_distance";
+        const QString FAR_FIELD_CLUSTER_SIZE_KEY = "far_field_cluster_size";
+        const QString FAR_FIELD_MAX_HRTF_STREAMS_KEY = "far_field_max_hrtf_streams";
+
+        auto& farField = _workerSharedData.farFieldSettings;
+        farField.enabled = audioThreadingGroupObject[FAR_FIELD_BED_KEY].toBool(farField.enabled);
+        farField.distance = audioThreadingGroupObject[FAR_FIELD_DISTANCE_KEY].toDouble(farField.distance);
+        farField.maxHRTFStreams = audioThreadingGroupObject[FAR_FIELD_MAX_HRTF_STREAMS_KEY].toInt(farField.maxHRTFStreams);
+
+        const float MIN_FAR_FIELD_CLUSTER_SIZE = 0.5f;
+        float clusterSize = audioThreadingGroupObject[FAR_FIELD_CLUSTER_SIZE_KEY].toDouble(farField.clusterSize);
+        farField.clusterSize = std::max(clusterSize, MIN_FAR_FIELD_CLUSTER_SIZE);
+
+        if (farField.enabled) {
+            qCDebug(audio) << "Far-field bed enabled, distance:" << farField.distance << "cluster size:" << farField.clusterSize
+                << "max HRTF streams:" << farField.maxHRTFStreams;
+        }
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
@@ -789,12 +939,19 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
     }
 }
 
-AudioMixer::Timer::Timing::Timing(uint64_t& sum) : _sum(sum) {
+AudioMixer::Timer::Timing::Timing(Timer& timer) : _timer(timer) {
     _timing = p_high_resolution_clock::now();
 }
 
 AudioMixer::Timer::Timing::~Timing() {
-    _sum += chrono::duration_cast<chrono::microseconds>(p_high_resolution_clock::now() - _timing).count();
+    uint64_t duration = elapsed();
+    _timer._sum += duration;
+    _timer._last = duration;
+    _timer._histogram.record(duration);
+}
+
+uint64_t AudioMixer::Timer::Timing::elapsed() const {
+    return chrono::duration_cast<chrono::microseconds>(p_high_resolution_clock::now() - _timing).count();
 }
 
 void AudioMixer::Timer::get(uint64_t& timing, uint64_t& trailing) {
@@ -86,6 +86,7 @@ private:
     // mixing helpers
     std::chrono::microseconds timeFrame();
     void throttle(std::chrono::microseconds frameDuration, int frame);
+    void prepareFarFieldClusters();
 
     AudioMixerClientData* getOrCreateClientData(Node* node);
 
@@ -111,18 +112,33 @@ private:
     public:
         class Timing{
         public:
-            Timing(uint64_t& sum);
+            Timing(Timer& timer);
             ~Timing();
+
+            // usecs since the timing started
+            uint64_t elapsed() const;
         private:
             p_high_resolution_clock::time_point _timing;
-            uint64_t& _sum;
+            Timer& _timer;
         };
 
-        Timing timer() { return Timing(_sum); }
+        Timing timer() { return Timing(*this); }
         void get(uint64_t& timing, uint64_t& trailing);
+
+        // durations of each timing, and of the last one
+        const AudioMixerHistogram& getHistogram() const { return _histogram; }
+        uint64_t getLast() const { return _last; }
+
+        // frames that missed their deadline while this was the longest stage
+        int overruns { 0 };
+
+        void resetHistogram() { _histogram.reset(); overruns = 0; }
     private:
         static const int TIMER_TRAILING_SECONDS = 10;
 
+        AudioMixerHistogram _histogram;
+        uint64_t _last { 0 };
+
         uint64_t _sum { 0 };
         uint64_t _trailing { 0 };
         uint64_t _history[TIMER_TRAILING_SECONDS] {};
@@ -135,8 +151,12 @@ private:
     Timer _frameTiming;
     Timer _prepareTiming;
     Timer _mixTiming;
+    Timer _farFieldTiming;
     Timer _eventsTiming;
     Timer _packetsTiming;
+    Timer _decodeTiming;
+
+    int _numDeadlineMisses { 0 };
 
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
@@ -57,7 +57,7 @@ void AudioMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message,
     _packetQueue.push(message);
 }
 
-int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
+void AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
     SharedNodePointer node = _packetQueue.node;
     assert(_packetQueue.empty() || node);
     _packetQueue.node.clear();
@@ -74,7 +74,7 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
                     setupCodecForReplicatedAgent(packet);
                 }
 
-                processStreamPacket(*packet, addedStreams);
+                processStreamPacket(packet, addedStreams);
 
                 optionallyReplicatePacket(*packet, *node);
                 break;
@@ -108,10 +108,6 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
         _packetQueue.pop();
     }
     assert(_packetQueue.empty());
-
-    // now that we have processed all packets for this frame
-    // we can prepare the sources from this client to be ready for mixing
-    return checkBuffersBeforeFrameSend();
 }
 
 bool isReplicatedPacket(PacketType packetType) {
@@ -416,7 +412,8 @@ bool AudioMixerClientData::containsValidPosition(ReceivedMessage& message) const
     return true;
 }
 
-void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, ConcurrentAddedStreams &addedStreams) {
+void AudioMixerClientData::processStreamPacket(QSharedPointer<ReceivedMessage> packet, ConcurrentAddedStreams &addedStreams) {
+    ReceivedMessage& message = *packet;
 
     if (!containsValidPosition(message)) {
         qDebug() << "Refusing to process audio stream from" << message.getSourceID() << "with invalid position";
@@ -512,17 +509,8 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
         }
     }
 
-    // seek to the beginning of the packet so that the next reader is in the right spot
-    message.seek(0);
-
-    // check the overflow count before we parse data
-    auto overflowBefore = matchingStream->getOverflowCount();
-    matchingStream->parseData(message);
-
-    if (matchingStream->getOverflowCount() > overflowBefore) {
-        qCDebug(audio) << "Just overflowed on stream" << matchingStream->getStreamIdentifier()
-            << "from" << message.getSourceID();
-    }
+    // the packet is parsed into the stream in the decode stage
+    _pendingStreamPackets.push_back({ matchingStream, packet });
 
     if (newStream) {
         // whenever a stream is added, push it to the concurrent vector of streams added this frame
@@ -530,7 +518,24 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
     }
 }
 
-int AudioMixerClientData::checkBuffersBeforeFrameSend() {
+int AudioMixerClientData::decodeStreams(DecodedFrameArena& arena) {
+    for (auto& pending : _pendingStreamPackets) {
+        auto& message = *pending.message;
+
+        // seek to the beginning of the packet so that the stream reads it from the start
+        message.seek(0);
+
+        // check the overflow count before we parse data
+        auto overflowBefore = pending.stream->getOverflowCount();
+        pending.stream->parseData(message);
+
+        if (pending.stream->getOverflowCount() > overflowBefore) {
+            qCDebug(audio) << "Just overflowed on stream" << pending.stream->getStreamIdentifier()
+                << "from" << message.getSourceID();
+        }
+    }
+    _pendingStreamPackets.clear();
+
     auto it = _audioStreams.begin();
     while (it != _audioStreams.end()) {
         SharedStreamPointer stream = *it;
@@ -539,6 +544,22 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
             stream->updateLastPopOutputLoudnessAndTrailingLoudness();
         }
 
+        // copy the frame out of the ring buffer once, so that every listener can read it contiguously
+        // a stream that failed to pop keeps its last frame while it is being faded out
+        bool hasFrame = stream->lastPopSucceeded();
+        if (!hasFrame && !stream->getLastPopOutput().isNull() && stream->getType() != PositionalAudioStream::Injector) {
+            hasFrame = calculateRepeatedFrameFadeFactor(stream->getConsecutiveNotMixedCount() - 1) > 0.0f;
+        }
+
+        if (hasFrame) {
+            int16_t* decodedFrame = arena.allocate();
+            AudioRingBuffer::ConstIterator streamPopOutput = stream->getLastPopOutput();
+            streamPopOutput.readSamples(decodedFrame, stream->getNumFrameSamples());
+            stream->setDecodedFrame(decodedFrame);
+        } else {
+            stream->setDecodedFrame(nullptr);
+        }
+
         static const int INJECTOR_MAX_INACTIVE_BLOCKS = 500;
 
         // if we don't have new data for an injected stream in the last INJECTOR_MAX_INACTIVE_BLOCKS then
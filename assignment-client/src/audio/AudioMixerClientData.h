@@ -19,6 +19,8 @@
 #include <QtCore/QJsonObject>
 
 #include <AABox.h>
+#include <AudioEncodedMixes.h>
+#include <AudioFOA.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -28,6 +30,7 @@
 
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
+#include "DecodedFrameArena.h"
 
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
@@ -50,7 +53,11 @@ public:
     using AudioStreamVector = std::vector<SharedStreamPointer>;
 
     void queuePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer node);
-    int processPackets(ConcurrentAddedStreams& addedStreams); // returns the number of available streams this frame
+    void processPackets(ConcurrentAddedStreams& addedStreams);
+
+    // parse the stream packets queued by processPackets, then pop a frame from each audio stream and copy it to the arena
+    // returns the number of available streams this frame
+    int decodeStreams(DecodedFrameArena& arena);
 
     AudioStreamVector& getAudioStreams() { return _audioStreams; }
     AvatarAudioStream* getAvatarAudioStream();
@@ -59,7 +66,7 @@ public:
 
     // packet parsers
     int parseData(ReceivedMessage& message) override;
-    void processStreamPacket(ReceivedMessage& message, ConcurrentAddedStreams& addedStreams);
+    void processStreamPacket(QSharedPointer<ReceivedMessage> message, ConcurrentAddedStreams& addedStreams);
     void negotiateAudioFormat(ReceivedMessage& message, const SharedNodePointer& node);
     void parseRequestsDomainListData(ReceivedMessage& message);
     void parsePerAvatarGainSet(ReceivedMessage& message, const SharedNodePointer& node);
@@ -67,9 +74,6 @@ public:
     void parseRadiusIgnoreRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
     void parseSoloRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
 
-    // attempt to pop a frame from each audio stream, and return the number of streams from this client
-    int checkBuffersBeforeFrameSend();
-
     void removeDeadInjectedStreams();
 
     QJsonObject getAudioStreamStats();
@@ -87,6 +91,10 @@ public:
 
     AudioLimiter audioLimiter;
 
+    // decodes the far-field ambisonic bed for this listener
+    AudioFOA farFieldFOA;
+    bool farFieldBedActive { false };
+
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
     void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
@@ -98,6 +106,12 @@ public:
         // once you have encoded, you need to flush eventually.
         _shouldFlushEncoder = true;
     }
+    // same as above, sharing the output with the other listeners of the frame that have an identical mix and codec,
+    // when the encoder is stateless; returns true if the output of another listener was reused
+    bool encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer, AudioEncodedMixes& encodedMixes) {
+        _shouldFlushEncoder = true;
+        return encodedMixes.encode(_selectedCodecName, _encoder, decodedBuffer, encodedBuffer);
+    }
     void encodeFrameOfZeros(QByteArray& encodedZeros);
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
 
@@ -118,6 +132,7 @@ public:
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        bool inFarFieldBed { false };
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -172,6 +187,13 @@ private:
     };
     PacketQueue _packetQueue;
 
+    // stream packets are matched to their stream in processPackets, but only parsed (decoded) in decodeStreams
+    struct PendingStreamPacket {
+        SharedStreamPointer stream;
+        QSharedPointer<ReceivedMessage> message;
+    };
+    std::vector<PendingStreamPacket> _pendingStreamPackets;
+
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
     void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node);
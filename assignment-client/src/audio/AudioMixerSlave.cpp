@@ -12,16 +12,19 @@
 #include "AudioMixerSlave.h"
 
 #include <algorithm>
+#include <functional>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
 #include <glm/gtx/vector_angle.hpp>
 
+#include <GLMHelpers.h>
 #include <LogHandler.h>
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
 #include <OctreeConstants.h>
+#include <Profile.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
 #include <udt/PacketHeaders.h>
@@ -52,14 +55,28 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
 inline float computeGain(float masterListenerGain, const AvatarAudioStream& listeningNodeStream,
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance, bool isEcho);
+inline float computeDistanceAttenuation(const glm::vec3& sourcePosition, const glm::vec3& listenerPosition, float distance);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
 
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
-        // process packets and collect the number of streams available for this frame
-        stats.sumStreams += data->processPackets(_sharedData.addedStreams);
+        data->processPackets(_sharedData.addedStreams);
+    }
+}
+
+void AudioMixerSlave::decode(const SharedNodePointer& node) {
+    AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
+    if (data) {
+        auto start = usecTimestampNow();
+
+        // decode streams and collect the number of streams available for this frame
+        stats.sumStreams += data->decodeStreams(_decodedFrames);
+
+        auto decodeTime = usecTimestampNow() - start;
+        stats.decodeTime += decodeTime;
+        stats.decodeHistogram.record(decodeTime);
     }
 }
 
@@ -96,21 +113,34 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
     if (node->getType() == NodeType::Agent && node->getActiveSocket()) {
         ++stats.sumListeners;
 
+        PROFILE_RANGE(audio_detail, "listener");
+
         // mix the audio
+        auto mixStart = usecTimestampNow();
         bool mixHasAudio = prepareMix(node);
+        auto mixEnd = usecTimestampNow();
+        stats.mixHistogram.record(mixEnd - mixStart);
 
         // send audio packet
+        auto sendStart = mixEnd;
         if (mixHasAudio || data->shouldFlushEncoder()) {
             QByteArray encodedBuffer;
             if (mixHasAudio) {
                 // encode the audio
                 QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
+                if (data->encode(decodedBuffer, encodedBuffer, _sharedData.encodedMixes)) {
+                    ++stats.sharedEncodes;
+                } else {
+                    ++stats.encodes;
+                }
             } else {
                 // time to flush (resets shouldFlush until the next encode)
                 data->encodeFrameOfZeros(encodedBuffer);
             }
 
+            sendStart = usecTimestampNow();
+            stats.encodeHistogram.record(sendStart - mixEnd);
+
             sendMixPacket(node, *data, encodedBuffer);
         } else {
             ++stats.sumListenersSilent;
@@ -119,6 +149,7 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
 
         // send environment packet
         sendEnvironmentPacket(node, *data);
+        stats.sendHistogram.record(usecTimestampNow() - sendStart);
 
         // send stats packet (about every second)
         const unsigned int NUM_FRAMES_PER_SEC = (int)ceil(AudioConstants::NETWORK_FRAMES_PER_SEC);
@@ -128,7 +159,6 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
     }
 }
 
-
 template <class Container, class Predicate>
 void erase_if(Container& cont, Predicate&& pred) {
     auto it = remove_if(begin(cont), end(cont), std::forward<Predicate>(pred));
@@ -369,6 +399,12 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         return false;
     });
 
+    // pick the streams that are quiet enough to go in the far-field bed
+    _useFarFieldBed = _sharedData.farFieldSettings.enabled && !isSoloing;
+    if (_useFarFieldBed) {
+        prepareFarFieldBed(streams.active, *listenerAudioStream);
+    }
+
     // Process active streams
     erase_if(streams.active, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
@@ -467,6 +503,13 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
 
+    renderHRTFBatch();
+
+    // decode the far-field bed, and keep decoding for one more frame after it empties to flush its tail
+    if (!_farFieldBed.isEmpty() || listenerData->farFieldBedActive) {
+        renderFarFieldBed(*listenerData, *listenerAudioStream);
+    }
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     auto mixEnd = p_high_resolution_clock::now();
     auto mixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart);
@@ -475,13 +518,18 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     // check for silent audio before limiting
     // limiting uses a dither and can only guarantee abs(sample) <= 1
+    // a mix too quiet to change any sample (sources far away, or fully attenuated) is silent as well
+    const float SILENT_MIX_THRESHOLD = 0.5f / AudioConstants::MAX_SAMPLE_VALUE;
     bool hasAudio = false;
     for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-        if (_mixSamples[i] != 0.0f) {
+        if (fabsf(_mixSamples[i]) >= SILENT_MIX_THRESHOLD) {
             hasAudio = true;
             break;
         }
     }
+    if (!hasAudio && !streams.active.empty()) {
+        ++stats.sumListenersSilentMixes;
+    }
 
     // use the per listener AudioLimiter to render the mixed data
     listenerData->audioLimiter.render(_mixSamples, _bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
@@ -509,12 +557,10 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         gain = computeGain(masterListenerGain, listeningNodeStream, *streamToAdd, relativePosition, distance, isEcho);
     }
 
-    const int HRTF_DATASET_INDEX = 1;
-
     if (!streamToAdd->lastPopSucceeded()) {
         bool forceSilentBlock = true;
 
-        if (!streamToAdd->getLastPopOutput().isNull()) {
+        if (streamToAdd->getDecodedFrame()) {
             bool isInjector = dynamic_cast<const InjectedAudioStream*>(streamToAdd);
 
             // in an injector, just go silent - the injector has likely ended
@@ -534,9 +580,8 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
             // call renderSilent with a forced silent block to reduce artifacts
             // (this is not done for stereo streams since they do not go through the HRTF)
             if (!streamToAdd->isStereo() && !isEcho) {
-                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                static const int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+                _hrtfBatch.push_back({ mixableStream.hrtf.get(), silentMonoBlock, azimuth, distance, gain });
 
                 ++stats.hrtfRenders;
             }
@@ -545,8 +590,8 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         }
     }
 
-    // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd->getLastPopOutput();
+    // grab the frame decoded for this stream
+    const int16_t* streamPopOutput = streamToAdd->getDecodedFrame();
 
     // stereo sources are not passed through HRTF
     if (streamToAdd->isStereo()) {
@@ -556,10 +601,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
         const float scale = 1 / 32768.0f; // int16_t to float
 
-        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
-            _mixSamples[2*i+0] += (float)streamPopOutput[2*i+0] * gain * scale;
-            _mixSamples[2*i+1] += (float)streamPopOutput[2*i+1] * gain * scale;
-        }
+        accumulateSamplesWithGain(streamPopOutput, _mixSamples, gain * scale, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
         ++stats.manualStereoMixes;
     } else if (isEcho) {
@@ -574,16 +616,33 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         }
 
         ++stats.manualEchoMixes;
+    } else if (_useFarFieldBed && _farFieldBed.contains(mixableStream.approximateVolume, distance)) {
+        // distant and quiet sources are mixed into the far-field bed instead of their own HRTF
+        addFarFieldStream(mixableStream, relativePosition, distance, gain);
     } else {
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        if (mixableStream.inFarFieldBed) {
+            // the HRTF was reset when this stream went in the bed, it starts over from silence
+            mixableStream.inFarFieldBed = false;
+        }
 
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        // deferred to renderHRTFBatch(), so the HRTFs of this listener are rendered together
+        _hrtfBatch.push_back({ mixableStream.hrtf.get(), streamPopOutput, azimuth, distance, gain });
 
         ++stats.hrtfRenders;
     }
 }
 
+void AudioMixerSlave::renderHRTFBatch() {
+    if (_hrtfBatch.empty()) {
+        return;
+    }
+
+    const int HRTF_DATASET_INDEX = 1;
+    AudioHRTF::render(_hrtfBatch.data(), (int)_hrtfBatch.size(), _mixSamples, HRTF_DATASET_INDEX,
+                      AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    _hrtfBatch.clear();
+}
+
 void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
                                       AvatarAudioStream& listeningNodeStream,
                                       float masterListenerGain) {
@@ -608,6 +667,70 @@ void AudioMixerSlave::resetHRTFState(AudioMixerClientData::MixableStream& mixabl
     ++stats.hrtfResets;
 }
 
+void AudioMixerSlave::prepareFarFieldBed(MixableStreamsVector& activeStreams, const AvatarAudioStream& listenerAudioStream) {
+    _farFieldVolumes.clear();
+
+    for (auto& stream : activeStreams) {
+        if (!shouldBeRemoved(stream, _sharedData)) {
+            stream.approximateVolume = approximateVolume(stream, &listenerAudioStream);
+            _farFieldVolumes.push_back(stream.approximateVolume);
+        }
+    }
+
+    _farFieldBed.prepare(_sharedData.farFieldSettings, _farFieldVolumes);
+}
+
+void AudioMixerSlave::addFarFieldStream(MixableStream& mixableStream, const glm::vec3& relativePosition,
+                                        float distance, float gain) {
+    if (!mixableStream.inFarFieldBed) {
+        // drop the HRTF tail, the stream will start over from silence if it leaves the bed
+        resetHRTFState(mixableStream);
+        mixableStream.inFarFieldBed = true;
+    }
+
+    // streams with a per-avatar gain can't use the shared cluster mix
+    float gainAdjustment = mixableStream.hrtf->getGainAdjustment() / HRTF_GAIN;
+    int cluster = -1;
+    if (gainAdjustment == 1.0f) {
+        auto it = _sharedData.farFieldClusterIndices.find(mixableStream.positionalStream);
+        if (it != _sharedData.farFieldClusterIndices.end()) {
+            cluster = it->second;
+        }
+    }
+
+    _farFieldBed.addSource(mixableStream.positionalStream->getDecodedFrame(), gain * gainAdjustment,
+                           relativePosition / distance, cluster);
+
+    ++stats.farFieldStreams;
+}
+
+void AudioMixerSlave::renderFarFieldBed(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerAudioStream) {
+    bool hasBed = !_farFieldBed.isEmpty();
+
+    glm::vec3 listenerPosition = listenerAudioStream.getPosition();
+    stats.farFieldClusterMixes += _farFieldBed.encode(_sharedData.farFieldClusters, listenerPosition,
+                                                      listenerData.getMasterAvatarGain(),
+                                                      [&](const glm::vec3& sourcePosition, float distance) {
+        return computeDistanceAttenuation(sourcePosition, listenerPosition, distance);
+    });
+
+    // rotate the world-aligned bed into the listener's frame, and decode it
+    glm::quat relativeOrientation = glm::inverse(listenerAudioStream.getOrientation());
+
+    // convert from Y-up (OpenGL) to Z-up (Ambisonic) coordinate system
+    float qw = relativeOrientation.w;
+    float qx = -relativeOrientation.z;
+    float qy = -relativeOrientation.x;
+    float qz = relativeOrientation.y;
+
+    const int HRTF_DATASET_INDEX = 1;
+    listenerData.farFieldFOA.render(_farFieldBed.getBed(), _mixSamples, HRTF_DATASET_INDEX, qw, qx, qy, qz, 1.0f,
+                                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    listenerData.farFieldBedActive = hasBed;
+
+    ++stats.farFieldRenders;
+}
+
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
     auto audioPacket = NLPacket::create(type, size);
     audioPacket->writePrimitive(sequence);
@@ -734,38 +857,30 @@ float approximateGain(const AvatarAudioStream& listeningNodeStream, const Positi
 
 float computeGain(float masterListenerGain, const AvatarAudioStream& listeningNodeStream,
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance, bool isEcho) {
-    float gain = 1.0f;
+    float gain = computeDistanceAttenuation(streamToAdd.getPosition(), listeningNodeStream.getPosition(), distance);
 
     // injector: apply attenuation
     if (streamToAdd.getType() == PositionalAudioStream::Injector) {
         gain *= reinterpret_cast<const InjectedAudioStream*>(&streamToAdd)->getAttenuationRatio();
-
-    // avatar: apply fixed off-axis attenuation to make them quieter as they turn away
-    } else if (!isEcho && (streamToAdd.getType() == PositionalAudioStream::Microphone)) {
-        glm::vec3 rotatedListenerPosition = glm::inverse(streamToAdd.getOrientation()) * relativePosition;
-
-        // source directivity is based on angle of emission, in local coordinates
-        glm::vec3 direction = glm::normalize(rotatedListenerPosition);
-        float angleOfDelivery = fastAcosf(glm::clamp(-direction.z, -1.0f, 1.0f));   // UNIT_NEG_Z is "forward"
-
-        const float MAX_OFF_AXIS_ATTENUATION = 0.2f;
-        const float OFF_AXIS_ATTENUATION_STEP = (1 - MAX_OFF_AXIS_ATTENUATION) / 2.0f;
-        float offAxisCoefficient = MAX_OFF_AXIS_ATTENUATION + (angleOfDelivery * (OFF_AXIS_ATTENUATION_STEP / PI_OVER_TWO));
-
-        gain *= offAxisCoefficient;
-
-        // apply master gain, only to avatars
-        gain *= masterListenerGain;
     }
 
+    // avatar: apply fixed off-axis attenuation to make them quieter as they turn away, and master gain
+    // (shared with the far-field clusters, so that a source gets the same gain in and out of the bed)
+    bool isAvatar = !isEcho && (streamToAdd.getType() == PositionalAudioStream::Microphone);
+    glm::vec3 sourceForward = streamToAdd.getOrientation() * Vectors::UNIT_NEG_Z;
+    return AudioFarFieldBed::computeSourceGain(gain, isAvatar, sourceForward, relativePosition / distance,
+                                               masterListenerGain);
+}
+
+float computeDistanceAttenuation(const glm::vec3& sourcePosition, const glm::vec3& listenerPosition, float distance) {
     auto& audioZones = AudioMixer::getAudioZones();
     auto& zoneSettings = AudioMixer::getZoneSettings();
 
     // find distance attenuation coefficient
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (const auto& settings : zoneSettings) {
-        if (audioZones[settings.source].area.contains(streamToAdd.getPosition()) &&
-            audioZones[settings.listener].area.contains(listeningNodeStream.getPosition())) {
+        if (audioZones[settings.source].area.contains(sourcePosition) &&
+            audioZones[settings.listener].area.contains(listenerPosition)) {
             attenuationPerDoublingInDistance = settings.coefficient;
             break;
         }
@@ -775,10 +890,7 @@ float computeGain(float masterListenerGain, const AvatarAudioStream& listeningNo
 
     // calculate the attenuation using the distance to this node
     // reference attenuation of 0dB at distance = 1.0m
-    gain *= fastExp2f(fastLog2f(g) * fastLog2f(std::max(distance, HRTF_NEARFIELD_MIN)));
-    gain = std::min(gain, 1.0f / HRTF_NEARFIELD_MIN);
-
-    return gain;
+    return fastExp2f(fastLog2f(g) * fastLog2f(std::max(distance, HRTF_NEARFIELD_MIN)));
 }
 
 float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
@@ -12,9 +12,14 @@
 #ifndef hifi_AudioMixerSlave_h
 #define hifi_AudioMixerSlave_h
 
+#include <unordered_map>
+#include <vector>
+
 #include <tbb/concurrent_vector.h>
 
 #include <AABox.h>
+#include <AudioConstants.h>
+#include <AudioFarFieldBed.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
 #include <ThreadedAssignment.h>
@@ -24,6 +29,7 @@
 
 #include "AudioMixerClientData.h"
 #include "AudioMixerStats.h"
+#include "DecodedFrameArena.h"
 
 class AvatarAudioStream;
 class AudioHRTF;
@@ -36,6 +42,14 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+
+        // distant, quiet sources can be mixed into a first-order ambisonic bed instead of getting their own HRTF
+        AudioFarFieldBed::Settings farFieldSettings;
+        AudioFarFieldClusters farFieldClusters;
+        std::unordered_map<const PositionalAudioStream*, int> farFieldClusterIndices;
+
+        // cleared every frame
+        AudioEncodedMixes encodedMixes;
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -43,6 +57,12 @@ public:
     // process packets for a given node (requires no configuration)
     void processPackets(const SharedNodePointer& node);
 
+    // decode the streams of a given node for this frame (requires configuration using configureDecode, below)
+    void decode(const SharedNodePointer& node);
+
+    // configure a round of decoding, this releases the frames decoded by this slave in the previous round
+    void configureDecode() { _decodedFrames.reset(); }
+
     // configure a round of mixing
     void configureMix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain);
 
@@ -62,13 +82,32 @@ private:
                               AvatarAudioStream& listeningNodeStream,
                               float masterListenerGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
+    void renderHRTFBatch();
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
 
+    // far-field bed
+    void prepareFarFieldBed(AudioMixerClientData::MixableStreamsVector& activeStreams,
+                            const AvatarAudioStream& listenerAudioStream);
+    void addFarFieldStream(AudioMixerClientData::MixableStream& mixableStream,
+                           const glm::vec3& relativePosition, float distance, float gain);
+    void renderFarFieldBed(AudioMixerClientData& listenerData, const AvatarAudioStream& listenerAudioStream);
+
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
 
+    // HRTF renders queued by addStream() for the listener being mixed
+    std::vector<AudioHRTF::Source> _hrtfBatch;
+
+    // streams decoded by this slave, read by all slaves while mixing
+    DecodedFrameArena _decodedFrames;
+
+    // far-field state for the listener being mixed
+    bool _useFarFieldBed { false };
+    AudioFarFieldBed _farFieldBed;
+    std::vector<float> _farFieldVolumes;
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
@@ -74,6 +74,14 @@ void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     run(begin, end);
 }
 
+void AudioMixerSlavePool::decode(ConstIter begin, ConstIter end) {
+    _function = &AudioMixerSlave::decode;
+    _configure = [](AudioMixerSlave& slave) {
+        slave.configureDecode();
+    };
+    run(begin, end);
+}
+
 void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
     _function = &AudioMixerSlave::mix;
     _configure = [=](AudioMixerSlave& slave) {
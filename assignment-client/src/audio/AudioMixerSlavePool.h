@@ -66,6 +66,9 @@ public:
     // process packets on slave threads
     void processPackets(ConstIter begin, ConstIter end);
 
+    // decode streams on slave threads
+    void decode(ConstIter begin, ConstIter end);
+
     // mix on slave threads
     void mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain);
 
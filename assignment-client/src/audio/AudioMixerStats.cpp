@@ -11,13 +11,99 @@
 
 #include "AudioMixerStats.h"
 
+#include <algorithm>
+#include <cmath>
+
+int AudioMixerHistogram::bucketFor(uint64_t usecs) {
+    if (usecs < NUM_LINEAR_BUCKETS) {
+        return (int)usecs;
+    }
+
+    // find the power of two, and use the next bits to pick the sub-bucket
+    int exponent = 4;
+    while ((usecs >> (exponent + 1)) != 0) {
+        ++exponent;
+    }
+    int subBucket = (int)(usecs >> (exponent - SUB_BUCKET_BITS)) & ((1 << SUB_BUCKET_BITS) - 1);
+    int bucket = NUM_LINEAR_BUCKETS + ((exponent - 4) << SUB_BUCKET_BITS) + subBucket;
+
+    return std::min(bucket, NUM_BUCKETS - 1);
+}
+
+uint64_t AudioMixerHistogram::bucketUpperBound(int bucket) {
+    if (bucket < NUM_LINEAR_BUCKETS) {
+        return (uint64_t)bucket;
+    }
+
+    int exponent = 4 + ((bucket - NUM_LINEAR_BUCKETS) >> SUB_BUCKET_BITS);
+    int subBucket = (bucket - NUM_LINEAR_BUCKETS) & ((1 << SUB_BUCKET_BITS) - 1);
+    uint64_t lowerBound = (uint64_t)((1 << SUB_BUCKET_BITS) + subBucket) << (exponent - SUB_BUCKET_BITS);
+
+    return lowerBound + ((uint64_t)1 << (exponent - SUB_BUCKET_BITS)) - 1;
+}
+
+void AudioMixerHistogram::record(uint64_t usecs) {
+    ++_buckets[bucketFor(usecs)];
+    ++_count;
+    _max = std::max(_max, usecs);
+}
+
+void AudioMixerHistogram::reset() {
+    // slave stats are reset every frame, skip the clear when nothing was recorded
+    if (_count > 0) {
+        _buckets.fill(0);
+        _count = 0;
+        _max = 0;
+    }
+}
+
+void AudioMixerHistogram::accumulate(const AudioMixerHistogram& otherHistogram) {
+    if (otherHistogram._count == 0) {
+        return;
+    }
+
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        _buckets[i] += otherHistogram._buckets[i];
+    }
+    _count += otherHistogram._count;
+    _max = std::max(_max, otherHistogram._max);
+}
+
+uint64_t AudioMixerHistogram::percentile(float percent) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    uint64_t target = std::max((uint64_t)1, (uint64_t)std::ceil(percent / 100.0f * (float)_count));
+
+    uint64_t sum = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        sum += _buckets[i];
+        if (sum >= target) {
+            return std::min(bucketUpperBound(i), _max);
+        }
+    }
+    return _max;
+}
+
 void AudioMixerStats::reset() {
     sumStreams = 0;
     sumListeners = 0;
     sumListenersSilent = 0;
+    sumListenersSilentMixes = 0;
+
+    decodeTime = 0;
+
+    decodeHistogram.reset();
+    mixHistogram.reset();
+    encodeHistogram.reset();
+    sendHistogram.reset();
 
     totalMixes = 0;
 
+    encodes = 0;
+    sharedEncodes = 0;
+
     hrtfRenders = 0;
     hrtfResets = 0;
     hrtfUpdates = 0;
@@ -25,6 +111,10 @@ void AudioMixerStats::reset() {
     manualStereoMixes = 0;
     manualEchoMixes = 0;
 
+    farFieldStreams = 0;
+    farFieldClusterMixes = 0;
+    farFieldRenders = 0;
+
     skippedToActive = 0;
     skippedToInactive = 0;
     inactiveToSkipped = 0;
@@ -45,9 +135,20 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     sumStreams += otherStats.sumStreams;
     sumListeners += otherStats.sumListeners;
     sumListenersSilent += otherStats.sumListenersSilent;
+    sumListenersSilentMixes += otherStats.sumListenersSilentMixes;
+
+    decodeTime += otherStats.decodeTime;
+
+    decodeHistogram.accumulate(otherStats.decodeHistogram);
+    mixHistogram.accumulate(otherStats.mixHistogram);
+    encodeHistogram.accumulate(otherStats.encodeHistogram);
+    sendHistogram.accumulate(otherStats.sendHistogram);
 
     totalMixes += otherStats.totalMixes;
 
+    encodes += otherStats.encodes;
+    sharedEncodes += otherStats.sharedEncodes;
+
     hrtfRenders += otherStats.hrtfRenders;
     hrtfResets += otherStats.hrtfResets;
     hrtfUpdates += otherStats.hrtfUpdates;
@@ -55,6 +156,10 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
 
+    farFieldStreams += otherStats.farFieldStreams;
+    farFieldClusterMixes += otherStats.farFieldClusterMixes;
+    farFieldRenders += otherStats.farFieldRenders;
+
     skippedToActive += otherStats.skippedToActive;
     skippedToInactive += otherStats.skippedToInactive;
     inactiveToSkipped += otherStats.inactiveToSkipped;
@@ -12,17 +12,57 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
+#include <array>
 #include <cstdint>
-#endif
+
+// Histogram of durations in usecs, with buckets about 12% wide
+//   Each slave records into its own stats, which are merged after the slaves are done, so no locking is needed.
+class AudioMixerHistogram {
+public:
+    void record(uint64_t usecs);
+
+    void reset();
+    void accumulate(const AudioMixerHistogram& otherHistogram);
+
+    uint64_t count() const { return _count; }
+    uint64_t max() const { return _max; }
+
+    // upper bound of the bucket holding the given percentile (0-100), clamped to max()
+    uint64_t percentile(float percent) const;
+
+private:
+    // exact below 16us, then 8 buckets per power of two up to 2^27us
+    static const int NUM_LINEAR_BUCKETS = 16;
+    static const int SUB_BUCKET_BITS = 3;
+    static const int NUM_BUCKETS = NUM_LINEAR_BUCKETS + (27 - 4) * (1 << SUB_BUCKET_BITS);
+
+    static int bucketFor(uint64_t usecs);
+    static uint64_t bucketUpperBound(int bucket);
+
+    std::array<uint32_t, NUM_BUCKETS> _buckets {};
+    uint64_t _count { 0 };
+    uint64_t _max { 0 };
+};
 
 struct AudioMixerStats {
     int sumStreams { 0 };
     int sumListeners { 0 };
     int sumListenersSilent { 0 };
+    int sumListenersSilentMixes { 0 }; // listeners with sources, whose mix was silent
+
+    uint64_t decodeTime { 0 }; // usecs, summed over slaves
+
+    // per node durations
+    AudioMixerHistogram decodeHistogram;
+    AudioMixerHistogram mixHistogram;
+    AudioMixerHistogram encodeHistogram;
+    AudioMixerHistogram sendHistogram;
 
     int totalMixes { 0 };
 
+    int encodes { 0 };
+    int sharedEncodes { 0 };
+
     int hrtfRenders { 0 };
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
@@ -30,6 +70,10 @@ struct AudioMixerStats {
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
+    int farFieldStreams { 0 };
+    int farFieldClusterMixes { 0 };
+    int farFieldRenders { 0 };
+
     int skippedToActive { 0 };
     int skippedToInactive { 0 };
     int inactiveToSkipped { 0 };
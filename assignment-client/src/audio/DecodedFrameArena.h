@@ -0,0 +1,44 @@
+//
+//  DecodedFrameArena.h
+//  assignment-client/src/audio
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DecodedFrameArena_h
+#define hifi_DecodedFrameArena_h
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <AudioConstants.h>
+
+// Frame-scoped storage for the decoded output of audio streams
+//   Blocks are reused from frame to frame, so a steady number of streams causes no allocations.
+//   Pointers handed out by allocate() stay valid until the next reset().
+//   DecodedFrameArena is not thread-safe, each AudioMixerSlave owns its own.
+class DecodedFrameArena {
+    using Frame = std::array<int16_t, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO>;
+
+public:
+    int16_t* allocate() {
+        if (_numUsed == _frames.size()) {
+            _frames.emplace_back(new Frame);
+        }
+        return _frames[_numUsed++]->data();
+    }
+
+    void reset() { _numUsed = 0; }
+
+    size_t size() const { return _numUsed; }
+
+private:
+    std::vector<std::unique_ptr<Frame>> _frames;
+    size_t _numUsed { 0 };
+};
+
+#endif // hifi_DecodedFrameArena_h
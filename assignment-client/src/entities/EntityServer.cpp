@@ -16,6 +16,7 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 
+#include <ClientEntityCache.h>
 #include <EntityTree.h>
 #include <SimpleEntitySimulation.h>
 #include <ResourceCache.h>
@@ -57,6 +58,8 @@ EntityServer::EntityServer(ReceivedMessage& message) :
         PacketType::ChallengeOwnershipReply },
         this,
         "handleEntityPacket");
+    packetReceiver.registerListener(PacketType::EntityQueryCache, this, "handleEntityQueryCachePacket");
+    packetReceiver.registerListener(PacketType::EntityQueryResend, this, "handleEntityQueryResendPacket");
 
     connect(&_dynamicDomainVerificationTimer, &QTimer::timeout, this, &EntityServer::startDynamicDomainVerification);
     _dynamicDomainVerificationTimer.setSingleShot(true);
@@ -86,6 +89,40 @@ void EntityServer::handleEntityPacket(QSharedPointer<ReceivedMessage> message, S
     }
 }
 
+void EntityServer::handleEntityQueryCachePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    // the manifest can arrive before the first query
+    auto nodeList = DependencyManager::get<NodeList>();
+    EntityNodeData* nodeData = static_cast<EntityNodeData*>(nodeList->getOrCreateLinkedData(senderNode));
+    if (!nodeData) {
+        return;
+    }
+
+    // the send thread picks the manifest up before its next traversal
+    QHash<QUuid, quint64> clientCache;
+    if (ClientEntityCache::readManifest(message->readAll(), clientCache)) {
+        nodeData->setClientCache(clientCache);
+    } else {
+        qDebug() << "Ignoring a malformed entity cache manifest from" << senderNode->getUUID();
+        nodeData->setClientCache(QHash<QUuid, quint64>());
+    }
+}
+
+void EntityServer::handleEntityQueryResendPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    EntityNodeData* nodeData = static_cast<EntityNodeData*>(senderNode->getLinkedData());
+    if (!nodeData) {
+        return;
+    }
+
+    // the send thread defines the strings again and resends the entities before its next traversal
+    QVector<quint32> stringIDs;
+    QVector<QUuid> entityIDs;
+    if (OctreeSharedStrings::readResendRequest(message->readAll(), stringIDs, entityIDs)) {
+        nodeData->addResendRequest(stringIDs, entityIDs);
+    } else {
+        qDebug() << "Ignoring a malformed entity resend request from" << senderNode->getUUID();
+    }
+}
+
 std::unique_ptr<OctreeQueryNode> EntityServer::createOctreeQueryNode() {
     return std::unique_ptr<OctreeQueryNode> { new EntityNodeData() };
 }
@@ -134,7 +171,8 @@ bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
     if (nodeData) {
         quint64 deletedEntitiesSentAt = nodeData->getLastDeletedEntitiesSentAt();
         EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
-        shouldSendDeletedEntities = tree->hasEntitiesDeletedSince(deletedEntitiesSentAt);
+        shouldSendDeletedEntities = tree->hasEntitiesDeletedSince(deletedEntitiesSentAt) ||
+            nodeData->hasStaleCachedEntities();
 
         #ifdef EXTRA_ERASE_DEBUGGING
             if (shouldSendDeletedEntities) {
@@ -186,6 +224,9 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
         qint64 numberOfIDsPos = deletesPacket->pos();
         deletesPacket->writePrimitive(numberOfIDs);
 
+        // the entities in the client's cache which are gone from the server are erased along with the deleted ones
+        QVector<QUuid> entityIDs = nodeData->takeStaleCachedEntities();
+
         // we keep a multi map of entity IDs to timestamps, we only want to include the entity IDs that have been
         // deleted since we last sent to this node
         auto it = recentlyDeleted.constBegin();
@@ -195,67 +236,65 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
             if (it.key() > considerEntitiesSince) {
 
                 // get all the IDs for this timestamp
-                const auto& entityIDsFromTime = recentlyDeleted.values(it.key());
-
-                for (const auto& entityID : entityIDsFromTime) {
-
-                    // check to make sure we have room for one more ID, if we don't have more
-                    // room, then send out this packet and create another one
-                    if (NUM_BYTES_RFC4122_UUID > deletesPacket->bytesAvailableForWrite()) {
+                entityIDs += recentlyDeleted.values(it.key()).toVector();
+            }
 
-                        // replace the count for the number of included IDs
-                        deletesPacket->seek(numberOfIDsPos);
-                        deletesPacket->writePrimitive(numberOfIDs);
+            ++it;
+        } // end while
 
-                        // Send the current packet
-                        queryNode->packetSent(*deletesPacket);
-                        auto thisPacketSize = deletesPacket->getDataSize();
-                        totalBytes += thisPacketSize;
-                        packetsSent++;
-                        DependencyManager::get<NodeList>()->sendPacket(std::move(deletesPacket), *node);
+        for (const auto& entityID : entityIDs) {
 
-                        #ifdef EXTRA_ERASE_DEBUGGING
-                            qDebug() << "EntityServer::sendSpecialPackets() sending packet packetsSent[" << packetsSent << "] size:" << thisPacketSize;
-                        #endif
+            // check to make sure we have room for one more ID, if we don't have more
+            // room, then send out this packet and create another one
+            if (NUM_BYTES_RFC4122_UUID > deletesPacket->bytesAvailableForWrite()) {
 
+                // replace the count for the number of included IDs
+                deletesPacket->seek(numberOfIDsPos);
+                deletesPacket->writePrimitive(numberOfIDs);
 
-                        // create another packet
-                        deletesPacket = NLPacket::create(PacketType::EntityErase);
+                // Send the current packet
+                queryNode->packetSent(*deletesPacket);
+                auto thisPacketSize = deletesPacket->getDataSize();
+                totalBytes += thisPacketSize;
+                packetsSent++;
+                DependencyManager::get<NodeList>()->sendPacket(std::move(deletesPacket), *node);
 
-                        // pack in flags
-                        deletesPacket->writePrimitive(flags);
+                #ifdef EXTRA_ERASE_DEBUGGING
+                    qDebug() << "EntityServer::sendSpecialPackets() sending packet packetsSent[" << packetsSent << "] size:" << thisPacketSize;
+                #endif
 
-                        // pack in sequence number
-                        sequenceNumber = queryNode->getSequenceNumber();
-                        deletesPacket->writePrimitive(sequenceNumber);
 
-                        // pack in timestamp
-                        deletesPacket->writePrimitive(now);
+                // create another packet
+                deletesPacket = NLPacket::create(PacketType::EntityErase);
 
-                        // figure out where we are now and pack a temporary number of IDs
-                        numberOfIDs = 0;
-                        numberOfIDsPos = deletesPacket->pos();
-                        deletesPacket->writePrimitive(numberOfIDs);
-                    }
+                // pack in flags
+                deletesPacket->writePrimitive(flags);
 
-                    // FIXME - we still seem to see cases where incorrect EntityIDs get sent from the server
-                    // to the client. These were causing "lost" entities like flashlights and laser pointers
-                    // now that we keep around some additional history of the erased entities and resend that
-                    // history for a longer time window, these entities are not "lost". But we haven't yet
-                    // found/fixed the underlying issue that caused bad UUIDs to be sent to some users.
-                    deletesPacket->write(entityID.toRfc4122());
-                    ++numberOfIDs;
+                // pack in sequence number
+                sequenceNumber = queryNode->getSequenceNumber();
+                deletesPacket->writePrimitive(sequenceNumber);
 
-                    #ifdef EXTRA_ERASE_DEBUGGING
-                        qDebug() << "EntityTree::encodeEntitiesDeletedSince() including:" << entityID;
-                    #endif
-                } // end for (ids)
+                // pack in timestamp
+                deletesPacket->writePrimitive(now);
 
-            } // end if (it.val > sinceLast)
+                // figure out where we are now and pack a temporary number of IDs
+                numberOfIDs = 0;
+                numberOfIDsPos = deletesPacket->pos();
+                deletesPacket->writePrimitive(numberOfIDs);
+            }
 
+            // FIXME - we still seem to see cases where incorrect EntityIDs get sent from the server
+            // to the client. These were causing "lost" entities like flashlights and laser pointers
+            // now that we keep around some additional history of the erased entities and resend that
+            // history for a longer time window, these entities are not "lost". But we haven't yet
+            // found/fixed the underlying issue that caused bad UUIDs to be sent to some users.
+            deletesPacket->write(entityID.toRfc4122());
+            ++numberOfIDs;
 
-            ++it;
-        } // end while
+            #ifdef EXTRA_ERASE_DEBUGGING
+                qDebug() << "EntityTree::encodeEntitiesDeletedSince() including:" << entityID;
+            #endif
+        } // end for (ids)
 
         // replace the count for the number of included IDs
         deletesPacket->seek(numberOfIDsPos);
@@ -411,6 +450,22 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    // display the time spent in each pass of the simulation
+    if (_entitySimulation) {
+        statsString += "<b>Entity Server Simulation Statistics</b>\r\n";
+        statsString += QString("  Expire mortal entities: %1 usecs\r\n")
+            .arg(locale.toString(_entitySimulation->getAverageExpireTime()).rightJustified(16, ' '));
+        statsString += QString("         Update entities: %1 usecs\r\n")
+            .arg(locale.toString(_entitySimulation->getAverageUpdateTime()).rightJustified(16, ' '));
+        statsString += QString("  Move simple kinematics: %1 usecs\r\n")
+            .arg(locale.toString(_entitySimulation->getAverageMoveTime()).rightJustified(16, ' '));
+        statsString += QString("  Ownership and stopping: %1 usecs\r\n")
+            .arg(locale.toString(_entitySimulation->getAverageInternalTime()).rightJustified(16, ' '));
+        statsString += QString("     Sort moved entities: %1 usecs\r\n")
+            .arg(locale.toString(_entitySimulation->getAverageSortTime()).rightJustified(16, ' '));
+        statsString += "\r\n\r\n";
+    }
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
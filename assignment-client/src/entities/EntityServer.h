@@ -72,6 +72,8 @@ protected:
 
 private slots:
     void handleEntityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleEntityQueryCachePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleEntityQueryResendPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void domainSettingsRequestFailed();
 
 private:
@@ -40,6 +40,7 @@ public:
     virtual char getMyNodeType() const override { return NodeType::EntityServer; }
     virtual PacketType getMyQueryMessageType() const override { return PacketType::EntityQuery; }
     virtual PacketType getExpectedPacketType() const override { return PacketType::EntityData; }
+    virtual PacketType getMyResendRequestMessageType() const override { return PacketType::EntityQueryResend; }
 
     void update();
 
@@ -17,6 +17,9 @@
 
 #include "EntityServer.h"
 
+// how long to hold off the first traversal for the manifest of a client's entity cache
+const quint64 MAX_CLIENT_CACHE_WAIT = 2 * USECS_PER_SECOND;
+
 EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
     OctreeSendThread(myServer, node)
 {
@@ -26,6 +29,8 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
     // connect to connection ID change on EntityNodeData so we can clear state for this receiver
     auto nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
     connect(nodeData, &EntityNodeData::incomingConnectionIDChanged, this, &EntityTreeSendThread::resetState);
+
+    _packetData.setSharedStrings(&_sharedStrings);
 }
 
 void EntityTreeSendThread::resetState() {
@@ -33,6 +38,11 @@ void EntityTreeSendThread::resetState() {
 
     _knownState.clear();
     _traversal.reset();
+    _sharedStrings.clear();
+
+    // a new connection sends a new manifest, unless it already came in
+    _clientCacheResolved = !_clientCache.isEmpty();
+    _clientCacheWaitStart = 0;
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -101,6 +111,12 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
+    if (waitForClientCache(static_cast<EntityNodeData*>(nodeData))) {
+        return false;
+    }
+
+    processResendRequest(static_cast<EntityNodeData*>(nodeData));
+
     if (viewFrustumChanged || _traversal.finished()) {
         EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
 
@@ -171,6 +187,81 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
     return sendComplete;
 }
 
+bool EntityTreeSendThread::waitForClientCache(EntityNodeData* nodeData) {
+    QHash<QUuid, quint64> clientCache;
+    if (nodeData->takeClientCache(clientCache)) {
+        // start over so that the First traversal skips what the client already has
+        _clientCache.swap(clientCache);
+        _clientCacheResolved = true;
+        _traversal.reset();
+        return false;
+    }
+
+    if (_clientCacheResolved || !nodeData->hasClientCache()) {
+        return false;
+    }
+
+    // hold off until the manifest arrives, rather than sending entities the client may already have
+    quint64 now = usecTimestampNow();
+    if (_clientCacheWaitStart == 0) {
+        _clientCacheWaitStart = now;
+    }
+    if (now - _clientCacheWaitStart < MAX_CLIENT_CACHE_WAIT) {
+        return true;
+    }
+    qCDebug(entities) << "Gave up waiting for the entity cache manifest of" << _nodeUuid;
+    _clientCacheResolved = true;
+    return false;
+}
+
+void EntityTreeSendThread::seedKnownStateFromClientCache() {
+    // the cached entities which didn't change since are known to the client, the ones which are gone get erased
+    auto entityTree = std::static_pointer_cast<EntityTree>(_myServer->getOctree());
+    uint64_t now = usecTimestampNow();
+    QVector<QUuid> staleEntities;
+    for (auto itr = _clientCache.constBegin(); itr != _clientCache.constEnd(); ++itr) {
+        EntityItemPointer entity = entityTree->findEntityByID(itr.key());
+        if (!entity) {
+            staleEntities.push_back(itr.key());
+        } else if (entity->getLastEdited() == itr.value()) {
+            _knownState[entity.get()] = now;
+        }
+    }
+    for (const auto& entityID : staleEntities) {
+        _clientCache.remove(entityID);
+    }
+
+    auto node = _node.toStrongRef();
+    auto nodeData = node ? static_cast<EntityNodeData*>(node->getLinkedData()) : nullptr;
+    if (nodeData && !staleEntities.isEmpty()) {
+        nodeData->addStaleCachedEntities(staleEntities);
+    }
+}
+
+void EntityTreeSendThread::processResendRequest(EntityNodeData* nodeData) {
+    QVector<quint32> stringIDs;
+    QVector<QUuid> entityIDs;
+    if (!nodeData->takeResendRequest(stringIDs, entityIDs)) {
+        return;
+    }
+
+    for (auto id : stringIDs) {
+        _sharedStrings.forget(id);
+    }
+
+    // the entities are known to the client but incomplete, so they are sent again whatever the traversal finds
+    auto entityTree = std::static_pointer_cast<EntityTree>(_myServer->getOctree());
+    entityTree->withReadLock([&] {
+        for (const auto& entityID : entityIDs) {
+            EntityItemPointer entity = entityTree->findEntityByID(entityID);
+            if (entity && !_sendQueue.contains(entity.get())) {
+                _knownState.erase(entity.get());
+                _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY);
+            }
+        }
+    });
+}
+
 bool EntityTreeSendThread::addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID,
                                                               EntityItem& entityItem, EntityNodeData& nodeData) {
     // check if this entity has a parent that is also an entity
@@ -235,12 +326,21 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
         case DiffTraversal::First:
             // When we get to a First traversal, clear the _knownState
             _knownState.clear();
+            if (!_clientCache.isEmpty()) {
+                seedKnownStateFromClientCache();
+            }
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
                 next.element->forEachEntity([&](EntityItemPointer entity) {
                     // Bail early if we've already checked this entity this frame
                     if (_sendQueue.contains(entity.get())) {
                         return;
                     }
+                    // Skip the entities the client has in its cache, unless they changed since
+                    auto knownTimestamp = _knownState.find(entity.get());
+                    if (knownTimestamp != _knownState.end() && entity->getLastEdited() <= knownTimestamp->second &&
+                        entity->getLastChangedOnServer() <= knownTimestamp->second) {
+                        return;
+                    }
                     const auto& view = _traversal.getCurrentView();
                     float priority = view.computePriority(entity);
 
@@ -251,6 +351,8 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
             });
             break;
         case DiffTraversal::Repeat:
+            // a First traversal completed, the client's cache is no longer needed
+            _clientCache.clear();
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
                 uint64_t startOfCompletedTraversal = _traversal.getStartOfCompletedTraversal();
                 if (next.element->getLastChangedContent() > startOfCompletedTraversal) {
@@ -282,6 +384,7 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
             break;
         case DiffTraversal::Differential:
             assert(view.usesViewFrustums());
+            _clientCache.clear();
             _traversal.setScanCallback([this] (DiffTraversal::VisibleElement& next) {
                 next.element->forEachEntity([&](EntityItemPointer entity) {
                     // Bail early if we've already checked this entity this frame
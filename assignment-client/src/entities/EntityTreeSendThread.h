@@ -42,6 +42,13 @@ private:
     bool addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
 
+    // returns true while the client's entity cache manifest is awaited
+    bool waitForClientCache(EntityNodeData* nodeData);
+    void seedKnownStateFromClientCache();
+
+    // forgets the strings the client has no definition for, and queues the entities that referred to them
+    void processResendRequest(EntityNodeData* nodeData);
+
     void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
 
@@ -52,6 +59,12 @@ private:
     DiffTraversal _traversal;
     EntityPriorityQueue _sendQueue;
     std::unordered_map<EntityItem*, uint64_t> _knownState;
+    OctreeSharedStrings _sharedStrings; // the strings sent to this viewer
+
+    // the manifest of the client's entity cache, applied by First traversals until one completes
+    QHash<QUuid, quint64> _clientCache;
+    bool _clientCacheResolved { false };
+    quint64 _clientCacheWaitStart { 0 };
 
     // packet construction stuff
     EntityTreeElementExtraEncodeDataPointer _extraEncodeData { new EntityTreeElementExtraEncodeData() };
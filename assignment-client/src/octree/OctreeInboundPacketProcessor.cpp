@@ -11,8 +11,11 @@
 
 #include "OctreeInboundPacketProcessor.h"
 
+#include <iterator>
 #include <limits>
 
+#include <tbb/parallel_for.h>
+
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
@@ -23,6 +26,9 @@
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
 
+// Number of edit packets applied under one write lock of the tree
+const size_t MAX_EDIT_PACKETS_PER_BATCH = 64;
+
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
     _receivedPacketCount(0),
@@ -225,6 +231,109 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
     }
 }
 
+void OctreeInboundPacketProcessor::processPackets(std::list<NodeSharedReceivedMessagePair>& packets) {
+    auto tree = _myServer->getOctree();
+    if (!tree->canDecodeEditsConcurrently() || _myServer->wantsVerboseDebug()) {
+        ReceivedPacketProcessor::processPackets(packets);
+        return;
+    }
+
+    // Consecutive edit packets are processed together, the other packets are processed in between, in order
+    std::vector<NodeSharedReceivedMessagePair> editPackets;
+    for (auto& packetPair : packets) {
+        bool isEditPacket = tree->handlesEditPacketType(packetPair.second->getType());
+        if (isEditPacket) {
+            editPackets.push_back(packetPair);
+        }
+        if (!isEditPacket || editPackets.size() >= MAX_EDIT_PACKETS_PER_BATCH) {
+            processEditPackets(editPackets);
+            editPackets.clear();
+        }
+        if (!isEditPacket) {
+            processPacket(packetPair.second, packetPair.first);
+            _lastWindowProcessedPackets++;
+            midProcess();
+        }
+    }
+    processEditPackets(editPackets);
+}
+
+void OctreeInboundPacketProcessor::processEditPackets(std::vector<NodeSharedReceivedMessagePair>& packets) {
+    if (packets.empty()) {
+        return;
+    }
+    if (_shuttingDown) {
+        qDebug() << "OctreeInboundPacketProcessor::processEditPackets() while shutting down... ignoring incoming packets";
+        return;
+    }
+
+    struct DecodedPacket {
+        unsigned short int sequence { 0 };
+        quint64 transitTime { 0 };
+        quint64 decodeTime { 0 };
+        int numEditRecords { 0 };
+        OctreeDecodedEdits edits;
+    };
+    std::vector<DecodedPacket> decodedPackets(packets.size());
+
+    auto tree = _myServer->getOctree();
+    bool debugReceiving = _myServer->wantsDebugReceiving();
+    tbb::parallel_for((size_t)0, packets.size(), [&](size_t i) {
+        auto& message = packets[i].second;
+        auto& sendingNode = packets[i].first;
+        auto& decodedPacket = decodedPackets[i];
+
+        message->readPrimitive(&decodedPacket.sequence);
+
+        quint64 sentAt;
+        message->readPrimitive(&sentAt);
+
+        quint64 arrivedAt = usecTimestampNow();
+        if (sentAt > arrivedAt) {
+            if (debugReceiving) {
+                qDebug() << "unreasonable sentAt=" << sentAt << " usecs";
+                qDebug() << "setting sentAt to arrivedAt=" << arrivedAt << " usecs";
+            }
+            sentAt = arrivedAt;
+        }
+        decodedPacket.transitTime = arrivedAt - sentAt;
+
+        decodedPacket.numEditRecords = tree->decodeEditPacket(*message, sendingNode, decodedPacket.edits);
+        decodedPacket.decodeTime = usecTimestampNow() - arrivedAt;
+    });
+
+    size_t numEdits = 0;
+    for (auto& decodedPacket : decodedPackets) {
+        numEdits += decodedPacket.edits.size();
+    }
+    OctreeDecodedEdits edits;
+    edits.reserve(numEdits);
+    for (auto& decodedPacket : decodedPackets) {
+        std::move(decodedPacket.edits.begin(), decodedPacket.edits.end(), std::back_inserter(edits));
+    }
+
+    quint64 lockWaitTime = 0;
+    quint64 processTime = 0;
+    tree->processDecodedEdits(edits, lockWaitTime, processTime);
+
+    // the time spent applying the batch is shared between its packets, by number of decoded edits
+    for (size_t i = 0; i < packets.size(); i++) {
+        auto& sendingNode = packets[i].first;
+        auto& decodedPacket = decodedPackets[i];
+        quint64 decodedEdits = decodedPacket.edits.size();
+        quint64 packetProcessTime = decodedPacket.decodeTime + (numEdits ? processTime * decodedEdits / numEdits : 0);
+        quint64 packetLockWaitTime = numEdits ? lockWaitTime * decodedEdits / numEdits : 0;
+
+        const QUuid& nodeUUID = sendingNode ? sendingNode->getUUID() : DEFAULT_NODE_ID_REF;
+        trackInboundPacket(nodeUUID, decodedPacket.sequence, decodedPacket.transitTime, decodedPacket.numEditRecords,
+            packetProcessTime, packetLockWaitTime);
+
+        _receivedPacketCount++;
+        _lastWindowProcessedPackets++;
+    }
+    midProcess();
+}
+
 void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int editsInPacket, quint64 processTime, quint64 lockWaitTime) {
 
@@ -79,6 +79,7 @@ public:
 protected:
 
     virtual void processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) override;
+    virtual void processPackets(std::list<NodeSharedReceivedMessagePair>& packets) override;
 
     virtual uint32_t getMaxWait() const override;
     virtual void preProcess() override;
@@ -87,6 +88,9 @@ protected:
 private:
     int sendNackPackets();
 
+    // Decodes the edit packets concurrently, then has the tree apply all their edits in order
+    void processEditPackets(std::vector<NodeSharedReceivedMessagePair>& packets);
+
 private:
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
@@ -479,6 +479,7 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
                 // either there is room, or we've flushed and reset nodeData's data buffer
                 // so we can transfer whatever is in _packetData to nodeData
                 nodeData->writeToPacket(_packetData.getFinalizedData(), _packetData.getFinalizedSize());
+                _packetData.commitSharedStrings();
                 compressAndWriteElapsedUsec = (float)(usecTimestampNow()- compressAndWriteStart);
             }
 
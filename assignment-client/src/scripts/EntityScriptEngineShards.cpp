@@ -0,0 +1,138 @@
+//
+//  EntityScriptEngineShards.cpp
+//  assignment-client/src/scripts
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptEngineShards.h"
+
+#include <limits>
+
+#include <QtCore/QJsonArray>
+
+void EntityScriptEngineShards::addEngine(const ScriptEnginePointer& engine) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _engines.push_back(engine);
+    _engineEntityCounts.push_back(0);
+}
+
+std::vector<ScriptEnginePointer> EntityScriptEngineShards::getEngines() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _engines;
+}
+
+ScriptEnginePointer EntityScriptEngineShards::getFirstEngine() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _engines.empty() ? ScriptEnginePointer() : _engines.front();
+}
+
+void EntityScriptEngineShards::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _engines.clear();
+    _entityEngines.clear();
+    _engineEntityCounts.clear();
+}
+
+ScriptEnginePointer EntityScriptEngineShards::getEngineForEntity(const EntityItemID& entityID) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entityEngines.constFind(entityID);
+    if (it == _entityEngines.constEnd()) {
+        return ScriptEnginePointer();
+    }
+    return _engines[it.value()];
+}
+
+ScriptEnginePointer EntityScriptEngineShards::assignEngineForEntity(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_engines.empty()) {
+        return ScriptEnginePointer();
+    }
+
+    auto it = _entityEngines.constFind(entityID);
+    if (it != _entityEngines.constEnd()) {
+        return _engines[it.value()];
+    }
+
+    // pick the engine with the least time used by its loaded scripts, then the fewest scripts.
+    size_t bestIndex = 0;
+    quint64 bestUsecs = std::numeric_limits<quint64>::max();
+    int bestCount = std::numeric_limits<int>::max();
+    for (size_t i = 0; i < _engines.size(); i++) {
+        quint64 usecs = _engines[i]->getTotalEntityScriptUsecs();
+        int count = _engineEntityCounts[i];
+        if (usecs < bestUsecs || (usecs == bestUsecs && count < bestCount)) {
+            bestIndex = i;
+            bestUsecs = usecs;
+            bestCount = count;
+        }
+    }
+
+    _entityEngines[entityID] = bestIndex;
+    _engineEntityCounts[bestIndex]++;
+    return _engines[bestIndex];
+}
+
+void EntityScriptEngineShards::removeEntity(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entityEngines.find(entityID);
+    if (it != _entityEngines.end()) {
+        _engineEntityCounts[it.value()]--;
+        _entityEngines.erase(it);
+    }
+}
+
+int EntityScriptEngineShards::getNumRunningEntityScripts() const {
+    int sum = 0;
+    for (auto& engine : getEngines()) {
+        sum += engine->getNumRunningEntityScripts();
+    }
+    return sum;
+}
+
+QJsonObject EntityScriptEngineShards::getStats() const {
+    QJsonObject stats;
+    QJsonArray engineStats;
+    quint64 totalUsecs = 0;
+    for (auto& engine : getEngines()) {
+        QJsonObject engineObject;
+        QJsonObject scriptsObject;
+        quint64 engineUsecs = 0;
+        auto scriptUsecs = engine->getEntityScriptUsecs();
+        for (auto it = scriptUsecs.cbegin(); it != scriptUsecs.cend(); ++it) {
+            scriptsObject[it.key().toString()] = (qint64)it.value();
+            engineUsecs += it.value();
+        }
+        engineObject["running_scripts"] = engine->getNumRunningEntityScripts();
+        engineObject["script_usecs"] = (qint64)engineUsecs;
+        engineObject["usecs_per_script"] = scriptsObject;
+        engineStats.append(engineObject);
+        totalUsecs += engineUsecs;
+    }
+    stats["engines"] = engineStats;
+    stats["script_usecs"] = (qint64)totalUsecs;
+    return stats;
+}
+
+void EntityScriptEngineShards::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                      const QStringList& params, const QUuid& remoteCallerID) {
+    auto engine = getEngineForEntity(entityID);
+    if (engine) {
+        engine->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    }
+}
+
+QFuture<QVariant> EntityScriptEngineShards::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto engine = getEngineForEntity(entityID);
+    if (!engine) {
+        // let an engine produce the usual "no script" details
+        engine = getFirstEngine();
+    }
+    if (!engine) {
+        return QFuture<QVariant>();
+    }
+    return engine->getLocalEntityScriptDetails(entityID);
+}
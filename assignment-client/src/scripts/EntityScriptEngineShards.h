@@ -0,0 +1,59 @@
+//
+//  EntityScriptEngineShards.h
+//  assignment-client/src/scripts
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptEngineShards_h
+#define hifi_EntityScriptEngineShards_h
+
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+// Spreads entity server scripts over several ScriptEngines, each running on its own thread.
+// Every entity script is owned by one engine for as long as it is loaded.  New scripts go to the
+// engine whose running scripts have spent the least time running so far.
+class EntityScriptEngineShards : public EntitiesScriptEngineProvider {
+public:
+    void addEngine(const ScriptEnginePointer& engine);
+    std::vector<ScriptEnginePointer> getEngines() const;
+    ScriptEnginePointer getFirstEngine() const;
+    void clear();
+
+    // the engine owning the script for entityID, or null if no engine has it.
+    ScriptEnginePointer getEngineForEntity(const EntityItemID& entityID) const;
+
+    // same as above, but picks the least loaded engine for entities that don't have one yet.
+    ScriptEnginePointer assignEngineForEntity(const EntityItemID& entityID);
+
+    void removeEntity(const EntityItemID& entityID);
+
+    int getNumRunningEntityScripts() const;
+
+    // per engine and per script time spent running, wall clock, so runaway scripts can be found
+    QJsonObject getStats() const;
+
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<ScriptEnginePointer> _engines;
+    QHash<EntityItemID, size_t> _entityEngines;
+    std::vector<int> _engineEntityCounts; // number of entities assigned to each engine
+};
+
+using EntityScriptEngineShardsPointer = QSharedPointer<EntityScriptEngineShards>;
+
+#endif // hifi_EntityScriptEngineShards_h
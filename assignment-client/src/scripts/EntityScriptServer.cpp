@@ -19,6 +19,7 @@
 #include <DebugDraw.h>
 #include <EntityNodeData.h>
 #include <EntityScriptingInterface.h>
+#include <EntityTreeElement.h>
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <plugins/CodecPlugin.h>
@@ -27,6 +28,7 @@
 #include <ResourceScriptingInterface.h>
 #include <ScriptCache.h>
 #include <ScriptEngines.h>
+#include <ScriptProgramCache.h>
 #include <SoundCacheScriptingInterface.h>
 #include <UUID.h>
 #include <WebSocketServerClass.h>
@@ -112,7 +114,10 @@ void EntityScriptServer::handleReloadEntityServerScriptPacket(QSharedPointer<Rec
 
         if (_entityViewer.getTree() && !_shuttingDown) {
             qCDebug(entity_script_server) << "Reloading: " << entityID;
-            _entitiesScriptEngine->unloadEntityScript(entityID);
+            auto engine = _entitiesScriptEngines->getEngineForEntity(entityID);
+            if (engine) {
+                engine->unloadEntityScript(entityID);
+            }
             checkAndCallPreload(entityID, true);
         }
     }
@@ -128,7 +133,8 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        auto engine = _entitiesScriptEngines->getEngineForEntity(entityID);
+        if (engine && engine->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -170,10 +176,22 @@ void EntityScriptServer::handleSettings() {
 
     qDebug() << QString("Received entity script server settings, Max Entity PPS: %1, Entity PPS Per Entity Script: %2")
                 .arg(_maxEntityPPS).arg(_entityPPSPerScript);
+
+    static const QString SCRIPT_THREADS_OPTION = "script_threads";
+    static const int MAX_SCRIPT_THREADS = 64;
+
+    if (entityScriptServerSettings.contains(SCRIPT_THREADS_OPTION)) {
+        int numEngines = std::min(std::max(entityScriptServerSettings[SCRIPT_THREADS_OPTION].toInt(), 1), MAX_SCRIPT_THREADS);
+        if (numEngines != _numEntitiesScriptEngines && !_shuttingDown) {
+            qDebug() << "Running entity scripts on" << numEngines << "script threads";
+            _numEntitiesScriptEngines = numEngines;
+            reloadAllEntityScripts();
+        }
+    }
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = _entitiesScriptEngines->getNumRunningEntityScripts();
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -235,7 +253,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entitiesScriptEngines->getFirstEngine() && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -249,7 +267,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        _entitiesScriptEngines->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -279,8 +297,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
@@ -435,63 +453,97 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
-    auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
-    auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
 
-    auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
-    newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
+    for (auto& oldEngine : _entitiesScriptEngines->getEngines()) {
+        disconnect(oldEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+                   this, &EntityScriptServer::updateEntityPPS);
+    }
+    _entitiesScriptEngines->clear();
 
-    newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCacheScriptingInterface>().data());
+    for (int i = 0; i < _numEntitiesScriptEngines; i++) {
+        auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
+        auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
 
-    // connect this script engines printedMessage signal to the global ScriptEngines these various messages
-    auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
-    connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
-    connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
-    connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
-    connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
-
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->update();
-    });
+        auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
+        newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
 
+        newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCacheScriptingInterface>().data());
 
-    newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngineSP);
+        // connect this script engines printedMessage signal to the global ScriptEngines these various messages
+        connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
+        connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
+        connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
+        connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
+        // the first engine drives the entity viewer, the others just run scripts
+        if (i == 0) {
+            connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+                _entityViewer.queryOctree();
+                _entityViewer.getTree()->update();
+            });
+        }
+
+        newEngine->runInThread();
+
+        connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+                this, &EntityScriptServer::updateEntityPPS);
+        _entitiesScriptEngines->addEngine(newEngine);
     }
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    auto enginesSP = qSharedPointerCast<EntitiesScriptEngineProvider>(_entitiesScriptEngines);
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(enginesSP);
+}
+
+void EntityScriptServer::reloadAllEntityScripts() {
+    // stop the current engines, then start the scripts of every entity we know about on the new set of engines
+    for (auto& engine : _entitiesScriptEngines->getEngines()) {
+        engine->unloadAllEntityScripts();
+        engine->stop();
+        engine->waitTillDoneRunning();
+    }
+    resetEntitiesScriptEngines();
+
+    auto tree = _entityViewer.getTree();
+    if (!tree) {
+        return;
+    }
+    QVector<EntityItemID> entityIDs;
+    tree->withReadLock([&] {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](const EntityItemPointer& entity) {
+                entityIDs.push_back(entity->getEntityItemID());
+            });
+            return true;
+        });
+    });
+    for (auto& entityID : entityIDs) {
+        checkAndCallPreload(entityID);
+    }
 }
 
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
+    // unload and stop the engines
+    for (auto& engine : _entitiesScriptEngines->getEngines()) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
+        engine->unloadAllEntityScripts();
+        engine->stop();
+        engine->waitTillDoneRunning();
     }
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (auto& engine : _entitiesScriptEngines->getEngines()) {
+        engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
@@ -500,7 +552,7 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
+    _entitiesScriptEngines->clear();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -518,37 +570,55 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown) {
+        auto engine = _entitiesScriptEngines->getEngineForEntity(entityID);
+        if (engine) {
+            engine->unloadEntityScript(entityID, true);
+            _entitiesScriptEngines->removeEntity(entityID);
+        }
     }
 }
 
 void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID, bool reload) {
     if (_entityViewer.getTree() && !_shuttingDown) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+        auto engine = _entitiesScriptEngines->getEngineForEntity(entityID);
+        if (engine) {
+            engine->unloadEntityScript(entityID, true);
+            _entitiesScriptEngines->removeEntity(entityID);
+        }
         checkAndCallPreload(entityID, reload);
     }
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool reload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines->getFirstEngine()) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool notRunning = !_entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        auto engine = _entitiesScriptEngines->getEngineForEntity(entityID);
+        bool notRunning = !engine || !engine->getEntityScriptDetails(entityID, details);
         if (entity && (reload || notRunning || details.scriptText != entity->getServerScripts())) {
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
                 qCDebug(entity_script_server) << "Loading entity server script" << scriptUrl << "for" << entityID;
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, reload);
+                engine = _entitiesScriptEngines->assignEngineForEntity(entityID);
+                engine->loadEntityScript(entityID, scriptUrl, reload);
             }
         }
     }
 }
 
 void EntityScriptServer::sendStatsPacket() {
+    QJsonObject statsObject;
+
+    // syntax checked entity script sources shared by repeated loads of the same script
+    statsObject["script_programs"] = ScriptProgramCache::instance().getStats();
+
+    // Time spent running each entity script, grouped by the engine thread it runs on
+    statsObject["script_engines"] = _entitiesScriptEngines->getStats();
 
+    addPacketStatsAndSendStatsPacket(statsObject);
 }
 
 void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
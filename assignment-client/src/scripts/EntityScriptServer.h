@@ -23,6 +23,7 @@
 #include <ScriptEngine.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptEngineShards.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -60,7 +61,8 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    void resetEntitiesScriptEngines();
+    void reloadAllEntityScripts();
     void clear();
     void shutdownScriptEngine();
 
@@ -74,7 +76,8 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    int _numEntitiesScriptEngines { 1 };
+    EntityScriptEngineShardsPointer _entitiesScriptEngines { new EntityScriptEngineShards() };
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
 
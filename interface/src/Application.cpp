@@ -2543,6 +2543,7 @@ void Application::cleanupBeforeQuit() {
         nodeList->getPacketReceiver().setShouldDropPackets(true);
     }
 
+    saveEntityCache();
     getEntities()->shutdown(); // tell the entities system we're shutting down, so it will stop running scripts
 
     // Clear any queued processing (I/O, FBX/OBJ/Texture parsing)
@@ -5582,6 +5583,7 @@ void Application::reloadResourceCaches() {
     // Query the octree to refresh everything in view
     _queryExpiry = SteadyClock::now();
     _octreeQuery.incrementConnectionID();
+    _octreeQuery.setHasClientCache(false);
 
     queryOctree(NodeType::EntityServer, PacketType::EntityQuery);
 
@@ -6615,6 +6617,40 @@ void Application::queryOctree(NodeType_t serverType, PacketType packetType) {
     }
 }
 
+void Application::loadEntityCache(const SharedNodePointer& entityServer) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    QUuid domainID = nodeList->getDomainHandler().getUUID();
+    if (isServerlessMode() || domainID.isNull()) {
+        _octreeQuery.setHasClientCache(false);
+        return;
+    }
+
+    auto entityTree = getEntities()->getTree();
+    if (domainID != _entityCacheDomainID) {
+        _entityCacheDomainID = domainID;
+        int numLoaded = _entityCache.load(domainID, entityTree);
+        qCDebug(interfaceapp) << "Loaded" << numLoaded << "entities from the cache of domain" << domainID;
+    }
+
+    // tell the entity server which entities we have, so that it only sends the ones which changed
+    auto manifest = ClientEntityCache::getManifest(entityTree);
+    _octreeQuery.setHasClientCache(!manifest.isEmpty());
+    if (!manifest.isEmpty()) {
+        auto packetList = NLPacketList::create(PacketType::EntityQueryCache, QByteArray(), true, true);
+        packetList->write(ClientEntityCache::writeManifest(manifest));
+        nodeList->sendPacketList(std::move(packetList), *entityServer);
+    }
+}
+
+void Application::saveEntityCache() {
+    if (!_entityCacheDomainID.isNull()) {
+        int numSaved = _entityCache.save(_entityCacheDomainID, getEntities()->getTree());
+        qCDebug(interfaceapp) << "Saved" << numSaved << "entities to the cache of domain" << _entityCacheDomainID;
+        _entityCacheDomainID = QUuid();
+    }
+    _octreeQuery.setHasClientCache(false);
+}
+
 
 bool Application::isHMDMode() const {
     return getActiveDisplayPlugin()->isHmd();
@@ -6770,7 +6806,8 @@ void Application::clearDomainOctreeDetails() {
         _octreeServerSceneStats.clear();
     });
 
-    // reset the model renderer
+    // keep what we have of the domain we are leaving, then reset the model renderer
+    saveEntityCache();
     getEntities()->clear();
 
     auto skyStage = DependencyManager::get<SceneScriptingInterface>()->getSkyStage();
@@ -6851,6 +6888,7 @@ void Application::nodeActivated(SharedNodePointer node) {
     if (node->getType() == NodeType::EntityServer) {
         _queryExpiry = SteadyClock::now();
         _octreeQuery.incrementConnectionID();
+        loadEntityCache(node);
 
         if  (!_failedToConnectToEntityServer) {
             _entityServerConnectionTimer.stop();
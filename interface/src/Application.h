@@ -27,6 +27,7 @@
 #include <ThreadHelpers.h>
 #include <AbstractScriptingServicesInterface.h>
 #include <AbstractViewStateInterface.h>
+#include <ClientEntityCache.h>
 #include <EntityEditPacketSender.h>
 #include <EntityTreeRenderer.h>
 #include <FileScriptingInterface.h>
@@ -34,6 +35,7 @@
 #include <input-plugins/TouchscreenDevice.h>
 #include <input-plugins/TouchscreenVirtualPadDevice.h>
 #include <OctreeQuery.h>
+#include <PathUtils.h>
 #include <PhysicalEntitySimulation.h>
 #include <PhysicsEngine.h>
 #include <plugins/Forward.h>
@@ -540,6 +542,10 @@ private:
     void queryOctree(NodeType_t serverType, PacketType packetType);
     void queryAvatars();
 
+    // the entities of a domain are kept across sessions, so that reconnecting only downloads what changed
+    void loadEntityCache(const SharedNodePointer& entityServer);
+    void saveEntityCache();
+
     int sendNackPackets();
 
     std::shared_ptr<MyAvatar> getMyAvatar() const;
@@ -625,6 +631,9 @@ private:
 
     OctreeQuery _octreeQuery { true }; // NodeData derived class for querying octee cells from octree servers
 
+    ClientEntityCache _entityCache { PathUtils::getAppLocalDataFilePath("entityCache") };
+    QUuid _entityCacheDomainID; // the domain whose entities are in the tree, saved to its cache when leaving it
+
     std::shared_ptr<controller::StateController> _applicationStateDevice; // Default ApplicationDevice reflecting the state of different properties of the session
     std::shared_ptr<KeyboardMouseDevice> _keyboardMouseDevice;   // Default input device, the good old keyboard mouse and maybe touchpad
     std::shared_ptr<TouchscreenDevice> _touchscreenDevice;   // the good old touchscreen
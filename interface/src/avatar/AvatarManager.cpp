@@ -36,6 +36,7 @@
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <TBBHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
@@ -52,6 +53,9 @@
 const int CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 50;
 static const quint64 MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS = USECS_PER_SECOND / CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
 
+// other avatars are simulated in batches of this size, joint poses for a batch are computed in parallel.
+static const size_t AVATAR_JOINT_UPDATE_BATCH_SIZE = 16;
+
 // We add _myAvatar into the hash with all the other AvatarData, and we use the default NULL QUid as the key.
 const QUuid MY_AVATAR_KEY;  // NULL key
 
@@ -258,46 +262,20 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
-    for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
-        const SortableAvatar& sortData = *it;
-        const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
-        if (!avatar->_isClientAvatar) {
-            avatar->setIsClientAvatar(true);
-        }
-        // TODO: to help us scale to more avatars it would be nice to not have to poll this stuff every update
-        if (avatar->getSkeletonModel()->isLoaded()) {
-            // remove the orb if it is there
-            avatar->removeOrb();
-            if (avatar->needsPhysicsUpdate()) {
-                _avatarsToChangeInPhysics.insert(avatar);
-            }
-        } else {
-            avatar->updateOrbPosition();
-        }
 
-        // for ALL avatars...
-        if (_shouldRender) {
-            avatar->ensureInScene(avatar, qApp->getMain3DScene());
-        }
-        avatar->animateScaleChanges(deltaTime);
+    // Avatars are processed in batches, in sorted order.  Within a batch the joint poses of every avatar are
+    // computed in parallel, then the rest of the simulation runs serially.  The time budget is checked between batches.
+    struct BatchedAvatar {
+        std::shared_ptr<OtherAvatar> avatar;
+        bool inView;
+    };
+    std::vector<BatchedAvatar> batch;
+    batch.reserve(AVATAR_JOINT_UPDATE_BATCH_SIZE);
 
+    auto it = sortedAvatarVector.begin();
+    while (it != sortedAvatarVector.end()) {
         uint64_t now = usecTimestampNow();
-        if (now < updateExpiry) {
-            // we're within budget
-            bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
-            if (inView && avatar->hasNewJointData()) {
-                numAvatarsUpdated++;
-            }
-            auto transitStatus = avatar->_transit.update(deltaTime, avatar->_serverPosition, _transitConfig);
-            if (avatar->getIsNewAvatar() && (transitStatus == AvatarTransit::Status::START_TRANSIT || transitStatus == AvatarTransit::Status::ABORT_TRANSIT)) {
-                avatar->_transit.reset();
-                avatar->setIsNewAvatar(false);
-            }
-            avatar->simulate(deltaTime, inView);
-            avatar->updateRenderItem(renderTransaction);
-            avatar->updateSpaceProxy(workloadTransaction);
-            avatar->setLastRenderUpdateTime(startTime);
-        } else {
+        if (now >= updateExpiry) {
             // we've spent our full time budget --> bail on the rest of the avatar updates
             // --> more avatars may freeze until their priority trickles up
             // --> some scale animations may glitch
@@ -317,6 +295,60 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             }
             break;
         }
+
+        batch.clear();
+        while (it != sortedAvatarVector.end() && batch.size() < AVATAR_JOINT_UPDATE_BATCH_SIZE) {
+            const SortableAvatar& sortData = *it;
+            const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+            ++it;
+            if (!avatar->_isClientAvatar) {
+                avatar->setIsClientAvatar(true);
+            }
+            // TODO: to help us scale to more avatars it would be nice to not have to poll this stuff every update
+            if (avatar->getSkeletonModel()->isLoaded()) {
+                // remove the orb if it is there
+                avatar->removeOrb();
+                if (avatar->needsPhysicsUpdate()) {
+                    _avatarsToChangeInPhysics.insert(avatar);
+                }
+            } else {
+                avatar->updateOrbPosition();
+            }
+
+            // for ALL avatars...
+            if (_shouldRender) {
+                avatar->ensureInScene(avatar, qApp->getMain3DScene());
+            }
+            avatar->animateScaleChanges(deltaTime);
+
+            bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
+            if (inView && avatar->hasNewJointData()) {
+                numAvatarsUpdated++;
+            }
+            auto transitStatus = avatar->_transit.update(deltaTime, avatar->_serverPosition, _transitConfig);
+            if (avatar->getIsNewAvatar() && (transitStatus == AvatarTransit::Status::START_TRANSIT || transitStatus == AvatarTransit::Status::ABORT_TRANSIT)) {
+                avatar->_transit.reset();
+                avatar->setIsNewAvatar(false);
+            }
+            batch.push_back({ avatar, inView });
+        }
+
+        {
+            PROFILE_RANGE(simulation, "prepareJoints");
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.size()), [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); i++) {
+                    batch[i].avatar->prepareJointsForSimulate(batch[i].inView);
+                }
+            });
+        }
+
+        for (auto& batchedAvatar : batch) {
+            const auto& avatar = batchedAvatar.avatar;
+            avatar->simulate(deltaTime, batchedAvatar.inView);
+            avatar->updateRenderItem(renderTransaction);
+            avatar->updateSpaceProxy(workloadTransaction);
+            avatar->setLastRenderUpdateTime(startTime);
+        }
     }
 
     if (_shouldRender) {
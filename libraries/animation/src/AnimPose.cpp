@@ -55,10 +55,37 @@ glm::vec3 AnimPose::xformVectorFast(const glm::vec3& rhs) const {
     return _rot * (_scale * rhs);
 }
 
+// glm::quat_cast() returns the quaternion with its largest component positive,
+// flip q to match, so both paths in operator* agree on sign.
+static glm::quat canonicalizeSign(const glm::quat& q) {
+    float biggest = q.w;
+    if (fabsf(q.x) > fabsf(biggest)) {
+        biggest = q.x;
+    }
+    if (fabsf(q.y) > fabsf(biggest)) {
+        biggest = q.y;
+    }
+    if (fabsf(q.z) > fabsf(biggest)) {
+        biggest = q.z;
+    }
+    return biggest < 0.0f ? -q : q;
+}
+
 AnimPose AnimPose::operator*(const AnimPose& rhs) const {
-    glm::mat4 result;
-    glm_mat4u_mul(*this, rhs, result);
-    return AnimPose(result);
+    static const float UNIFORM_SCALE_EPSILON = 0.00001f;
+    bool uniformScale = fabsf(_scale.x - _scale.y) < UNIFORM_SCALE_EPSILON && fabsf(_scale.x - _scale.z) < UNIFORM_SCALE_EPSILON;
+    bool positiveScale = _scale.x > 0.0f && rhs._scale.x > 0.0f && rhs._scale.y > 0.0f && rhs._scale.z > 0.0f;
+    if (uniformScale && positiveScale) {
+        // no shear can be introduced, so compose the parts directly,
+        // this skips the matrix round trip and the decomposition in AnimPose(const glm::mat4&)
+        return AnimPose(_scale.x * rhs._scale,
+                        canonicalizeSign(glm::normalize(_rot * rhs._rot)),
+                        _trans + _rot * (_scale.x * rhs._trans));
+    } else {
+        glm::mat4 result;
+        glm_mat4u_mul(*this, rhs, result);
+        return AnimPose(result);
+    }
 }
 
 AnimPose AnimPose::inverse() const {
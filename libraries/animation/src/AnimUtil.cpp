@@ -13,17 +13,137 @@
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// four poses transposed into structure-of-arrays form, one joint per lane.
+struct PoseLanes {
+    __m128 sx, sy, sz;
+    __m128 rx, ry, rz, rw;
+    __m128 tx, ty, tz;
+};
+
+static inline void loadPoseLanes(const AnimPose* p, PoseLanes& l) {
+    l.sx = _mm_setr_ps(p[0].scale().x, p[1].scale().x, p[2].scale().x, p[3].scale().x);
+    l.sy = _mm_setr_ps(p[0].scale().y, p[1].scale().y, p[2].scale().y, p[3].scale().y);
+    l.sz = _mm_setr_ps(p[0].scale().z, p[1].scale().z, p[2].scale().z, p[3].scale().z);
+    l.rx = _mm_setr_ps(p[0].rot().x, p[1].rot().x, p[2].rot().x, p[3].rot().x);
+    l.ry = _mm_setr_ps(p[0].rot().y, p[1].rot().y, p[2].rot().y, p[3].rot().y);
+    l.rz = _mm_setr_ps(p[0].rot().z, p[1].rot().z, p[2].rot().z, p[3].rot().z);
+    l.rw = _mm_setr_ps(p[0].rot().w, p[1].rot().w, p[2].rot().w, p[3].rot().w);
+    l.tx = _mm_setr_ps(p[0].trans().x, p[1].trans().x, p[2].trans().x, p[3].trans().x);
+    l.ty = _mm_setr_ps(p[0].trans().y, p[1].trans().y, p[2].trans().y, p[3].trans().y);
+    l.tz = _mm_setr_ps(p[0].trans().z, p[1].trans().z, p[2].trans().z, p[3].trans().z);
+}
+
+static inline void storePoseLanes(const PoseLanes& l, AnimPose* p) {
+    alignas(16) float s[3][4], r[4][4], t[3][4];
+    _mm_store_ps(s[0], l.sx);
+    _mm_store_ps(s[1], l.sy);
+    _mm_store_ps(s[2], l.sz);
+    _mm_store_ps(r[0], l.rx);
+    _mm_store_ps(r[1], l.ry);
+    _mm_store_ps(r[2], l.rz);
+    _mm_store_ps(r[3], l.rw);
+    _mm_store_ps(t[0], l.tx);
+    _mm_store_ps(t[1], l.ty);
+    _mm_store_ps(t[2], l.tz);
+    for (int i = 0; i < 4; i++) {
+        p[i].scale() = glm::vec3(s[0][i], s[1][i], s[2][i]);
+        p[i].rot() = glm::quat(r[3][i], r[0][i], r[1][i], r[2][i]);
+        p[i].trans() = glm::vec3(t[0][i], t[1][i], t[2][i]);
+    }
+}
+
+// x * (1 - a) + y * a, same operation order as lerp() in GLMHelpers
+static inline __m128 lerpLanes(__m128 x, __m128 y, __m128 oneMinusAlpha, __m128 alpha) {
+    return _mm_add_ps(_mm_mul_ps(x, oneMinusAlpha), _mm_mul_ps(y, alpha));
+}
+
+// vectorized version of blend(), per-lane alpha.
+// rotations use safeLerp(), a sign corrected nlerp.
+static inline void blendPoseLanes(const PoseLanes& a, PoseLanes& b, __m128 alpha, PoseLanes& r) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 oneMinusAlpha = _mm_sub_ps(one, alpha);
+
+    r.sx = lerpLanes(a.sx, b.sx, oneMinusAlpha, alpha);
+    r.sy = lerpLanes(a.sy, b.sy, oneMinusAlpha, alpha);
+    r.sz = lerpLanes(a.sz, b.sz, oneMinusAlpha, alpha);
+
+    r.tx = lerpLanes(a.tx, b.tx, oneMinusAlpha, alpha);
+    r.ty = lerpLanes(a.ty, b.ty, oneMinusAlpha, alpha);
+    r.tz = lerpLanes(a.tz, b.tz, oneMinusAlpha, alpha);
+
+    // flip b, in lanes where it is in the opposite hemisphere from a.
+    __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.rx, b.rx), _mm_mul_ps(a.ry, b.ry)),
+                            _mm_add_ps(_mm_mul_ps(a.rz, b.rz), _mm_mul_ps(a.rw, b.rw)));
+    __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), signMask);
+    b.rx = _mm_xor_ps(b.rx, flip);
+    b.ry = _mm_xor_ps(b.ry, flip);
+    b.rz = _mm_xor_ps(b.rz, flip);
+    b.rw = _mm_xor_ps(b.rw, flip);
+
+    __m128 qx = lerpLanes(a.rx, b.rx, oneMinusAlpha, alpha);
+    __m128 qy = lerpLanes(a.ry, b.ry, oneMinusAlpha, alpha);
+    __m128 qz = lerpLanes(a.rz, b.rz, oneMinusAlpha, alpha);
+    __m128 qw = lerpLanes(a.rw, b.rw, oneMinusAlpha, alpha);
+
+    // normalize, full precision sqrt and div to match glm::normalize()
+    __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)),
+                                           _mm_add_ps(_mm_mul_ps(qz, qz), _mm_mul_ps(qw, qw))));
+    __m128 invLength = _mm_div_ps(one, length);
+    r.rx = _mm_mul_ps(qx, invLength);
+    r.ry = _mm_mul_ps(qy, invLength);
+    r.rz = _mm_mul_ps(qz, invLength);
+    r.rw = _mm_mul_ps(qw, invLength);
+}
+
+// blend four poses at a time, the remainder (numPoses % 4) is handled by the caller.
+// if weights is non-null, the alpha for pose i is weights[i] * alpha.
+static size_t blend_SSE(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* weights, float alpha, AnimPose* result) {
+    size_t numBlocks = numPoses / 4;
+    __m128 alphaLanes = _mm_set1_ps(alpha);
+    PoseLanes aLanes, bLanes, rLanes;
+    for (size_t i = 0; i < numBlocks * 4; i += 4) {
+        loadPoseLanes(&a[i], aLanes);
+        loadPoseLanes(&b[i], bLanes);
+        __m128 blockAlpha = weights ? _mm_mul_ps(_mm_loadu_ps(&weights[i]), alphaLanes) : alphaLanes;
+        blendPoseLanes(aLanes, bLanes, blockAlpha, rLanes);
+        storePoseLanes(rLanes, &result[i]);
+    }
+    return numBlocks * 4;
+}
+
+#else   // portable reference code
+
+static size_t blend_SSE(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* weights, float alpha, AnimPose* result) {
+    return 0;
+}
+
+#endif
+
+static inline void blendPose(const AnimPose& aPose, const AnimPose& bPose, float alpha, AnimPose& result) {
+    result.scale() = lerp(aPose.scale(), bPose.scale(), alpha);
+    result.rot() = safeLerp(aPose.rot(), bPose.rot(), alpha);
+    result.trans() = lerp(aPose.trans(), bPose.trans(), alpha);
+}
 
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
-    for (size_t i = 0; i < numPoses; i++) {
-        const AnimPose& aPose = a[i];
-        const AnimPose& bPose = b[i];
+    size_t i = blend_SSE(numPoses, a, b, nullptr, alpha, result);
+    for (; i < numPoses; i++) {
+        blendPose(a[i], b[i], alpha, result[i]);
+    }
+}
 
-        result[i].scale() = lerp(aPose.scale(), bPose.scale(), alpha);
-        result[i].rot() = safeLerp(aPose.rot(), bPose.rot(), alpha);
-        result[i].trans() = lerp(aPose.trans(), bPose.trans(), alpha);
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, const float* weights, float alpha, AnimPose* result) {
+    size_t i = blend_SSE(numPoses, a, b, weights, alpha, result);
+    for (; i < numPoses; i++) {
+        blendPose(a[i], b[i], weights[i] * alpha, result[i]);
     }
 }
 
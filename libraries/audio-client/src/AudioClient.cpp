@@ -170,10 +170,6 @@ static void channelDownmix(int16_t* source, int16_t* dest, int numSamples) {
     }
 }
 
-static inline float convertToFloat(int16_t sample) {
-    return (float)sample * (1 / 32768.0f);
-}
-
 AudioClient::AudioClient() :
     AbstractAudioInterface(),
     _gate(this),
@@ -1189,11 +1185,19 @@ void AudioClient::handleMicAudioInput() {
         if (_muted) {
             _inputRingBuffer.shiftReadPosition(inputSamplesRequired);
         } else {
-            _inputRingBuffer.readSamples(inputAudioSamples.get(), inputSamplesRequired);
+            // resample straight from the ring, unless the samples wrap around its end
+            auto inputSpans = _inputRingBuffer.readSpans(inputSamplesRequired);
+            const int16_t* inputSamples = inputSpans.first;
+            if (inputSpans.secondSize > 0) {
+                memcpy(inputAudioSamples.get(), inputSpans.first, inputSpans.firstSize * sizeof(int16_t));
+                memcpy(inputAudioSamples.get() + inputSpans.firstSize, inputSpans.second, inputSpans.secondSize * sizeof(int16_t));
+                inputSamples = inputAudioSamples.get();
+            }
             possibleResampling(_inputToNetworkResampler,
-                inputAudioSamples.get(), networkAudioSamples,
+                inputSamples, networkAudioSamples,
                 inputSamplesRequired, numNetworkSamples,
                 _inputFormat.channelCount(), _desiredInputFormat.channelCount());
+            _inputRingBuffer.shiftReadPosition(inputSamplesRequired);
         }
         int bytesInInputRingBuffer = _inputRingBuffer.samplesAvailable() * AudioConstants::SAMPLE_SIZE;
         float msecsInInputRingBuffer = bytesInInputRingBuffer / (float)(_inputFormat.bytesForDuration(USECS_PER_MSEC));
@@ -1335,9 +1339,8 @@ bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
 
                     // stereo gets directly mixed into mixBuffer
                     float gain = injector->getVolume();
-                    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
-                        mixBuffer[i] += convertToFloat(_localScratchBuffer[i]) * gain;
-                    }
+                    accumulateSamplesWithGain(_localScratchBuffer, mixBuffer, gain * (1 / 32768.0f),
+                                              AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
                 } else {
 
@@ -1974,9 +1977,7 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
         qCDebug(audiostream, "Read %d samples from buffer (%d available, %d requested)", networkSamplesPopped, _receivedAudioStream.getSamplesAvailable(), samplesRequested);
         AudioRingBuffer::ConstIterator lastPopOutput = _receivedAudioStream.getLastPopOutput();
         lastPopOutput.readSamples(scratchBuffer, networkSamplesPopped);
-        for (int i = 0; i < networkSamplesPopped; i++) {
-            mixBuffer[i] = convertToFloat(scratchBuffer[i]);
-        }
+        convertSamplesToFloat(scratchBuffer, mixBuffer, 1 / 32768.0f, networkSamplesPopped);
         samplesRequested = networkSamplesPopped;
     }
 
@@ -0,0 +1,56 @@
+//
+//  AudioEncodedMixes.cpp
+//  libraries/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioEncodedMixes.h"
+
+#include <QHash>
+
+#include <plugins/CodecPlugin.h>
+
+static void encodeBuffer(Encoder* encoder, const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
+    if (encoder) {
+        encoder->encode(decodedBuffer, encodedBuffer);
+    } else {
+        encodedBuffer = decodedBuffer;
+    }
+}
+
+bool AudioEncodedMixes::encode(const QString& codec, Encoder* encoder, const QByteArray& decodedBuffer,
+                               QByteArray& encodedBuffer) {
+    if (encoder && !encoder->isStateless()) {
+        encodeBuffer(encoder, decodedBuffer, encodedBuffer);
+        return false;
+    }
+
+    uint key = qHash(decodedBuffer, qHash(codec));
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto range = _encodedMixes.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            // the buffers are compared, so hash collisions are harmless
+            if (it->second.codec == codec && it->second.decodedBuffer == decodedBuffer) {
+                encodedBuffer = it->second.encodedBuffer;
+                return true;
+            }
+        }
+    }
+
+    // encode outside of the lock, another thread may encode the same mix concurrently, which is harmless
+    encodeBuffer(encoder, decodedBuffer, encodedBuffer);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _encodedMixes.emplace(key, EncodedMix { codec, decodedBuffer, encodedBuffer });
+    return false;
+}
+
+void AudioEncodedMixes::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _encodedMixes.clear();
+}
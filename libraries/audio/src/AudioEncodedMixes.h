@@ -0,0 +1,46 @@
+//
+//  AudioEncodedMixes.h
+//  libraries/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AudioEncodedMixes_h
+#define hifi_AudioEncodedMixes_h
+
+#include <mutex>
+#include <unordered_map>
+
+#include <QByteArray>
+#include <QString>
+
+class Encoder;
+
+// The mixes encoded during one frame, so that listeners with identical mixes and codecs share a single encode.
+// Only the output of stateless encoders can be shared, as the output of the others depends on what they encoded
+// before. Safe to use from several threads, and cleared between frames.
+class AudioEncodedMixes {
+public:
+    // encodes decodedBuffer with the encoder of the codec (a copy if there is no encoder), or reuses the output
+    // of an identical buffer already encoded with the same codec this frame. Returns true if the output was reused.
+    bool encode(const QString& codec, Encoder* encoder, const QByteArray& decodedBuffer, QByteArray& encodedBuffer);
+
+    void clear();
+
+private:
+    struct EncodedMix {
+        QString codec;
+        QByteArray decodedBuffer;
+        QByteArray encodedBuffer;
+    };
+
+    std::mutex _mutex;
+    std::unordered_multimap<uint, EncodedMix> _encodedMixes; // keyed by the hash of the decoded buffer and codec
+};
+
+#endif // hifi_AudioEncodedMixes_h
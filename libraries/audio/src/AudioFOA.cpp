@@ -882,6 +882,36 @@ static void convertInput_ref(int16_t* src, float *dst[4], float gain, int numFra
 
 #endif
 
+#ifdef FOA_INPUT_FUMA
+
+// convert to deinterleaved float (B-format)
+static void convertInputFloat(const float* src, float *dst[4], float gain, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+        dst[0][i] = src[4*i+0] * gain;  // W
+        dst[1][i] = src[4*i+1] * gain;  // X
+        dst[2][i] = src[4*i+2] * gain;  // Y
+        dst[3][i] = src[4*i+3] * gain;  // Z
+    }
+}
+
+#else
+
+// convert to deinterleaved float (B-format)
+static void convertInputFloat(const float* src, float *dst[4], float gain, int numFrames) {
+
+    const float gainW = gain * SQRT1_2; // -3dB
+
+    for (int i = 0; i < numFrames; i++) {
+        dst[0][i] = src[4*i+0] * gainW; // W
+        dst[2][i] = src[4*i+1] * gain;  // Y
+        dst[3][i] = src[4*i+2] * gain;  // Z
+        dst[1][i] = src[4*i+3] * gain;  // X
+    }
+}
+
+#endif
+
 // in-place rotation of the soundfield
 // crossfade between old and new rotation, to prevent artifacts
 static void rotate_3x3_ref(float* buf[4], const float m0[3][3], const float m1[3][3], const float* win, int numFrames) {
@@ -1042,16 +1072,39 @@ void AudioFOA::render(int16_t* input, float* output, int index, float qw, float
     assert(index < FOA_TABLES);
     assert(numFrames == FOA_BLOCK);
 
-    ALIGN32 float fftBuffer[FOA_NFFT];          // in-place FFT buffer
-    ALIGN32 float accBuffer[2][FOA_NFFT] = {};  // binaural accumulation buffers
     ALIGN32 float inBuffer[4][FOA_BLOCK];       // deinterleaved input buffers
 
     float* in[4] = { inBuffer[0], inBuffer[1], inBuffer[2], inBuffer[3] };
-    float rotation[3][3];
 
     // convert input to deinterleaved float
     convertInput(input, in, FOA_GAIN * gain, FOA_BLOCK);
 
+    renderBFormat(in, output, index, qw, qx, qy, qz);
+}
+
+void AudioFOA::render(const float* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < FOA_TABLES);
+    assert(numFrames == FOA_BLOCK);
+
+    ALIGN32 float inBuffer[4][FOA_BLOCK];       // deinterleaved input buffers
+
+    float* in[4] = { inBuffer[0], inBuffer[1], inBuffer[2], inBuffer[3] };
+
+    // convert input to deinterleaved float
+    convertInputFloat(input, in, FOA_GAIN * gain, FOA_BLOCK);
+
+    renderBFormat(in, output, index, qw, qx, qy, qz);
+}
+
+void AudioFOA::renderBFormat(float* in[4], float* output, int index, float qw, float qx, float qy, float qz) {
+
+    ALIGN32 float fftBuffer[FOA_NFFT];          // in-place FFT buffer
+    ALIGN32 float accBuffer[2][FOA_NFFT] = {};  // binaural accumulation buffers
+
+    float rotation[3][3];
+
     // convert quaternion to 3x3 rotation
     quatToMatrix_3x3(qw, qx, qy, qz, rotation);
 
@@ -45,10 +45,18 @@ public:
     //
     void render(int16_t* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
 
+    //
+    // same as above, with interleaved float input (full scale is 1.0)
+    //
+    void render(const float* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
+
 private:
     AudioFOA(const AudioFOA&) = delete;
     AudioFOA& operator=(const AudioFOA&) = delete;
 
+    // rotate and decode deinterleaved B-format input
+    void renderBFormat(float* in[4], float* output, int index, float qw, float qx, float qy, float qz);
+
     // For best cache utilization when processing thousands of instances, only
     // the minimum persistant state is stored here. No coefs or work buffers.
 
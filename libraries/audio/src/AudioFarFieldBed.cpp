@@ -0,0 +1,169 @@
+//
+//  AudioFarFieldBed.cpp
+//  libraries/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioFarFieldBed.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <AudioHelpers.h>
+#include <NumericalConstants.h>
+
+#include "AudioHRTF.h"
+
+static const float INT16_TO_FLOAT_SCALE = 1 / 32768.0f;
+
+void AudioFarFieldClusters::clear(float clusterSize) {
+    _clusters.clear();
+    _cells.clear();
+    _cellScale = 1.0f / clusterSize;
+}
+
+int AudioFarFieldClusters::addSource(const int16_t* samples, float gain, const glm::vec3& position,
+                                     const glm::vec3& forward, bool isMicrophone) {
+    // sources are clustered in a grid of cubic cells, and avatars also in a grid of facing directions
+    const float FACING_CELLS_PER_UNIT = 4.0f;   // spreads the facings in a cluster by at most ~25 degrees
+    const uint64_t INJECTOR_FACING = 1023;      // past the 9 * 9 * 9 facing cells
+    const int64_t CELL_MASK = (1 << 18) - 1;
+
+    uint64_t facing = INJECTOR_FACING;
+    if (isMicrophone) {
+        glm::ivec3 facingCell = glm::ivec3(glm::round(forward * FACING_CELLS_PER_UNIT)) + glm::ivec3(4);
+        facing = (uint64_t)(facingCell.x * 81 + facingCell.y * 9 + facingCell.z);
+    }
+    glm::ivec3 cell = glm::ivec3(glm::floor(position * _cellScale));
+    uint64_t key = ((uint64_t)(cell.x & CELL_MASK) << 46) | ((uint64_t)(cell.y & CELL_MASK) << 28) |
+        ((uint64_t)(cell.z & CELL_MASK) << 10) | facing;
+
+    auto it = _cells.emplace(key, (int)_clusters.size());
+    if (it.second) {
+        _clusters.emplace_back();
+        _clusters.back().isMicrophone = isMicrophone;
+    }
+    int index = it.first->second;
+    auto& cluster = _clusters[index];
+
+    gain *= INT16_TO_FLOAT_SCALE;
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        cluster.samples[i] += (float)samples[i] * gain;
+    }
+
+    cluster.position += position;
+    cluster.forward += forward;
+    ++cluster.numStreams;
+    return index;
+}
+
+void AudioFarFieldClusters::finish() {
+    for (auto& cluster : _clusters) {
+        cluster.position /= (float)cluster.numStreams;
+        float length = glm::length(cluster.forward);
+        cluster.forward = (length > EPSILON) ? cluster.forward / length : glm::vec3(0.0f, 0.0f, -1.0f);
+    }
+}
+
+float AudioFarFieldBed::computeSourceGain(float distanceAttenuation, bool isMicrophone, const glm::vec3& sourceForward,
+                                          const glm::vec3& direction, float masterAvatarGain) {
+    float gain = distanceAttenuation;
+    if (isMicrophone) {
+        gain *= computeOffAxisCoefficient(sourceForward, direction) * masterAvatarGain;
+    }
+    return std::min(gain, 1.0f / HRTF_NEARFIELD_MIN);
+}
+
+float AudioFarFieldBed::computeOffAxisCoefficient(const glm::vec3& sourceForward, const glm::vec3& direction) {
+    // source directivity is based on angle of emission, between its forward and the direction to it
+    float angleOfDelivery = fastAcosf(glm::clamp(glm::dot(sourceForward, direction), -1.0f, 1.0f));
+
+    const float MAX_OFF_AXIS_ATTENUATION = 0.2f;
+    const float OFF_AXIS_ATTENUATION_STEP = (1 - MAX_OFF_AXIS_ATTENUATION) / 2.0f;
+    return MAX_OFF_AXIS_ATTENUATION + (angleOfDelivery * (OFF_AXIS_ATTENUATION_STEP / PI_OVER_TWO));
+}
+
+void AudioFarFieldBed::prepare(const Settings& settings, std::vector<float>& volumes) {
+    _sources.clear();
+    _distance = settings.distance;
+
+    int maxHRTFStreams = std::max(settings.maxHRTFStreams, 0);
+    if ((int)volumes.size() > maxHRTFStreams) {
+        auto threshold = volumes.begin() + maxHRTFStreams;
+        std::nth_element(volumes.begin(), threshold, volumes.end(), std::greater<float>());
+        _volumeThreshold = *threshold;
+    } else {
+        // volumes are never negative, so no source goes in the bed
+        _volumeThreshold = -1.0f;
+    }
+}
+
+void AudioFarFieldBed::addSource(const int16_t* samples, float gain, const glm::vec3& direction, int cluster) {
+    _sources.push_back({ samples, gain, direction, cluster });
+}
+
+// accumulate a mono source into an interleaved ambiX (ACN/SN3D) bed, in world coordinates
+template <class Samples>
+static void encodeSource(const Samples& samples, float gain, const glm::vec3& direction, float* bed) {
+    // convert from Y-up (OpenGL) to Z-up (Ambisonic) coordinate system
+    float x = -direction.z;
+    float y = -direction.x;
+    float z = direction.y;
+
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        float sample = (float)samples[i] * gain;
+        bed[4*i+0] += sample;       // W
+        bed[4*i+1] += sample * y;   // Y
+        bed[4*i+2] += sample * z;   // Z
+        bed[4*i+3] += sample * x;   // X
+    }
+}
+
+int AudioFarFieldBed::encode(const AudioFarFieldClusters& clusters, const glm::vec3& listenerPosition,
+                             float masterAvatarGain, const DistanceAttenuation& computeDistanceAttenuation) {
+    const auto& clusterMixes = clusters.getClusters();
+
+    memset(_bed, 0, sizeof(_bed));
+
+    // a cluster whose sources are all in this bed is encoded once, from its shared mix
+    _clusterCounts.assign(clusterMixes.size(), 0);
+    for (const auto& source : _sources) {
+        if (source.cluster >= 0) {
+            ++_clusterCounts[source.cluster];
+        }
+    }
+
+    for (const auto& source : _sources) {
+        int cluster = source.cluster;
+        if (cluster >= 0 && _clusterCounts[cluster] == clusterMixes[cluster].numStreams) {
+            continue;
+        }
+        encodeSource(source.samples, source.gain * INT16_TO_FLOAT_SCALE, source.direction, _bed);
+    }
+
+    int numClusters = 0;
+    for (size_t i = 0; i < clusterMixes.size(); i++) {
+        const auto& cluster = clusterMixes[i];
+        if (_clusterCounts[i] == 0 || _clusterCounts[i] != cluster.numStreams) {
+            continue;
+        }
+
+        // the cluster is far away, so its sources share the distance attenuation and direction of its centroid,
+        // and its avatars face alike, so they share the off-axis attenuation of its mean facing
+        glm::vec3 relativePosition = cluster.position - listenerPosition;
+        float distance = glm::max(glm::length(relativePosition), EPSILON);
+        glm::vec3 direction = relativePosition / distance;
+        float gain = computeSourceGain(computeDistanceAttenuation(cluster.position, distance), cluster.isMicrophone,
+                                       cluster.forward, direction, masterAvatarGain);
+
+        encodeSource(cluster.samples, gain, direction, _bed);
+        ++numClusters;
+    }
+
+    _sources.clear();
+    return numClusters;
+}
@@ -0,0 +1,111 @@
+//
+//  AudioFarFieldBed.h
+//  libraries/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AudioFarFieldBed_h
+#define hifi_AudioFarFieldBed_h
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AudioConstants.h"
+
+// The mono sources of one type in one cell of the world, summed once per frame and shared by all listeners.
+// Avatars are also split by the direction they face, so that a cluster can share their off-axis attenuation.
+class AudioFarFieldClusters {
+public:
+    struct Cluster {
+        glm::vec3 position;             // centroid of the sources
+        glm::vec3 forward;              // mean facing of the sources, avatars only
+        bool isMicrophone { false };
+        int numStreams { 0 };
+        float samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] {};
+    };
+
+    // starts a new frame, with cubic cells of the given edge
+    void clear(float clusterSize);
+
+    // sums a frame of a mono source into the cluster of its cell (and facing, for avatars)
+    // returns the index of that cluster
+    int addSource(const int16_t* samples, float gain, const glm::vec3& position, const glm::vec3& forward,
+                  bool isMicrophone);
+
+    // turns the sums of the positions and facings into their means, once every source is added
+    void finish();
+
+    const std::vector<Cluster>& getClusters() const { return _clusters; }
+
+private:
+    std::vector<Cluster> _clusters;
+    std::unordered_map<uint64_t, int> _cells;
+    float _cellScale { 1.0f };
+};
+
+// A first-order ambisonic bed that the distant, quiet sources of a listener are mixed into, instead of getting
+// their own HRTF. The bed is encoded in world coordinates, to be rotated and decoded by the caller.
+class AudioFarFieldBed {
+public:
+    struct Settings {
+        bool enabled { false };
+        float distance { 10.0f };       // sources closer than this always get their own HRTF
+        float clusterSize { 8.0f };     // edge of the cubic cells that sources are clustered in
+        int maxHRTFStreams { 16 };      // number of loudest sources that always get their own HRTF
+    };
+
+    // the distance attenuation of a source at a given position and distance from the listener
+    using DistanceAttenuation = std::function<float(const glm::vec3& sourcePosition, float distance)>;
+
+    // the gain of a mono source at the listener: avatars are attenuated as they turn away and by the master avatar
+    // gain, then the distance attenuation applies, capped in the near field
+    static float computeSourceGain(float distanceAttenuation, bool isMicrophone, const glm::vec3& sourceForward,
+                                   const glm::vec3& direction, float masterAvatarGain);
+    static float computeOffAxisCoefficient(const glm::vec3& sourceForward, const glm::vec3& direction);
+
+    // starts the bed of a listener, from the approximate volumes of its streams (reordered):
+    // only the sources quieter than the loudest maxHRTFStreams ones can go in the bed
+    void prepare(const Settings& settings, std::vector<float>& volumes);
+
+    // whether a source of the given approximate volume and distance goes in the bed
+    bool contains(float volume, float distance) const { return volume <= _volumeThreshold && distance >= _distance; }
+
+    // adds a mono source in the bed, with its gain, direction from the listener and cluster (-1 if none)
+    void addSource(const int16_t* samples, float gain, const glm::vec3& direction, int cluster);
+
+    bool isEmpty() const { return _sources.empty(); }
+
+    // encodes the sources added since the last call, replacing those of a cluster by its shared mix when they were
+    // all added; the cluster then gets the gain of a source at its centroid, facing its mean facing
+    // returns the number of clusters encoded
+    int encode(const AudioFarFieldClusters& clusters, const glm::vec3& listenerPosition, float masterAvatarGain,
+               const DistanceAttenuation& computeDistanceAttenuation);
+
+    // the interleaved ambiX (ACN/SN3D) bed of the last call to encode
+    const float* getBed() const { return _bed; }
+
+private:
+    struct Source {
+        const int16_t* samples;
+        float gain;
+        glm::vec3 direction;
+        int cluster;
+    };
+
+    float _bed[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
+    std::vector<Source> _sources;
+    std::vector<int> _clusterCounts;
+    float _volumeThreshold { -1.0f };
+    float _distance { 0.0f };
+};
+
+#endif // hifi_AudioFarFieldBed_h
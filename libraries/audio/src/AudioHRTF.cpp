@@ -276,6 +276,61 @@ static void FIR_1x4_SSE(float* src, float* dst0, float* dst1, float* dst2, float
     }
 }
 
+// 2 channel input, 8 channel output
+// both sources share a single pass, for 8 independent accumulators
+static void FIR_2x8_SSE(float* src0, float* src1, float* dst[8], float coef[8][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+    float* coef4 = coef[4] + HRTF_TAPS - 1;
+    float* coef5 = coef[5] + HRTF_TAPS - 1;
+    float* coef6 = coef[6] + HRTF_TAPS - 1;
+    float* coef7 = coef[7] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        __m128 acc2 = _mm_setzero_ps();
+        __m128 acc3 = _mm_setzero_ps();
+        __m128 acc4 = _mm_setzero_ps();
+        __m128 acc5 = _mm_setzero_ps();
+        __m128 acc6 = _mm_setzero_ps();
+        __m128 acc7 = _mm_setzero_ps();
+
+        float* ps0 = &src0[i - HRTF_TAPS + 1];  // process forwards
+        float* ps1 = &src1[i - HRTF_TAPS + 1];
+
+        for (int k = 0; k < HRTF_TAPS; k++) {
+
+            __m128 x0 = _mm_loadu_ps(&ps0[k]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k]), x0));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k]), x0));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_load1_ps(&coef2[-k]), x0));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_load1_ps(&coef3[-k]), x0));
+
+            __m128 x1 = _mm_loadu_ps(&ps1[k]);
+            acc4 = _mm_add_ps(acc4, _mm_mul_ps(_mm_load1_ps(&coef4[-k]), x1));
+            acc5 = _mm_add_ps(acc5, _mm_mul_ps(_mm_load1_ps(&coef5[-k]), x1));
+            acc6 = _mm_add_ps(acc6, _mm_mul_ps(_mm_load1_ps(&coef6[-k]), x1));
+            acc7 = _mm_add_ps(acc7, _mm_mul_ps(_mm_load1_ps(&coef7[-k]), x1));
+        }
+
+        _mm_storeu_ps(&dst[0][i], acc0);
+        _mm_storeu_ps(&dst[1][i], acc1);
+        _mm_storeu_ps(&dst[2][i], acc2);
+        _mm_storeu_ps(&dst[3][i], acc3);
+        _mm_storeu_ps(&dst[4][i], acc4);
+        _mm_storeu_ps(&dst[5][i], acc5);
+        _mm_storeu_ps(&dst[6][i], acc6);
+        _mm_storeu_ps(&dst[7][i], acc7);
+    }
+}
+
 // 4 channel planar to interleaved
 static void interleave_4x4_SSE(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
@@ -446,6 +501,8 @@ static void interpolate_SSE(const float* src0, const float* src1, float* dst, fl
 
 void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
 void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void FIR_2x8_AVX2(float* src0, float* src1, float* dst[8], float coef[8][HRTF_TAPS], int numFrames);
+void FIR_2x8_AVX512(float* src0, float* src1, float* dst[8], float coef[8][HRTF_TAPS], int numFrames);
 void interleave_4x4_AVX2(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
 void biquad2_4x4_AVX2(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
 void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames);
@@ -456,6 +513,11 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
     (*f)(src, dst0, dst1, dst2, dst3, coef, numFrames); // dispatch
 }
 
+static void FIR_2x8(float* src0, float* src1, float* dst[8], float coef[8][HRTF_TAPS], int numFrames) {
+    static auto f = cpuSupportsAVX512() ? FIR_2x8_AVX512 : (cpuSupportsAVX2() ? FIR_2x8_AVX2 : FIR_2x8_SSE);
+    (*f)(src0, src1, dst, coef, numFrames); // dispatch
+}
+
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
     static auto f = cpuSupportsAVX2() ? interleave_4x4_AVX2 : interleave_4x4_SSE;
     (*f)(src0, src1, src2, src3, dst, numFrames); // dispatch
@@ -543,6 +605,12 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
     }
 }
 
+// 2 channel input, 8 channel output
+static void FIR_2x8(float* src0, float* src1, float* dst[8], float coef[8][HRTF_TAPS], int numFrames) {
+    FIR_1x4(src0, dst[0], dst[1], dst[2], dst[3], &coef[0], numFrames);
+    FIR_1x4(src1, dst[4], dst[5], dst[6], dst[7], &coef[4], numFrames);
+}
+
 // 4 channel planar to interleaved
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
@@ -1088,18 +1156,8 @@ static void setFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int dela
     }
 }
 
-void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
-
-    assert(index >= 0);
-    assert(index < HRTF_TABLES);
-    assert(numFrames == HRTF_BLOCK);
-
-    ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
-    ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
-    ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
-    ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
-    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
-    int delay[4];                                           // 4-channel (interleaved)
+void AudioHRTF::prepare(const int16_t* input, float* in, float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int delay[4],
+                        int index, float azimuth, float distance, float gain) {
 
     // apply global and local gain adjustment
     gain *= _gainAdjust;
@@ -1123,14 +1181,11 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     // FIR state update
     memcpy(in, _firState, HRTF_TAPS * sizeof(float));
     memcpy(_firState, &in[HRTF_BLOCK], HRTF_TAPS * sizeof(float));
+}
 
-    // process old/new FIR
-    FIR_1x4(&in[HRTF_TAPS], 
-            &firBuffer[L0][HRTF_DELAY], 
-            &firBuffer[R0][HRTF_DELAY], 
-            &firBuffer[L1][HRTF_DELAY], 
-            &firBuffer[R1][HRTF_DELAY], 
-            firCoef, HRTF_BLOCK);
+void AudioHRTF::finish(float firBuffer[4][HRTF_DELAY + HRTF_BLOCK], float bqCoef[5][8], int delay[4], float* output) {
+
+    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
 
     // delay state update
     memcpy(firBuffer[L0], _delayState[L0], HRTF_DELAY * sizeof(float));
@@ -1175,3 +1230,69 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
 
     _resetState = false;
 }
+
+void AudioHRTF::render(const int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
+    ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
+    ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
+    ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
+    int delay[4];                                           // 4-channel (interleaved)
+
+    prepare(input, in, firCoef, bqCoef, delay, index, azimuth, distance, gain);
+
+    // process old/new FIR
+    FIR_1x4(&in[HRTF_TAPS], 
+            &firBuffer[L0][HRTF_DELAY], 
+            &firBuffer[R0][HRTF_DELAY], 
+            &firBuffer[L1][HRTF_DELAY], 
+            &firBuffer[R1][HRTF_DELAY], 
+            firCoef, HRTF_BLOCK);
+
+    finish(firBuffer, bqCoef, delay, output);
+}
+
+void AudioHRTF::render(const Source* sources, int numSources, float* output, int index, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    ALIGN32 float in[2][HRTF_TAPS + HRTF_BLOCK];            // 2 x mono
+    ALIGN32 float firCoef[8][HRTF_TAPS];                    // 2 x 4-channel
+    ALIGN32 float firBuffer[2][4][HRTF_DELAY + HRTF_BLOCK]; // 2 x 4-channel
+    ALIGN32 float bqCoef[2][5][8];                          // 2 x 4-channel (interleaved)
+    int delay[2][4];                                        // 2 x 4-channel (interleaved)
+
+    int i = 0;
+    for (; i + 1 < numSources; i += 2) {
+        const Source& s0 = sources[i + 0];
+        const Source& s1 = sources[i + 1];
+        assert(s0.hrtf != s1.hrtf);
+
+        s0.hrtf->prepare(s0.input, in[0], &firCoef[0], bqCoef[0], delay[0], index, s0.azimuth, s0.distance, s0.gain);
+        s1.hrtf->prepare(s1.input, in[1], &firCoef[4], bqCoef[1], delay[1], index, s1.azimuth, s1.distance, s1.gain);
+
+        // process old/new FIR of both sources in one pass
+        float* dst[8] = {
+            &firBuffer[0][L0][HRTF_DELAY], &firBuffer[0][R0][HRTF_DELAY],
+            &firBuffer[0][L1][HRTF_DELAY], &firBuffer[0][R1][HRTF_DELAY],
+            &firBuffer[1][L0][HRTF_DELAY], &firBuffer[1][R0][HRTF_DELAY],
+            &firBuffer[1][L1][HRTF_DELAY], &firBuffer[1][R1][HRTF_DELAY],
+        };
+        FIR_2x8(&in[0][HRTF_TAPS], &in[1][HRTF_TAPS], dst, firCoef, HRTF_BLOCK);
+
+        s0.hrtf->finish(firBuffer[0], bqCoef[0], delay[0], output);
+        s1.hrtf->finish(firBuffer[1], bqCoef[1], delay[1], output);
+    }
+
+    // odd source out
+    if (i < numSources) {
+        const Source& s = sources[i];
+        s.hrtf->render(s.input, output, index, s.azimuth, s.distance, s.gain, numFrames);
+    }
+}
@@ -44,7 +44,21 @@ public:
     // gain: gain factor for distance attenuation
     // numFrames: must be HRTF_BLOCK in this version
     //
-    void render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
+    void render(const int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames);
+
+    //
+    // Batched render of many sources into one listener mix
+    // Sources are processed in pairs, computing the FIR of both in a single pass.
+    // Equivalent to calling render() on each source in turn; each AudioHRTF may appear at most once.
+    //
+    struct Source {
+        AudioHRTF* hrtf;
+        const int16_t* input;
+        float azimuth;
+        float distance;
+        float gain;
+    };
+    static void render(const Source* sources, int numSources, float* output, int index, int numFrames);
 
     //
     // Fast path when input is known to be silent and state as been flushed
@@ -89,6 +103,11 @@ private:
     AudioHRTF(const AudioHRTF&) = delete;
     AudioHRTF& operator=(const AudioHRTF&) = delete;
 
+    // render() stages, before and after the FIR
+    void prepare(const int16_t* input, float* in, float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int delay[4],
+                 int index, float azimuth, float distance, float gain);
+    void finish(float firBuffer[4][HRTF_DELAY + HRTF_BLOCK], float bqCoef[5][8], int delay[4], float* output);
+
     // SIMD channel assignmentS
     enum Channel {
         L0, R0,
@@ -11,6 +11,7 @@
 
 #include "AudioRingBuffer.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <functional>
@@ -36,8 +37,8 @@ AudioRingBufferTemplate<T>::AudioRingBufferTemplate(int numFrameSamples, int num
     if (numFrameSamples) {
         _buffer = new Sample[_bufferLength];
         memset(_buffer, 0, _bufferLength * SampleSize);
-        _nextOutput = _buffer;
-        _endOfLastWrite = _buffer;
+        _nextOutput.store(_buffer);
+        _endOfLastWrite.store(_buffer);
     }
 }
 
@@ -48,8 +49,8 @@ AudioRingBufferTemplate<T>::~AudioRingBufferTemplate() {
 
 template <class T>
 void AudioRingBufferTemplate<T>::clear() {
-    _endOfLastWrite = _buffer;
-    _nextOutput = _buffer;
+    _endOfLastWrite.store(_buffer);
+    _nextOutput.store(_buffer);
 }
 
 template <class T>
@@ -95,24 +96,69 @@ int AudioRingBufferTemplate<T>::writeSamples(const Sample* source, int maxSample
 }
 
 template <class T>
-int AudioRingBufferTemplate<T>::readData(char *data, int maxSize) {
-    // only copy up to the number of samples we have available
-    int maxSamples = maxSize / SampleSize;
+auto AudioRingBufferTemplate<T>::readSpans(int maxSamples) const -> Spans<const Sample> {
+    Spans<const Sample> spans;
+
+    // only the consumer moves the read position, the write position can only make more samples available
+    Sample* nextOutput = readPosition();
+    spans.first = nextOutput;
+
     int numReadSamples = std::min(maxSamples, samplesAvailable());
+    if (numReadSamples <= 0) {
+        return spans;
+    }
+
+    int numSamplesToEnd = (_buffer + _bufferLength) - nextOutput;
+    spans.firstSize = std::min(numReadSamples, numSamplesToEnd);
+    if (numReadSamples > numSamplesToEnd) {
+        // the data wraps around the edge
+        spans.second = _buffer;
+        spans.secondSize = numReadSamples - numSamplesToEnd;
+    }
+    return spans;
+}
 
-    if (_nextOutput + numReadSamples > _buffer + _bufferLength) {
-        // we're going to need to do two reads to get this data, it wraps around the edge
-        int numSamplesToEnd = (_buffer + _bufferLength) - _nextOutput;
+template <class T>
+auto AudioRingBufferTemplate<T>::writeSpans(int maxSamples) -> Spans<Sample> {
+    Spans<Sample> spans;
 
-        // read to the end of the buffer
-        memcpy(data, _nextOutput, numSamplesToEnd * SampleSize);
+    // only the producer moves the write position, the read position can only make more room
+    Sample* endOfLastWrite = _endOfLastWrite.load(std::memory_order_relaxed);
+    spans.first = endOfLastWrite;
 
-        // read the rest from the beginning of the buffer
-        memcpy(data + (numSamplesToEnd * SampleSize), _buffer, (numReadSamples - numSamplesToEnd) * SampleSize);
-    } else {
-        memcpy(data, _nextOutput, numReadSamples * SampleSize);
+    int numWriteSamples = std::min(maxSamples, _sampleCapacity - samplesAvailable());
+    if (!endOfLastWrite || numWriteSamples <= 0) {
+        return spans;
     }
 
+    int numSamplesToEnd = (_buffer + _bufferLength) - endOfLastWrite;
+    spans.firstSize = std::min(numWriteSamples, numSamplesToEnd);
+    if (numWriteSamples > numSamplesToEnd) {
+        // the room wraps around the edge
+        spans.second = _buffer;
+        spans.secondSize = numWriteSamples - numSamplesToEnd;
+    }
+    return spans;
+}
+
+template <class T>
+void AudioRingBufferTemplate<T>::commitWrite(int numSamples) {
+    Sample* endOfLastWrite = _endOfLastWrite.load(std::memory_order_relaxed);
+    _endOfLastWrite.store(shiftedPositionAccomodatingWrap(endOfLastWrite, numSamples), std::memory_order_release);
+}
+
+template <class T>
+int AudioRingBufferTemplate<T>::readData(char *data, int maxSize) {
+    // only copy up to the number of samples we have available
+    auto spans = readSpans(maxSize / SampleSize);
+
+    // the second span is only set when the data wraps around the edge
+    memcpy(data, spans.first, spans.firstSize * SampleSize);
+    if (spans.secondSize > 0) {
+        memcpy(data + (spans.firstSize * SampleSize), spans.second, spans.secondSize * SampleSize);
+    }
+
+    int numReadSamples = spans.size();
     shiftReadPosition(numReadSamples);
 
     return numReadSamples * SampleSize;
@@ -121,31 +167,15 @@ int AudioRingBufferTemplate<T>::readData(char *data, int maxSize) {
 template <class T>
 int AudioRingBufferTemplate<T>::appendData(char *data, int maxSize) {
     // only copy up to the number of samples we have available
-    int maxSamples = maxSize / SampleSize;
-    int numReadSamples = std::min(maxSamples, samplesAvailable());
+    auto spans = readSpans(maxSize / SampleSize);
 
     Sample* dest = reinterpret_cast<Sample*>(data);
-    Sample* output = _nextOutput;
-    if (_nextOutput + numReadSamples > _buffer + _bufferLength) {
-        // we're going to need to do two reads to get this data, it wraps around the edge
-        int numSamplesToEnd = (_buffer + _bufferLength) - _nextOutput;
-
-        // read to the end of the buffer
-        for (int i = 0; i < numSamplesToEnd; i++) {
-            *dest++ += *output++;
-        }
-
-        // read the rest from the beginning of the buffer
-        output = _buffer;
-        for (int i = 0; i < (numReadSamples - numSamplesToEnd); i++) {
-            *dest++ += *output++;
-        }
-    } else {
-        for (int i = 0; i < numReadSamples; i++) {
-            *dest++ += *output++;
-        }
+    accumulateSamples(spans.first, dest, spans.firstSize);
+    if (spans.secondSize > 0) {
+        accumulateSamples(spans.second, dest + spans.firstSize, spans.secondSize);
     }
 
+    int numReadSamples = spans.size();
     shiftReadPosition(numReadSamples);
 
     return numReadSamples * SampleSize;
@@ -157,48 +187,56 @@ namespace {
 }
 
 template <class T>
-int AudioRingBufferTemplate<T>::writeData(const char* data, int maxSize) {
-    // only copy up to the number of samples we have capacity for
-    int maxSamples = maxSize / SampleSize;
-    int numWriteSamples = std::min(maxSamples, _sampleCapacity);
+void AudioRingBufferTemplate<T>::dropSamplesForWrite(int numWriteSamples) {
     int samplesRoomFor = _sampleCapacity - samplesAvailable();
 
     if (numWriteSamples > samplesRoomFor) {
         // there's not enough room for this write. erase old data to make room for this new data
         int samplesToDelete = numWriteSamples - samplesRoomFor;
-        _nextOutput = shiftedPositionAccomodatingWrap(_nextOutput, samplesToDelete);
+        shiftReadPosition(samplesToDelete);
         _overflowCount++;
 
         std::call_once(messageIDFlag, [](int* id) { *id = LogHandler::getInstance().newRepeatedMessageID(); },
             &repeatedOverflowMessageID);
         HIFI_FCDEBUG_ID(audio(), repeatedOverflowMessageID, RING_BUFFER_OVERFLOW_DEBUG);
     }
+}
 
-    if (_endOfLastWrite + numWriteSamples > _buffer + _bufferLength) {
+template <class T>
+int AudioRingBufferTemplate<T>::writeData(const char* data, int maxSize) {
+    // only copy up to the number of samples we have capacity for
+    int maxSamples = maxSize / SampleSize;
+    int numWriteSamples = std::min(maxSamples, _sampleCapacity);
+
+    dropSamplesForWrite(numWriteSamples);
+
+    Sample* endOfLastWrite = _endOfLastWrite.load(std::memory_order_relaxed);
+    if (endOfLastWrite + numWriteSamples > _buffer + _bufferLength) {
         // we're going to need to do two writes to set this data, it wraps around the edge
-        int numSamplesToEnd = (_buffer + _bufferLength) - _endOfLastWrite;
+        int numSamplesToEnd = (_buffer + _bufferLength) - endOfLastWrite;
 
         // write to the end of the buffer
-        memcpy(_endOfLastWrite, data, numSamplesToEnd * SampleSize);
+        memcpy(endOfLastWrite, data, numSamplesToEnd * SampleSize);
 
         // write the rest to the beginning of the buffer
         memcpy(_buffer, data + (numSamplesToEnd * SampleSize), (numWriteSamples - numSamplesToEnd) * SampleSize);
     } else {
-        memcpy(_endOfLastWrite, data, numWriteSamples * SampleSize);
+        memcpy(endOfLastWrite, data, numWriteSamples * SampleSize);
     }
 
-    _endOfLastWrite = shiftedPositionAccomodatingWrap(_endOfLastWrite, numWriteSamples);
+    commitWrite(numWriteSamples);
 
     return numWriteSamples * SampleSize;
 }
 
 template <class T>
 int AudioRingBufferTemplate<T>::samplesAvailable() const {
-    if (!_endOfLastWrite) {
+    Sample* endOfLastWrite = writePosition();
+    if (!endOfLastWrite) {
         return 0;
     }
 
-    int sampleDifference = _endOfLastWrite - _nextOutput;
+    int sampleDifference = endOfLastWrite - readPosition();
     if (sampleDifference < 0) {
         sampleDifference += _bufferLength;
     }
@@ -221,27 +259,22 @@ typename AudioRingBufferTemplate<T>::Sample* AudioRingBufferTemplate<T>::shifted
 
 template <class T>
 int AudioRingBufferTemplate<T>::addSilentSamples(int silentSamples) {
-    // NOTE: This implementation is nearly identical to writeData save for s/memcpy/memset, refer to comments there
+    // unlike writeData, this only writes in the room left, dropping silent samples that would overflow
     int numWriteSamples = std::min(silentSamples, _sampleCapacity);
-    int samplesRoomFor = _sampleCapacity - samplesAvailable();
-
-    if (numWriteSamples > samplesRoomFor) {
-        numWriteSamples = samplesRoomFor;
+    auto spans = writeSpans(numWriteSamples);
 
+    if (spans.size() < numWriteSamples) {
         HIFI_FCDEBUG(audio(), DROPPED_SILENT_DEBUG);
     }
 
-    if (_endOfLastWrite + numWriteSamples > _buffer + _bufferLength) {
-        int numSamplesToEnd = (_buffer + _bufferLength) - _endOfLastWrite;
-        memset(_endOfLastWrite, 0, numSamplesToEnd * SampleSize);
-        memset(_buffer, 0, (numWriteSamples - numSamplesToEnd) * SampleSize);
-    } else {
-        memset(_endOfLastWrite, 0, numWriteSamples * SampleSize);
+    memset(spans.first, 0, spans.firstSize * SampleSize);
+    if (spans.secondSize > 0) {
+        memset(spans.second, 0, spans.secondSize * SampleSize);
     }
 
-    _endOfLastWrite = shiftedPositionAccomodatingWrap(_endOfLastWrite, numWriteSamples);
+    commitWrite(spans.size());
 
-    return numWriteSamples;
+    return spans.size();
 }
 
 template <class T>
@@ -273,24 +306,16 @@ float AudioRingBufferTemplate<T>::getFrameLoudness(ConstIterator frameStart) con
 template <class T>
 int AudioRingBufferTemplate<T>::writeSamples(ConstIterator source, int maxSamples) {
     int samplesToCopy = std::min(maxSamples, _sampleCapacity);
-    int samplesRoomFor = _sampleCapacity - samplesAvailable();
-    if (samplesToCopy > samplesRoomFor) {
-        // there's not enough room for this write.  erase old data to make room for this new data
-        int samplesToDelete = samplesToCopy - samplesRoomFor;
-        _nextOutput = shiftedPositionAccomodatingWrap(_nextOutput, samplesToDelete);
-        _overflowCount++;
-
-        std::call_once(messageIDFlag, [](int* id) { *id = LogHandler::getInstance().newRepeatedMessageID(); },
-            &repeatedOverflowMessageID);
-        HIFI_FCDEBUG_ID(audio(), repeatedOverflowMessageID, RING_BUFFER_OVERFLOW_DEBUG);
-    }
+    dropSamplesForWrite(samplesToCopy);
 
+    Sample* endOfLastWrite = _endOfLastWrite.load(std::memory_order_relaxed);
     Sample* bufferLast = _buffer + _bufferLength - 1;
     for (int i = 0; i < samplesToCopy; i++) {
-        *_endOfLastWrite = *source;
-        _endOfLastWrite = (_endOfLastWrite == bufferLast) ? _buffer : _endOfLastWrite + 1;
+        *endOfLastWrite = *source;
+        endOfLastWrite = (endOfLastWrite == bufferLast) ? _buffer : endOfLastWrite + 1;
         ++source;
     }
+    _endOfLastWrite.store(endOfLastWrite, std::memory_order_release);
 
     return samplesToCopy;
 }
@@ -298,28 +323,143 @@ int AudioRingBufferTemplate<T>::writeSamples(ConstIterator source, int maxSample
 template <class T>
 int AudioRingBufferTemplate<T>::writeSamplesWithFade(ConstIterator source, int maxSamples, float fade) {
     int samplesToCopy = std::min(maxSamples, _sampleCapacity);
-    int samplesRoomFor = _sampleCapacity - samplesAvailable();
-    if (samplesToCopy > samplesRoomFor) {
-        // there's not enough room for this write.  erase old data to make room for this new data
-        int samplesToDelete = samplesToCopy - samplesRoomFor;
-        _nextOutput = shiftedPositionAccomodatingWrap(_nextOutput, samplesToDelete);
-        _overflowCount++;
-
-        std::call_once(messageIDFlag, [](int* id) { *id = LogHandler::getInstance().newRepeatedMessageID(); },
-            &repeatedOverflowMessageID);
-        HIFI_FCDEBUG_ID(audio(), repeatedOverflowMessageID, RING_BUFFER_OVERFLOW_DEBUG);
-    }
+    dropSamplesForWrite(samplesToCopy);
 
+    Sample* endOfLastWrite = _endOfLastWrite.load(std::memory_order_relaxed);
     Sample* bufferLast = _buffer + _bufferLength - 1;
     for (int i = 0; i < samplesToCopy; i++) {
-        *_endOfLastWrite = (Sample)((float)(*source) * fade);
-        _endOfLastWrite = (_endOfLastWrite == bufferLast) ? _buffer : _endOfLastWrite + 1;
+        *endOfLastWrite = (Sample)((float)(*source) * fade);
+        endOfLastWrite = (endOfLastWrite == bufferLast) ? _buffer : endOfLastWrite + 1;
         ++source;
     }
+    _endOfLastWrite.store(endOfLastWrite, std::memory_order_release);
 
     return samplesToCopy;
 }
 
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static void accumulate_float_SSE(const float* src, float* dst, int numSamples) {
+    int i = 0;
+    for (; i + 4 <= numSamples; i += 4) {
+        _mm_storeu_ps(&dst[i], _mm_add_ps(_mm_loadu_ps(&dst[i]), _mm_loadu_ps(&src[i])));
+    }
+    for (; i < numSamples; i++) {
+        dst[i] += src[i];
+    }
+}
+
+static void accumulate_int16_SSE(const int16_t* src, int16_t* dst, int numSamples) {
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)&src[i]);
+        __m128i y = _mm_loadu_si128((const __m128i*)&dst[i]);
+        _mm_storeu_si128((__m128i*)&dst[i], _mm_add_epi16(y, x));
+    }
+    for (; i < numSamples; i++) {
+        dst[i] += src[i];
+    }
+}
+
+// sign-extend 8 int16 to two vectors of 4 float
+static inline void int16ToFloat_SSE(const int16_t* src, __m128& lo, __m128& hi) {
+    __m128i x = _mm_loadu_si128((const __m128i*)src);
+    lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+    hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+}
+
+static void accumulateWithGain_SSE(const int16_t* src, float* dst, float gain, int numSamples) {
+    __m128 g = _mm_set1_ps(gain);
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        __m128 lo, hi;
+        int16ToFloat_SSE(&src[i], lo, hi);
+        _mm_storeu_ps(&dst[i+0], _mm_add_ps(_mm_loadu_ps(&dst[i+0]), _mm_mul_ps(lo, g)));
+        _mm_storeu_ps(&dst[i+4], _mm_add_ps(_mm_loadu_ps(&dst[i+4]), _mm_mul_ps(hi, g)));
+    }
+    for (; i < numSamples; i++) {
+        dst[i] += (float)src[i] * gain;
+    }
+}
+
+static void convertToFloat_SSE(const int16_t* src, float* dst, float gain, int numSamples) {
+    __m128 g = _mm_set1_ps(gain);
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        __m128 lo, hi;
+        int16ToFloat_SSE(&src[i], lo, hi);
+        _mm_storeu_ps(&dst[i+0], _mm_mul_ps(lo, g));
+        _mm_storeu_ps(&dst[i+4], _mm_mul_ps(hi, g));
+    }
+    for (; i < numSamples; i++) {
+        dst[i] = (float)src[i] * gain;
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void accumulate_float_AVX2(const float* src, float* dst, int numSamples);
+void accumulate_int16_AVX2(const int16_t* src, int16_t* dst, int numSamples);
+void accumulateWithGain_AVX2(const int16_t* src, float* dst, float gain, int numSamples);
+void convertToFloat_AVX2(const int16_t* src, float* dst, float gain, int numSamples);
+
+void accumulateSamples(const float* src, float* dst, int numSamples) {
+    static auto f = cpuSupportsAVX2() ? accumulate_float_AVX2 : accumulate_float_SSE;
+    (*f)(src, dst, numSamples); // dispatch
+}
+
+void accumulateSamples(const int16_t* src, int16_t* dst, int numSamples) {
+    static auto f = cpuSupportsAVX2() ? accumulate_int16_AVX2 : accumulate_int16_SSE;
+    (*f)(src, dst, numSamples); // dispatch
+}
+
+void accumulateSamplesWithGain(const int16_t* src, float* dst, float gain, int numSamples) {
+    static auto f = cpuSupportsAVX2() ? accumulateWithGain_AVX2 : accumulateWithGain_SSE;
+    (*f)(src, dst, gain, numSamples); // dispatch
+}
+
+void convertSamplesToFloat(const int16_t* src, float* dst, float gain, int numSamples) {
+    static auto f = cpuSupportsAVX2() ? convertToFloat_AVX2 : convertToFloat_SSE;
+    (*f)(src, dst, gain, numSamples); // dispatch
+}
+
+#else   // portable reference code
+
+void accumulateSamples(const float* src, float* dst, int numSamples) {
+    for (int i = 0; i < numSamples; i++) {
+        dst[i] += src[i];
+    }
+}
+
+void accumulateSamples(const int16_t* src, int16_t* dst, int numSamples) {
+    for (int i = 0; i < numSamples; i++) {
+        dst[i] += src[i];
+    }
+}
+
+void accumulateSamplesWithGain(const int16_t* src, float* dst, float gain, int numSamples) {
+    for (int i = 0; i < numSamples; i++) {
+        dst[i] += (float)src[i] * gain;
+    }
+}
+
+void convertSamplesToFloat(const int16_t* src, float* dst, float gain, int numSamples) {
+    for (int i = 0; i < numSamples; i++) {
+        dst[i] = (float)src[i] * gain;
+    }
+}
+
+#endif
+
 // explicit instantiations for scratch/mix buffers
 template class AudioRingBufferTemplate<int16_t>;
 template class AudioRingBufferTemplate<float>;
@@ -14,6 +14,8 @@
 
 #include "AudioConstants.h"
 
+#include <atomic>
+
 #include <QtCore/QIODevice>
 
 #include <SharedUtil.h>
@@ -45,12 +47,35 @@ public:
     // FIXME: discards any data in the buffer
     void resizeForFrameSize(int numFrameSamples);
 
-    // Reading and writing to the buffer uses minimal shared data, such that
+    // Reading and writing to the buffer only shares the read and write positions, such that
     // in cases that avoid overwriting the buffer, a single producer/consumer
     // may use this as a lock-free pipe (see audio-client/src/AudioClient.cpp).
+    // The producer publishes the write position with release ordering once the samples are in the ring,
+    // and the consumer publishes the read position with release ordering once it is done with the samples.
+    // An overflowing write moves the read position, which is only safe without a concurrent consumer.
     // IMPORTANT: Avoid changes to the implementation that touch shared data unless you can
     // maintain this behavior.
 
+    /// Up to two contiguous ranges of samples, the second one starting at the beginning of the ring
+    template <class S>
+    struct Spans {
+        S* first { nullptr };
+        int firstSize { 0 };
+        S* second { nullptr };
+        int secondSize { 0 };
+
+        int size() const { return firstSize + secondSize; }
+    };
+
+    /// Consumer: returns up to maxSamples of the available samples in place, without consuming them
+    /// Follow with shiftReadPosition() to release the samples that were used
+    Spans<const Sample> readSpans(int maxSamples) const;
+
+    /// Producer: returns room for up to maxSamples in place, without overwriting unread samples
+    /// Follow with commitWrite() to publish the samples that were written
+    Spans<Sample> writeSpans(int maxSamples);
+    void commitWrite(int numSamples);
+
     /// Read up to maxSamples into destination (will only read up to samplesAvailable())
     /// Returns number of read samples
     int readSamples(Sample* destination, int maxSamples);
@@ -85,17 +110,19 @@ public:
     int writeData(const char* source, int maxSize);
 
     /// Returns a reference to the index-th sample offset from the current read sample
-    Sample& operator[](const int index) { return *shiftedPositionAccomodatingWrap(_nextOutput, index); }
-    const Sample& operator[] (const int index) const { return *shiftedPositionAccomodatingWrap(_nextOutput, index); }
+    Sample& operator[](const int index) { return *shiftedPositionAccomodatingWrap(readPosition(), index); }
+    const Sample& operator[] (const int index) const { return *shiftedPositionAccomodatingWrap(readPosition(), index); }
 
     /// Essentially discards the next numSamples from the ring buffer
     /// NOTE: This is not checked - it is possible to shift past written data
     ///       Use samplesAvailable() to see the distance a valid shift can go
-    void shiftReadPosition(unsigned int numSamples) { _nextOutput = shiftedPositionAccomodatingWrap(_nextOutput, numSamples); }
+    void shiftReadPosition(unsigned int numSamples) {
+        _nextOutput.store(shiftedPositionAccomodatingWrap(readPosition(), numSamples), std::memory_order_release);
+    }
 
     int samplesAvailable() const;
     int framesAvailable() const { return (_numFrameSamples == 0) ? 0 : samplesAvailable() / _numFrameSamples; }
-    float getNextOutputFrameLoudness() const { return getFrameLoudness(_nextOutput); }
+    float getNextOutputFrameLoudness() const { return getFrameLoudness(readPosition()); }
 
 
     int getNumFrameSamples() const { return _numFrameSamples; }
@@ -199,10 +226,10 @@ public:
     };
 
     ConstIterator nextOutput() const {
-        return ConstIterator(_buffer, _bufferLength, _nextOutput);
+        return ConstIterator(_buffer, _bufferLength, readPosition());
     }
     ConstIterator lastFrameWritten() const {
-        return ConstIterator(_buffer, _bufferLength, _endOfLastWrite) - _numFrameSamples;
+        return ConstIterator(_buffer, _bufferLength, writePosition()) - _numFrameSamples;
     }
 
     int writeSamples(ConstIterator source, int maxSamples);
@@ -214,17 +241,30 @@ protected:
     Sample* shiftedPositionAccomodatingWrap(Sample* position, int numSamplesShift) const;
     float getFrameLoudness(const Sample* frameStart) const;
 
+    // acquire the position published by the other side
+    Sample* readPosition() const { return _nextOutput.load(std::memory_order_acquire); }
+    Sample* writePosition() const { return _endOfLastWrite.load(std::memory_order_acquire); }
+
+    // make room for a write of numWriteSamples by dropping the oldest samples, if needed
+    void dropSamplesForWrite(int numWriteSamples);
+
     int _numFrameSamples;
     int _frameCapacity;
     int _sampleCapacity;
     int _bufferLength; // actual _buffer length (_sampleCapacity + 1)
     int _overflowCount{ 0 }; // times the ring buffer has overwritten data
 
-    Sample* _nextOutput{ nullptr };
-    Sample* _endOfLastWrite{ nullptr };
+    std::atomic<Sample*> _nextOutput { nullptr };      // written by the consumer
+    std::atomic<Sample*> _endOfLastWrite { nullptr };  // written by the producer
     Sample* _buffer{ nullptr };
 };
 
+// Vectorized kernels for moving samples out of ring buffers, dispatched at runtime to SSE2 or AVX2
+void accumulateSamples(const float* src, float* dst, int numSamples);
+void accumulateSamples(const int16_t* src, int16_t* dst, int numSamples);       // wraps on overflow, like +=
+void accumulateSamplesWithGain(const int16_t* src, float* dst, float gain, int numSamples);
+void convertSamplesToFloat(const int16_t* src, float* dst, float gain, int numSamples);
+
 // expose explicit instantiations for scratch/mix buffers
 using AudioRingBuffer = AudioRingBufferTemplate<int16_t>;
 using AudioMixRingBuffer = AudioRingBufferTemplate<float>;
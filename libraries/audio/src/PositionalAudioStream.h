@@ -59,6 +59,11 @@ public:
     float getLastPopOutputLoudness() const { return _lastPopOutputLoudness; }
     float getQuietestFrameLoudness() const { return _quietestFrameLoudness; }
 
+    // contiguous copy of the last popped frame (or of the frame being faded out), null when the stream is silent
+    // the storage is owned by the mixer, and is only valid for the frame it was decoded in
+    const int16_t* getDecodedFrame() const { return _decodedFrame; }
+    void setDecodedFrame(const int16_t* decodedFrame) { _decodedFrame = decodedFrame; }
+
     bool shouldLoopbackForNode() const { return _shouldLoopbackForNode; }
     bool isStereo() const { return _isStereo; }
 
@@ -107,6 +112,8 @@ protected:
     float _quietestFrameLoudness;
     int _frameCounter;
 
+    const int16_t* _decodedFrame { nullptr };
+
     bool _isIgnoreBoxEnabled { false };
     IgnoreBox _ignoreBox;
 };
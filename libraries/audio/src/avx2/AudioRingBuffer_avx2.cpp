@@ -0,0 +1,70 @@
+//
+//  AudioRingBuffer_avx2.cpp
+//  libraries/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+void accumulate_float_AVX2(const float* src, float* dst, int numSamples) {
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        _mm256_storeu_ps(&dst[i], _mm256_add_ps(_mm256_loadu_ps(&dst[i]), _mm256_loadu_ps(&src[i])));
+    }
+    for (; i < numSamples; i++) {
+        dst[i] += src[i];
+    }
+
+    _mm256_zeroupper();
+}
+
+void accumulate_int16_AVX2(const int16_t* src, int16_t* dst, int numSamples) {
+    int i = 0;
+    for (; i + 16 <= numSamples; i += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)&src[i]);
+        __m256i y = _mm256_loadu_si256((const __m256i*)&dst[i]);
+        _mm256_storeu_si256((__m256i*)&dst[i], _mm256_add_epi16(y, x));
+    }
+    for (; i < numSamples; i++) {
+        dst[i] += src[i];
+    }
+
+    _mm256_zeroupper();
+}
+
+void accumulateWithGain_AVX2(const int16_t* src, float* dst, float gain, int numSamples) {
+    __m256 g = _mm256_set1_ps(gain);
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        __m256 x = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)&src[i])));
+        _mm256_storeu_ps(&dst[i], _mm256_fmadd_ps(x, g, _mm256_loadu_ps(&dst[i])));
+    }
+    for (; i < numSamples; i++) {
+        dst[i] += (float)src[i] * gain;
+    }
+
+    _mm256_zeroupper();
+}
+
+void convertToFloat_AVX2(const int16_t* src, float* dst, float gain, int numSamples) {
+    __m256 g = _mm256_set1_ps(gain);
+    int i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        __m256 x = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)&src[i])));
+        _mm256_storeu_ps(&dst[i], _mm256_mul_ps(x, g));
+    }
+    for (; i < numSamples; i++) {
+        dst[i] = (float)src[i] * gain;
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
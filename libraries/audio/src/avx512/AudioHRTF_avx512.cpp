@@ -87,4 +87,93 @@ void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* ds
     _mm256_zeroupper();
 }
 
+// 2 channel input, 8 channel output
+// both sources share a single pass, split into even and odd taps as in FIR_1x4
+void FIR_2x8_AVX512(float* src0, float* src1, float* dst[8], float coef[8][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+    float* coef4 = coef[4] + HRTF_TAPS - 1;
+    float* coef5 = coef[5] + HRTF_TAPS - 1;
+    float* coef6 = coef[6] + HRTF_TAPS - 1;
+    float* coef7 = coef[7] + HRTF_TAPS - 1;
+
+    assert(numFrames % 16 == 0);
+
+    for (int i = 0; i < numFrames; i += 16) {
+
+        __m512 acc0 = _mm512_setzero_ps();
+        __m512 acc1 = _mm512_setzero_ps();
+        __m512 acc2 = _mm512_setzero_ps();
+        __m512 acc3 = _mm512_setzero_ps();
+        __m512 acc4 = _mm512_setzero_ps();
+        __m512 acc5 = _mm512_setzero_ps();
+        __m512 acc6 = _mm512_setzero_ps();
+        __m512 acc7 = _mm512_setzero_ps();
+
+        __m512 acc8 = _mm512_setzero_ps();
+        __m512 acc9 = _mm512_setzero_ps();
+        __m512 acc10 = _mm512_setzero_ps();
+        __m512 acc11 = _mm512_setzero_ps();
+        __m512 acc12 = _mm512_setzero_ps();
+        __m512 acc13 = _mm512_setzero_ps();
+        __m512 acc14 = _mm512_setzero_ps();
+        __m512 acc15 = _mm512_setzero_ps();
+
+        float* ps0 = &src0[i - HRTF_TAPS + 1];  // process forwards
+        float* ps1 = &src1[i - HRTF_TAPS + 1];
+
+        static_assert(HRTF_TAPS % 2 == 0, "HRTF_TAPS must be a multiple of 2");
+
+        for (int k = 0; k < HRTF_TAPS; k += 2) {
+
+            __m512 x0 = _mm512_loadu_ps(&ps0[k+0]);
+            acc0 = _mm512_fmadd_ps(_mm512_set1_ps(coef0[-k-0]), x0, acc0);
+            acc1 = _mm512_fmadd_ps(_mm512_set1_ps(coef1[-k-0]), x0, acc1);
+            acc2 = _mm512_fmadd_ps(_mm512_set1_ps(coef2[-k-0]), x0, acc2);
+            acc3 = _mm512_fmadd_ps(_mm512_set1_ps(coef3[-k-0]), x0, acc3);
+
+            __m512 x1 = _mm512_loadu_ps(&ps1[k+0]);
+            acc4 = _mm512_fmadd_ps(_mm512_set1_ps(coef4[-k-0]), x1, acc4);
+            acc5 = _mm512_fmadd_ps(_mm512_set1_ps(coef5[-k-0]), x1, acc5);
+            acc6 = _mm512_fmadd_ps(_mm512_set1_ps(coef6[-k-0]), x1, acc6);
+            acc7 = _mm512_fmadd_ps(_mm512_set1_ps(coef7[-k-0]), x1, acc7);
+
+            __m512 x2 = _mm512_loadu_ps(&ps0[k+1]);
+            acc8 = _mm512_fmadd_ps(_mm512_set1_ps(coef0[-k-1]), x2, acc8);
+            acc9 = _mm512_fmadd_ps(_mm512_set1_ps(coef1[-k-1]), x2, acc9);
+            acc10 = _mm512_fmadd_ps(_mm512_set1_ps(coef2[-k-1]), x2, acc10);
+            acc11 = _mm512_fmadd_ps(_mm512_set1_ps(coef3[-k-1]), x2, acc11);
+
+            __m512 x3 = _mm512_loadu_ps(&ps1[k+1]);
+            acc12 = _mm512_fmadd_ps(_mm512_set1_ps(coef4[-k-1]), x3, acc12);
+            acc13 = _mm512_fmadd_ps(_mm512_set1_ps(coef5[-k-1]), x3, acc13);
+            acc14 = _mm512_fmadd_ps(_mm512_set1_ps(coef6[-k-1]), x3, acc14);
+            acc15 = _mm512_fmadd_ps(_mm512_set1_ps(coef7[-k-1]), x3, acc15);
+        }
+
+        acc0 = _mm512_add_ps(acc0, acc8);
+        acc1 = _mm512_add_ps(acc1, acc9);
+        acc2 = _mm512_add_ps(acc2, acc10);
+        acc3 = _mm512_add_ps(acc3, acc11);
+        acc4 = _mm512_add_ps(acc4, acc12);
+        acc5 = _mm512_add_ps(acc5, acc13);
+        acc6 = _mm512_add_ps(acc6, acc14);
+        acc7 = _mm512_add_ps(acc7, acc15);
+
+        _mm512_storeu_ps(&dst[0][i], acc0);
+        _mm512_storeu_ps(&dst[1][i], acc1);
+        _mm512_storeu_ps(&dst[2][i], acc2);
+        _mm512_storeu_ps(&dst[3][i], acc3);
+        _mm512_storeu_ps(&dst[4][i], acc4);
+        _mm512_storeu_ps(&dst[5][i], acc5);
+        _mm512_storeu_ps(&dst[6][i], acc6);
+        _mm512_storeu_ps(&dst[7][i], acc7);
+    }
+
+    _mm256_zeroupper();
+}
+
 #endif
@@ -563,9 +563,10 @@ void Avatar::simulate(float deltaTime, bool inView) {
         if (inView) {
             Head* head = getHead();
             if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+                if (!_jointsPreparedForSimulate) {
+                    prepareJointsForSimulate(inView);
+                }
+                _jointsPreparedForSimulate = false;
                 _jointDataSimulationRate.increment();
 
                 _skeletonModel->simulate(deltaTime, true);
@@ -620,6 +621,16 @@ void Avatar::simulate(float deltaTime, bool inView) {
     updateFadingStatus();
 }
 
+void Avatar::prepareJointsForSimulate(bool inView) {
+    if (inView && (_hasNewJointData || _transit.isActive())) {
+        PROFILE_RANGE(simulation, "prepareJoints");
+        _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+        glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+        _skeletonModel->getRig().computeExternalPoses(rootTransform);
+        _jointsPreparedForSimulate = true;
+    }
+}
+
 float Avatar::getSimulationRate(const QString& rateName) const {
     if (rateName == "") {
         return _simulationRate.rate();
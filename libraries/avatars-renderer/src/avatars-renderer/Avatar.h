@@ -144,6 +144,10 @@ public:
     void simulate(float deltaTime, bool inView);
     virtual void simulateAttachments(float deltaTime);
 
+    // Copies the latest joint data into the rig and computes its poses, ahead of simulate().
+    // Only touches this avatar's Rig, so AvatarManager may call it for many avatars in parallel.
+    void prepareJointsForSimulate(bool inView);
+
     virtual void render(RenderArgs* renderArgs);
 
     void addToScene(AvatarSharedPointer self, const render::ScenePointer& scene,
@@ -574,6 +578,7 @@ protected:
     RateCounter<> _simulationInViewRate;
     RateCounter<> _skeletonModelSimulationRate;
     RateCounter<> _jointDataSimulationRate;
+    bool _jointsPreparedForSimulate { false };
 
 
 protected:
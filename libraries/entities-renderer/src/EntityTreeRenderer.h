@@ -67,6 +67,7 @@ public:
     virtual char getMyNodeType() const override { return NodeType::EntityServer; }
     virtual PacketType getMyQueryMessageType() const override { return PacketType::EntityQuery; }
     virtual PacketType getExpectedPacketType() const override { return PacketType::EntityData; }
+    virtual PacketType getMyResendRequestMessageType() const override { return PacketType::EntityQueryResend; }
 
     // Returns the priority at which an entity should be loaded. Higher values indicate higher priority.
     static float getEntityLoadingPriority(const EntityItem& item) { return _calculateEntityLoadingPriorityFunc(item); }
@@ -0,0 +1,265 @@
+//
+//  PolyVoxChunks.cpp
+//  libraries/entities-renderer/src/
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunks.h"
+
+#include <QtConcurrent/QtConcurrentMap>
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning( disable : 4267 )
+#endif
+#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
+#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+const int PolyVoxChunks::CHUNK_SIZE;
+
+const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
+
+static glm::ivec3 toGlm(const PolyVox::Vector3DInt32& v) {
+    return glm::ivec3(v.getX(), v.getY(), v.getZ());
+}
+
+static glm::vec3 toGlm(const PolyVox::Vector3DFloat& v) {
+    return glm::vec3(v.getX(), v.getY(), v.getZ());
+}
+
+void PolyVoxChunks::reset(const PolyVox::Region& region) {
+    glm::ivec3 lowerCorner = toGlm(region.getLowerCorner());
+    glm::ivec3 upperCorner = toGlm(region.getUpperCorner());
+
+    _lowerCorner = lowerCorner;
+    _numChunks = glm::max((upperCorner - lowerCorner + CHUNK_SIZE - 1) / CHUNK_SIZE, glm::ivec3(1));
+    _chunks.clear();
+    _chunks.resize(_numChunks.x * _numChunks.y * _numChunks.z);
+
+    glm::ivec3 chunkCoords;
+    for (chunkCoords.z = 0; chunkCoords.z < _numChunks.z; chunkCoords.z++) {
+        for (chunkCoords.y = 0; chunkCoords.y < _numChunks.y; chunkCoords.y++) {
+            for (chunkCoords.x = 0; chunkCoords.x < _numChunks.x; chunkCoords.x++) {
+                glm::ivec3 chunkLower = lowerCorner + chunkCoords * CHUNK_SIZE;
+                glm::ivec3 chunkUpper = glm::min(chunkLower + CHUNK_SIZE, upperCorner);
+                _chunks[getChunkIndex(chunkCoords)].region =
+                    PolyVox::Region(PolyVox::Vector3DInt32(chunkLower.x, chunkLower.y, chunkLower.z),
+                                    PolyVox::Vector3DInt32(chunkUpper.x, chunkUpper.y, chunkUpper.z));
+            }
+        }
+    }
+}
+
+void PolyVoxChunks::markDirty(const glm::ivec3& voxel) {
+    if (_chunks.empty()) {
+        return;
+    }
+
+    // the surfaces read the voxels on the shared faces of the chunks, and the hulls read the neighbors of each voxel
+    glm::ivec3 relative = voxel - _lowerCorner;
+    glm::ivec3 low = glm::min(glm::max(relative - 1, glm::ivec3(0)) / CHUNK_SIZE, _numChunks - 1);
+    glm::ivec3 high = glm::min(glm::max(relative + 1, glm::ivec3(0)) / CHUNK_SIZE, _numChunks - 1);
+
+    glm::ivec3 chunkCoords;
+    for (chunkCoords.z = low.z; chunkCoords.z <= high.z; chunkCoords.z++) {
+        for (chunkCoords.y = low.y; chunkCoords.y <= high.y; chunkCoords.y++) {
+            for (chunkCoords.x = low.x; chunkCoords.x <= high.x; chunkCoords.x++) {
+                Chunk& chunk = _chunks[getChunkIndex(chunkCoords)];
+                chunk.surfaceDirty = true;
+                chunk.hullsDirty = true;
+            }
+        }
+    }
+}
+
+void PolyVoxChunks::markAllDirty() {
+    for (auto& chunk : _chunks) {
+        chunk.surfaceDirty = true;
+        chunk.hullsDirty = true;
+    }
+}
+
+bool PolyVoxChunks::hasDirtySurfaces() const {
+    for (const auto& chunk : _chunks) {
+        if (chunk.surfaceDirty) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int PolyVoxChunks::extractSurfaces(Volume* volume, bool marchingCubes) {
+    std::vector<Chunk*> dirtyChunks;
+    for (auto& chunk : _chunks) {
+        if (chunk.surfaceDirty) {
+            dirtyChunks.push_back(&chunk);
+        }
+    }
+
+    QtConcurrent::blockingMap(dirtyChunks, [&](Chunk* chunk) {
+        extractSurface(*chunk, volume, marchingCubes);
+    });
+    return (int)dirtyChunks.size();
+}
+
+void PolyVoxChunks::mergeSurfaces(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) const {
+    size_t numVertices = 0;
+    size_t numIndices = 0;
+    for (const auto& chunk : _chunks) {
+        numVertices += chunk.vertices.size();
+        numIndices += chunk.indices.size();
+    }
+
+    vertices.clear();
+    indices.clear();
+    vertices.reserve(numVertices);
+    indices.reserve(numIndices);
+    for (const auto& chunk : _chunks) {
+        uint32_t baseVertex = (uint32_t)vertices.size();
+        vertices.insert(vertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+        for (uint32_t index : chunk.indices) {
+            indices.push_back(baseVertex + index);
+        }
+    }
+}
+
+int PolyVoxChunks::buildHulls(const Volume* volume, bool marchingCubes, const PolyVox::Region& userRegion) {
+    std::vector<Chunk*> dirtyChunks;
+    for (auto& chunk : _chunks) {
+        if (chunk.hullsDirty) {
+            dirtyChunks.push_back(&chunk);
+        }
+    }
+
+    QtConcurrent::blockingMap(dirtyChunks, [&](Chunk* chunk) {
+        if (marchingCubes) {
+            buildTriangleHulls(*chunk);
+        } else {
+            buildVoxelHulls(*chunk, volume, userRegion);
+        }
+        chunk->hullsDirty = false;
+    });
+    return (int)dirtyChunks.size();
+}
+
+void PolyVoxChunks::getHulls(const glm::mat4& voxelToLocal, ShapeInfo::PointCollection& hulls, AABox& box) const {
+    int numHulls = 0;
+    for (const auto& chunk : _chunks) {
+        numHulls += chunk.hulls.size();
+    }
+
+    hulls.clear();
+    hulls.reserve(numHulls);
+    for (const auto& chunk : _chunks) {
+        for (const auto& chunkHull : chunk.hulls) {
+            ShapeInfo::PointList hull;
+            hull.reserve(chunkHull.size());
+            for (const auto& point : chunkHull) {
+                glm::vec3 localPoint = glm::vec3(voxelToLocal * glm::vec4(point, 1.0f));
+                box += localPoint;
+                hull << localPoint;
+            }
+            hulls << hull;
+        }
+    }
+}
+
+int PolyVoxChunks::getChunkIndex(const glm::ivec3& chunkCoords) const {
+    return chunkCoords.x + _numChunks.x * (chunkCoords.y + _numChunks.y * chunkCoords.z);
+}
+
+void PolyVoxChunks::extractSurface(Chunk& chunk, Volume* volume, bool marchingCubes) {
+    PolyVox::SurfaceMesh<Vertex> surface;
+    if (marchingCubes) {
+        PolyVox::MarchingCubesSurfaceExtractor<Volume> surfaceExtractor(volume, chunk.region, &surface);
+        surfaceExtractor.execute();
+    } else {
+        PolyVox::CubicSurfaceExtractorWithNormals<Volume> surfaceExtractor(volume, chunk.region, &surface);
+        surfaceExtractor.execute();
+    }
+
+    // the extractors place the vertices relative to the lower corner of the region
+    glm::ivec3 lowerCorner = toGlm(chunk.region.getLowerCorner());
+    PolyVox::Vector3DFloat offset((float)lowerCorner.x, (float)lowerCorner.y, (float)lowerCorner.z);
+    chunk.vertices = surface.getRawVertexData();
+    for (auto& vertex : chunk.vertices) {
+        vertex.setPosition(vertex.getPosition() + offset);
+    }
+    chunk.indices = surface.getIndices();
+
+    chunk.surfaceDirty = false;
+    chunk.hullsDirty = true;
+}
+
+void PolyVoxChunks::buildTriangleHulls(Chunk& chunk) {
+    // pull each triangle in the surface into a polyhedron which can be collided with
+    chunk.hulls.clear();
+    chunk.hulls.reserve((int)(chunk.indices.size() / 3));
+    for (size_t i = 0; i + 2 < chunk.indices.size(); i += 3) {
+        glm::vec3 p0 = toGlm(chunk.vertices[chunk.indices[i]].getPosition());
+        glm::vec3 p1 = toGlm(chunk.vertices[chunk.indices[i + 1]].getPosition());
+        glm::vec3 p2 = toGlm(chunk.vertices[chunk.indices[i + 2]].getPosition());
+
+        glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
+        glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+        glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
+
+        ShapeInfo::PointList hull;
+        hull << p0 << p1 << p2 << p3;
+        chunk.hulls << hull;
+    }
+}
+
+void PolyVoxChunks::buildVoxelHulls(Chunk& chunk, const Volume* volume, const PolyVox::Region& userRegion) {
+    // each chunk owns the voxels below its upper faces
+    glm::ivec3 userLower = toGlm(userRegion.getLowerCorner());
+    glm::ivec3 userUpper = toGlm(userRegion.getUpperCorner());
+    glm::ivec3 low = glm::max(toGlm(chunk.region.getLowerCorner()), userLower);
+    glm::ivec3 high = glm::min(toGlm(chunk.region.getUpperCorner()), userUpper + 1);
+
+    chunk.hulls.clear();
+    glm::ivec3 v;
+    for (v.z = low.z; v.z < high.z; v.z++) {
+        for (v.y = low.y; v.y < high.y; v.y++) {
+            for (v.x = low.x; v.x < high.x; v.x++) {
+                if (volume->getVoxelAt(v.x, v.y, v.z) == 0) {
+                    continue;
+                }
+
+                if (glm::all(glm::greaterThan(v, userLower)) &&
+                    glm::all(glm::lessThan(v, userUpper)) &&
+                    (volume->getVoxelAt(v.x - 1, v.y, v.z) > 0) &&
+                    (volume->getVoxelAt(v.x, v.y - 1, v.z) > 0) &&
+                    (volume->getVoxelAt(v.x, v.y, v.z - 1) > 0) &&
+                    (volume->getVoxelAt(v.x + 1, v.y, v.z) > 0) &&
+                    (volume->getVoxelAt(v.x, v.y + 1, v.z) > 0) &&
+                    (volume->getVoxelAt(v.x, v.y, v.z + 1) > 0)) {
+                    // this voxel has neighbors in every cardinal direction, so there's no need
+                    // to include it in the collision hull.
+                    continue;
+                }
+
+                glm::vec3 lowCorner = glm::vec3(v) - 0.5f;
+                glm::vec3 highCorner = glm::vec3(v) + 0.5f;
+
+                ShapeInfo::PointList hull;
+                hull << glm::vec3(lowCorner.x, lowCorner.y, lowCorner.z);
+                hull << glm::vec3(lowCorner.x, lowCorner.y, highCorner.z);
+                hull << glm::vec3(lowCorner.x, highCorner.y, lowCorner.z);
+                hull << glm::vec3(lowCorner.x, highCorner.y, highCorner.z);
+                hull << glm::vec3(highCorner.x, lowCorner.y, lowCorner.z);
+                hull << glm::vec3(highCorner.x, lowCorner.y, highCorner.z);
+                hull << glm::vec3(highCorner.x, highCorner.y, lowCorner.z);
+                hull << glm::vec3(highCorner.x, highCorner.y, highCorner.z);
+                chunk.hulls << hull;
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+//
+//  PolyVoxChunks.h
+//  libraries/entities-renderer/src/
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunks_h
+#define hifi_PolyVoxChunks_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <PolyVoxCore/Region.h>
+#include <PolyVoxCore/SimpleVolume.h>
+#include <PolyVoxCore/SurfaceMesh.h>
+
+#include <AABox.h>
+#include <ShapeInfo.h>
+
+// Splits a voxel volume in cubic chunks whose surfaces and collision hulls are extracted separately.
+//   Editing a voxel only dirties the chunks that read it, so a small edit re-extracts a few chunks instead of the volume.
+//   The dirty chunks are extracted in parallel on the global thread pool.
+//   Chunk regions share their upper faces with the lower faces of the next chunks, so the surfaces knit together.
+//   PolyVoxChunks is not thread-safe, RenderablePolyVoxEntityItem guards its chunks with its own locks.
+class PolyVoxChunks {
+public:
+    using Volume = PolyVox::SimpleVolume<uint8_t>;
+    using Vertex = PolyVox::PositionMaterialNormal;
+
+    static const int CHUNK_SIZE = 16; // in voxels
+
+    // lays the chunks out over region, in volume coordinates, and marks them all dirty
+    void reset(const PolyVox::Region& region);
+
+    // marks the chunks whose surfaces or hulls depend on the voxel, in volume coordinates
+    void markDirty(const glm::ivec3& voxel);
+    void markAllDirty();
+
+    int getNumChunks() const { return (int)_chunks.size(); }
+    bool hasDirtySurfaces() const;
+
+    // re-extracts the surfaces of the dirty chunks, and returns how many were extracted
+    int extractSurfaces(Volume* volume, bool marchingCubes);
+
+    // concatenates the surfaces of all the chunks, with vertices in volume coordinates
+    void mergeSurfaces(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) const;
+
+    // rebuilds the collision hulls of the dirty chunks, and returns how many were rebuilt
+    //   with marching cubes each triangle of the surfaces becomes a hull, so the surfaces must be extracted first.
+    //   otherwise each voxel of userRegion that isn't surrounded by other voxels becomes a box.
+    int buildHulls(const Volume* volume, bool marchingCubes, const PolyVox::Region& userRegion);
+
+    // gathers the hulls of all the chunks, transformed by voxelToLocal
+    void getHulls(const glm::mat4& voxelToLocal, ShapeInfo::PointCollection& hulls, AABox& box) const;
+
+private:
+    struct Chunk {
+        PolyVox::Region region;
+        std::vector<Vertex> vertices; // in volume coordinates
+        std::vector<uint32_t> indices;
+        ShapeInfo::PointCollection hulls; // in volume coordinates
+        bool surfaceDirty { true };
+        bool hullsDirty { true };
+    };
+
+    int getChunkIndex(const glm::ivec3& chunkCoords) const;
+
+    static void extractSurface(Chunk& chunk, Volume* volume, bool marchingCubes);
+    static void buildTriangleHulls(Chunk& chunk);
+    static void buildVoxelHulls(Chunk& chunk, const Volume* volume, const PolyVox::Region& userRegion);
+
+    std::vector<Chunk> _chunks;
+    glm::ivec3 _lowerCorner { 0 };
+    glm::ivec3 _numChunks { 0 };
+};
+
+#endif // hifi_PolyVoxChunks_h
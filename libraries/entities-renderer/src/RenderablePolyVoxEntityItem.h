@@ -13,6 +13,7 @@
 #define hifi_RenderablePolyVoxEntityItem_h
 
 #include <atomic>
+#include <mutex>
 
 #include <QSemaphore>
 
@@ -26,6 +27,7 @@
 #include <TextureCache.h>
 #include <PolyVoxEntityItem.h>
 
+#include "PolyVoxChunks.h"
 #include "RenderableEntityItem.h"
 
 namespace render { namespace entities {
@@ -144,6 +146,10 @@ private:
     ShapeInfo _shapeInfo;
 
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
+    // surfaces and collision hulls of _volData, by chunk.  Changed under the write lock, or by the
+    // mesh and shape workers under the read lock and _chunksMutex
+    PolyVoxChunks _chunks;
+    std::mutex _chunksMutex;
     bool _voxelDataDirty{ true };
     bool _volDataDirty { false }; // does recomputeMesh need to be called?
     int _onCount; // how many non-zero voxels are in _volData
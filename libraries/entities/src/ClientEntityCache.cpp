@@ -0,0 +1,152 @@
+//
+//  ClientEntityCache.cpp
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ClientEntityCache.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtScript/QScriptEngine>
+
+#include <udt/PacketHeaders.h>
+#include <UUID.h>
+
+#include "EntitiesLogging.h"
+#include "VariantMapToScriptValue.h"
+
+static const quint32 CACHE_FILE_MAGIC = 0x48464543; // "HFEC"
+static const QString CACHE_FILE_EXTENSION = ".entities";
+
+// the domain entities which came from the entity server
+static QVector<EntityItemPointer> getCachedEntities(const EntityTreePointer& tree) {
+    QVector<EntityItemPointer> entities;
+    tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+        std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](EntityItemPointer entity) {
+            if (entity->isDomainEntity() && entity->getLastEditedFromRemoteInRemoteTime() > 0) {
+                entities.push_back(entity);
+            }
+        });
+        return true;
+    });
+    return entities;
+}
+
+int ClientEntityCache::save(const QUuid& domainID, const EntityTreePointer& tree) const {
+    if (domainID.isNull() || !tree) {
+        return 0;
+    }
+
+    QDir().mkpath(_directory);
+    QSaveFile file(getFilePath(domainID));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(entities) << "Could not open the entity cache" << file.fileName() << "for writing";
+        return 0;
+    }
+
+    QDataStream stream(&file);
+    QScriptEngine scriptEngine;
+    int numEntities = 0;
+    tree->withReadLock([&] {
+        QVector<EntityItemPointer> entities = getCachedEntities(tree);
+        numEntities = entities.size();
+
+        // the cache is only valid for the protocol version it was received with
+        stream << CACHE_FILE_MAGIC << (quint32)versionForPacketType(PacketType::EntityData) << (quint32)numEntities;
+        for (const auto& entity : entities) {
+            QVariantMap properties =
+                EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, entity->getProperties()).toVariant().toMap();
+            stream << entity->getID() << entity->getLastEditedFromRemoteInRemoteTime() << properties;
+        }
+    });
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(entities) << "Could not write the entity cache" << file.fileName();
+        return 0;
+    }
+    return numEntities;
+}
+
+int ClientEntityCache::load(const QUuid& domainID, const EntityTreePointer& tree) const {
+    if (domainID.isNull() || !tree) {
+        return 0;
+    }
+
+    QFile file(getFilePath(domainID));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 numEntities = 0;
+    stream >> magic >> version >> numEntities;
+    if (stream.status() != QDataStream::Ok || magic != CACHE_FILE_MAGIC ||
+        version != (quint32)versionForPacketType(PacketType::EntityData)) {
+        qCDebug(entities) << "Ignoring the out of date entity cache" << file.fileName();
+        return 0;
+    }
+
+    QScriptEngine scriptEngine;
+    int numAdded = 0;
+    tree->withWriteLock([&] {
+        for (quint32 i = 0; i < numEntities; i++) {
+            QUuid entityID;
+            quint64 lastEditedFromRemote = 0;
+            QVariantMap propertiesMap;
+            stream >> entityID >> lastEditedFromRemote >> propertiesMap;
+            if (stream.status() != QDataStream::Ok) {
+                qCWarning(entities) << "The entity cache" << file.fileName() << "is truncated";
+                break;
+            }
+
+            EntityItemProperties properties;
+            EntityItemPropertiesFromScriptValueIgnoreReadOnly(variantMapToScriptValue(propertiesMap, scriptEngine), properties);
+            if (tree->addCachedEntity(entityID, properties, lastEditedFromRemote)) {
+                numAdded++;
+            }
+        }
+    });
+    return numAdded;
+}
+
+QHash<QUuid, quint64> ClientEntityCache::getManifest(const EntityTreePointer& tree) {
+    QHash<QUuid, quint64> manifest;
+    if (tree) {
+        tree->withReadLock([&] {
+            for (const auto& entity : getCachedEntities(tree)) {
+                manifest.insert(entity->getID(), entity->getLastEditedFromRemoteInRemoteTime());
+            }
+        });
+    }
+    return manifest;
+}
+
+QByteArray ClientEntityCache::writeManifest(const QHash<QUuid, quint64>& manifest) {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << manifest;
+    return data;
+}
+
+bool ClientEntityCache::readManifest(const QByteArray& data, QHash<QUuid, quint64>& manifest) {
+    QDataStream stream(data);
+    stream >> manifest;
+    if (stream.status() != QDataStream::Ok) {
+        manifest.clear();
+        return false;
+    }
+    return true;
+}
+
+QString ClientEntityCache::getFilePath(const QUuid& domainID) const {
+    return QDir(_directory).absoluteFilePath(uuidStringWithoutCurlyBraces(domainID) + CACHE_FILE_EXTENSION);
+}
@@ -0,0 +1,48 @@
+//
+//  ClientEntityCache.h
+//  libraries/entities/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ClientEntityCache_h
+#define hifi_ClientEntityCache_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+#include "EntityTree.h"
+
+// Keeps the domain entities a client received on disk, so that reconnecting to a domain only downloads what changed.
+//   Each domain has its own file, holding the properties of its entities and the time each was last edited in the
+//   time frame of the entity server.  After loading it the client sends these times, the manifest, to the entity
+//   server in an EntityQueryCache packet, which skips the entities that are still current and erases those that are gone.
+class ClientEntityCache {
+public:
+    ClientEntityCache(const QString& directory) : _directory(directory) {}
+
+    // writes the domain entities of tree received from the entity server as the cache of domainID,
+    // returns the number of entities written
+    int save(const QUuid& domainID, const EntityTreePointer& tree) const;
+
+    // adds the cached entities of domainID which tree doesn't have, returns the number of entities added
+    int load(const QUuid& domainID, const EntityTreePointer& tree) const;
+
+    // the server edit times of the domain entities in tree, by entity ID
+    static QHash<QUuid, quint64> getManifest(const EntityTreePointer& tree);
+
+    static QByteArray writeManifest(const QHash<QUuid, quint64>& manifest);
+    static bool readManifest(const QByteArray& data, QHash<QUuid, quint64>& manifest);
+
+private:
+    QString getFilePath(const QUuid& domainID) const;
+
+    QString _directory;
+};
+
+#endif // hifi_ClientEntityCache_h
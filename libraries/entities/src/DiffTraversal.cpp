@@ -64,8 +64,9 @@ void DiffTraversal::Waypoint::getNextVisibleElementRepeat(
             while (_nextIndex < NUMBER_OF_CHILDREN) {
                 EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
                 ++_nextIndex;
+                // skip the subtrees whose content didn't change since the last traversal
                 if (nextElement &&
-                    nextElement->getLastChanged() > lastTime &&
+                    nextElement->getSubtreeLastChanged() > lastTime &&
                     view.shouldTraverseElement(*nextElement)) {
 
                     next.element = nextElement;
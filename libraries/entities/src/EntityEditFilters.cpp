@@ -11,13 +11,39 @@
 
 #include "EntityEditFilters.h"
 
+#include <QThread>
 #include <QUrl>
 
 #include <ResourceManager.h>
 
-QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
-    QList<EntityItemID> zones;
-    QList<EntityItemID> missingZones;
+#include "ZoneEntityItem.h"
+
+static const int MAX_FILTER_ENGINES = 4;
+
+void EntityEditFilters::FilterEngines::add(std::unique_ptr<Engine> engine) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _freeEngines.push_back(engine.get());
+    _engines.push_back(std::move(engine));
+}
+
+EntityEditFilters::FilterEngines::Engine* EntityEditFilters::FilterEngines::acquire() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _engineReleased.wait(lock, [this] { return !_freeEngines.empty(); });
+    Engine* engine = _freeEngines.back();
+    _freeEngines.pop_back();
+    return engine;
+}
+
+void EntityEditFilters::FilterEngines::release(Engine* engine) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _freeEngines.push_back(engine);
+    }
+    _engineReleased.notify_one();
+}
+
+std::vector<EntityEditFilters::Zone> EntityEditFilters::getZones() {
+    std::vector<Zone> zones;
     _lock.lockForRead();
     auto zoneIDs = _filterDataMap.keys();
     _lock.unlock();
@@ -29,13 +55,13 @@ QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
             if (!zone) {
                 // TODO: maybe remove later?
                 removeFilter(id);
-            } else if (zone->contains(position)) {
-                zones.append(id);
+            } else {
+                zones.push_back({ id, zone });
             }
         } else {
             // the null id is the global filter we put in the domain server's 
             // advanced entity server settings
-            zones.append(id);
+            zones.push_back({ id, EntityItemPointer() });
         }
     }
     return zones;
@@ -43,132 +69,224 @@ QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
 
 bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut,
         bool& wasChanged, EntityTree::FilterType filterType, EntityItemID& itemID, EntityItemPointer& existingEntity) {
-    
-    // get the ids of all the zones (plus the global entity edit filter) that the position
-    // lies within
-    auto zoneIDs = getZonesByPosition(position);
-    for (auto id : zoneIDs) {
-        if (!itemID.isInvalidID() && id == itemID) {
-            continue;
-        }
-        
+    std::vector<FilterRequest> requests(1);
+    auto& request = requests.front();
+    request.position = position;
+    request.properties = &propertiesIn;
+    request.filterType = filterType;
+    request.entityID = itemID;
+    request.existingEntity = existingEntity;
+    filterBatch(requests);
+
+    if (&propertiesOut != &propertiesIn) {
+        propertiesOut = propertiesIn;
+    }
+    wasChanged = request.wasChanged;
+    return request.accepted;
+}
+
+void EntityEditFilters::filterBatch(std::vector<FilterRequest>& requests) {
+    // get the ids of all the zones (plus the global entity edit filter), once for the batch
+    auto zones = getZones();
+    std::vector<FilterRequest*> zoneRequests;
+    zoneRequests.reserve(requests.size());
+    for (const auto& zone : zones) {
         // get the filter pair, etc...  
         _lock.lockForRead();
-        FilterData filterData = _filterDataMap.value(id);
+        FilterData filterData = _filterDataMap.value(zone.id);
         _lock.unlock();
-    
-        if (filterData.valid()) {
-            if (filterData.rejectAll) {
-                return false;
-            }
 
-            // check to see if this filter wants to filter this message type
-            if ((!filterData.wantsToFilterEdit && filterType == EntityTree::FilterType::Edit) ||
-                (!filterData.wantsToFilterPhysics && filterType == EntityTree::FilterType::Physics) ||
-                (!filterData.wantsToFilterDelete && filterType == EntityTree::FilterType::Delete) ||
-                (!filterData.wantsToFilterAdd && filterType == EntityTree::FilterType::Add)) {
+        if (!filterData.valid()) {
+            continue;
+        }
 
-                wasChanged = false;
-                return true; // accept the message
+        // the edits the position of which lies within the zone
+        zoneRequests.clear();
+        for (auto& request : requests) {
+            if (request.done || (!request.entityID.isInvalidID() && zone.id == request.entityID) ||
+                (zone.entity && !zone.entity->contains(request.position))) {
+                continue;
             }
 
-            auto oldProperties = propertiesIn.getDesiredProperties();
-            auto specifiedProperties = propertiesIn.getChangedProperties();
-            propertiesIn.setDesiredProperties(specifiedProperties);
-            QScriptValue inputValues = propertiesIn.copyToScriptValue(filterData.engine, false, true, true);
-            propertiesIn.setDesiredProperties(oldProperties);
-
-            auto in = QJsonValue::fromVariant(inputValues.toVariant()); // grab json copy now, because the inputValues might be side effected by the filter.
+            if (filterData.rejectAll) {
+                request.accepted = false;
+                request.done = true;
+            } else if (!wantsToFilter(filterData, request)) {
+                // the filter doesn't want this message type, accept the message
+                request.wasChanged = false;
+                request.done = true;
+            } else {
+                zoneRequests.push_back(&request);
+            }
+        }
 
-            QScriptValueList args;
-            args << inputValues;
-            args << filterType;
+        if (!zoneRequests.empty()) {
+            filterRequests(zone.id, zone.entity, filterData, zoneRequests);
+        }
+    }
+}
 
-            // get the current properties for then entity and include them for the filter call
-            if (existingEntity && filterData.wantsOriginalProperties) {
-                auto currentProperties = existingEntity->getProperties(filterData.includedOriginalProperties);
-                QScriptValue currentValues = currentProperties.copyToScriptValue(filterData.engine, false, true, true);
-                args << currentValues;
-            }
+bool EntityEditFilters::wantsToFilter(const FilterData& filterData, const FilterRequest& request) const {
+    // check to see if this filter wants to filter this message type
+    auto filterType = request.filterType;
+    if ((!filterData.wantsToFilterEdit && filterType == EntityTree::FilterType::Edit) ||
+        (!filterData.wantsToFilterPhysics && filterType == EntityTree::FilterType::Physics) ||
+        (!filterData.wantsToFilterDelete && filterType == EntityTree::FilterType::Delete) ||
+        (!filterData.wantsToFilterAdd && filterType == EntityTree::FilterType::Add)) {
+        return false;
+    }
+    return true;
+}
 
+// true when the request changes one of the properties the filter declared it wants, the other edits skip the script.
+// Adds and deletes always go through it, a filter can reject them whatever their properties.
+static bool changesWantedProperties(const EntityEditFilters::FilterData& filterData,
+                                    const EntityEditFilters::FilterRequest& request) {
+    if (!filterData.declaresWantedProperties ||
+        (request.filterType != EntityTree::FilterType::Edit && request.filterType != EntityTree::FilterType::Physics)) {
+        return true;
+    }
+    const auto& wantedProperties = filterData.wantedProperties;
+    auto changedProperties = request.properties->getChangedProperties();
+    for (int flag = (int)wantedProperties.firstFlag(); flag <= (int)wantedProperties.lastFlag(); flag++) {
+        if (wantedProperties.getHasProperty((EntityPropertyList)flag) &&
+            changedProperties.getHasProperty((EntityPropertyList)flag)) {
+            return true;
+        }
+    }
+    return false;
+}
 
-            // get the zone properties
-            if (filterData.wantsZoneProperties) {
-                auto zoneEntity = _tree->findEntityByEntityItemID(id);
-                if (zoneEntity) {
-                    auto zoneProperties = zoneEntity->getProperties(filterData.includedZoneProperties);
-                    QScriptValue zoneValues = zoneProperties.copyToScriptValue(filterData.engine, false, true, true);
-
-                    if (filterData.wantsZoneBoundingBox) {
-                        bool success = true;
-                        AABox aaBox = zoneEntity->getAABox(success);
-                        if (success) {
-                            QScriptValue boundingBox = filterData.engine->newObject();
-                            QScriptValue bottomRightNear = vec3ToScriptValue(filterData.engine, aaBox.getCorner());
-                            QScriptValue topFarLeft = vec3ToScriptValue(filterData.engine, aaBox.calcTopFarLeft());
-                            QScriptValue center = vec3ToScriptValue(filterData.engine, aaBox.calcCenter());
-                            QScriptValue boundingBoxDimensions = vec3ToScriptValue(filterData.engine, aaBox.getDimensions());
-                            boundingBox.setProperty("brn", bottomRightNear);
-                            boundingBox.setProperty("tfl", topFarLeft);
-                            boundingBox.setProperty("center", center);
-                            boundingBox.setProperty("dimensions", boundingBoxDimensions);
-                            zoneValues.setProperty("boundingBox", boundingBox);
-                        }
-                    }
+void EntityEditFilters::filterRequests(const EntityItemID& zoneID, const EntityItemPointer& zone,
+                                       const FilterData& filterData, const std::vector<FilterRequest*>& requests) {
+    std::vector<FilterRequest*> filteredRequests;
+    filteredRequests.reserve(requests.size());
+    for (auto request : requests) {
+        if (changesWantedProperties(filterData, *request)) {
+            filteredRequests.push_back(request);
+        }
+    }
+    if (filteredRequests.empty()) {
+        return;
+    }
 
-                    // If this is an add or delete, or original properties weren't requested
-                    // there won't be original properties in the args, but zone properties need
-                    // to be the fourth parameter, so we need to pad the args accordingly
-                    int EXPECTED_ARGS = 3;
-                    if (args.length() < EXPECTED_ARGS) {
-                        args << QScriptValue();
-                    }
-                    assert(args.length() == EXPECTED_ARGS); // we MUST have 3 args by now!
-                    args << zoneValues;
+    FilterEngines::Lease engine(*filterData.engines);
+    QScriptEngine* scriptEngine = engine->engine.get();
+
+    // get the zone properties, once for all the edits
+    QScriptValue zoneValues;
+    if (filterData.wantsZoneProperties) {
+        auto zoneEntity = zone ? zone : _tree->findEntityByEntityItemID(zoneID);
+        if (zoneEntity) {
+            auto zoneProperties = zoneEntity->getProperties(filterData.includedZoneProperties);
+            zoneValues = zoneProperties.copyToScriptValue(scriptEngine, false, true, true);
+
+            if (filterData.wantsZoneBoundingBox) {
+                bool success = true;
+                AABox aaBox = zoneEntity->getAABox(success);
+                if (success) {
+                    QScriptValue boundingBox = scriptEngine->newObject();
+                    QScriptValue bottomRightNear = vec3ToScriptValue(scriptEngine, aaBox.getCorner());
+                    QScriptValue topFarLeft = vec3ToScriptValue(scriptEngine, aaBox.calcTopFarLeft());
+                    QScriptValue center = vec3ToScriptValue(scriptEngine, aaBox.calcCenter());
+                    QScriptValue boundingBoxDimensions = vec3ToScriptValue(scriptEngine, aaBox.getDimensions());
+                    boundingBox.setProperty("brn", bottomRightNear);
+                    boundingBox.setProperty("tfl", topFarLeft);
+                    boundingBox.setProperty("center", center);
+                    boundingBox.setProperty("dimensions", boundingBoxDimensions);
+                    zoneValues.setProperty("boundingBox", boundingBox);
                 }
             }
+        }
+    }
 
-            QScriptValue result = filterData.filterFn.call(_nullObjectForFilter, args);
+    std::vector<QScriptValueList> argsList;
+    std::vector<QJsonValue> inputs;
+    argsList.reserve(filteredRequests.size());
+    inputs.reserve(filteredRequests.size());
+    for (auto request : filteredRequests) {
+        auto& propertiesIn = *request->properties;
+        auto oldProperties = propertiesIn.getDesiredProperties();
+        auto specifiedProperties = propertiesIn.getChangedProperties();
+        propertiesIn.setDesiredProperties(specifiedProperties);
+        QScriptValue inputValues = propertiesIn.copyToScriptValue(scriptEngine, false, true, true);
+        propertiesIn.setDesiredProperties(oldProperties);
+
+        inputs.push_back(QJsonValue::fromVariant(inputValues.toVariant())); // grab json copy now, because the inputValues might be side effected by the filter.
+
+        QScriptValueList args;
+        args << inputValues;
+        args << request->filterType;
+
+        // get the current properties for then entity and include them for the filter call
+        if (request->existingEntity && filterData.wantsOriginalProperties) {
+            auto currentProperties = request->existingEntity->getProperties(filterData.includedOriginalProperties);
+            QScriptValue currentValues = currentProperties.copyToScriptValue(scriptEngine, false, true, true);
+            args << currentValues;
+        }
 
-            if (filterData.uncaughtExceptions()) {
-                return false;
+        if (zoneValues.isValid()) {
+            // If this is an add or delete, or original properties weren't requested
+            // there won't be original properties in the args, but zone properties need
+            // to be the fourth parameter, so we need to pad the args accordingly
+            int EXPECTED_ARGS = 3;
+            if (args.length() < EXPECTED_ARGS) {
+                args << QScriptValue();
             }
+            assert(args.length() == EXPECTED_ARGS); // we MUST have 3 args by now!
+            args << zoneValues;
+        }
+        argsList.push_back(args);
+    }
 
-            if (result.isObject()) {
-                // make propertiesIn reflect the changes, for next filter...
-                propertiesIn.copyFromScriptValue(result, false);
-
-                // and update propertiesOut too.  TODO: this could be more efficient...
-                propertiesOut.copyFromScriptValue(result, false);
-                // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
-                auto out = QJsonValue::fromVariant(result.toVariant());
-                wasChanged |= (in != out);
-            } else if (result.isBool()) {
-
-                // if the filter returned false, then it's authoritative
-                if (!result.toBool()) {
-                    return false;
-                }
+    if (engine->filterBatchFn.isFunction()) {
+        QScriptValue edits = scriptEngine->newArray((uint)argsList.size());
+        for (size_t i = 0; i < argsList.size(); i++) {
+            const auto& args = argsList[i];
+            QScriptValue editArgs = scriptEngine->newArray((uint)args.size());
+            for (int j = 0; j < args.size(); j++) {
+                editArgs.setProperty((quint32)j, args[j]);
+            }
+            edits.setProperty((quint32)i, editArgs);
+        }
 
-                // otherwise, assume it wants to pass all properties
-                propertiesOut = propertiesIn;
-                wasChanged = false;
-                
-            } else {
-                return false;
+        QScriptValue results = engine->filterBatchFn.call(_nullObjectForFilter, QScriptValueList() << edits);
+        bool failed = engine->uncaughtExceptions() || !results.isArray();
+        for (size_t i = 0; i < filteredRequests.size(); i++) {
+            QScriptValue result = failed ? QScriptValue() : results.property((quint32)i);
+            applyResult(result, inputs[i], *filteredRequests[i]);
+        }
+    } else {
+        for (size_t i = 0; i < filteredRequests.size(); i++) {
+            QScriptValue result = engine->filterFn.call(_nullObjectForFilter, argsList[i]);
+            if (engine->uncaughtExceptions()) {
+                result = QScriptValue();
             }
+            applyResult(result, inputs[i], *filteredRequests[i]);
         }
     }
-    // if we made it here, 
-    return true;
+}
+
+void EntityEditFilters::applyResult(const QScriptValue& result, const QJsonValue& in, FilterRequest& request) const {
+    if (result.isObject()) {
+        // make the properties reflect the changes, for next filter...
+        request.properties->copyFromScriptValue(result, false);
+        // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
+        auto out = QJsonValue::fromVariant(result.toVariant());
+        request.wasChanged |= (in != out);
+    } else if (result.isBool() && result.toBool()) {
+        // the filter returned true, assume it wants to pass all properties
+        request.wasChanged = false;
+    } else {
+        // if the filter returned false, then it's authoritative, and so are its failures
+        request.accepted = false;
+        request.done = true;
+    }
 }
 
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
+    // the engines are deleted along the last filter call using them
     QWriteLocker writeLock(&_lock);
-    FilterData filterData = _filterDataMap.value(entityID);
-    if (filterData.valid()) {
-        delete filterData.engine;
-    }
     _filterDataMap.remove(entityID);
 }
 
@@ -247,6 +365,39 @@ static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName
     return false;
 }
 
+bool EntityEditFilters::FilterEngines::Engine::uncaughtExceptions() {
+    return hadUncaughtExceptions(*engine, fileName);
+}
+
+// the pool of engines which evaluated the script, null when the script failed
+static std::shared_ptr<EntityEditFilters::FilterEngines> createFilterEngines(const QString& scriptContents,
+                                                                             const QString& urlString) {
+    auto engines = std::make_shared<EntityEditFilters::FilterEngines>();
+    int numEngines = glm::clamp(QThread::idealThreadCount(), 1, MAX_FILTER_ENGINES);
+    for (int i = 0; i < numEngines; i++) {
+        std::unique_ptr<EntityEditFilters::FilterEngines::Engine> filterEngine(new EntityEditFilters::FilterEngines::Engine());
+        filterEngine->engine.reset(new QScriptEngine());
+        filterEngine->fileName = urlString;
+        QScriptEngine* engine = filterEngine->engine.get();
+        engine->evaluate(scriptContents);
+        if (hadUncaughtExceptions(*engine, urlString)) {
+            return nullptr;
+        }
+
+        auto global = engine->globalObject();
+        auto entitiesObject = engine->newObject();
+        entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
+        entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
+        entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
+        entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
+        global.setProperty("Entities", entitiesObject);
+        filterEngine->filterFn = global.property("filter");
+        filterEngine->filterBatchFn = global.property("filterBatch");
+        engines->add(std::move(filterEngine));
+    }
+    return engines;
+}
+
 void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
     qDebug() << "script request completed for entity " << entityID;
     auto scriptRequest = qobject_cast<ResourceRequest*>(sender());
@@ -254,132 +405,135 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
         const QString urlString = scriptRequest->getUrl().toString();
         auto scriptContents = scriptRequest->getData();
         qInfo() << "Downloaded script:" << scriptContents;
-        QScriptProgram program(scriptContents, urlString);
-        if (hasCorrectSyntax(program)) {
-            // create a QScriptEngine for this script
-            QScriptEngine* engine = new QScriptEngine();
-            engine->evaluate(scriptContents);
-            if (!hadUncaughtExceptions(*engine, urlString)) {
-                // put the engine in the engine map (so we don't leak them, etc...)
-                FilterData filterData;
-                filterData.engine = engine;
-                filterData.rejectAll = false;
-                
-                // define the uncaughtException function
-                QScriptEngine& engineRef = *engine;
-                filterData.uncaughtExceptions = [&engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
-
-                // now get the filter function
-                auto global = engine->globalObject();
-                auto entitiesObject = engine->newObject();
-                entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
-                entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
-                entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
-                entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
-                global.setProperty("Entities", entitiesObject);
-                filterData.filterFn = global.property("filter");
-                if (!filterData.filterFn.isFunction()) {
-                    qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
-                    delete engine;
-                    filterData.rejectAll=true;
-                }
+        if (addFilterScript(entityID, scriptContents, urlString)) {
+            return;
+        }
+    } else if (scriptRequest) {
+        const QString urlString = scriptRequest->getUrl().toString();
+        qCritical() << "Failed to download script";
+        // See HTTPResourceRequest::onRequestFinished for interpretation of codes. For example, a 404 is code 6 and 403 is 3. A timeout is 2. Go figure.
+        qCritical() << "ResourceRequest error was" << scriptRequest->getResult();
+    } else {
+        qCritical() << "Failed to create script request.";
+    }
+    emit filterAdded(entityID, false);
+}
 
-                // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterAddValue = filterData.filterFn.property("wantsToFilterAdd");
-                filterData.wantsToFilterAdd = wantsToFilterAddValue.isBool() ? wantsToFilterAddValue.toBool() : true;
-
-                // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterEditValue = filterData.filterFn.property("wantsToFilterEdit");
-                filterData.wantsToFilterEdit = wantsToFilterEditValue.isBool() ? wantsToFilterEditValue.toBool() : true;
-
-                // if the wantsToFilterPhysics is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterPhysicsValue = filterData.filterFn.property("wantsToFilterPhysics");
-                filterData.wantsToFilterPhysics = wantsToFilterPhysicsValue.isBool() ? wantsToFilterPhysicsValue.toBool() : true;
-
-                // if the wantsToFilterDelete is a boolean evaluate as a boolean, otherwise assume false
-                QScriptValue wantsToFilterDeleteValue = filterData.filterFn.property("wantsToFilterDelete");
-                filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
-
-                // check to see if the filterFn has properties asking for Original props
-                QScriptValue wantsOriginalPropertiesValue = filterData.filterFn.property("wantsOriginalProperties");
-                // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
-                //   - boolean - true  - include all original properties
-                //               false - no properties at all
-                //   - string  - empty - no properties at all
-                //               any valid property - include just that property in the Original properties
-                //   - list of strings - include only those properties in the Original properties
-                if (wantsOriginalPropertiesValue.isBool()) {
-                    filterData.wantsOriginalProperties = wantsOriginalPropertiesValue.toBool();
-                } else if (wantsOriginalPropertiesValue.isString()) {
-                    auto stringValue = wantsOriginalPropertiesValue.toString();
-                    filterData.wantsOriginalProperties = !stringValue.isEmpty();
-                    if (filterData.wantsOriginalProperties) {
-                        EntityPropertyFlagsFromScriptValue(wantsOriginalPropertiesValue, filterData.includedOriginalProperties);
-                    }
-                } else if (wantsOriginalPropertiesValue.isArray()) {
+bool EntityEditFilters::addFilterScript(EntityItemID entityID, const QString& scriptContents, const QString& urlString) {
+    QScriptProgram program(scriptContents, urlString);
+    if (hasCorrectSyntax(program)) {
+        // create the pool of QScriptEngines for this script
+        auto engines = createFilterEngines(scriptContents, urlString);
+        if (engines) {
+            // put the engines in the engine map (so we don't leak them, etc...)
+            FilterData filterData;
+            filterData.rejectAll = false;
+
+            // now get the filter function
+            QScriptValue filterFn = engines->front().filterFn;
+            if (!filterFn.isFunction()) {
+                qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
+                filterData.rejectAll=true;
+            } else {
+                filterData.engines = engines;
+            }
+
+            // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
+            QScriptValue wantsToFilterAddValue = filterFn.property("wantsToFilterAdd");
+            filterData.wantsToFilterAdd = wantsToFilterAddValue.isBool() ? wantsToFilterAddValue.toBool() : true;
+
+            // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
+            QScriptValue wantsToFilterEditValue = filterFn.property("wantsToFilterEdit");
+            filterData.wantsToFilterEdit = wantsToFilterEditValue.isBool() ? wantsToFilterEditValue.toBool() : true;
+
+            // if the wantsToFilterPhysics is a boolean evaluate as a boolean, otherwise assume true
+            QScriptValue wantsToFilterPhysicsValue = filterFn.property("wantsToFilterPhysics");
+            filterData.wantsToFilterPhysics = wantsToFilterPhysicsValue.isBool() ? wantsToFilterPhysicsValue.toBool() : true;
+
+            // if the wantsToFilterDelete is a boolean evaluate as a boolean, otherwise assume false
+            QScriptValue wantsToFilterDeleteValue = filterFn.property("wantsToFilterDelete");
+            filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
+
+            // check to see if the filterFn has properties asking for Original props
+            QScriptValue wantsOriginalPropertiesValue = filterFn.property("wantsOriginalProperties");
+            // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
+            //   - boolean - true  - include all original properties
+            //               false - no properties at all
+            //   - string  - empty - no properties at all
+            //               any valid property - include just that property in the Original properties
+            //   - list of strings - include only those properties in the Original properties
+            if (wantsOriginalPropertiesValue.isBool()) {
+                filterData.wantsOriginalProperties = wantsOriginalPropertiesValue.toBool();
+            } else if (wantsOriginalPropertiesValue.isString()) {
+                auto stringValue = wantsOriginalPropertiesValue.toString();
+                filterData.wantsOriginalProperties = !stringValue.isEmpty();
+                if (filterData.wantsOriginalProperties) {
                     EntityPropertyFlagsFromScriptValue(wantsOriginalPropertiesValue, filterData.includedOriginalProperties);
-                    filterData.wantsOriginalProperties = !filterData.includedOriginalProperties.isEmpty();
                 }
+            } else if (wantsOriginalPropertiesValue.isArray()) {
+                EntityPropertyFlagsFromScriptValue(wantsOriginalPropertiesValue, filterData.includedOriginalProperties);
+                filterData.wantsOriginalProperties = !filterData.includedOriginalProperties.isEmpty();
+            }
 
-                // check to see if the filterFn has properties asking for Zone props
-                QScriptValue wantsZonePropertiesValue = filterData.filterFn.property("wantsZoneProperties");
-                // if the wantsZoneProperties is a boolean, or a string, or list of strings, then evaluate as follows:
-                //   - boolean - true  - include all Zone properties
-                //               false - no properties at all
-                //   - string  - empty - no properties at all
-                //               any valid property - include just that property in the Zone properties
-                //   - list of strings - include only those properties in the Zone properties
-                if (wantsZonePropertiesValue.isBool()) {
-                    filterData.wantsZoneProperties = wantsZonePropertiesValue.toBool();
-                    filterData.wantsZoneBoundingBox = filterData.wantsZoneProperties; // include this too
-                } else if (wantsZonePropertiesValue.isString()) {
-                    auto stringValue = wantsZonePropertiesValue.toString();
-                    filterData.wantsZoneProperties = !stringValue.isEmpty();
-                    if (filterData.wantsZoneProperties) {
+            // check to see if the filterFn has properties asking for Zone props
+            QScriptValue wantsZonePropertiesValue = filterFn.property("wantsZoneProperties");
+            // if the wantsZoneProperties is a boolean, or a string, or list of strings, then evaluate as follows:
+            //   - boolean - true  - include all Zone properties
+            //               false - no properties at all
+            //   - string  - empty - no properties at all
+            //               any valid property - include just that property in the Zone properties
+            //   - list of strings - include only those properties in the Zone properties
+            if (wantsZonePropertiesValue.isBool()) {
+                filterData.wantsZoneProperties = wantsZonePropertiesValue.toBool();
+                filterData.wantsZoneBoundingBox = filterData.wantsZoneProperties; // include this too
+            } else if (wantsZonePropertiesValue.isString()) {
+                auto stringValue = wantsZonePropertiesValue.toString();
+                filterData.wantsZoneProperties = !stringValue.isEmpty();
+                if (filterData.wantsZoneProperties) {
+                    if (stringValue == "boundingBox") {
+                        filterData.wantsZoneBoundingBox = true;
+                    } else {
+                        EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
+                    }
+                }
+            } else if (wantsZonePropertiesValue.isArray()) {
+                auto length = wantsZonePropertiesValue.property("length").toInteger();
+                for (int i = 0; i < length; i++) {
+                    auto stringValue = wantsZonePropertiesValue.property(i).toString();
+                    if (!stringValue.isEmpty()) {
+                        filterData.wantsZoneProperties = true;
+
+                        // boundingBox is a special case since it's not a true EntityPropertyFlag, so we
+                        // need to detect it here.
                         if (stringValue == "boundingBox") {
                             filterData.wantsZoneBoundingBox = true;
-                        } else {
-                            EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
+                            break; // we can break here, since there are no other special cases
                         }
-                    }
-                } else if (wantsZonePropertiesValue.isArray()) {
-                    auto length = wantsZonePropertiesValue.property("length").toInteger();
-                    for (int i = 0; i < length; i++) {
-                        auto stringValue = wantsZonePropertiesValue.property(i).toString();
-                        if (!stringValue.isEmpty()) {
-                            filterData.wantsZoneProperties = true;
-
-                            // boundingBox is a special case since it's not a true EntityPropertyFlag, so we
-                            // need to detect it here.
-                            if (stringValue == "boundingBox") {
-                                filterData.wantsZoneBoundingBox = true;
-                                break; // we can break here, since there are no other special cases
-                            }
 
-                        }
-                    }
-                    if (filterData.wantsZoneProperties) {
-                        EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
                     }
                 }
+                if (filterData.wantsZoneProperties) {
+                    EntityPropertyFlagsFromScriptValue(wantsZonePropertiesValue, filterData.includedZoneProperties);
+                }
+            }
 
-                _lock.lockForWrite();
-                _filterDataMap.insert(entityID, filterData);
-                _lock.unlock();
-
-                qDebug() << "script request filter processed for entity id " << entityID;
-                
-                emit filterAdded(entityID, true);
-                return;
+            // check to see if the filterFn declares the properties it looks at, as a string or list of strings,
+            // then the edits which change none of them skip the filter
+            QScriptValue wantsPropertiesValue = filterFn.property("wantsProperties");
+            if (wantsPropertiesValue.isString() || wantsPropertiesValue.isArray()) {
+                filterData.declaresWantedProperties = true;
+                EntityPropertyFlagsFromScriptValue(wantsPropertiesValue, filterData.wantedProperties);
             }
-        } 
-    } else if (scriptRequest) {
-        const QString urlString = scriptRequest->getUrl().toString();
-        qCritical() << "Failed to download script";
-        // See HTTPResourceRequest::onRequestFinished for interpretation of codes. For example, a 404 is code 6 and 403 is 3. A timeout is 2. Go figure.
-        qCritical() << "ResourceRequest error was" << scriptRequest->getResult();
-    } else {
-        qCritical() << "Failed to create script request.";
+
+            _lock.lockForWrite();
+            _filterDataMap.insert(entityID, filterData);
+            _lock.unlock();
+
+            qDebug() << "script request filter processed for entity id " << entityID;
+            
+            emit filterAdded(entityID, true);
+            return true;
+        }
     }
-    emit filterAdded(entityID, false);
+    return false;
 }
@@ -17,17 +17,30 @@
 #include <QScriptEngine>
 #include <glm/glm.hpp>
 
+#include <condition_variable>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
 #include "EntityTree.h"
 
+// The filter scripts may declare, as properties of their filter function:
+//   - wantsToFilterAdd, wantsToFilterEdit, wantsToFilterPhysics, wantsToFilterDelete
+//   - wantsOriginalProperties, wantsZoneProperties
+//   - wantsProperties - the properties the filter looks at, the edits which change none of them skip the filter
+// and may define a filterBatch(edits) function, called with an array of the argument lists of filter() and returning
+// an array of its results, in place of one filter() call per edit.
+// Each filter is loaded in a small pool of script engines, so edits are filtered concurrently. The script globals are
+// per engine, they are not shared between the calls of the filter.
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
+    class FilterEngines;
+
     struct FilterData {
-        QScriptValue filterFn;
         bool wantsOriginalProperties { false };
         bool wantsZoneProperties { false };
 
@@ -40,23 +53,45 @@ public:
         EntityPropertyFlags includedZoneProperties;
         bool wantsZoneBoundingBox { false };
 
-        std::function<bool()> uncaughtExceptions;
-        QScriptEngine* engine;
+        bool declaresWantedProperties { false };
+        EntityPropertyFlags wantedProperties;
+
+        std::shared_ptr<FilterEngines> engines;
         bool rejectAll;
-        
-        FilterData(): engine(nullptr), rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+
+        FilterData(): rejectAll(false) {};
+        bool valid() { return (rejectAll || engines != nullptr); }
+    };
+
+    // an edit filtered by filterBatch(), its properties are changed in place by the filters
+    struct FilterRequest {
+        glm::vec3 position;
+        EntityItemProperties* properties { nullptr };
+        EntityTree::FilterType filterType { EntityTree::FilterType::Edit };
+        EntityItemID entityID;
+        EntityItemPointer existingEntity;
+
+        bool accepted { true };
+        bool wasChanged { false };
+        bool done { false };
     };
 
     EntityEditFilters() {};
     EntityEditFilters(EntityTreePointer tree ): _tree(tree) {};
 
     void addFilter(EntityItemID entityID, QString filterURL);
+
+    // adds the filter of the zone from its script, as downloaded by addFilter(), returns false when it can't be used
+    bool addFilterScript(EntityItemID entityID, const QString& scriptContents, const QString& urlString);
     void removeFilter(EntityItemID entityID);
 
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, EntityItemPointer& existingEntity);
 
+    // Filters many edits at once, each filter runs on a single script engine for the whole batch, and converts the
+    // properties of its zone once
+    void filterBatch(std::vector<FilterRequest>& requests);
+
 signals:
     void filterAdded(EntityItemID id, bool success);
 
@@ -64,7 +99,16 @@ private slots:
     void scriptRequestFinished(EntityItemID entityID);
     
 private:
-    QList<EntityItemID> getZonesByPosition(glm::vec3& position);
+    struct Zone {
+        EntityItemID id;
+        EntityItemPointer entity; // null for the global filter
+    };
+    std::vector<Zone> getZones();
+
+    bool wantsToFilter(const FilterData& filterData, const FilterRequest& request) const;
+    void filterRequests(const EntityItemID& zoneID, const EntityItemPointer& zone, const FilterData& filterData,
+                        const std::vector<FilterRequest*>& requests);
+    void applyResult(const QScriptValue& result, const QJsonValue& in, FilterRequest& request) const;
 
     EntityTreePointer _tree {};
     bool _rejectAll {false};
@@ -74,4 +118,42 @@ private:
     QMap<EntityItemID, FilterData> _filterDataMap;
 };
 
+// The pre-warmed script engines of a filter, each evaluated the filter script once
+class EntityEditFilters::FilterEngines {
+public:
+    struct Engine {
+        std::unique_ptr<QScriptEngine> engine;
+        QScriptValue filterFn;
+        QScriptValue filterBatchFn;
+        QString fileName;
+
+        bool uncaughtExceptions();
+    };
+
+    // a pooled engine, returned to the pool when released
+    class Lease {
+    public:
+        Lease(FilterEngines& engines) : _engines(engines), _engine(engines.acquire()) {}
+        ~Lease() { _engines.release(_engine); }
+        Engine& operator*() { return *_engine; }
+        Engine* operator->() { return _engine; }
+    private:
+        FilterEngines& _engines;
+        Engine* _engine;
+    };
+
+    void add(std::unique_ptr<Engine> engine);
+    Engine& front() { return *_engines.front(); }
+    int size() const { return (int)_engines.size(); }
+
+private:
+    Engine* acquire();
+    void release(Engine* engine);
+
+    std::vector<std::unique_ptr<Engine>> _engines;
+    std::vector<Engine*> _freeEngines;
+    std::mutex _mutex;
+    std::condition_variable _engineReleased;
+};
+
 #endif //hifi_EntityEditFilters_h
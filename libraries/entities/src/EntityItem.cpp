@@ -31,6 +31,7 @@
 #include <SharedUtil.h> // usecTimestampNow()
 #include <LogHandler.h>
 #include <Extents.h>
+#include <InternedStrings.h>
 
 #include "EntityScriptingInterface.h"
 #include "EntitiesLogging.h"
@@ -258,9 +259,9 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         APPEND_ENTITY_PROPERTY(PROP_RESTITUTION, getRestitution());
         APPEND_ENTITY_PROPERTY(PROP_FRICTION, getFriction());
         APPEND_ENTITY_PROPERTY(PROP_LIFETIME, getLifetime());
-        APPEND_ENTITY_PROPERTY(PROP_SCRIPT, getScript());
+        APPEND_ENTITY_SHARED_STRING_PROPERTY(PROP_SCRIPT, getScript());
         APPEND_ENTITY_PROPERTY(PROP_SCRIPT_TIMESTAMP, getScriptTimestamp());
-        APPEND_ENTITY_PROPERTY(PROP_SERVER_SCRIPTS, getServerScripts());
+        APPEND_ENTITY_SHARED_STRING_PROPERTY(PROP_SERVER_SCRIPTS, getServerScripts());
         APPEND_ENTITY_PROPERTY(PROP_REGISTRATION_POINT, getRegistrationPoint());
         APPEND_ENTITY_PROPERTY(PROP_ANGULAR_DAMPING, getAngularDamping());
         APPEND_ENTITY_PROPERTY(PROP_VISIBLE, getVisible());
@@ -833,7 +834,7 @@ int EntityItem::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
     READ_ENTITY_PROPERTY(PROP_RESTITUTION, float, setRestitution);
     READ_ENTITY_PROPERTY(PROP_FRICTION, float, setFriction);
     READ_ENTITY_PROPERTY(PROP_LIFETIME, float, setLifetime);
-    READ_ENTITY_PROPERTY(PROP_SCRIPT, QString, setScript);
+    READ_ENTITY_SHARED_STRING_PROPERTY(PROP_SCRIPT, setScript);
     READ_ENTITY_PROPERTY(PROP_SCRIPT_TIMESTAMP, quint64, setScriptTimestamp);
 
     {
@@ -845,7 +846,7 @@ int EntityItem::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
 
         bool overwriteLocalData = !ignoreServerPacket || (lastEditedFromBufferAdjusted > _serverScriptsChangedTimestamp);
 
-        READ_ENTITY_PROPERTY(PROP_SERVER_SCRIPTS, QString, setServerScripts);
+        READ_ENTITY_SHARED_STRING_PROPERTY(PROP_SERVER_SCRIPTS, setServerScripts);
     }
 
     READ_ENTITY_PROPERTY(PROP_REGISTRATION_POINT, glm::vec3, setRegistrationPoint);
@@ -1036,7 +1037,9 @@ void EntityItem::setHref(QString value) {
         return;
     }
     withWriteLock([&] {
-        _href = value;
+        if (getSparseProperties().href != value) {
+            editSparseProperties().href = value;
+        }
     });
 }
 
@@ -1044,7 +1047,7 @@ void EntityItem::setCollisionSoundURL(const QString& value) {
     bool modified = false;
     withWriteLock([&] {
         if (_collisionSoundURL != value) {
-            _collisionSoundURL = value;
+            _collisionSoundURL = InternedStrings::intern(value);
             modified = true;
         }
     });
@@ -2633,7 +2636,7 @@ void EntityItem::requiresRecalcBoxes() {
 QString EntityItem::getHref() const {
     QString result;
     withReadLock([&] {
-        result = _href;
+        result = getSparseProperties().href;
     });
     return result;
 }
@@ -2641,14 +2644,16 @@ QString EntityItem::getHref() const {
 QString EntityItem::getDescription() const {
     QString result;
     withReadLock([&] {
-        result = _description;
+        result = getSparseProperties().description;
     });
     return result;
 }
 
 void EntityItem::setDescription(const QString& value) {
     withWriteLock([&] {
-        _description = value;
+        if (getSparseProperties().description != value) {
+            editSparseProperties().description = value;
+        }
     });
 }
 
@@ -2739,7 +2744,7 @@ QString EntityItem::getScript() const {
 
 void EntityItem::setScript(const QString& value) {
     withWriteLock([&] {
-        _script = value;
+        _script = InternedStrings::intern(value);
     });
 }
 
@@ -2767,7 +2772,7 @@ QString EntityItem::getServerScripts() const {
 
 void EntityItem::setServerScripts(const QString& serverScripts) {
     withWriteLock([&] {
-        _serverScripts = serverScripts;
+        _serverScripts = InternedStrings::intern(serverScripts);
         _serverScriptsChangedTimestamp = usecTimestampNow();
     });
 }
@@ -2806,7 +2811,7 @@ QString EntityItem::getName() const {
 
 void EntityItem::setName(const QString& value) {
     withWriteLock([&] {
-        _name = value;
+        _name = InternedStrings::intern(value);
     });
 }
 
@@ -2955,12 +2960,21 @@ void EntityItem::setUserData(const QString& value) {
     });
 }
 
+const EntityItem::SparseProperties EntityItem::DEFAULT_SPARSE_PROPERTIES;
+
+EntityItem::SparseProperties& EntityItem::editSparseProperties() {
+    if (!_sparseProperties) {
+        _sparseProperties.reset(new SparseProperties());
+    }
+    return *_sparseProperties;
+}
+
 // Certifiable Properties
 #define DEFINE_PROPERTY_GETTER(type, accessor, var) \
 type EntityItem::get##accessor() const {            \
     type result;         \
     withReadLock([&] {   \
-        result = _##var; \
+        result = getSparseProperties().var; \
     });                  \
     return result;       \
 }
@@ -2968,7 +2982,9 @@ type EntityItem::get##accessor() const {            \
 #define DEFINE_PROPERTY_SETTER(type, accessor, var)   \
 void EntityItem::set##accessor(const type & value) { \
     withWriteLock([&] {                               \
-       _##var = value;                                \
+        if (getSparseProperties().var != value) {     \
+            editSparseProperties().var = value;       \
+        }                                             \
     });                                               \
 }
 #define DEFINE_PROPERTY_ACCESSOR(type, accessor, var) DEFINE_PROPERTY_GETTER(type, accessor, var) DEFINE_PROPERTY_SETTER(type, accessor, var)
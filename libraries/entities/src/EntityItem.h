@@ -169,6 +169,8 @@ public:
     bool stepKinematicMotion(float timeElapsed); // return 'true' if moving
 
     virtual bool needsToCallUpdate() const { return false; }
+    // 'true' if update() only touches this entity, so the simulation may call it from several threads at once
+    virtual bool canUpdateConcurrently() const { return false; }
 
     virtual void debugDump() const;
 
@@ -432,6 +434,10 @@ public:
     quint64 getLastEditedFromRemote() const { return _lastEditedFromRemote; }
     void updateLastEditedFromRemote() { _lastEditedFromRemote = usecTimestampNow(); }
 
+    // the last edited time of the last edit accepted from the server, in the server's time frame
+    quint64 getLastEditedFromRemoteInRemoteTime() const { return _lastEditedFromRemoteInRemoteTime; }
+    void setLastEditedFromRemoteInRemoteTime(quint64 lastEdited) { _lastEditedFromRemoteInRemoteTime = lastEdited; }
+
     void getTransformAndVelocityProperties(EntityItemProperties& properties) const;
 
     void flagForMotionStateChange() { _flags |= Simulation::DIRTY_MOTION_TYPE; }
@@ -632,21 +638,31 @@ protected:
     SimulationOwner _simulationOwner;
     bool _shouldHighlight { false };
     QString _name { ENTITY_ITEM_DEFAULT_NAME };
-    QString _href; //Hyperlink href
-    QString _description; //Hyperlink description
 
-    // Certifiable Properties
-    QString _itemName { ENTITY_ITEM_DEFAULT_ITEM_NAME };
-    QString _itemDescription { ENTITY_ITEM_DEFAULT_ITEM_DESCRIPTION };
-    QString _itemCategories { ENTITY_ITEM_DEFAULT_ITEM_CATEGORIES };
-    QString _itemArtist { ENTITY_ITEM_DEFAULT_ITEM_ARTIST };
-    QString _itemLicense { ENTITY_ITEM_DEFAULT_ITEM_LICENSE };
-    quint32 _limitedRun { ENTITY_ITEM_DEFAULT_LIMITED_RUN };
-    QString _certificateID { ENTITY_ITEM_DEFAULT_CERTIFICATE_ID };
-    quint32 _editionNumber { ENTITY_ITEM_DEFAULT_EDITION_NUMBER };
-    quint32 _entityInstanceNumber { ENTITY_ITEM_DEFAULT_ENTITY_INSTANCE_NUMBER };
-    QString _marketplaceID { ENTITY_ITEM_DEFAULT_MARKETPLACE_ID };
-    quint32 _staticCertificateVersion { ENTITY_ITEM_DEFAULT_STATIC_CERTIFICATE_VERSION };
+    // properties that most entities leave to their defaults, only allocated once one of them is changed
+    struct SparseProperties {
+        QString href; //Hyperlink href
+        QString description; //Hyperlink description
+
+        // Certifiable Properties
+        QString itemName { ENTITY_ITEM_DEFAULT_ITEM_NAME };
+        QString itemDescription { ENTITY_ITEM_DEFAULT_ITEM_DESCRIPTION };
+        QString itemCategories { ENTITY_ITEM_DEFAULT_ITEM_CATEGORIES };
+        QString itemArtist { ENTITY_ITEM_DEFAULT_ITEM_ARTIST };
+        QString itemLicense { ENTITY_ITEM_DEFAULT_ITEM_LICENSE };
+        quint32 limitedRun { ENTITY_ITEM_DEFAULT_LIMITED_RUN };
+        QString certificateID { ENTITY_ITEM_DEFAULT_CERTIFICATE_ID };
+        quint32 editionNumber { ENTITY_ITEM_DEFAULT_EDITION_NUMBER };
+        quint32 entityInstanceNumber { ENTITY_ITEM_DEFAULT_ENTITY_INSTANCE_NUMBER };
+        QString marketplaceID { ENTITY_ITEM_DEFAULT_MARKETPLACE_ID };
+        quint32 staticCertificateVersion { ENTITY_ITEM_DEFAULT_STATIC_CERTIFICATE_VERSION };
+    };
+    static const SparseProperties DEFAULT_SPARSE_PROPERTIES;
+    const SparseProperties& getSparseProperties() const {
+        return _sparseProperties ? *_sparseProperties : DEFAULT_SPARSE_PROPERTIES;
+    }
+    SparseProperties& editSparseProperties();
+    std::unique_ptr<SparseProperties> _sparseProperties;
 
 
     // NOTE: Damping is applied like this:  v *= pow(1 - damping, dt)
@@ -35,6 +35,24 @@
             propertiesDidntFit -= P;                                \
         }
 
+// strings that many entities repeat, like urls and scripts, are only sent once to each viewer
+#define APPEND_ENTITY_SHARED_STRING_PROPERTY(P,V) \
+        if (requestedProperties.getHasProperty(P)) {                \
+            LevelDetails propertyLevel = packetData->startLevel();  \
+            successPropertyFits = packetData->appendSharedString(V); \
+            if (successPropertyFits) {                              \
+                propertyFlags |= P;                                 \
+                propertiesDidntFit -= P;                            \
+                propertyCount++;                                    \
+                packetData->endLevel(propertyLevel);                \
+            } else {                                                \
+                packetData->discardLevel(propertyLevel);            \
+                appendState = OctreeElement::PARTIAL;               \
+            }                                                       \
+        } else {                                                    \
+            propertiesDidntFit -= P;                                \
+        }
+
 #define READ_ENTITY_PROPERTY(P,T,S)                                                \
         if (propertyFlags.getHasProperty(P)) {                                     \
             T fromBuffer;                                                          \
@@ -47,6 +65,22 @@
             somethingChanged = true;                                               \
         }
 
+// a shared string the viewer missed the definition of leaves the property unchanged, and has the entity resent
+#define READ_ENTITY_SHARED_STRING_PROPERTY(P,S)                                    \
+        if (propertyFlags.getHasProperty(P)) {                                     \
+            QString fromBuffer;                                                    \
+            bool found;                                                            \
+            int bytes = OctreePacketData::unpackSharedStringFromBytes(dataAt, fromBuffer, args.sharedStrings, found); \
+            dataAt += bytes;                                                       \
+            bytesRead += bytes;                                                    \
+            if (overwriteLocalData && found) {                                     \
+                S(fromBuffer);                                                     \
+            } else if (!found && args.sharedStrings) {                             \
+                args.sharedStrings->addUnresolvedEntity(getEntityItemID());        \
+            }                                                                      \
+            somethingChanged = true;                                               \
+        }
+
 #define SKIP_ENTITY_PROPERTY(P,T)                                                  \
         if (propertyFlags.getHasProperty(P)) {                                     \
             T fromBuffer;                                                          \
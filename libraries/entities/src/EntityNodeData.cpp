@@ -28,3 +28,38 @@ bool EntityNodeData::isEntityFlaggedAsExtra(const QUuid& entityID) const {
 
     return false;
 }
+
+void EntityNodeData::setClientCache(const QHash<QUuid, quint64>& clientCache) {
+    QMutexLocker locker(&_clientCacheLock);
+    _clientCache = clientCache;
+    _hasClientCacheManifest = true;
+}
+
+bool EntityNodeData::takeClientCache(QHash<QUuid, quint64>& clientCache) {
+    QMutexLocker locker(&_clientCacheLock);
+    if (!_hasClientCacheManifest) {
+        return false;
+    }
+    clientCache.swap(_clientCache);
+    _clientCache.clear();
+    _hasClientCacheManifest = false;
+    return true;
+}
+
+void EntityNodeData::addResendRequest(const QVector<quint32>& stringIDs, const QVector<QUuid>& entityIDs) {
+    QMutexLocker locker(&_resendRequestLock);
+    _resendStringIDs += stringIDs;
+    _resendEntityIDs += entityIDs;
+}
+
+bool EntityNodeData::takeResendRequest(QVector<quint32>& stringIDs, QVector<QUuid>& entityIDs) {
+    QMutexLocker locker(&_resendRequestLock);
+    if (_resendEntityIDs.isEmpty()) {
+        return false;
+    }
+    stringIDs.swap(_resendStringIDs);
+    entityIDs.swap(_resendEntityIDs);
+    _resendStringIDs.clear();
+    _resendEntityIDs.clear();
+    return true;
+}
@@ -12,6 +12,8 @@
 #ifndef hifi_EntityNodeData_h
 #define hifi_EntityNodeData_h
 
+#include <QtCore/QMutex>
+
 #include <udt/PacketHeaders.h>
 
 #include <OctreeQueryNode.h>
@@ -44,11 +46,36 @@ public:
     bool isEntityFlaggedAsExtra(const QUuid& entityID) const;
     void resetFlaggedExtraEntities() { _previousFlaggedExtraEntities = _flaggedExtraEntities; _flaggedExtraEntities.clear(); }
 
+    // the manifest of the client's entity cache, entity ID to last edited time, set from its EntityQueryCache packet
+    void setClientCache(const QHash<QUuid, quint64>& clientCache);
+    bool takeClientCache(QHash<QUuid, quint64>& clientCache);
+
+    // shared strings the client has no definition for, and the entities that referred to them, set from its
+    // EntityQueryResend packets
+    void addResendRequest(const QVector<quint32>& stringIDs, const QVector<QUuid>& entityIDs);
+    bool takeResendRequest(QVector<quint32>& stringIDs, QVector<QUuid>& entityIDs);
+
+    // the following stale cached entity methods can only be called from the OctreeSendThread for the given Node
+
+    // cached entities which are gone from the server, erased along with the recently deleted entities
+    void addStaleCachedEntities(const QVector<QUuid>& entityIDs) { _staleCachedEntities += entityIDs; }
+    bool hasStaleCachedEntities() const { return !_staleCachedEntities.isEmpty(); }
+    QVector<QUuid> takeStaleCachedEntities() { QVector<QUuid> entityIDs; entityIDs.swap(_staleCachedEntities); return entityIDs; }
+
 private:
     quint64 _lastDeletedEntitiesSentAt { usecTimestampNow() };
     QSet<QUuid> _sentFilteredEntities;
     QHash<QUuid, QSet<QUuid>> _flaggedExtraEntities;
     QHash<QUuid, QSet<QUuid>> _previousFlaggedExtraEntities;
+
+    QMutex _clientCacheLock;
+    QHash<QUuid, quint64> _clientCache;
+    bool _hasClientCacheManifest { false };
+    QVector<QUuid> _staleCachedEntities;
+
+    QMutex _resendRequestLock;
+    QVector<quint32> _resendStringIDs;
+    QVector<QUuid> _resendEntityIDs;
 };
 
 #endif // hifi_EntityNodeData_h
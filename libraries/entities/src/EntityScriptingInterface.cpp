@@ -11,6 +11,8 @@
 
 #include "EntityScriptingInterface.h"
 
+#include <limits>
+
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/transform.hpp>
 
@@ -780,6 +782,162 @@ QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScri
     return finalResult;
 }
 
+namespace {
+
+using PackedPropertyGetter = void (*)(const EntityItemPointer& entity, float* values);
+
+struct PackedEntityProperty {
+    const char* name;
+    int numValues;
+    PackedPropertyGetter getter;
+};
+
+void packVec3(const glm::vec3& v, float* values) {
+    values[0] = v.x;
+    values[1] = v.y;
+    values[2] = v.z;
+}
+
+void packQuat(const glm::quat& q, float* values) {
+    values[0] = q.x;
+    values[1] = q.y;
+    values[2] = q.z;
+    values[3] = q.w;
+}
+
+const PackedEntityProperty PACKED_ENTITY_PROPERTIES[] = {
+    { "position", 3, [](const EntityItemPointer& entity, float* values) { packVec3(entity->getWorldPosition(), values); } },
+    { "rotation", 4, [](const EntityItemPointer& entity, float* values) { packQuat(entity->getWorldOrientation(), values); } },
+    { "velocity", 3, [](const EntityItemPointer& entity, float* values) { packVec3(entity->getWorldVelocity(), values); } },
+    { "angularVelocity", 3, [](const EntityItemPointer& entity, float* values) {
+        packVec3(entity->getWorldAngularVelocity(), values);
+    } },
+    { "dimensions", 3, [](const EntityItemPointer& entity, float* values) { packVec3(entity->getScaledDimensions(), values); } },
+    { "registrationPoint", 3, [](const EntityItemPointer& entity, float* values) {
+        packVec3(entity->getRegistrationPoint(), values);
+    } },
+    { "localPosition", 3, [](const EntityItemPointer& entity, float* values) { packVec3(entity->getLocalPosition(), values); } },
+    { "localRotation", 4, [](const EntityItemPointer& entity, float* values) {
+        packQuat(entity->getLocalOrientation(), values);
+    } },
+    { "localVelocity", 3, [](const EntityItemPointer& entity, float* values) { packVec3(entity->getLocalVelocity(), values); } },
+    { "localAngularVelocity", 3, [](const EntityItemPointer& entity, float* values) {
+        packVec3(entity->getLocalAngularVelocity(), values);
+    } }
+};
+
+const PackedEntityProperty* findPackedEntityProperty(const QString& name) {
+    for (const auto& property : PACKED_ENTITY_PROPERTIES) {
+        if (name == property.name) {
+            return &property;
+        }
+    }
+    return nullptr;
+}
+
+}
+
+// Static method to make sure that we have the right script engine.
+// The values are packed into a QByteArray that the script engine wraps in an ArrayBuffer, so no per-entity script
+// values are made.
+QScriptValue EntityScriptingInterface::getPackedEntityProperties(QScriptContext* context, QScriptEngine* engine) {
+    const int ARGUMENT_ENTITY_IDS = 0;
+    const int ARGUMENT_PROPERTY_NAMES = 1;
+
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    const auto entityIDs = qScriptValueToValue<QVector<QUuid>>(context->argument(ARGUMENT_ENTITY_IDS));
+    QStringList propertyNames;
+    QScriptValue propertyNamesValue = context->argument(ARGUMENT_PROPERTY_NAMES);
+    if (propertyNamesValue.isString()) {
+        propertyNames.push_back(propertyNamesValue.toString());
+    } else {
+        propertyNames = qScriptValueToValue<QStringList>(propertyNamesValue);
+    }
+
+    QVector<int> offsets;
+    int stride = entityScriptingInterface->getPackedEntityPropertiesStride(propertyNames, offsets);
+    int numFloats = stride * entityIDs.size();
+
+    QByteArray bytes(numFloats * (int)sizeof(float), Qt::Uninitialized);
+    entityScriptingInterface->getPackedEntityPropertiesInternal(entityIDs, propertyNames, offsets,
+                                                                reinterpret_cast<float*>(bytes.data()), numFloats);
+
+    // the script engine converts a QByteArray to an ArrayBuffer, sharing its data, and provides the Float32Array class
+    QScriptValue arrayBuffer = engine->toScriptValue(bytes);
+    if (!arrayBuffer.isObject()) {
+        return context->throwError("Entities.getPackedEntityProperties: could not allocate result buffer");
+    }
+
+    QScriptValue offsetsValue = engine->newObject();
+    for (int i = 0; i < propertyNames.size(); i++) {
+        if (offsets[i] >= 0) {
+            offsetsValue.setProperty(propertyNames[i], offsets[i]);
+        }
+    }
+
+    QScriptValue result = engine->newObject();
+    result.setProperty("stride", stride);
+    result.setProperty("offsets", offsetsValue);
+    result.setProperty("data", engine->globalObject().property("Float32Array").construct(QScriptValueList() << arrayBuffer));
+    return result;
+}
+
+int EntityScriptingInterface::getPackedEntityPropertiesStride(const QStringList& propertyNames, QVector<int>& offsets) const {
+    int stride = 0;
+    offsets.resize(propertyNames.size());
+    for (int i = 0; i < propertyNames.size(); i++) {
+        auto property = findPackedEntityProperty(propertyNames[i]);
+        if (property) {
+            offsets[i] = stride;
+            stride += property->numValues;
+        } else {
+            offsets[i] = -1;
+        }
+    }
+    return stride;
+}
+
+int EntityScriptingInterface::getPackedEntityPropertiesInternal(const QVector<QUuid>& entityIDs, const QStringList& propertyNames,
+                                                                QVector<int>& offsets, float* data, int dataSize) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    int stride = getPackedEntityPropertiesStride(propertyNames, offsets);
+    if (stride == 0 || dataSize < stride * entityIDs.size()) {
+        return stride;
+    }
+
+    std::vector<const PackedEntityProperty*> properties;
+    std::vector<int> propertyOffsets;
+    for (int i = 0; i < propertyNames.size(); i++) {
+        if (offsets[i] >= 0) {
+            properties.push_back(findPackedEntityProperty(propertyNames[i]));
+            propertyOffsets.push_back(offsets[i]);
+        }
+    }
+
+    const float MISSING_VALUE = std::numeric_limits<float>::quiet_NaN();
+    if (!_entityTree) {
+        std::fill(data, data + stride * entityIDs.size(), MISSING_VALUE);
+        return stride;
+    }
+
+    _entityTree->withReadLock([&] {
+        float* entityData = data;
+        for (const auto& entityID : entityIDs) {
+            EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(entityID));
+            if (entity) {
+                for (size_t i = 0; i < properties.size(); i++) {
+                    properties[i]->getter(entity, entityData + propertyOffsets[i]);
+                }
+            } else {
+                std::fill(entityData, entityData + stride, MISSING_VALUE);
+            }
+            entityData += stride;
+        }
+    });
+    return stride;
+}
+
 QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties& scriptSideProperties) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
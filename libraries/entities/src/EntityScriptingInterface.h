@@ -164,6 +164,43 @@ public:
     */
     static QScriptValue getMultipleEntityProperties(QScriptContext* context, QScriptEngine* engine);
     QScriptValue getMultipleEntityPropertiesInternal(QScriptEngine* engine, QVector<QUuid> entityIDs, const QScriptValue& extendedDesiredProperties);
+
+    /**jsdoc
+    * Get a few numeric properties of many entities, packed into a single <code>Float32Array</code>. This is much cheaper
+    * than {@link Entities.getMultipleEntityProperties} for scripts that poll entities every frame.
+    * <p>The values for each entity are stored one after the other, <code>stride</code> floats per entity, in the same
+    * order as <code>entityIDs</code>. The values of entities that can't be found are <code>NaN</code>.</p>
+    * <p>Supported properties: <code>position</code>, <code>rotation</code>, <code>velocity</code>,
+    * <code>angularVelocity</code>, <code>dimensions</code>, <code>registrationPoint</code>, <code>localPosition</code>,
+    * <code>localRotation</code>, <code>localVelocity</code> and <code>localAngularVelocity</code>. Rotations are stored as
+    * <code>x, y, z, w</code>.</p>
+    * @function Entities.getPackedEntityProperties
+    * @param {Uuid[]} entityIDs - The IDs of the entities to get the properties of.
+    * @param {string[]} properties - The names of the properties to get.
+    * @returns {Entities.PackedEntityProperties} The packed property values.
+    * @example <caption>Report the positions of nearby entities.</caption>
+    * var entityIDs = Entities.findEntities(MyAvatar.position, 50);
+    * var packed = Entities.getPackedEntityProperties(entityIDs, ["position"]);
+    * for (var i = 0; i < entityIDs.length; i++) {
+    *     var offset = i * packed.stride + packed.offsets.position;
+    *     print(entityIDs[i] + ": " + packed.data[offset] + ", " + packed.data[offset + 1] + ", " + packed.data[offset + 2]);
+    * }
+    */
+    /**jsdoc
+    * @typedef {object} Entities.PackedEntityProperties
+    * @property {number} stride - The number of floats used by each entity.
+    * @property {object} offsets - The offset of each supported property requested, in floats from the start of an entity's
+    *     values.
+    * @property {Float32Array} data - The property values.
+    */
+    static QScriptValue getPackedEntityProperties(QScriptContext* context, QScriptEngine* engine);
+
+    // fills data with the values of the named properties for each entity, under a single read lock of the tree.
+    // offsets receives the position of each property within an entity's values, or -1 if it isn't supported.
+    // returns the number of floats used by each entity.
+    int getPackedEntityPropertiesInternal(const QVector<QUuid>& entityIDs, const QStringList& propertyNames,
+                                          QVector<int>& offsets, float* data, int dataSize);
+    int getPackedEntityPropertiesStride(const QStringList& propertyNames, QVector<int>& offsets) const;
 public slots:
 
     /**jsdoc
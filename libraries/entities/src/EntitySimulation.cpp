@@ -11,12 +11,47 @@
 
 #include "EntitySimulation.h"
 
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <AACube.h>
 #include <Profile.h>
 
 #include "EntitiesLogging.h"
 #include "MovingEntitiesOperator.h"
 
+namespace {
+
+// the entity passes are split in chunks of this many entities between the worker threads
+const size_t SIMULATION_CHUNK_SIZE = 64;
+
+using EntityRange = tbb::blocked_range<size_t>;
+
+// returns 'true' if the entity is still undergoing non-physical kinematic motion, after stepping it
+bool stepSimpleKinematic(const EntityItemPointer& entity, uint64_t now) {
+    // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
+    // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
+    bool ancestryIsKnown;
+    entity->getMaximumAACube(ancestryIsKnown);
+    bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
+
+    if (entity->isMovingRelativeToParent() && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
+        entity->simulate(now);
+        return true;
+    }
+    return false;
+}
+
+enum KinematicResult : uint8_t {
+    KINEMATIC_MOVED,
+    KINEMATIC_STOPPED,
+    KINEMATIC_DEFERRED // touches other entities, stepped on the simulation thread
+};
+
+}
+
 void EntitySimulation::setEntityTree(EntityTreePointer tree) {
     if (_entityTree && _entityTree != tree) {
         _mortalEntities.clear();
@@ -34,11 +69,34 @@ void EntitySimulation::updateEntities() {
     PerformanceTimer perfTimer("EntitySimulation::updateEntities");
 
     // these methods may accumulate entries in _entitiesToBeDeleted
+    uint64_t start = usecTimestampNow();
     expireMortalEntities(now);
+    uint64_t end = usecTimestampNow();
+    _expireTime.updateAverage((float)(end - start));
+
+    start = end;
     callUpdateOnEntitiesThatNeedIt(now);
+    end = usecTimestampNow();
+    _updateTime.updateAverage((float)(end - start));
+
+    start = end;
     moveSimpleKinematics(now);
+    end = usecTimestampNow();
+    _moveTime.updateAverage((float)(end - start));
+
+    start = end;
     updateEntitiesInternal(now);
+    end = usecTimestampNow();
+    _internalTime.updateAverage((float)(end - start));
+
+    start = end;
     sortEntitiesThatMoved();
+    end = usecTimestampNow();
+    _sortTime.updateAverage((float)(end - start));
+}
+
+bool EntitySimulation::canMoveConcurrently(const EntityItemPointer& entity) {
+    return entity->getParentID().isNull() && !entity->hasChildren();
 }
 
 void EntitySimulation::takeDeadEntities(SetOfEntities& entitiesToDelete) {
@@ -104,6 +162,7 @@ void EntitySimulation::expireMortalEntities(uint64_t now) {
 void EntitySimulation::callUpdateOnEntitiesThatNeedIt(uint64_t now) {
     PerformanceTimer perfTimer("updatingEntities");
     QMutexLocker lock(&_mutex);
+    std::vector<EntityItemPointer> concurrentUpdates;
     SetOfEntities::iterator itemItr = _entitiesToUpdate.begin();
     while (itemItr != _entitiesToUpdate.end()) {
         EntityItemPointer entity = *itemItr;
@@ -112,10 +171,20 @@ void EntitySimulation::callUpdateOnEntitiesThatNeedIt(uint64_t now) {
         if (!entity->needsToCallUpdate()) {
             itemItr = _entitiesToUpdate.erase(itemItr);
         } else {
-            entity->update(now);
+            if (entity->canUpdateConcurrently()) {
+                concurrentUpdates.push_back(entity);
+            } else {
+                entity->update(now);
+            }
             ++itemItr;
         }
     }
+
+    tbb::parallel_for(EntityRange(0, concurrentUpdates.size(), SIMULATION_CHUNK_SIZE), [&](const EntityRange& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            concurrentUpdates[i]->update(now);
+        }
+    });
 }
 
 // protected
@@ -235,23 +304,33 @@ void EntitySimulation::clearEntities() {
 
 void EntitySimulation::moveSimpleKinematics(uint64_t now) {
     PROFILE_RANGE_EX(simulation_physics, "MoveSimples", 0xffff00ff, (uint64_t)_simpleKinematicEntities.size());
-    SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
-    while (itemItr != _simpleKinematicEntities.end()) {
-        EntityItemPointer entity = *itemItr;
 
-        // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
-        // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
-        bool ancestryIsKnown;
-        entity->getMaximumAACube(ancestryIsKnown);
-        bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
+    // step the transforms in parallel, then sort out the results on this thread
+    std::vector<EntityItemPointer> entities(_simpleKinematicEntities.begin(), _simpleKinematicEntities.end());
+    std::vector<KinematicResult> results(entities.size());
+    tbb::parallel_for(EntityRange(0, entities.size(), SIMULATION_CHUNK_SIZE), [&](const EntityRange& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            const EntityItemPointer& entity = entities[i];
+            if (!canMoveConcurrently(entity)) {
+                results[i] = KINEMATIC_DEFERRED;
+            } else {
+                results[i] = stepSimpleKinematic(entity, now) ? KINEMATIC_MOVED : KINEMATIC_STOPPED;
+            }
+        }
+    });
 
-        if (entity->isMovingRelativeToParent() && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
-            entity->simulate(now);
+    for (size_t i = 0; i < entities.size(); ++i) {
+        const EntityItemPointer& entity = entities[i];
+        KinematicResult result = results[i];
+        if (result == KINEMATIC_DEFERRED) {
+            result = stepSimpleKinematic(entity, now) ? KINEMATIC_MOVED : KINEMATIC_STOPPED;
+        }
+
+        if (result == KINEMATIC_MOVED) {
             _entitiesToSort.insert(entity);
-            ++itemItr;
         } else {
             // the entity is no longer non-physical-kinematic
-            itemItr = _simpleKinematicEntities.erase(itemItr);
+            _simpleKinematicEntities.remove(entity);
         }
     }
 }
@@ -19,6 +19,7 @@
 #include <QVector>
 
 #include <PerfStat.h>
+#include <SimpleMovingAverage.h>
 
 #include "EntityDynamicInterface.h"
 #include "EntityItem.h"
@@ -82,6 +83,13 @@ public:
     /// \param entity pointer to EntityItem that needs to be put on the entitiesToDelete list and removed from others.
     virtual void prepareEntityForDelete(EntityItemPointer entity);
 
+    // average time spent in each pass of updateEntities(), in usecs per call
+    float getAverageExpireTime() const { return _expireTime.getAverage(); }
+    float getAverageUpdateTime() const { return _updateTime.getAverage(); }
+    float getAverageMoveTime() const { return _moveTime.getAverage(); }
+    float getAverageInternalTime() const { return _internalTime.getAverage(); }
+    float getAverageSortTime() const { return _sortTime.getAverage(); }
+
 protected:
     // These pure virtual methods are protected because they are not to be called will-nilly. The base class
     // calls them in the right places.
@@ -95,6 +103,10 @@ protected:
     void callUpdateOnEntitiesThatNeedIt(uint64_t now);
     virtual void sortEntitiesThatMoved();
 
+    // entities without parent nor children only change their own transform when they move,
+    // so these can be stepped by several threads at once
+    static bool canMoveConcurrently(const EntityItemPointer& entity);
+
     QMutex _mutex{ QMutex::Recursive };
 
     SetOfEntities _entitiesToSort; // entities moved by simulation (and might need resort in EntityTree)
@@ -120,6 +132,12 @@ private:
 
 
     SetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
+
+    SimpleMovingAverage _expireTime;
+    SimpleMovingAverage _updateTime;
+    SimpleMovingAverage _moveTime;
+    SimpleMovingAverage _internalTime;
+    SimpleMovingAverage _sortTime;
 };
 
 #endif // hifi_EntitySimulation_h
@@ -23,7 +23,15 @@
 
 #include <QtScript/QScriptEngine>
 
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <Extents.h>
+#include <InternedStrings.h>
 #include <PerfStat.h>
 #include <Profile.h>
 
@@ -41,6 +49,7 @@
 #include "EntityDynamicFactoryInterface.h"
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
+static const quint64 INTERNED_STRINGS_PURGE_PERIOD = USECS_PER_SECOND * 10;
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
 
 // combines the ray cast arguments into a single object
@@ -264,6 +273,18 @@ bool EntityTree::handlesEditPacketType(PacketType packetType) const {
 
 /// Adds a new entity item to the tree
 void EntityTree::postAddEntity(EntityItemPointer entity) {
+    if (!registerAddedEntity(entity)) {
+        return;
+    }
+
+    // find and hook up any entities with this entity as a (previously) missing parent
+    fixupNeedsParentFixups();
+
+    emit addingEntity(entity->getEntityItemID());
+    emit addingEntityPointer(entity.get());
+}
+
+bool EntityTree::registerAddedEntity(EntityItemPointer entity) {
     assert(entity);
 
     if (getIsServer()) {
@@ -286,7 +307,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
             qCDebug(entities) << "Certificate ID" << certID << "already exists on entity with ID"
                 << existingEntityItemID << ". Deleting existing entity.";
             deleteEntity(existingEntityItemID, true);
-            return;
+            return false;
         }
     }
 
@@ -300,12 +321,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
-
-    // find and hook up any entities with this entity as a (previously) missing parent
-    fixupNeedsParentFixups();
-
-    emit addingEntity(entity->getEntityItemID());
-    emit addingEntityPointer(entity.get());
+    return true;
 }
 
 bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode) {
@@ -584,6 +600,158 @@ EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const Enti
     return result;
 }
 
+EntityItemPointer EntityTree::addCachedEntity(const EntityItemID& entityID, const EntityItemProperties& properties,
+                                              quint64 lastEditedFromRemote) {
+    if (getContainingElement(entityID) || isDeletedEntity(entityID)) {
+        return nullptr;
+    }
+
+    EntityItemPointer entity = EntityTypes::constructEntityItem(properties.getType(), entityID, properties);
+    if (entity) {
+        // any edit from the server, even the one the cache was made from, overwrites the cached properties
+        entity->setLastEdited(0);
+        entity->setLastEditedFromRemoteInRemoteTime(lastEditedFromRemote);
+
+        AddEntityOperator theOperator(getThisPointer(), entity);
+        recurseTreeWithOperator(&theOperator);
+        if (!entity->getParentID().isNull()) {
+            addToNeedsParentFixupList(entity);
+        }
+        postAddEntity(entity);
+    }
+    return entity;
+}
+
+// the indices of the children leading from the root to the element AddEntityOperator would add entity to
+static QByteArray getEntityElementPath(const EntityItem& entity) {
+    bool success;
+    AABox bounds = entity.getQueryAACube(success).clamp((float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE);
+    glm::vec3 minPoint = bounds.getMinimumPoint();
+    glm::vec3 maxPoint = bounds.getMaximumPoint();
+
+    // the cubes of the elements are built up as OctreeElement::calculateAACube() does from their octal codes,
+    // so that they are exactly the same
+    QByteArray path;
+    glm::vec3 unitCorner(0.0f);
+    float unitScale = 0.5f;
+    AACube cube(glm::vec3((float)-HALF_TREE_SCALE), (float)TREE_SCALE);
+    while (!EntityTreeElement::cubeBestFitsBounds(cube, minPoint, maxPoint)) {
+        int childIndex = OctreeElement::getChildContainingPoint(cube, minPoint);
+        if (childIndex == OctreeElement::CHILD_UNKNOWN) {
+            break;
+        }
+        path.append((char)childIndex);
+        unitCorner += unitScale * glm::vec3((childIndex >> 2) & 1, (childIndex >> 1) & 1, childIndex & 1);
+        unitScale *= 0.5f;
+        cube.setBox(unitCorner * (float)TREE_SCALE - (float)HALF_TREE_SCALE, (float)TREE_SCALE / powf(2.0f, path.size()));
+    }
+    return path;
+}
+
+QVector<EntityItemPointer> EntityTree::addEntities(const QVector<EntityItemID>& entityIDs,
+                                                   const QVector<EntityItemProperties>& properties) {
+    assert(entityIDs.size() == properties.size());
+    int numEntities = entityIDs.size();
+    QVector<EntityItemPointer> addedEntities(numEntities);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (!nodeList) {
+        qCDebug(entities) << "EntityTree::addEntities -- can't get NodeList";
+        return addedEntities;
+    }
+    bool canRez = !getIsClient() || _serverlessDomain || nodeList->getThisNodeCanRez() || nodeList->getThisNodeCanRezTmp() ||
+        nodeList->getThisNodeCanRezCertified() || nodeList->getThisNodeCanRezTmpCertified();
+
+    // the entities are constructed in order, so that the first of two with the same ID is the one added
+    QSet<EntityItemID> addedIDs;
+    for (int i = 0; i < numEntities; i++) {
+        const EntityItemID& entityID = entityIDs[i];
+        const EntityItemProperties& props = properties[i];
+        if (props.getEntityHostType() == entity::HostType::DOMAIN && !canRez) {
+            continue;
+        }
+        if (addedIDs.contains(entityID) || getContainingElement(entityID)) {
+            qCWarning(entities) << "EntityTree::addEntities() on existing entity item with entityID=" << entityID;
+            continue;
+        }
+
+        EntityItemPointer entity = EntityTypes::constructEntityItem(props.getType(), entityID, props);
+        if (entity) {
+            if (props.getCreated() == UNKNOWN_CREATED_TIME) {
+                entity->recordCreationTime();
+            }
+            addedEntities[i] = entity;
+            addedIDs.insert(entityID);
+        }
+    }
+
+    // An entity's query cube only depends on the other entities through its parent, so the entities without one are
+    // placed concurrently.
+    QVector<QByteArray> paths(numEntities);
+    tbb::parallel_for(0, numEntities, [&](int i) {
+        if (addedEntities[i] && addedEntities[i]->getParentID().isNull()) {
+            paths[i] = getEntityElementPath(*addedEntities[i]);
+        }
+    });
+    QVector<int> order;
+    order.reserve(addedIDs.size());
+    for (int i = 0; i < numEntities; i++) {
+        if (addedEntities[i]) {
+            if (!addedEntities[i]->getParentID().isNull()) {
+                paths[i] = getEntityElementPath(*addedEntities[i]);
+            }
+            order.push_back(i);
+        }
+    }
+
+    // Going through the paths in sorted order, each element is found or created once, and the entities of an element
+    // keep the order they were given in.
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return paths[a] < paths[b];
+    });
+    QVector<OctreeElementPointer> elements { _rootElement };
+    _rootElement->markWithChangedTime();
+    QByteArray previousPath;
+    for (int i : order) {
+        const QByteArray& path = paths[i];
+        int depth = 0;
+        while (depth < path.size() && depth < previousPath.size() && path[depth] == previousPath[depth]) {
+            depth++;
+        }
+        elements.resize(depth + 1);
+        for (; depth < path.size(); depth++) {
+            OctreeElementPointer child = elements.back()->getChildAtIndex(path[depth]);
+            if (!child) {
+                child = elements.back()->addChildAtIndex(path[depth]);
+            }
+            child->markWithChangedTime();
+            elements.push_back(child);
+        }
+        previousPath = path;
+
+        addEntityMapEntry(addedEntities[i]);
+        std::static_pointer_cast<EntityTreeElement>(elements.back())->addEntityItem(addedEntities[i]);
+    }
+
+    // With every entity in the tree, the children are hooked up to their parents by a single fixup, rather than one
+    // for each entity added.
+    QVector<EntityItemPointer> registeredEntities;
+    for (const auto& entity : addedEntities) {
+        if (entity && entity->getElement() && registerAddedEntity(entity)) {
+            registeredEntities.push_back(entity);
+        }
+    }
+    fixupNeedsParentFixups();
+    for (const auto& entity : registeredEntities) {
+        // an entity may have been deleted since, for having the certificate of one added after it
+        if (entity->getElement()) {
+            emit addingEntity(entity->getEntityItemID());
+            emit addingEntityPointer(entity.get());
+        }
+    }
+    return addedEntities;
+}
+
 void EntityTree::emitEntityScriptChanging(const EntityItemID& entityItemID, bool reload) {
     emit entityScriptChanging(entityItemID, reload);
 }
@@ -1548,8 +1716,6 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     }
 
     int processedBytes = 0;
-    bool isAdd = false;
-    bool isClone = false;
     // we handle these types of "edit" packets
     switch (message.getType()) {
         case PacketType::EntityErase: {
@@ -1559,290 +1725,519 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
         }
 
         case PacketType::EntityClone:
-            isClone = true; // fall through to next case
-            // FALLTHRU
         case PacketType::EntityAdd:
-            isAdd = true;  // fall through to next case
-            // FALLTHRU
         case PacketType::EntityPhysics:
         case PacketType::EntityEdit: {
-            quint64 startDecode = 0, endDecode = 0;
-            quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startFilter = 0, endFilter = 0;
-            quint64 startLogging = 0, endLogging = 0;
-
-            bool suppressDisallowedClientScript = false;
-            bool suppressDisallowedServerScript = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
-
-            _totalEditMessages++;
-
-            EntityItemID entityItemID;
-            EntityItemProperties properties;
-            startDecode = usecTimestampNow();
-
-            bool validEditPacket = false;
-            EntityItemID entityIDToClone;
-            EntityItemPointer entityToClone;
-            if (isClone) {
-                QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-                validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, entityIDToClone, entityItemID);
-                if (validEditPacket) {
-                    entityToClone = findEntityByEntityItemID(entityIDToClone);
-                    if (entityToClone) {
-                        properties = entityToClone->getProperties();
-                    }
-                }
-            } else {
-                validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
-            }
+            EntityEdit edit;
+            edit.senderNode = senderNode;
+            decodeEntityEdit(edit, message.getType(), editData, maxLength, processedBytes);
+            applyEntityEdit(edit);
+            break;
+        }
+
+        default:
+            processedBytes = 0;
+            break;
+    }
+    return processedBytes;
+}
+
+OctreeDecodedEditPointer EntityTree::decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                          const SharedNodePointer& senderNode, int& processedBytes) {
+    processedBytes = 0;
+    if (!handlesEditPacketType(message.getType())) {
+        return OctreeDecodedEditPointer();
+    }
 
-            endDecode = usecTimestampNow();
+    auto edit = std::unique_ptr<EntityEdit>(new EntityEdit());
+    edit->senderNode = senderNode;
+    decodeEntityEdit(*edit, message.getType(), editData, maxLength, processedBytes);
+    return std::move(edit);
+}
 
-            EntityItemPointer existingEntity;
-            if (!isAdd) {
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                if (!existingEntity) {
-                    // this is not an add-entity operation, and we don't know about the identified entity.
-                    validEditPacket = false;
-                }
+void EntityTree::processDecodedEdits(OctreeDecodedEdits& decodedEdits, quint64& lockWaitTime, quint64& processTime) {
+    // The edits referring to an entity already referred to by a previous edit of the batch depend on it being applied,
+    // they are prepared in order, when applied. The others are prepared concurrently.
+    std::vector<EntityEdit*> independentEdits;
+    independentEdits.reserve(decodedEdits.size());
+    QSet<EntityItemID> referredIDs;
+    for (auto& decodedEdit : decodedEdits) {
+        auto& edit = static_cast<EntityEdit&>(*decodedEdit);
+        if (edit.type == PacketType::EntityErase) {
+            for (const auto& entityID : edit.erasedIDs) {
+                referredIDs.insert(entityID);
             }
+            continue;
+        }
 
-            if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
+        bool dependent = referredIDs.contains(edit.entityItemID) || (edit.isClone && referredIDs.contains(edit.entityIDToClone));
+        referredIDs.insert(edit.entityItemID);
+        if (!dependent) {
+            independentEdits.push_back(&edit);
+        }
+    }
 
-                bool wasDeletedBecauseOfClientScript = false;
+    // The lookups, permission checks and filters only read the tree. The filters are run by batches, each on its
+    // own pooled script engine.
+    withReadLock([&] {
+        tbb::parallel_for((size_t)0, independentEdits.size(), [&](size_t i) {
+            prepareEntityEdit(*independentEdits[i]);
+        });
+        const size_t FILTER_BATCH_SIZE = 32;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, independentEdits.size(), FILTER_BATCH_SIZE),
+                          [&](const tbb::blocked_range<size_t>& range) {
+            filterEntityEdits(&independentEdits[range.begin()], range.size());
+        });
+    });
 
-                // check the client entity script to make sure its URL is in the whitelist
-                if (!properties.getScript().isEmpty()) {
-                    bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+    // The runs of edits which change an entity within its shard are applied concurrently, shard by shard. The other
+    // edits are applied in order between the runs, with the whole tree write locked.
+    lockWaitTime = 0;
+    processTime = 0;
+    size_t next = 0;
+    while (next < decodedEdits.size()) {
+        std::array<std::vector<EntityEdit*>, NUMBER_OF_CHILDREN> shardEdits;
+        bool hasShardEdits = false;
+        withReadLock([&] {
+            for (; next < decodedEdits.size(); next++) {
+                auto& edit = static_cast<EntityEdit&>(*decodedEdits[next]);
+                int shard = getEditShardIndex(edit);
+                if (shard < 0) {
+                    break;
+                }
+                shardEdits[shard].push_back(&edit);
+                hasShardEdits = true;
+            }
+        });
 
-                    if (!clientScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set entity script not on whitelist, edit rejected";
+        std::vector<EntityEdit*> deferredEdits;
+        if (hasShardEdits) {
+            std::mutex deferredEditsMutex;
+            std::atomic<quint64> shardsLockWaitTime { 0 };
+            quint64 startShards = usecTimestampNow();
+            tbb::parallel_for(0, NUMBER_OF_CHILDREN, [&](int shard) {
+                auto& edits = shardEdits[shard];
+                if (edits.empty()) {
+                    return;
+                }
+                quint64 startLock = usecTimestampNow();
+                withShardsWriteLock(shardBit(shard), [&] {
+                    shardsLockWaitTime += usecTimestampNow() - startLock;
+                    for (size_t i = 0; i < edits.size(); i++) {
+                        // the entity may have been moved out of the shard by a full tree writer since, the rest of
+                        // the run is then applied afterwards to keep the order of the edits of the entity
+                        if (getEditShardIndex(*edits[i]) != shard) {
+                            std::lock_guard<std::mutex> lock(deferredEditsMutex);
+                            deferredEdits.insert(deferredEdits.end(), edits.begin() + i, edits.end());
+                            break;
                         }
+                        applyEntityEdit(*edits[i]);
+                    }
+                });
+            });
+            lockWaitTime += shardsLockWaitTime;
+            processTime += usecTimestampNow() - startShards;
+        }
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                            validEditPacket = false;
-                            wasDeletedBecauseOfClientScript = true;
-                        } else {
-                            suppressDisallowedClientScript = true;
-                        }
+        if (!deferredEdits.empty() || next < decodedEdits.size()) {
+            quint64 startProcess, startLock = usecTimestampNow();
+            withWriteLock([&] {
+                startProcess = usecTimestampNow();
+                for (auto edit : deferredEdits) {
+                    applyEntityEdit(*edit);
+                }
+                for (; next < decodedEdits.size(); next++) {
+                    auto& edit = static_cast<EntityEdit&>(*decodedEdits[next]);
+                    if (edit.prepared && getEditShardIndex(edit) >= 0) {
+                        break;
                     }
+                    applyEntityEdit(edit);
                 }
+            });
+            lockWaitTime += startProcess - startLock;
+            processTime += usecTimestampNow() - startProcess;
+        }
+    }
+}
 
-                // check all server entity scripts to make sure their URLs are in the whitelist
-                if (!properties.getServerScripts().isEmpty()) {
-                    bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+int EntityTree::getEditShardIndex(const EntityEdit& edit) const {
+    const auto& entity = edit.existingEntity;
+    if (edit.type == PacketType::EntityErase || edit.isAdd || !edit.valid || !entity) {
+        return -1;
+    }
 
-                    if (!serverScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set server entity script not on whitelist, edit rejected";
-                        }
+    // the other entities of the family may move with the entity
+    const auto& properties = edit.properties;
+    if (properties.parentIDChanged() || properties.parentJointIndexChanged() || entity->hasChildren()) {
+        return -1;
+    }
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            // Make sure we didn't already need to send back a delete because the client script failed
-                            // the whitelist check
-                            if (!wasDeletedBecauseOfClientScript) {
-                                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                                validEditPacket = false;
-                            }
-                        } else {
-                            suppressDisallowedServerScript = true;
-                        }
-                    }
-                }
+    EntityTreeElementPointer element = entity->getElement();
+    if (!element) {
+        return -1;
+    }
+    int shard = getShardIndex(element->getAACube());
+    if (shard == ROOT_SHARD) {
+        return -1;
+    }
+    if (properties.queryAACubeChanged() && getShardIndex(properties.getQueryAACube()) != shard) {
+        return -1;
+    }
+    return shard;
+}
 
-            }
+void EntityTree::decodeEntityEdit(EntityEdit& edit, PacketType type, const unsigned char* editData, int maxLength,
+                                  int& processedBytes) const {
+    edit.type = type;
+    edit.isClone = type == PacketType::EntityClone;
+    edit.isAdd = edit.isClone || type == PacketType::EntityAdd;
+    edit.isPhysics = type == PacketType::EntityPhysics;
 
-            if (!isClone) {
-                if ((isAdd || properties.lifetimeChanged()) &&
-                    ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
-                    (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
-                    // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
-                    if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
-                        properties.getLifetime() > _maxTmpEntityLifetime) {
-                        properties.setLifetime(_maxTmpEntityLifetime);
-                        bumpTimestamp(properties);
-                    }
+    if (type == PacketType::EntityErase) {
+        QByteArray dataByteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
+        processedBytes = parseEraseMessageDetails(dataByteArray, edit.erasedIDs);
+        edit.valid = true;
+        return;
+    }
+
+    quint64 startDecode = usecTimestampNow();
+    if (edit.isClone) {
+        QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
+        edit.valid = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, edit.entityIDToClone, edit.entityItemID);
+    } else {
+        edit.valid = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, edit.entityItemID, edit.properties);
+    }
+    edit.decodeTime = usecTimestampNow() - startDecode;
+}
+
+void EntityTree::prepareEntityEdit(EntityEdit& edit) {
+    edit.prepared = true;
+    if (edit.type == PacketType::EntityErase) {
+        return;
+    }
+
+    const auto& senderNode = edit.senderNode;
+    const auto& entityItemID = edit.entityItemID;
+    const bool isAdd = edit.isAdd;
+    const bool isClone = edit.isClone;
+    auto& properties = edit.properties;
+
+    if (isClone && edit.valid) {
+        edit.entityToClone = findEntityByEntityItemID(edit.entityIDToClone);
+        if (edit.entityToClone) {
+            properties = edit.entityToClone->getProperties();
+        }
+    }
+
+    if (!isAdd) {
+        // search for the entity by EntityItemID
+        quint64 startLookup = usecTimestampNow();
+        edit.existingEntity = findEntityByEntityItemID(entityItemID);
+        edit.lookupTime = usecTimestampNow() - startLookup;
+        if (!edit.existingEntity) {
+            // this is not an add-entity operation, and we don't know about the identified entity.
+            edit.valid = false;
+        }
+    }
+
+    if (edit.valid && !_entityScriptSourceWhitelist.isEmpty()) {
+
+        bool wasDeletedBecauseOfClientScript = false;
+
+        // check the client entity script to make sure its URL is in the whitelist
+        if (!properties.getScript().isEmpty()) {
+            bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+
+            if (!clientScriptPassedWhitelist) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] attempting to set entity script not on whitelist, edit rejected";
                 }
 
-                if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
-                    // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
-                    // clear the locked property and allow the unlocked entity to be created.
-                    properties.setLocked(false);
-                    bumpTimestamp(properties);
+                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+                if (isAdd) {
+                    QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                    _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+                    edit.valid = false;
+                    wasDeletedBecauseOfClientScript = true;
+                } else {
+                    edit.suppressDisallowedClientScript = true;
                 }
             }
+        }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
+        // check all server entity scripts to make sure their URLs are in the whitelist
+        if (!properties.getServerScripts().isEmpty()) {
+            bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+
+            if (!serverScriptPassedWhitelist) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] attempting to set server entity script not on whitelist, edit rejected";
                 }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
+
+                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+                if (isAdd) {
+                    // Make sure we didn't already need to send back a delete because the client script failed
+                    // the whitelist check
+                    if (!wasDeletedBecauseOfClientScript) {
+                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+                        edit.valid = false;
+                    }
+                } else {
+                    edit.suppressDisallowedServerScript = true;
                 }
-                endFilter = usecTimestampNow();
+            }
+        }
 
-                if (existingEntity && !isAdd) {
+    }
 
-                    if (suppressDisallowedClientScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
-                    }
+    if (!isClone) {
+        if ((isAdd || properties.lifetimeChanged()) &&
+            ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
+            (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
+            // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
+            if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
+                properties.getLifetime() > _maxTmpEntityLifetime) {
+                properties.setLifetime(_maxTmpEntityLifetime);
+                bumpTimestamp(properties);
+            }
+        }
+
+        if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
+            // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
+            // clear the locked property and allow the unlocked entity to be created.
+            properties.setLocked(false);
+            bumpTimestamp(properties);
+        }
+    }
+}
+
+void EntityTree::filterEntityEdits(EntityEdit* const* edits, size_t numEdits) {
+    quint64 startFilter = usecTimestampNow();
+    auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
+    std::vector<EntityEditFilters::FilterRequest> requests;
+    std::vector<EntityEdit*> filteredEdits;
+    size_t numValidEdits = 0;
+    for (size_t i = 0; i < numEdits; i++) {
+        auto& edit = *edits[i];
+        if (edit.type == PacketType::EntityErase || !edit.valid) {
+            continue;
+        }
+        numValidEdits++;
 
-                    if (suppressDisallowedServerScript) {
-                        bumpTimestamp(properties);
-                        properties.setServerScripts(existingEntity->getServerScripts());
+        // Having (un)lock rights bypasses the filter, unless it's a physics result.
+        edit.allowed = true;
+        if ((edit.isPhysics || !edit.senderNode->isAllowedEditor()) && entityEditFilters) {
+            const auto& existingEntity = edit.existingEntity;
+            EntityEditFilters::FilterRequest request;
+            request.position = existingEntity ? existingEntity->getWorldPosition() : edit.properties.getPosition();
+            request.properties = &edit.properties;
+            request.filterType = edit.isPhysics ? FilterType::Physics : (edit.isAdd ? FilterType::Add : FilterType::Edit);
+            request.entityID = existingEntity ? existingEntity->getEntityItemID() : EntityItemID();
+            request.existingEntity = existingEntity;
+            requests.push_back(request);
+            filteredEdits.push_back(&edit);
+        }
+    }
+
+    if (!requests.empty()) {
+        entityEditFilters->filterBatch(requests);
+    }
+
+    for (size_t i = 0; i < filteredEdits.size(); i++) {
+        auto& edit = *filteredEdits[i];
+        auto& properties = edit.properties;
+        edit.allowed = requests[i].accepted;
+        if (!edit.allowed) {
+            auto timestamp = properties.getLastEdited();
+            properties = EntityItemProperties();
+            properties.setLastEdited(timestamp);
+        }
+        if (!edit.allowed || requests[i].wasChanged) {
+            bumpTimestamp(properties);
+            // For now, free ownership on any modification.
+            properties.clearSimulationOwner();
+        }
+    }
+
+    // the filtering time is shared by the edits of the batch
+    if (numValidEdits > 0) {
+        quint64 filterTime = (usecTimestampNow() - startFilter) / numValidEdits;
+        for (size_t i = 0; i < numEdits; i++) {
+            if (edits[i]->type != PacketType::EntityErase && edits[i]->valid) {
+                edits[i]->filterTime = filterTime;
+            }
+        }
+    }
+}
+
+void EntityTree::applyEntityEdit(EntityEdit& edit) {
+    if (edit.type == PacketType::EntityErase) {
+        eraseEntities(edit.erasedIDs, edit.senderNode);
+        return;
+    }
+
+    _totalEditMessages++;
+
+    if (!edit.prepared) {
+        prepareEntityEdit(edit);
+        EntityEdit* edits[] = { &edit };
+        filterEntityEdits(edits, 1);
+    } else if (edit.existingEntity) {
+        // the entity may have been deleted since the edit was prepared
+        EntityItemPointer existingEntity = findEntityByEntityItemID(edit.entityItemID);
+        if (existingEntity != edit.existingEntity) {
+            edit.existingEntity = existingEntity;
+            edit.valid = edit.valid && existingEntity;
+        }
+    }
+
+    const auto& senderNode = edit.senderNode;
+    const auto& entityItemID = edit.entityItemID;
+    const auto& entityIDToClone = edit.entityIDToClone;
+    const auto& existingEntity = edit.existingEntity;
+    const auto& entityToClone = edit.entityToClone;
+    const bool isAdd = edit.isAdd;
+    const bool isClone = edit.isClone;
+    const bool allowed = edit.allowed;
+    auto& properties = edit.properties;
+
+    quint64 startUpdate = 0, endUpdate = 0;
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startLogging = 0, endLogging = 0;
+
+    // If we got a valid edit packet, then it could be a new entity or it could be an update to
+    // an existing entity... handle appropriately
+    if (edit.valid) {
+        if (existingEntity && !isAdd) {
+
+            if (edit.suppressDisallowedClientScript) {
+                bumpTimestamp(properties);
+                properties.setScript(existingEntity->getScript());
+            }
+
+            if (edit.suppressDisallowedServerScript) {
+                bumpTimestamp(properties);
+                properties.setServerScripts(existingEntity->getServerScripts());
+            }
+
+            // if the EntityItem exists, then update it
+            startLogging = usecTimestampNow();
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                qCDebug(entities) << "   properties:" << properties;
+            }
+            if (wantTerseEditLogging()) {
+                QList<QString> changedProperties = properties.listChangedProperties();
+                fixupTerseEditLogging(properties, changedProperties);
+                qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                    existingEntity->getDebugName() << changedProperties;
+            }
+            endLogging = usecTimestampNow();
+
+            startUpdate = usecTimestampNow();
+            if (!edit.isPhysics) {
+                properties.setLastEditedBy(senderNode->getUUID());
+            }
+            updateEntity(existingEntity, properties, senderNode);
+            existingEntity->markAsChangedOnServer();
+            endUpdate = usecTimestampNow();
+            _totalUpdates++;
+        } else if (isAdd) {
+            bool failedAdd = !allowed;
+            bool isCertified = !properties.getCertificateID().isEmpty();
+            bool isCloneable = properties.getCloneable();
+            int cloneLimit = properties.getCloneLimit();
+            if (!allowed) {
+                qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+            } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add an uncertified entity with ID:" << entityItemID;
+            } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add a certified entity with ID:" << entityItemID;
+            } else if (isClone && isCertified) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
+            } else if (isClone && !isCloneable) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
+            } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
+            } else {
+                if (isClone) {
+                    properties.convertToCloneProperties(entityIDToClone);
+                }
+
+                // this is a new entity... assign a new entityID
+                properties.setCreated(properties.getLastEdited());
+                properties.setLastEditedBy(senderNode->getUUID());
+                startCreate = usecTimestampNow();
+                EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                endCreate = usecTimestampNow();
+                _totalCreates++;
+
+                if (newEntity && isCertified && getIsServer()) {
+                    if (!properties.verifyStaticCertificateProperties()) {
+                        qCDebug(entities) << "User" << senderNode->getUUID()
+                            << "attempted to add a certified entity with ID" << entityItemID << "which failed"
+                            << "static certificate verification.";
+                        // Delete the entity we just added if it doesn't pass static certificate verification
+                        deleteEntity(entityItemID, true);
+                    } else {
+                        validatePop(properties.getCertificateID(), entityItemID, senderNode);
                     }
+                }
+
+                if (newEntity && isClone) {
+                    entityToClone->addCloneID(newEntity->getEntityItemID());
+                    newEntity->setCloneOriginID(entityIDToClone);
+                }
+
+                if (newEntity) {
+                    newEntity->markAsChangedOnServer();
+                    notifyNewlyCreatedEntity(*newEntity, senderNode);
 
-                    // if the EntityItem exists, then update it
                     startLogging = usecTimestampNow();
                     if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                          << newEntity->getEntityItemID();
                         qCDebug(entities) << "   properties:" << properties;
                     }
                     if (wantTerseEditLogging()) {
                         QList<QString> changedProperties = properties.listChangedProperties();
                         fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
+                        qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
                     }
                     endLogging = usecTimestampNow();
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(existingEntity, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    bool isCertified = !properties.getCertificateID().isEmpty();
-                    bool isCloneable = properties.getCloneable();
-                    int cloneLimit = properties.getCloneLimit();
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add an uncertified entity with ID:" << entityItemID;
-                    } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add a certified entity with ID:" << entityItemID;
-                    } else if (isClone && isCertified) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && !isCloneable) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
-                    } else {
-                        if (isClone) {
-                            properties.convertToCloneProperties(entityIDToClone);
-                        }
-
-                        // this is a new entity... assign a new entityID
-                        properties.setCreated(properties.getLastEdited());
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isCertified && getIsServer()) {
-                            if (!properties.verifyStaticCertificateProperties()) {
-                                qCDebug(entities) << "User" << senderNode->getUUID()
-                                    << "attempted to add a certified entity with ID" << entityItemID << "which failed"
-                                    << "static certificate verification.";
-                                // Delete the entity we just added if it doesn't pass static certificate verification
-                                deleteEntity(entityItemID, true);
-                            } else {
-                                validatePop(properties.getCertificateID(), entityItemID, senderNode);
-                            }
-                        }
-
-                        if (newEntity && isClone) {
-                            entityToClone->addCloneID(newEntity->getEntityItemID());
-                            newEntity->setCloneOriginID(entityIDToClone);
-                        }
-
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-                            
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
-
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
-                        }
-                    }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
                 } else {
-                    HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get());
+                    failedAdd = true;
+                    qCDebug(entities) << "Add entity failed ID:" << entityItemID;
                 }
             }
-
-
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-            _totalFilterTime += endFilter - startFilter;
-
-            break;
+            if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            }
+        } else {
+            HIFI_FCDEBUG(entities(), "Edit failed. [" << edit.type <<"] " <<
+                    "entity id:" << entityItemID << 
+                    "existingEntity pointer:" << existingEntity.get());
         }
-
-        default:
-            processedBytes = 0;
-            break;
     }
-    return processedBytes;
+
+    _totalDecodeTime += edit.decodeTime;
+    _totalLookupTime += edit.lookupTime;
+    _totalUpdateTime += endUpdate - startUpdate;
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
+    _totalFilterTime += edit.filterTime;
 }
 
 
@@ -2016,6 +2411,13 @@ void EntityTree::update(bool simulate) {
             }
         }
     });
+
+    // drop the urls and names that no entity uses anymore
+    quint64 now = usecTimestampNow();
+    if (now - _lastInternedStringsPurge > INTERNED_STRINGS_PURGE_PERIOD) {
+        _lastInternedStringsPurge = now;
+        InternedStrings::purge();
+    }
 }
 
 quint64 EntityTree::getAdjustedConsiderSince(quint64 sinceTime) {
@@ -2149,6 +2551,13 @@ int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, cons
     #ifdef EXTRA_ERASE_DEBUGGING
         qCDebug(entities) << "EntityTree::processEraseMessageDetails()";
     #endif
+    QVector<EntityItemID> entityItemIDs;
+    int processedBytes = parseEraseMessageDetails(dataByteArray, entityItemIDs);
+    eraseEntities(entityItemIDs, sourceNode);
+    return processedBytes;
+}
+
+int EntityTree::parseEraseMessageDetails(const QByteArray& dataByteArray, QVector<EntityItemID>& entityItemIDs) const {
     const unsigned char* packetData = (const unsigned char*)dataByteArray.constData();
     const unsigned char* dataAt = packetData;
     size_t packetLength = dataByteArray.size();
@@ -2159,37 +2568,41 @@ int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, cons
     dataAt += sizeof(numberOfIds);
     processedBytes += sizeof(numberOfIds);
 
-    if (numberOfIds > 0) {
-        QSet<EntityItemID> entityItemIDsToDelete;
+    for (size_t i = 0; i < numberOfIds; i++) {
 
-        for (size_t i = 0; i < numberOfIds; i++) {
 
+        if (processedBytes + NUM_BYTES_RFC4122_UUID > packetLength) {
+            qCDebug(entities) << "EntityTree::processEraseMessageDetails().... bailing because not enough bytes in buffer";
+            break; // bail to prevent buffer overflow
+        }
 
-            if (processedBytes + NUM_BYTES_RFC4122_UUID > packetLength) {
-                qCDebug(entities) << "EntityTree::processEraseMessageDetails().... bailing because not enough bytes in buffer";
-                break; // bail to prevent buffer overflow
-            }
-
-            QByteArray encodedID = dataByteArray.mid((int)processedBytes, NUM_BYTES_RFC4122_UUID);
-            QUuid entityID = QUuid::fromRfc4122(encodedID);
-            dataAt += encodedID.size();
-            processedBytes += encodedID.size();
+        QByteArray encodedID = dataByteArray.mid((int)processedBytes, NUM_BYTES_RFC4122_UUID);
+        QUuid entityID = QUuid::fromRfc4122(encodedID);
+        dataAt += encodedID.size();
+        processedBytes += encodedID.size();
 
-            #ifdef EXTRA_ERASE_DEBUGGING
-                qCDebug(entities) << "    ---- EntityTree::processEraseMessageDetails() contains id:" << entityID;
-            #endif
+        #ifdef EXTRA_ERASE_DEBUGGING
+            qCDebug(entities) << "    ---- EntityTree::processEraseMessageDetails() contains id:" << entityID;
+        #endif
 
-            EntityItemID entityItemID(entityID);
+        entityItemIDs << EntityItemID(entityID);
+    }
+    return (int)processedBytes;
+}
 
-            if (shouldEraseEntity(entityID, sourceNode)) {
-                entityItemIDsToDelete << entityItemID;
-                cleanupCloneIDs(entityItemID);
-            }
+void EntityTree::eraseEntities(const QVector<EntityItemID>& entityItemIDs, const SharedNodePointer& sourceNode) {
+    if (entityItemIDs.isEmpty()) {
+        return;
+    }
 
+    QSet<EntityItemID> entityItemIDsToDelete;
+    for (const auto& entityItemID : entityItemIDs) {
+        if (shouldEraseEntity(entityItemID, sourceNode)) {
+            entityItemIDsToDelete << entityItemID;
+            cleanupCloneIDs(entityItemID);
         }
-        deleteEntities(entityItemIDsToDelete, true, true);
     }
-    return (int)processedBytes;
+    deleteEntities(entityItemIDsToDelete, true, true);
 }
 
 EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& entityItemID)  /*const*/ {
@@ -2606,11 +3019,123 @@ void convertGrabUserDataToProperties(EntityItemProperties& properties) {
     }
 }
 
+// converts the description of an entity from readFromMap(), updating the properties of older content
+static void readEntityFromMap(const QVariantMap& entityMap, int contentVersion, const QUuid& myNodeID,
+                              QScriptEngine& scriptEngine, EntityItemID& entityItemID, EntityItemProperties& properties) {
+    bool needsConversion = (contentVersion < (int)EntityVersion::ZoneLightInheritModes);
+
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+    if (entityMap.contains("id")) {
+        entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        entityItemID = EntityItemID(QUuid::createUuid());
+    }
+
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        }
+    }
+
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        properties.setOwningAvatarID(myNodeID);
+    }
+
+    // Fix for older content not containing mode fields in the zones
+    if (needsConversion && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+        }
+
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getURL() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+            }
+        }
+
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+        }
+    }
+
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
+            }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
+            }
+
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
+        }
+    }
+
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+        }
+    }
+
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+}
 
 bool EntityTree::readFromMap(QVariantMap& map) {
     // These are needed to deal with older content (before adding inheritance modes)
     int contentVersion = map["Version"].toInt();
-    bool needsConversion = (contentVersion < (int)EntityVersion::ZoneLightInheritModes);
 
     if (map.contains("Id")) {
         _persistID = map["Id"].toUuid();
@@ -2635,19 +3160,19 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     // to a QScriptValue, and then to EntityItemProperties.  These properties are used
     // to add the new entity to the EntityTree.
     QVariantList entitiesQList = map["Entities"].toList();
-    QScriptEngine scriptEngine;
 
     if (entitiesQList.length() == 0) {
         // Empty map or invalidly formed file.
         return false;
     }
 
-    QMap<QUuid, QVector<QUuid>> cloneIDs;
-
-    bool success = true;
-    foreach (QVariant entityVariant, entitiesQList) {
-        // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
-        QVariantMap entityMap = entityVariant.toMap();
+    // The descriptions are converted to properties concurrently, by batches each with its own script engine, and
+    // the entities are then added to the tree at once.
+    int numEntities = entitiesQList.length();
+    QVector<QVariantMap> entityMaps(numEntities);
+    for (int i = 0; i < numEntities; i++) {
+        QVariantMap& entityMap = entityMaps[i];
+        entityMap = entitiesQList.at(i).toMap();
 
         // handle parentJointName for wearables
         if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
@@ -2658,122 +3183,30 @@ bool EntityTree::readFromMap(QVariantMap& map) {
             qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
                 " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
         }
+    }
 
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
-
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
-        } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
-        }
-
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
-            }
-        }
-
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
-        }
-
-        // Fix for older content not containing mode fields in the zones
-        if (needsConversion && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
-
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
-            }
-
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
-                }
-            }
-
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
-            }
-        }
-
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
-
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
-                }
-
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
-            }
-        }
-
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
-
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
-            }
+    auto nodeList = DependencyManager::get<NodeList>();
+    const QUuid myNodeID = nodeList ? nodeList->getSessionUUID() : QUuid();
+    QVector<EntityItemID> entityItemIDs(numEntities);
+    QVector<EntityItemProperties> entityProperties(numEntities);
+    const int READ_BATCH_SIZE = 256;
+    tbb::parallel_for(tbb::blocked_range<int>(0, numEntities, READ_BATCH_SIZE),
+                      [&](const tbb::blocked_range<int>& range) {
+        QScriptEngine scriptEngine;
+        for (int i = range.begin(); i < range.end(); i++) {
+            readEntityFromMap(entityMaps[i], contentVersion, myNodeID, scriptEngine, entityItemIDs[i], entityProperties[i]);
         }
+    });
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
-        }
+    QVector<EntityItemPointer> addedEntities = addEntities(entityItemIDs, entityProperties);
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
-        }
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
 
-        EntityItemPointer entity = addEntity(entityItemID, properties);
+    bool success = true;
+    for (int i = 0; i < numEntities; i++) {
+        const EntityItemPointer& entity = addedEntities[i];
         if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+            qCDebug(entities) << "adding Entity failed:" << entityItemIDs[i] << entityProperties[i].getType();
             success = false;
         }
 
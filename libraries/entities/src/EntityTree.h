@@ -12,6 +12,8 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <atomic>
+
 #include <QSet>
 #include <QVector>
 
@@ -88,6 +90,10 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual bool canDecodeEditsConcurrently() const override { return getIsServer(); }
+    virtual OctreeDecodedEditPointer decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                          const SharedNodePointer& senderNode, int& processedBytes) override;
+    virtual void processDecodedEdits(OctreeDecodedEdits& edits, quint64& lockWaitTime, quint64& processTime) override;
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -119,6 +125,15 @@ public:
 
     EntityItemPointer addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone = false);
 
+    // adds an entity loaded from the client's entity cache, as if the server had sent it at lastEditedFromRemote
+    EntityItemPointer addCachedEntity(const EntityItemID& entityID, const EntityItemProperties& properties,
+                                      quint64 lastEditedFromRemote);
+
+    // adds the entities at once, leaving the tree as adding them in order with addEntity() would, and returns them,
+    // with null for those which couldn't be added
+    QVector<EntityItemPointer> addEntities(const QVector<EntityItemID>& entityIDs,
+                                           const QVector<EntityItemProperties>& properties);
+
     // use this method if you only know the entityID
     bool updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
 
@@ -192,6 +207,8 @@ public:
 
     int processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
     int processEraseMessageDetails(const QByteArray& buffer, const SharedNodePointer& sourceNode);
+    int parseEraseMessageDetails(const QByteArray& buffer, QVector<EntityItemID>& entityItemIDs) const;
+    void eraseEntities(const QVector<EntityItemID>& entityItemIDs, const SharedNodePointer& sourceNode);
     bool shouldEraseEntity(EntityItemID entityID, const SharedNodePointer& sourceNode);
 
 
@@ -332,6 +349,43 @@ protected:
 
     void notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode);
 
+    // An add, edit or erase record of an entity edit packet
+    class EntityEdit : public OctreeDecodedEdit {
+    public:
+        PacketType type { PacketType::Unknown };
+        SharedNodePointer senderNode;
+        bool valid { false };
+        bool isAdd { false };
+        bool isClone { false };
+        bool isPhysics { false };
+        EntityItemID entityItemID;
+        EntityItemID entityIDToClone;
+        EntityItemProperties properties;
+        QVector<EntityItemID> erasedIDs;
+
+        // set once prepared, against the state of the tree
+        bool prepared { false };
+        bool allowed { true };
+        bool suppressDisallowedClientScript { false };
+        bool suppressDisallowedServerScript { false };
+        EntityItemPointer existingEntity;
+        EntityItemPointer entityToClone;
+
+        quint64 decodeTime { 0 };
+        quint64 lookupTime { 0 };
+        quint64 filterTime { 0 };
+    };
+
+    // Edits are decoded from the packet data only, then prepared with the tree read locked (lookups, whitelist,
+    // permissions, and filters, which run on batches of edits), and applied with the tree write locked
+    void decodeEntityEdit(EntityEdit& edit, PacketType type, const unsigned char* editData, int maxLength, int& processedBytes) const;
+    void prepareEntityEdit(EntityEdit& edit);
+    void filterEntityEdits(EntityEdit* const* edits, size_t numEdits);
+    void applyEntityEdit(EntityEdit& edit);
+
+    // the shard of a prepared edit which only changes an existing entity within its shard, -1 when it needs the whole tree
+    int getEditShardIndex(const EntityEdit& edit) const;
+
     bool isScriptInWhitelist(const QString& scriptURL);
 
     QReadWriteLock _newlyCreatedHooksLock;
@@ -368,16 +422,16 @@ protected:
     bool _wantTerseEditLogging = false;
 
 
-    // some performance tracking properties - only used in server trees
-    int _totalEditMessages = 0;
-    int _totalUpdates = 0;
-    int _totalCreates = 0;
-    quint64 _totalDecodeTime = 0;
-    quint64 _totalLookupTime = 0;
-    quint64 _totalUpdateTime = 0;
-    quint64 _totalCreateTime = 0;
-    quint64 _totalLoggingTime = 0;
-    quint64 _totalFilterTime = 0;
+    // some performance tracking properties - only used in server trees, where edits are applied shard by shard
+    std::atomic<int> _totalEditMessages { 0 };
+    std::atomic<int> _totalUpdates { 0 };
+    std::atomic<int> _totalCreates { 0 };
+    std::atomic<quint64> _totalDecodeTime { 0 };
+    std::atomic<quint64> _totalLookupTime { 0 };
+    std::atomic<quint64> _totalUpdateTime { 0 };
+    std::atomic<quint64> _totalCreateTime { 0 };
+    std::atomic<quint64> _totalLoggingTime { 0 };
+    std::atomic<quint64> _totalFilterTime { 0 };
 
     // these performance statistics are only used in the client
     void resetClientEditStats();
@@ -387,6 +441,12 @@ protected:
     quint64 _maxEditDelta = 0;
     quint64 _treeResetTime = 0;
 
+    quint64 _lastInternedStringsPurge { 0 };
+
+    // the part of postAddEntity() before the parent fixup, returns false when it instead deleted the entity with the
+    // same certificate ID
+    bool registerAddedEntity(EntityItemPointer entity);
+
     void fixupNeedsParentFixups(); // try to hook members of _needsParentFixup to parent instances
     QVector<EntityItemWeakPointer> _needsParentFixup; // entites with a parentID but no (yet) known parent instance
     mutable QReadWriteLock _needsParentFixupLock;
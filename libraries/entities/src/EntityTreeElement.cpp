@@ -14,6 +14,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include <GeometryUtil.h>
+#include <OctalCode.h>
 #include <OctreeUtils.h>
 #include <Extents.h>
 
@@ -117,18 +118,22 @@ bool EntityTreeElement::containsBounds(const glm::vec3& minPoint, const glm::vec
 }
 
 bool EntityTreeElement::bestFitBounds(const glm::vec3& minPoint, const glm::vec3& maxPoint) const {
+    return cubeBestFitsBounds(_cube, minPoint, maxPoint);
+}
+
+bool EntityTreeElement::cubeBestFitsBounds(const AACube& cube, const glm::vec3& minPoint, const glm::vec3& maxPoint) {
     glm::vec3 clampedMin = glm::clamp(minPoint, (float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE);
     glm::vec3 clampedMax = glm::clamp(maxPoint, (float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE);
 
-    if (_cube.contains(clampedMin) && _cube.contains(clampedMax)) {
+    if (cube.contains(clampedMin) && cube.contains(clampedMax)) {
 
         // If our child would be smaller than our smallest reasonable element, then we are the best fit.
-        float childScale = _cube.getScale() / 2.0f;
+        float childScale = cube.getScale() / 2.0f;
         if (childScale <= SMALLEST_REASONABLE_OCTREE_ELEMENT_SCALE) {
             return true;
         }
-        int childForMinimumPoint = getMyChildContainingPoint(clampedMin);
-        int childForMaximumPoint = getMyChildContainingPoint(clampedMax);
+        int childForMinimumPoint = getChildContainingPoint(cube, clampedMin);
+        int childForMaximumPoint = getChildContainingPoint(cube, clampedMax);
 
         // If I contain both the minimum and maximum point, but two different children of mine
         // contain those points, then I am the best fit for that entity
@@ -592,6 +597,32 @@ int EntityTreeElement::readElementDataFromBuffer(const unsigned char* data, int
     return _myTree->readEntityDataFromBuffer(data, bytesLeftToRead, args);
 }
 
+void EntityTreeElement::bumpChangedContent() {
+    OctreeElement::bumpChangedContent();
+    uint64_t time = getLastChangedContent();
+    bumpSubtreeLastChanged(time);
+    if (!_myTree) {
+        return;
+    }
+
+    // walk down from the root along our octal code, so that traversals can prune the subtrees which didn't change
+    const unsigned char* octalCode = getOctalCode();
+    int depth = numberOfThreeBitSectionsInCode(octalCode);
+    OctreeElementPointer element = _myTree->getRoot();
+    for (int i = 0; element && i < depth; i++) {
+        std::static_pointer_cast<EntityTreeElement>(element)->bumpSubtreeLastChanged(time);
+        int childIndex = branchIndexWithDescendant(element->getOctalCode(), octalCode);
+        element = element->getChildAtIndex(childIndex);
+    }
+}
+
+void EntityTreeElement::bumpSubtreeLastChanged(uint64_t time) {
+    // concurrent writers in different shards share the ancestors, keep the latest time
+    uint64_t lastChanged = _subtreeLastChanged;
+    while (lastChanged < time && !_subtreeLastChanged.compare_exchange_weak(lastChanged, time)) {
+    }
+}
+
 void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
     assert(entity);
     assert(entity->_element == nullptr);
@@ -617,6 +648,11 @@ bool EntityTreeElement::collapseChildren() {
 }
 
 bool EntityTreeElement::pruneChildren() {
+    // the operators also prune the elements they pass by, which may belong to shards other writers are changing
+    if (_myTree && !_myTree->canChangeElement(*this)) {
+        return false;
+    }
+
     bool somethingPruned = false;
     for (int childIndex = 0; childIndex < NUMBER_OF_CHILDREN; childIndex++) {
         EntityTreeElementPointer child = getChildAtIndex(childIndex);
@@ -173,6 +173,12 @@ public:
     void setTree(EntityTreePointer tree) { _myTree = tree; }
     EntityTreePointer getTree() const { return _myTree; }
 
+    // also bumps the subtree time of this element and of its ancestors
+    virtual void bumpChangedContent() override;
+
+    // the last time the content of this element or of any element below it changed
+    uint64_t getSubtreeLastChanged() const { return _subtreeLastChanged; }
+
     void addEntityItem(EntityItemPointer entity);
 
     EntityItemPointer getClosestEntity(glm::vec3 position) const;
@@ -225,6 +231,9 @@ public:
     bool containsBounds(const glm::vec3& minPoint, const glm::vec3& maxPoint) const; // NOTE: units in tree units
     bool bestFitBounds(const glm::vec3& minPoint, const glm::vec3& maxPoint) const; // NOTE: units in tree units
 
+    // whether an element with cube is the best fit for the bounds, as bestFitBounds(), without needing the element
+    static bool cubeBestFitsBounds(const AACube& cube, const glm::vec3& minPoint, const glm::vec3& maxPoint);
+
     void debugDump();
 
     bool pruneChildren();
@@ -245,6 +254,11 @@ protected:
     virtual void init(unsigned char * octalCode) override;
     EntityTreePointer _myTree;
     EntityItems _entityItems;
+
+private:
+    void bumpSubtreeLastChanged(uint64_t time);
+
+    std::atomic<uint64_t> _subtreeLastChanged { 0 };
 };
 
 #endif // hifi_EntityTreeElement_h
@@ -8,6 +8,8 @@
 
 #include "ImageEntityItem.h"
 
+#include <InternedStrings.h>
+
 #include "EntityItemProperties.h"
 
 EntityItemPointer ImageEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
@@ -184,7 +186,7 @@ QString ImageEntityItem::getImageURL() const {
 
 void ImageEntityItem::setImageURL(const QString& url) {
     withWriteLock([&] {
-        _imageURL = url;
+        _imageURL = InternedStrings::intern(url);
     });
 }
 
@@ -8,6 +8,8 @@
 
 #include "MaterialEntityItem.h"
 
+#include <InternedStrings.h>
+
 #include "EntityItemProperties.h"
 
 #include "QJsonDocument"
@@ -167,7 +169,7 @@ void MaterialEntityItem::setMaterialURL(const QString& materialURLString, bool m
     bool usingMaterialData = materialDataChanged || materialURLString.startsWith("materialData");
     if (_materialURL != materialURLString || (usingMaterialData && materialDataChanged)) {
         removeMaterial();
-        _materialURL = materialURLString;
+        _materialURL = InternedStrings::intern(materialURLString);
 
         if (materialURLString.contains("?")) {
             auto split = materialURLString.split("?");
@@ -17,6 +17,7 @@
 
 #include <ByteCountCoding.h>
 #include <GLMHelpers.h>
+#include <InternedStrings.h>
 
 #include "EntitiesLogging.h"
 #include "EntityItemProperties.h"
@@ -50,7 +51,7 @@ const QString ModelEntityItem::getTextures() const {
 
 void ModelEntityItem::setTextures(const QString& textures) {
     QWriteLocker locker(&_texturesLock);
-    _textures = textures;
+    _textures = InternedStrings::intern(textures);
 }
 
 EntityItemProperties ModelEntityItem::getProperties(const EntityPropertyFlags& desiredProperties, bool allowEmptyDesiredProperties) const {
@@ -117,9 +118,9 @@ int ModelEntityItem::readEntitySubclassDataFromBuffer(const unsigned char* data,
     bool animationPropertiesChanged = false;
 
     READ_ENTITY_PROPERTY(PROP_COLOR, glm::u8vec3, setColor);
-    READ_ENTITY_PROPERTY(PROP_MODEL_URL, QString, setModelURL);
-    READ_ENTITY_PROPERTY(PROP_COMPOUND_SHAPE_URL, QString, setCompoundShapeURL);
-    READ_ENTITY_PROPERTY(PROP_TEXTURES, QString, setTextures);
+    READ_ENTITY_SHARED_STRING_PROPERTY(PROP_MODEL_URL, setModelURL);
+    READ_ENTITY_SHARED_STRING_PROPERTY(PROP_COMPOUND_SHAPE_URL, setCompoundShapeURL);
+    READ_ENTITY_SHARED_STRING_PROPERTY(PROP_TEXTURES, setTextures);
     READ_ENTITY_PROPERTY(PROP_SHAPE_TYPE, ShapeType, setShapeType);
     READ_ENTITY_PROPERTY(PROP_JOINT_ROTATIONS_SET, QVector<bool>, setJointRotationsSet);
     READ_ENTITY_PROPERTY(PROP_JOINT_ROTATIONS, QVector<glm::quat>, setJointRotations);
@@ -177,9 +178,9 @@ void ModelEntityItem::appendSubclassData(OctreePacketData* packetData, EncodeBit
     bool successPropertyFits = true;
 
     APPEND_ENTITY_PROPERTY(PROP_COLOR, getColor());
-    APPEND_ENTITY_PROPERTY(PROP_MODEL_URL, getModelURL());
-    APPEND_ENTITY_PROPERTY(PROP_COMPOUND_SHAPE_URL, getCompoundShapeURL());
-    APPEND_ENTITY_PROPERTY(PROP_TEXTURES, getTextures());
+    APPEND_ENTITY_SHARED_STRING_PROPERTY(PROP_MODEL_URL, getModelURL());
+    APPEND_ENTITY_SHARED_STRING_PROPERTY(PROP_COMPOUND_SHAPE_URL, getCompoundShapeURL());
+    APPEND_ENTITY_SHARED_STRING_PROPERTY(PROP_TEXTURES, getTextures());
     APPEND_ENTITY_PROPERTY(PROP_SHAPE_TYPE, (uint32_t)getShapeType());
     APPEND_ENTITY_PROPERTY(PROP_JOINT_ROTATIONS_SET, getJointRotationsSet());
     APPEND_ENTITY_PROPERTY(PROP_JOINT_ROTATIONS, getJointRotations());
@@ -276,7 +277,7 @@ ShapeType ModelEntityItem::computeTrueShapeType() const {
 void ModelEntityItem::setModelURL(const QString& url) {
     withWriteLock([&] {
         if (_modelURL != url) {
-            _modelURL = url;
+            _modelURL = InternedStrings::intern(url);
             if (_shapeType == SHAPE_TYPE_STATIC_MESH) {
                 _flags |= Simulation::DIRTY_SHAPE | Simulation::DIRTY_MASS;
             }
@@ -288,7 +289,7 @@ void ModelEntityItem::setCompoundShapeURL(const QString& url) {
     withWriteLock([&] {
         if (_compoundShapeURL.get() != url) {
             ShapeType oldType = computeTrueShapeType();
-            _compoundShapeURL.set(url);
+            _compoundShapeURL.set(InternedStrings::intern(url));
             if (oldType != computeTrueShapeType()) {
                 _flags |= Simulation::DIRTY_SHAPE | Simulation::DIRTY_MASS;
             }
@@ -49,6 +49,7 @@ public:
 
     virtual void update(const quint64& now) override;
     bool needsToCallUpdate() const override { return isAnimatingSomething(); }
+    bool canUpdateConcurrently() const override { return true; }
 
     virtual void debugDump() const override;
 
@@ -279,6 +279,19 @@ OctreeElementPointer MovingEntitiesOperator::possiblyCreateChildAt(const OctreeE
     return NULL; 
 }
 
+Octree::ShardMask MovingEntitiesOperator::getShardMask(const Octree& tree) const {
+    Octree::ShardMask shards = 0;
+    foreach(const EntityToMoveDetails& details, _entitiesToMove) {
+        int oldShard = tree.getShardIndex(details.oldContainingElementCube);
+        int newShard = tree.getShardIndex(details.newCubeClamped);
+        shards |= Octree::shardBit(oldShard) | Octree::shardBit(newShard);
+        if (oldShard != newShard) {
+            shards |= Octree::shardBit(Octree::ROOT_SHARD);
+        }
+    }
+    return shards;
+}
+
 void MovingEntitiesOperator::reset() {
     _entitiesToMove.clear();
     _foundOldCount = 0;
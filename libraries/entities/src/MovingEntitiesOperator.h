@@ -47,6 +47,10 @@ public:
     virtual OctreeElementPointer possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) override;
     bool hasMovingEntities() const { return _entitiesToMove.size() > 0; }
     void reset();
+
+    // The shards changed by the moves, for recursing the tree from a shard section. The moves across shards may
+    // create or prune the children of the root, so they also write the root shard.
+    Octree::ShardMask getShardMask(const Octree& tree) const;
 private:
     bool shouldRecurseSubTree(const OctreeElementPointer& element);
 
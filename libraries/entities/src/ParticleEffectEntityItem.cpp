@@ -34,6 +34,7 @@
 #include <ByteCountCoding.h>
 #include <GeometryUtil.h>
 #include <Interpolate.h>
+#include <InternedStrings.h>
 
 #include "EntityTree.h"
 #include "EntityTreeElement.h"
@@ -565,7 +566,7 @@ int ParticleEffectEntityItem::readEntitySubclassDataFromBuffer(const unsigned ch
     READ_ENTITY_PROPERTY(PROP_ALPHA_START, float, setAlphaStart);
     READ_ENTITY_PROPERTY(PROP_ALPHA_FINISH, float, setAlphaFinish);
 
-    READ_ENTITY_PROPERTY(PROP_TEXTURES, QString, setTextures);
+    READ_ENTITY_SHARED_STRING_PROPERTY(PROP_TEXTURES, setTextures);
     READ_ENTITY_PROPERTY(PROP_EMITTER_SHOULD_TRAIL, bool, setEmitterShouldTrail);
 
     READ_ENTITY_PROPERTY(PROP_PARTICLE_SPIN, float, setParticleSpin);
@@ -671,7 +672,7 @@ void ParticleEffectEntityItem::appendSubclassData(OctreePacketData* packetData,
     APPEND_ENTITY_PROPERTY(PROP_ALPHA_START, getAlphaStart());
     APPEND_ENTITY_PROPERTY(PROP_ALPHA_FINISH, getAlphaFinish());
 
-    APPEND_ENTITY_PROPERTY(PROP_TEXTURES, getTextures());
+    APPEND_ENTITY_SHARED_STRING_PROPERTY(PROP_TEXTURES, getTextures());
     APPEND_ENTITY_PROPERTY(PROP_EMITTER_SHOULD_TRAIL, getEmitterShouldTrail());
 
     APPEND_ENTITY_PROPERTY(PROP_PARTICLE_SPIN, getParticleSpin());
@@ -710,7 +711,7 @@ void ParticleEffectEntityItem::setMaxParticles(quint32 maxParticles) {
 
 void ParticleEffectEntityItem::setTextures(const QString& textures) {
     withWriteLock([&] {
-        _particleProperties.textures = textures;
+        _particleProperties.textures = InternedStrings::intern(textures);
     });
 }
 
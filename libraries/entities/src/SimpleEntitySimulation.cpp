@@ -11,7 +11,9 @@
 
 #include "SimpleEntitySimulation.h"
 
-#include <DirtyOctreeElementOperator.h>
+#include <vector>
+
+#include <tbb/parallel_for.h>
 
 #include "EntityItem.h"
 #include "EntitiesLogging.h"
@@ -38,8 +40,7 @@ void SimpleEntitySimulation::clearOwnership(const QUuid& ownerID) {
             entity->clearSimulationOwnership();
             entity->markAsChangedOnServer();
             if (auto element = entity->getElement()) {
-                DirtyOctreeElementOperator op(element);
-                getEntityTree()->recurseTreeWithOperator(&op);
+                element->bumpChangedContent();
             }
         } else {
             ++itemItr;
@@ -140,12 +141,21 @@ void SimpleEntitySimulation::clearEntitiesInternal() {
 }
 
 void SimpleEntitySimulation::sortEntitiesThatMoved() {
+    // the query cubes of the entities that only move themselves are updated in parallel
+    std::vector<EntityItemPointer> concurrentEntities;
     SetOfEntities::iterator itemItr = _entitiesToSort.begin();
     while (itemItr != _entitiesToSort.end()) {
         EntityItemPointer entity = *itemItr;
-        entity->updateQueryAACube();
+        if (canMoveConcurrently(entity)) {
+            concurrentEntities.push_back(entity);
+        } else {
+            entity->updateQueryAACube();
+        }
         ++itemItr;
     }
+    tbb::parallel_for(size_t(0), concurrentEntities.size(), [&](size_t i) {
+        concurrentEntities[i]->updateQueryAACube();
+    });
     EntitySimulation::sortEntitiesThatMoved();
 }
 
@@ -168,8 +178,9 @@ void SimpleEntitySimulation::expireStaleOwnerships(uint64_t now) {
                 // remove ownership and dirty all the tree elements that contain the it
                 entity->clearSimulationOwnership();
                 entity->markAsChangedOnServer();
-                DirtyOctreeElementOperator op(entity->getElement());
-                getEntityTree()->recurseTreeWithOperator(&op);
+                if (auto element = entity->getElement()) {
+                    element->bumpChangedContent();
+                }
             } else {
                 _nextStaleOwnershipExpiry = glm::min(_nextStaleOwnershipExpiry, expiry);
                 ++itemItr;
@@ -199,8 +210,9 @@ void SimpleEntitySimulation::stopOwnerlessEntities(uint64_t now) {
 
                     // dirty all the tree elements that contain it
                     entity->markAsChangedOnServer();
-                    DirtyOctreeElementOperator op(entity->getElement());
-                    getEntityTree()->recurseTreeWithOperator(&op);
+                    if (auto element = entity->getElement()) {
+                        element->bumpChangedContent();
+                    }
                 }
             } else {
                 _nextOwnerlessExpiry = glm::min(_nextOwnerlessExpiry, expiry);
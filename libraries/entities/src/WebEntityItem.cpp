@@ -15,6 +15,7 @@
 
 #include <ByteCountCoding.h>
 #include <GeometryUtil.h>
+#include <InternedStrings.h>
 
 #include "EntitiesLogging.h"
 #include "EntityItemProperties.h"
@@ -163,7 +164,7 @@ void WebEntityItem::setSourceUrl(const QString& value) {
             auto newURL = QUrl::fromUserInput(value);
 
             if (newURL.isValid()) {
-                _sourceUrl = newURL.toDisplayString();
+                _sourceUrl = InternedStrings::intern(newURL.toDisplayString());
             } else {
                 qCDebug(entities) << "Clearing web entity source URL since" << value << "cannot be parsed to a valid URL.";
             }
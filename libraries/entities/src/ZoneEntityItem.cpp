@@ -14,6 +14,7 @@
 #include <QDebug>
 
 #include <ByteCountCoding.h>
+#include <InternedStrings.h>
 
 #include "EntitiesLogging.h"
 #include "EntityItemProperties.h"
@@ -179,7 +180,7 @@ int ZoneEntityItem::readEntitySubclassDataFromBuffer(const unsigned char* data,
     }
 
     READ_ENTITY_PROPERTY(PROP_SHAPE_TYPE, ShapeType, setShapeType);
-    READ_ENTITY_PROPERTY(PROP_COMPOUND_SHAPE_URL, QString, setCompoundShapeURL);
+    READ_ENTITY_SHARED_STRING_PROPERTY(PROP_COMPOUND_SHAPE_URL, setCompoundShapeURL);
 
     READ_ENTITY_PROPERTY(PROP_FLYING_ALLOWED, bool, setFlyingAllowed);
     READ_ENTITY_PROPERTY(PROP_GHOSTING_ALLOWED, bool, setGhostingAllowed);
@@ -243,7 +244,7 @@ void ZoneEntityItem::appendSubclassData(OctreePacketData* packetData, EncodeBits
         propertyFlags, propertiesDidntFit, propertyCount, appendState);
 
     APPEND_ENTITY_PROPERTY(PROP_SHAPE_TYPE, (uint32_t)getShapeType());
-    APPEND_ENTITY_PROPERTY(PROP_COMPOUND_SHAPE_URL, getCompoundShapeURL());
+    APPEND_ENTITY_SHARED_STRING_PROPERTY(PROP_COMPOUND_SHAPE_URL, getCompoundShapeURL());
 
     APPEND_ENTITY_PROPERTY(PROP_FLYING_ALLOWED, getFlyingAllowed());
     APPEND_ENTITY_PROPERTY(PROP_GHOSTING_ALLOWED, getGhostingAllowed());
@@ -286,7 +287,7 @@ ShapeType ZoneEntityItem::getShapeType() const {
 
 void ZoneEntityItem::setCompoundShapeURL(const QString& url) {
     withWriteLock([&] {
-        _compoundShapeURL = url;
+        _compoundShapeURL = InternedStrings::intern(url);
         if (_compoundShapeURL.isEmpty() && _shapeType == SHAPE_TYPE_COMPOUND) {
             _shapeType = DEFAULT_SHAPE_TYPE;
         }
@@ -38,12 +38,12 @@ static const int MAX_NUM_UNIFORM_BUFFERS = 14;
 static const int MAX_NUM_RESOURCE_BUFFERS = 16;
 static const int MAX_NUM_RESOURCE_TEXTURES = 16;
 
-size_t Batch::_commandsMax{ BATCH_PREALLOCATE_MIN };
-size_t Batch::_commandOffsetsMax{ BATCH_PREALLOCATE_MIN };
-size_t Batch::_paramsMax{ BATCH_PREALLOCATE_MIN };
-size_t Batch::_dataMax{ BATCH_PREALLOCATE_MIN };
-size_t Batch::_objectsMax{ BATCH_PREALLOCATE_MIN };
-size_t Batch::_drawCallInfosMax{ BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_commandsMax{ BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_commandOffsetsMax{ BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_paramsMax{ BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_dataMax{ BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_objectsMax{ BATCH_PREALLOCATE_MIN };
+std::atomic<size_t> Batch::_drawCallInfosMax{ BATCH_PREALLOCATE_MIN };
 
 Batch::Batch(const char* name) {
     _name = name;
@@ -56,12 +56,12 @@ Batch::Batch(const char* name) {
 }
 
 Batch::~Batch() {
-    _commandsMax = std::max(_commands.size(), _commandsMax);
-    _commandOffsetsMax = std::max(_commandOffsets.size(), _commandOffsetsMax);
-    _paramsMax = std::max(_params.size(), _paramsMax);
-    _dataMax = std::max(_data.size(), _dataMax);
-    _objectsMax = std::max(_objects.size(), _objectsMax);
-    _drawCallInfosMax = std::max(_drawCallInfos.size(), _drawCallInfosMax);
+    updateMax(_commandsMax, _commands.size());
+    updateMax(_commandOffsetsMax, _commandOffsets.size());
+    updateMax(_paramsMax, _params.size());
+    updateMax(_dataMax, _data.size());
+    updateMax(_objectsMax, _objects.size());
+    updateMax(_drawCallInfosMax, _drawCallInfos.size());
 }
 
 void Batch::setName(const char* name) {
@@ -69,12 +69,12 @@ void Batch::setName(const char* name) {
 }
 
 void Batch::clear() {
-    _commandsMax = std::max(_commands.size(), _commandsMax);
-    _commandOffsetsMax = std::max(_commandOffsets.size(), _commandOffsetsMax);
-    _paramsMax = std::max(_params.size(), _paramsMax);
-    _dataMax = std::max(_data.size(), _dataMax);
-    _objectsMax = std::max(_objects.size(), _objectsMax);
-    _drawCallInfosMax = std::max(_drawCallInfos.size(), _drawCallInfosMax);
+    updateMax(_commandsMax, _commands.size());
+    updateMax(_commandOffsetsMax, _commandOffsets.size());
+    updateMax(_paramsMax, _params.size());
+    updateMax(_dataMax, _data.size());
+    updateMax(_objectsMax, _objects.size());
+    updateMax(_drawCallInfosMax, _drawCallInfos.size());
 
     _commands.clear();
     _commandOffsets.clear();
@@ -106,6 +106,153 @@ void Batch::clear() {
     _enableSkybox = false;
 }
 
+void Batch::append(const Batch& batch) {
+    assert(batch._currentNamedCall.empty());
+
+    // Offsets of the other batch caches in this one
+    const size_t paramsOffset = _params.size();
+    const size_t dataOffset = _data.size();
+    const size_t objectsOffset = _objects.size();
+    const size_t buffersOffset = _buffers.append(batch._buffers);
+    const size_t texturesOffset = _textures.append(batch._textures);
+    const size_t textureTablesOffset = _textureTables.append(batch._textureTables);
+    const size_t streamFormatsOffset = _streamFormats.append(batch._streamFormats);
+    const size_t transformsOffset = _transforms.append(batch._transforms);
+    const size_t pipelinesOffset = _pipelines.append(batch._pipelines);
+    const size_t framebuffersOffset = _framebuffers.append(batch._framebuffers);
+    const size_t swapChainsOffset = _swapChains.append(batch._swapChains);
+    const size_t queriesOffset = _queries.append(batch._queries);
+    const size_t lambdasOffset = _lambdas.append(batch._lambdas);
+    const size_t profileRangesOffset = _profileRanges.append(batch._profileRanges);
+    const size_t namesOffset = _names.append(batch._names);
+
+    _commands.insert(_commands.end(), batch._commands.begin(), batch._commands.end());
+    _params.insert(_params.end(), batch._params.begin(), batch._params.end());
+    _data.insert(_data.end(), batch._data.begin(), batch._data.end());
+    _objects.insert(_objects.end(), batch._objects.begin(), batch._objects.end());
+
+    // Then relocate the params refering to the caches, the positions match the order the params are pushed
+    // by the recording calls above
+    auto relocate = [&](size_t commandParamsOffset, size_t position, size_t offset) {
+        auto& param = _params[paramsOffset + commandParamsOffset + position];
+        param = Param((size_t)param._uint + offset);
+    };
+    const size_t numCommands = batch._commands.size();
+    _commandOffsets.reserve(_commandOffsets.size() + numCommands);
+    for (size_t i = 0; i < numCommands; i++) {
+        const size_t commandParamsOffset = batch._commandOffsets[i];
+        _commandOffsets.push_back(paramsOffset + commandParamsOffset);
+
+        switch (batch._commands[i]) {
+            case COMMAND_setInputFormat:
+                relocate(commandParamsOffset, 0, streamFormatsOffset);
+                break;
+            case COMMAND_setInputBuffer:
+            case COMMAND_setUniformBuffer:
+                relocate(commandParamsOffset, 2, buffersOffset);
+                break;
+            case COMMAND_setIndexBuffer:
+                relocate(commandParamsOffset, 1, buffersOffset);
+                break;
+            case COMMAND_setIndirectBuffer:
+            case COMMAND_setResourceBuffer:
+                relocate(commandParamsOffset, 0, buffersOffset);
+                break;
+            case COMMAND_setViewTransform:
+                relocate(commandParamsOffset, 0, transformsOffset);
+                break;
+            case COMMAND_setProjectionTransform:
+            case COMMAND_setViewportTransform:
+            case COMMAND_setStateScissorRect:
+            case COMMAND_glUniform3fv:
+            case COMMAND_glUniform4fv:
+            case COMMAND_glUniform4iv:
+            case COMMAND_glUniformMatrix3fv:
+            case COMMAND_glUniformMatrix4fv:
+                relocate(commandParamsOffset, 0, dataOffset);
+                break;
+            case COMMAND_setPipeline:
+                relocate(commandParamsOffset, 0, pipelinesOffset);
+                break;
+            case COMMAND_setResourceTexture:
+            case COMMAND_generateTextureMips:
+            case COMMAND_generateTextureMipsWithPipeline:
+                relocate(commandParamsOffset, 0, texturesOffset);
+                break;
+            case COMMAND_setResourceTextureTable:
+                relocate(commandParamsOffset, 0, textureTablesOffset);
+                break;
+            case COMMAND_setResourceFramebufferSwapChainTexture:
+            case COMMAND_setFramebufferSwapChain:
+            case COMMAND_advance:
+                relocate(commandParamsOffset, 0, swapChainsOffset);
+                break;
+            case COMMAND_setFramebuffer:
+                relocate(commandParamsOffset, 0, framebuffersOffset);
+                break;
+            case COMMAND_blit:
+                relocate(commandParamsOffset, 0, framebuffersOffset);
+                relocate(commandParamsOffset, 5, framebuffersOffset);
+                break;
+            case COMMAND_beginQuery:
+            case COMMAND_endQuery:
+            case COMMAND_getQuery:
+                relocate(commandParamsOffset, 0, queriesOffset);
+                break;
+            case COMMAND_runLambda:
+                relocate(commandParamsOffset, 0, lambdasOffset);
+                break;
+            case COMMAND_startNamedCall:
+                relocate(commandParamsOffset, 0, namesOffset);
+                break;
+            case COMMAND_pushProfileRange:
+                relocate(commandParamsOffset, 0, profileRangesOffset);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // The draw calls point to the transform objects
+    auto appendDrawCallInfos = [&](DrawCallInfoBuffer& drawCallInfos, const DrawCallInfoBuffer& otherDrawCallInfos) {
+        drawCallInfos.reserve(drawCallInfos.size() + otherDrawCallInfos.size());
+        for (const auto& info : otherDrawCallInfos) {
+            drawCallInfos.emplace_back((DrawCallInfo::Index)(info.index + objectsOffset), info.unused);
+        }
+    };
+    appendDrawCallInfos(_drawCallInfos, batch._drawCallInfos);
+
+    // The named calls accumulate their per instance data, so it is appended to the data recorded in this batch
+    for (const auto& mapItem : batch._namedData) {
+        const auto& otherInstance = mapItem.second;
+        auto& instance = _namedData[mapItem.first];
+        if (!instance.function) {
+            instance.function = otherInstance.function;
+        }
+        appendDrawCallInfos(instance.drawCallInfos, otherInstance.drawCallInfos);
+
+        if (instance.buffers.size() < otherInstance.buffers.size()) {
+            instance.buffers.resize(otherInstance.buffers.size());
+        }
+        for (size_t b = 0; b < otherInstance.buffers.size(); b++) {
+            const auto& otherBuffer = otherInstance.buffers[b];
+            if (!otherBuffer || otherBuffer->getSize() == 0) {
+                continue;
+            }
+            if (!instance.buffers[b]) {
+                instance.buffers[b] = std::make_shared<Buffer>();
+            }
+            instance.buffers[b]->append(otherBuffer->getSize(), otherBuffer->getData());
+        }
+    }
+
+    // Continue from the state of the appended batch, the next draw call needs its own transform object
+    _currentModel = batch._currentModel;
+    _invalidModel = true;
+    _drawcallUniform = batch._drawcallUniform;
+    _drawcallUniformReset = batch._drawcallUniformReset;
+}
+
 size_t Batch::cacheData(size_t size, const void* data) {
     size_t offset = _data.size();
     size_t numBytes = size;
@@ -11,6 +11,7 @@
 #ifndef hifi_gpu_Batch_h
 #define hifi_gpu_Batch_h
 
+#include <atomic>
 #include <vector>
 #include <mutex>
 #include <functional>
@@ -79,7 +80,7 @@ public:
     using NamedBatchDataMap = std::map<std::string, NamedBatchData>;
 
     DrawCallInfoBuffer _drawCallInfos;
-    static size_t _drawCallInfosMax;
+    static std::atomic<size_t> _drawCallInfosMax;
 
     mutable std::string _currentNamedCall;
 
@@ -99,6 +100,12 @@ public:
     const char* getName() const { return _name; }
     void clear();
 
+    // Append the commands recorded in another batch, as if they had been recorded at the end of this one
+    // This is how batches recorded concurrently for subsets of a pass are merged, in order, before submission.
+    // The model transform and drawcall uniform states become the ones of the appended batch, which should
+    // have been seeded with the states of this batch before recording.
+    void append(const Batch& batch);
+
     // Batches may need to override the context level stereo settings
     // if they're performing framebuffer copy operations, like the 
     // deferred lighting resolution mechanism
@@ -407,7 +414,7 @@ public:
         typedef T Data;
         Data _data;
         Cache<T>(const Data& data) : _data(data) {}
-        static size_t _max;
+        static std::atomic<size_t> _max;
 
         class Vector {
         public:
@@ -418,7 +425,7 @@ public:
             }
 
             ~Vector() {
-                _max = std::max(_items.size(), _max);
+                updateMax(_max, _items.size());
             }
 
 
@@ -429,6 +436,13 @@ public:
                 return offset;
             }
 
+            // Append the items of another cache, returns the offset of the first appended item
+            size_t append(const Vector& other) {
+                size_t offset = _items.size();
+                _items.insert(_items.end(), other._items.begin(), other._items.end());
+                return offset;
+            }
+
             const Data& get(uint32 offset) const {
                 assert((offset < _items.size()));
                 return (_items.data() + offset)->_data;
@@ -471,17 +485,24 @@ public:
         return (_data.data() + offset);
     }
 
+    // The preallocation sizes are updated from any thread recording batches
+    static void updateMax(std::atomic<size_t>& max, size_t size) {
+        size_t currentMax = max.load(std::memory_order_relaxed);
+        while (size > currentMax && !max.compare_exchange_weak(currentMax, size, std::memory_order_relaxed)) {
+        }
+    }
+
     Commands _commands;
-    static size_t _commandsMax;
+    static std::atomic<size_t> _commandsMax;
 
     CommandOffsets _commandOffsets;
-    static size_t _commandOffsetsMax;
+    static std::atomic<size_t> _commandOffsetsMax;
 
     Params _params;
-    static size_t _paramsMax;
+    static std::atomic<size_t> _paramsMax;
 
     Bytes _data;
-    static size_t _dataMax;
+    static std::atomic<size_t> _dataMax;
 
     // SSBO class... layout MUST match the layout in Transform.slh
     class TransformObject {
@@ -494,7 +515,7 @@ public:
     bool _invalidModel { true };
     Transform _currentModel;
     TransformObjects _objects;
-    static size_t _objectsMax;
+    static std::atomic<size_t> _objectsMax;
 
     BufferCaches _buffers;
     TextureCaches _textures;
@@ -542,7 +563,7 @@ protected:
 };
 
 template <typename T>
-size_t Batch::Cache<T>::_max = BATCH_PREALLOCATE_MIN;
+std::atomic<size_t> Batch::Cache<T>::_max { BATCH_PREALLOCATE_MIN };
 
 }
 
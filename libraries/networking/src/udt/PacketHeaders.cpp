@@ -33,9 +33,11 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::EntityEdit:
         case PacketType::EntityData:
         case PacketType::EntityPhysics:
-            return static_cast<PacketVersion>(EntityVersion::ImageEntities);
+            return static_cast<PacketVersion>(EntityVersion::SharedStrings);
         case PacketType::EntityQuery:
-            return static_cast<PacketVersion>(EntityQueryPacketVersion::ConicalFrustums);
+        case PacketType::EntityQueryCache:
+        case PacketType::EntityQueryResend:
+            return static_cast<PacketVersion>(EntityQueryPacketVersion::ResendRequest);
         case PacketType::AvatarIdentity:
         case PacketType::AvatarData:
         case PacketType::BulkAvatarData:
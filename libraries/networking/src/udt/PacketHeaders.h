@@ -133,6 +133,8 @@ public:
         EntityQueryInitialResultsComplete,
         BulkAvatarTraits,
         AudioSoloRequest,
+        EntityQueryCache,
+        EntityQueryResend,
 
         NUM_PACKET_TYPE
     };
@@ -248,7 +250,8 @@ enum class EntityVersion : PacketVersion {
     MaterialRepeat,
     EntityHostTypes,
     CleanupProperties,
-    ImageEntities
+    ImageEntities,
+    SharedStrings
 };
 
 enum class EntityScriptCallMethodVersion : PacketVersion {
@@ -262,7 +265,9 @@ enum class EntityQueryPacketVersion: PacketVersion {
     ConnectionIdentifier = 20,
     RemovedJurisdictions = 21,
     MultiFrustumQuery = 22,
-    ConicalFrustums = 23
+    ConicalFrustums = 23,
+    ClientCache = 24,
+    ResendRequest = 25
 };
 
 enum class AssetServerPacketVersion: PacketVersion {
@@ -11,6 +11,7 @@
 
 #include "Octree.h"
 
+#include <cassert>
 #include <cstring>
 #include <cstdio>
 #include <cmath>
@@ -44,6 +45,7 @@
 #include <ResourceManager.h>
 #include <SharedUtil.h>
 #include <PathUtils.h>
+#include <ReceivedMessage.h>
 #include <ViewFrustum.h>
 
 #include "OctreeConstants.h"
@@ -68,6 +70,87 @@ Octree::~Octree() {
     eraseAllOctreeElements(false);
 }
 
+int Octree::decodeEditPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode, OctreeDecodedEdits& edits) {
+    int numEditRecords = 0;
+    while (message.getBytesLeftToRead() > 0) {
+        auto editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+        int maxSize = message.getBytesLeftToRead();
+
+        int editDataBytesRead = 0;
+        auto edit = decodeEditPacketData(message, editData, maxSize, sourceNode, editDataBytesRead);
+        numEditRecords++;
+        if (edit) {
+            edits.push_back(std::move(edit));
+        }
+        if (editDataBytesRead <= 0) {
+            break;
+        }
+
+        // skip to next edit record in the packet
+        message.seek(message.getPosition() + editDataBytesRead);
+    }
+    return numEditRecords;
+}
+
+// the shard section of the current thread, a thread is in at most one at a time
+static thread_local const Octree* shardSectionTree { nullptr };
+static thread_local Octree::ShardMask shardSectionWriteShards { 0 };
+
+int Octree::getShardIndex(const AABox& box) const {
+    if (!_rootElement || box.getLargestDimension() > _rootElement->getAACube().getScale() / 2.0f) {
+        return ROOT_SHARD;
+    }
+    int childIndex = _rootElement->getMyChildContaining(box);
+    return childIndex == OctreeElement::CHILD_UNKNOWN ? ROOT_SHARD : childIndex;
+}
+
+bool Octree::canChangeElement(const OctreeElement& element) const {
+    if (shardSectionTree != this) {
+        return true;
+    }
+    return (shardSectionWriteShards & shardBit(getShardIndex(element.getAACube()))) != 0;
+}
+
+void Octree::lockShards(ShardMask readShards, ShardMask writeShards) const {
+    for (int shard = 0; shard < NUMBER_OF_SHARDS; shard++) {
+        if (writeShards & shardBit(shard)) {
+            _shardLocks[shard].lock.lockForWrite();
+        } else if (readShards & shardBit(shard)) {
+            _shardLocks[shard].lock.lockForRead();
+        }
+    }
+}
+
+bool Octree::tryLockShards(ShardMask readShards, int timeout) const {
+    for (int shard = 0; shard < NUMBER_OF_SHARDS; shard++) {
+        if ((readShards & shardBit(shard)) && !_shardLocks[shard].lock.tryLockForRead(timeout)) {
+            // release the shards locked so far
+            unlockShards(readShards & (shardBit(shard) - 1));
+            return false;
+        }
+    }
+    return true;
+}
+
+void Octree::unlockShards(ShardMask shards) const {
+    for (int shard = NUMBER_OF_SHARDS - 1; shard >= 0; shard--) {
+        if (shards & shardBit(shard)) {
+            _shardLocks[shard].lock.unlock();
+        }
+    }
+}
+
+void Octree::beginShardSection(ShardMask writeShards) const {
+    assert(!shardSectionTree);
+    shardSectionTree = this;
+    shardSectionWriteShards = writeShards;
+}
+
+void Octree::endShardSection() const {
+    shardSectionTree = nullptr;
+    shardSectionWriteShards = 0;
+}
+
 // Recurses voxel tree calling the RecurseOctreeOperation function for each element.
 // stops recursion if operation function returns false.
 void Octree::recurseTreeWithOperation(const RecurseOctreeOperation& operation, void* extraData) {
@@ -410,6 +493,7 @@ void Octree::eraseAllOctreeElements(bool createNewRoot) {
     } else {
         _rootElement.reset(); // this will recurse and delete all children
     }
+    _sharedStrings.clear();
 
     _isDirty = true;
 }
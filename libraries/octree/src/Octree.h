@@ -12,9 +12,12 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <set>
 #include <stdint.h>
+#include <vector>
 
 #include <QHash>
 #include <QObject>
@@ -39,6 +42,14 @@ using OctreePointer = std::shared_ptr<Octree>;
 
 extern QVector<QString> PERSIST_EXTENSIONS;
 
+/// An edit record decoded by Octree::decodeEditPacketData(), subclassed by the trees supporting it
+class OctreeDecodedEdit {
+public:
+    virtual ~OctreeDecodedEdit() {}
+};
+using OctreeDecodedEditPointer = std::unique_ptr<OctreeDecodedEdit>;
+using OctreeDecodedEdits = std::vector<OctreeDecodedEditPointer>;
+
 /// derive from this class to use the Octree::recurseTreeWithOperator() method
 class RecurseOctreeOperator {
 public:
@@ -109,6 +120,7 @@ public:
     SharedNodePointer sourceNode;
     int elementsPerPacket = 0;
     int entitiesPerPacket = 0;
+    OctreeSharedStrings* sharedStrings { nullptr };
 
     ReadBitstreamToTreeParams(
         bool includeExistsBits = WANT_EXISTS_BITS,
@@ -138,6 +150,20 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+
+    // Pipelined version of processEditPacketData(), for the trees which can decode edit packets concurrently.
+    // decodeEditPacketData() only reads the packet data and may be called from any thread, the decoded edits are then
+    // passed in order to processDecodedEdits(), which applies them to the tree under its own locks.
+    virtual bool canDecodeEditsConcurrently() const { return false; }
+    virtual OctreeDecodedEditPointer decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                          const SharedNodePointer& sourceNode, int& processedBytes) {
+        processedBytes = 0;
+        return OctreeDecodedEditPointer();
+    }
+    virtual void processDecodedEdits(OctreeDecodedEdits& edits, quint64& lockWaitTime, quint64& processTime) { }
+    // Decodes the edit records of the message from its current position with decodeEditPacketData(), returns the
+    // number of records read, including those which could not be decoded
+    int decodeEditPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode, OctreeDecodedEdits& edits);
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -151,6 +177,9 @@ public:
 
     virtual void eraseAllOctreeElements(bool createNewRoot = true);
 
+    // the strings defined by the server this tree is received from
+    OctreeSharedStrings& getSharedStrings() { return _sharedStrings; }
+
     virtual void readBitstreamToTree(const unsigned char* bitstream,  uint64_t bufferSizeBytes, ReadBitstreamToTreeParams& args);
     void reaverageOctreeElements(OctreeElementPointer startElement = OctreeElementPointer());
 
@@ -170,6 +199,44 @@ public:
 
     void recurseTreeWithOperator(RecurseOctreeOperator* operatorObject);
 
+    // The tree is split in spatial shards, one per child of the root, plus the root element itself, and each shard
+    // has its own lock. A shard section holds the tree lock for reading and then the shard locks, always taken in
+    // ascending order, so that the writers of different shards run concurrently. The full tree readers lock all the
+    // shards for reading, and the full tree writers remain exclusive through the tree lock.
+    // Shard sections must not nest other locks of the tree.
+    using ShardMask = uint16_t;
+    static const int ROOT_SHARD = NUMBER_OF_CHILDREN;
+    static const int NUMBER_OF_SHARDS = NUMBER_OF_CHILDREN + 1;
+    static const ShardMask ALL_SHARDS = (1 << NUMBER_OF_SHARDS) - 1;
+    static ShardMask shardBit(int shard) { return (ShardMask)(1 << shard); }
+
+    // the shard of the smallest subtree containing the box, ROOT_SHARD when it spans several children of the root
+    int getShardIndex(const AABox& box) const;
+    int getShardIndex(const AACube& cube) const { return getShardIndex(AABox(cube)); }
+
+    // false when the current thread is in a shard section of this tree which doesn't write the shard of the element
+    bool canChangeElement(const OctreeElement& element) const;
+
+    template <typename F>
+    void withShardsReadLock(ShardMask shards, F&& f) const;
+    template <typename F>
+    void withShardsWriteLock(ShardMask shards, F&& f) const;
+
+    // full tree reads, which also lock all the shards for reading
+    using ReadWriteLockable::withWriteLock;
+    template <typename F>
+    bool withWriteLock(F&& f, bool require) const;
+    template <typename F>
+    void withReadLock(F&& f) const;
+    template <typename T, typename F>
+    T resultWithReadLock(F&& f) const;
+    template <typename F>
+    bool withReadLock(F&& f, bool require) const;
+    template <typename F>
+    bool withTryReadLock(F&& f) const;
+    template <typename F>
+    bool withTryReadLock(F&& f, int timeout) const;
+
     bool isDirty() const { return _isDirty; }
     void clearDirtyBit() { _isDirty = false; }
     void setDirtyBit() { _isDirty = true; }
@@ -259,6 +326,12 @@ public:
 
 
 protected:
+    void lockShards(ShardMask readShards, ShardMask writeShards) const;
+    bool tryLockShards(ShardMask readShards, int timeout) const;
+    void unlockShards(ShardMask shards) const;
+    void beginShardSection(ShardMask writeShards) const;
+    void endShardSection() const;
+
     void deleteOctalCodeFromTreeRecursion(const OctreeElementPointer& element, void* extraData);
 
     static bool countOctreeElementsOperation(const OctreeElementPointer& element, void* extraData);
@@ -270,14 +343,92 @@ protected:
 
     OctreeElementPointer _rootElement = nullptr;
 
+    OctreeSharedStrings _sharedStrings;
+
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
 
-    bool _isDirty;
+    std::atomic<bool> _isDirty;
     bool _shouldReaverage;
 
     bool _isViewing;
     bool _isServer;
+
+private:
+    struct ShardLock {
+        QReadWriteLock lock { QReadWriteLock::Recursive };
+    };
+    mutable std::array<ShardLock, NUMBER_OF_SHARDS> _shardLocks;
 };
 
+template <typename F>
+inline void Octree::withShardsReadLock(ShardMask shards, F&& f) const {
+    QReadLocker locker(&getLock());
+    // the root element is read by all the traversals
+    shards |= shardBit(ROOT_SHARD);
+    lockShards(shards, 0);
+    f();
+    unlockShards(shards);
+}
+
+template <typename F>
+inline void Octree::withShardsWriteLock(ShardMask shards, F&& f) const {
+    QReadLocker locker(&getLock());
+    lockShards(shardBit(ROOT_SHARD) & ~shards, shards);
+    beginShardSection(shards);
+    f();
+    endShardSection();
+    unlockShards(shards | shardBit(ROOT_SHARD));
+}
+
+template <typename F>
+inline bool Octree::withWriteLock(F&& f, bool require) const {
+    if (require) {
+        ReadWriteLockable::withWriteLock(std::forward<F>(f));
+        return true;
+    } else {
+        return withTryReadLock(std::forward<F>(f));
+    }
+}
+
+template <typename F>
+inline void Octree::withReadLock(F&& f) const {
+    withShardsReadLock(ALL_SHARDS, std::forward<F>(f));
+}
+
+template <typename T, typename F>
+inline T Octree::resultWithReadLock(F&& f) const {
+    T result;
+    withReadLock([&] {
+        result = f();
+    });
+    return result;
+}
+
+template <typename F>
+inline bool Octree::withReadLock(F&& f, bool require) const {
+    if (require) {
+        withReadLock(std::forward<F>(f));
+        return true;
+    } else {
+        return withTryReadLock(std::forward<F>(f));
+    }
+}
+
+template <typename F>
+inline bool Octree::withTryReadLock(F&& f) const {
+    return withTryReadLock(std::forward<F>(f), 0);
+}
+
+template <typename F>
+inline bool Octree::withTryReadLock(F&& f, int timeout) const {
+    QTryReadLocker locker(&getLock(), timeout);
+    if (locker.isLocked() && tryLockShards(ALL_SHARDS, timeout)) {
+        f();
+        unlockShards(ALL_SHARDS);
+        return true;
+    }
+    return false;
+}
+
 #endif // hifi_Octree_h
@@ -635,11 +635,15 @@ int OctreeElement::getMyChildContaining(const AABox& box) const {
 }
 
 int OctreeElement::getMyChildContainingPoint(const glm::vec3& point) const {
-    glm::vec3 ourCenter = _cube.calcCenter();
+    return getChildContainingPoint(_cube, point);
+}
+
+int OctreeElement::getChildContainingPoint(const AACube& cube, const glm::vec3& point) {
+    glm::vec3 ourCenter = cube.calcCenter();
     int childIndex = CHILD_UNKNOWN;
 
     // since point is not contained in our element, it can't be in one of our children
-    if (!_cube.contains(point)) {
+    if (!cube.contains(point)) {
         return CHILD_UNKNOWN;
     }
 
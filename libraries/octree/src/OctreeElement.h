@@ -206,7 +206,10 @@ public:
     int getMyChildContaining(const AABox& box) const;
     int getMyChildContainingPoint(const glm::vec3& point) const;
 
-    void bumpChangedContent() { _lastChangedContent = usecTimestampNow(); }
+    // the index of the child of an element with cube that contains point, as getMyChildContainingPoint()
+    static int getChildContainingPoint(const AACube& cube, const glm::vec3& point);
+
+    virtual void bumpChangedContent() { _lastChangedContent = usecTimestampNow(); }
     uint64_t getLastChangedContent() const { return _lastChangedContent; }
 
 protected:
@@ -224,8 +227,9 @@ protected:
       unsigned char* pointer;
     } _octalCode;
 
-    quint64 _lastChanged; /// Client and server, timestamp this node was last changed, 8 bytes
-    uint64_t _lastChangedContent { 0 };
+    // atomic, the ancestors of the shards are marked by concurrent shard writers
+    std::atomic<quint64> _lastChanged; /// Client and server, timestamp this node was last changed, 8 bytes
+    std::atomic<uint64_t> _lastChangedContent { 0 };
 
     /// Client and server, pointers to child nodes, various encodings
 #ifdef SIMPLE_CHILD_ARRAY
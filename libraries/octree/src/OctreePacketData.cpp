@@ -11,7 +11,10 @@
 
 #include "OctreePacketData.h"
 
+#include <algorithm>
+
 #include <GLMHelpers.h>
+#include <InternedStrings.h>
 #include <PerfStat.h>
 
 #include "OctreeLogging.h"
@@ -25,6 +28,12 @@ AtomicUIntStat OctreePacketData::_totalBytesOfValues { 0 };
 AtomicUIntStat OctreePacketData::_totalBytesOfPositions { 0 };
 AtomicUIntStat OctreePacketData::_totalBytesOfRawData { 0 };
 
+// a shared string starts with one of these markers where a regular string starts with its length, so regular strings
+// are kept well under them, with room for more markers
+const uint16_t MAX_STRING_LENGTH = 0xFF00; // includes NULL
+const uint16_t SHARED_STRING_DEFINITION = 0xFFFE;
+const uint16_t SHARED_STRING_REFERENCE = 0xFFFF;
+
 struct aaCubeData {
     glm::vec3 corner;
     float scale;
@@ -59,6 +68,8 @@ void OctreePacketData::reset() {
     _bytesOfBitMasks = 0;
     _bytesOfColor = 0;
     _bytesOfOctalCodesCurrentSubTree = 0;
+
+    _pendingSharedStrings.clear();
 }
 
 OctreePacketData::~OctreePacketData() {
@@ -222,6 +233,7 @@ void OctreePacketData::discardSubTree() {
     _bytesAvailable += bytesInSubTree; 
     _subTreeAt = _bytesInUse; // should be the same actually...
     _dirty = true;
+    discardSharedStringsAfter(_bytesInUse);
 
     // rewind to start of this subtree, other items rewound by endLevel()
     int reduceBytesOfOctalCodes = _bytesOfOctalCodes - _bytesOfOctalCodesCurrentSubTree;
@@ -261,6 +273,7 @@ void OctreePacketData::discardLevel(LevelDetails key) {
     _bytesInUse -= bytesInLevel;
     _bytesAvailable += bytesInLevel; 
     _dirty = true;
+    discardSharedStringsAfter(_bytesInUse);
     
     // reserved bytes are reset to the value when the level started
     _bytesReserved = key._bytesReservedAtStart;
@@ -502,14 +515,66 @@ bool OctreePacketData::appendValue(bool value) {
 
 bool OctreePacketData::appendValue(const QString& string) {
     // TODO: make this a ByteCountCoded leading byte
-    uint16_t length = string.size() + 1; // include NULL
+    QByteArray bytes = string.toLocal8Bit();
+    if (bytes.size() + 1 > MAX_STRING_LENGTH) {
+        // the length would be read back as a shared string marker, or not fit at all
+        return false;
+    }
+    uint16_t length = bytes.size() + 1; // include NULL
     bool success = appendValue(length);
     if (success) {
-        success = appendRawData((const unsigned char*)qPrintable(string), length);
+        success = appendRawData((const unsigned char*)bytes.constData(), length);
+    }
+    return success;
+}
+
+bool OctreePacketData::appendSharedString(const QString& string) {
+    if (!_sharedStrings || string.isEmpty()) {
+        // appendValue() only writes lengths under MAX_STRING_LENGTH, which can't be taken for the markers
+        return appendValue(string);
+    }
+
+    quint32 id = InternedStrings::getID(string);
+    bool definedInStream = std::any_of(_pendingSharedStrings.begin(), _pendingSharedStrings.end(),
+        [&](const std::pair<int, quint32>& pending) { return pending.second == id; });
+    if (definedInStream || _sharedStrings->canReference(id, usecTimestampNow())) {
+        bool success = appendValue(SHARED_STRING_REFERENCE);
+        if (success) {
+            success = appendValue(id);
+        }
+        return success;
+    }
+
+    int offset = _bytesInUse;
+    bool success = appendValue(SHARED_STRING_DEFINITION);
+    if (success) {
+        success = appendValue(id);
+    }
+    if (success) {
+        success = appendValue(string);
+    }
+    if (success) {
+        _pendingSharedStrings.emplace_back(offset, id);
     }
     return success;
 }
 
+void OctreePacketData::commitSharedStrings() {
+    if (_sharedStrings) {
+        quint64 now = usecTimestampNow();
+        for (const auto& pending : _pendingSharedStrings) {
+            _sharedStrings->markSent(pending.second, now);
+        }
+    }
+    _pendingSharedStrings.clear();
+}
+
+void OctreePacketData::discardSharedStringsAfter(int offset) {
+    while (!_pendingSharedStrings.empty() && _pendingSharedStrings.back().first >= offset) {
+        _pendingSharedStrings.pop_back();
+    }
+}
+
 bool OctreePacketData::appendValue(const QUuid& uuid) {
     QByteArray bytes = uuid.toRfc4122();
     if (uuid.isNull()) {
@@ -711,6 +776,36 @@ int OctreePacketData::unpackDataFromBytes(const unsigned char* dataBytes, QStrin
     return sizeof(length) + length;
 }
 
+int OctreePacketData::unpackSharedStringFromBytes(const unsigned char* dataBytes, QString& result,
+                                                  OctreeSharedStrings* sharedStrings, bool& found) {
+    uint16_t marker;
+    memcpy(&marker, dataBytes, sizeof(marker));
+    if (marker != SHARED_STRING_DEFINITION && marker != SHARED_STRING_REFERENCE) {
+        found = true;
+        return unpackDataFromBytes(dataBytes, result);
+    }
+
+    quint32 id;
+    memcpy(&id, dataBytes + sizeof(marker), sizeof(id));
+    int bytes = sizeof(marker) + sizeof(id);
+    if (marker == SHARED_STRING_DEFINITION) {
+        bytes += unpackDataFromBytes(dataBytes + bytes, result);
+        if (sharedStrings) {
+            sharedStrings->define(id, result);
+        }
+        found = true;
+    } else {
+        found = sharedStrings && sharedStrings->lookup(id, result);
+        if (!found) {
+            qCDebug(octree) << "OctreePacketData::unpackSharedStringFromBytes() ... unknown shared string" << id;
+            if (sharedStrings) {
+                sharedStrings->addUnknownReference(id);
+            }
+        }
+    }
+    return bytes;
+}
+
 int OctreePacketData::unpackDataFromBytes(const unsigned char* dataBytes, QUuid& result) { 
     uint16_t length;
     memcpy(&length, dataBytes, sizeof(length));
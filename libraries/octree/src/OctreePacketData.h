@@ -23,6 +23,7 @@
 #define hifi_OctreePacketData_h
 
 #include <atomic>
+#include <vector>
 
 #include <QByteArray>
 #include <QString>
@@ -38,6 +39,7 @@
 
 #include "OctreeConstants.h"
 #include "OctreeElement.h"
+#include "OctreeSharedStrings.h"
 
 using AtomicUIntStat = std::atomic<uintmax_t>;
 
@@ -186,9 +188,21 @@ public:
     /// appends a bool value to the end of the stream, may fail if new data stream is too long to fit in packet
     bool appendValue(bool value);
 
-    /// appends a string value to the end of the stream, may fail if new data stream is too long to fit in packet
+    /// appends a string value to the end of the stream, may fail if new data stream is too long to fit in packet, or if
+    /// the string is too long for its length to be told apart from a shared string marker
     bool appendValue(const QString& string);
 
+    /// appends a string value that is defined once in the shared strings and referred to by ID afterwards, appends it
+    /// as a regular string when there are no shared strings, may fail if new data stream is too long to fit in packet,
+    /// or if the string is too long for appendValue(const QString&)
+    bool appendSharedString(const QString& string);
+
+    /// the strings shared with the recipient of the stream, owned by the caller
+    void setSharedStrings(OctreeSharedStrings* sharedStrings) { _sharedStrings = sharedStrings; }
+
+    /// records the strings defined in the stream as sent, call once the stream is written to a packet
+    void commitSharedStrings();
+
     /// appends a uuid value to the end of the stream, may fail if new data stream is too long to fit in packet
     bool appendValue(const QUuid& uuid);
 
@@ -267,6 +281,8 @@ public:
     static int unpackDataFromBytes(const unsigned char* dataBytes, glm::vec3& result);
     static int unpackDataFromBytes(const unsigned char* dataBytes, glm::u8vec3& result);
     static int unpackDataFromBytes(const unsigned char* dataBytes, QString& result);
+    static int unpackSharedStringFromBytes(const unsigned char* dataBytes, QString& result,
+                                           OctreeSharedStrings* sharedStrings, bool& found);
     static int unpackDataFromBytes(const unsigned char* dataBytes, QUuid& result);
     static int unpackDataFromBytes(const unsigned char* dataBytes, QVector<glm::vec3>& result);
     static int unpackDataFromBytes(const unsigned char* dataBytes, QVector<glm::quat>& result);
@@ -312,6 +328,11 @@ private:
 
     int _bytesOfOctalCodesCurrentSubTree;
 
+    void discardSharedStringsAfter(int offset);
+
+    OctreeSharedStrings* _sharedStrings { nullptr };
+    std::vector<std::pair<int, quint32>> _pendingSharedStrings; // offsets and IDs of the definitions in the stream
+
     static bool _debug;
 
     static AtomicUIntStat _compressContentTime;
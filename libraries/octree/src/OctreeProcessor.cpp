@@ -14,6 +14,7 @@
 
 #include <glm/glm.hpp>
 
+#include <NodeList.h>
 #include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <SharedUtil.h>
@@ -99,6 +100,9 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
         int subsection = 1;
         
         bool error = false;
+
+        QVector<quint32> unknownStringIDs;
+        QVector<QUuid> unresolvedEntityIDs;
         
         while (message.getBytesLeftToRead() > 0 && !error) {
             if (packetIsCompressed) {
@@ -116,6 +120,7 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
                 // ask the VoxelTree to read the bitstream into the tree
                 ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL,
                                                sourceUUID, sourceNode);
+                args.sharedStrings = &_tree->getSharedStrings();
                 quint64 startUncompress, startLock = usecTimestampNow();
                 quint64 startReadBitsteam, endReadBitsteam;
                 // FIXME STUTTER - there may be an opportunity to bump this lock outside of the
@@ -145,6 +150,7 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
                     startReadBitsteam = usecTimestampNow();
                     _tree->readBitstreamToTree(packetData.getUncompressedData(), packetData.getUncompressedSize(), args);
                     endReadBitsteam = usecTimestampNow();
+                    args.sharedStrings->takeUnresolved(unknownStringIDs, unresolvedEntityIDs);
                     if (extraDebugging) {
                         qCDebug(octree) << "OctreeProcessor::processDatagram() ******* END _tree->readBitstreamToTree()...";
                     }
@@ -166,6 +172,14 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
             }
             subsection++;
         }
+
+        if (!unresolvedEntityIDs.isEmpty()) {
+            // the definitions of these strings were lost, ask the server for them and the entities that referred to them
+            auto packetList = NLPacketList::create(getMyResendRequestMessageType(), QByteArray(), true, true);
+            packetList->write(OctreeSharedStrings::writeResendRequest(unknownStringIDs, unresolvedEntityIDs));
+            DependencyManager::get<NodeList>()->sendPacketList(std::move(packetList), *sourceNode);
+        }
+
         _elementsPerPacket.updateAverage(elementsPerPacket);
         _entitiesPerPacket.updateAverage(entitiesPerPacket);
 
@@ -33,6 +33,7 @@ public:
     virtual char getMyNodeType() const = 0;
     virtual PacketType getMyQueryMessageType() const = 0;
     virtual PacketType getExpectedPacketType() const = 0;
+    virtual PacketType getMyResendRequestMessageType() const = 0;
 
     virtual void setTree(OctreePointer newTree);
 
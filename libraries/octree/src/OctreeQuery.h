@@ -56,6 +56,11 @@ public:
     bool wantReportInitialCompletion() const { return _reportInitialCompletion; }
     void setReportInitialCompletion(bool reportInitialCompletion) { _reportInitialCompletion = reportInitialCompletion; }
 
+    // The client has a cache of this domain and sends its manifest in an EntityQueryCache packet,
+    // the server holds off sending until it arrives.
+    bool hasClientCache() const { return _hasClientCache; }
+    void setHasClientCache(bool hasClientCache) { _hasClientCache = hasClientCache; }
+
 signals:
     void incomingConnectionIDChanged();
 
@@ -78,11 +83,12 @@ protected:
     QJsonObject _jsonParameters;
     QReadWriteLock _jsonParametersLock;
     
-    enum OctreeQueryFlags : uint16_t { NoFlags = 0x0, WantInitialCompletion = 0x1 };
+    enum OctreeQueryFlags : uint16_t { NoFlags = 0x0, WantInitialCompletion = 0x1, HasClientCache = 0x2 };
     friend OctreeQuery::OctreeQueryFlags operator|=(OctreeQuery::OctreeQueryFlags& lhs, const int rhs);
 
     bool _hasReceivedFirstQuery { false };
     bool _reportInitialCompletion { false };
+    bool _hasClientCache { false };
 };
 
 #endif // hifi_OctreeQuery_h
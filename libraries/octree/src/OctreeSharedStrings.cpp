@@ -0,0 +1,70 @@
+//
+//  OctreeSharedStrings.cpp
+//  libraries/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSharedStrings.h"
+
+#include <QtCore/QDataStream>
+
+const quint64 OctreeSharedStrings::DEFAULT_SETTLE_USECS;
+
+bool OctreeSharedStrings::canReference(quint32 id, quint64 now) const {
+    auto itr = _sentTimes.find(id);
+    return itr != _sentTimes.end() && now - itr->second >= _settleUsecs;
+}
+
+void OctreeSharedStrings::markSent(quint32 id, quint64 now) {
+    // only the first definition counts, the later ones are just redundant
+    _sentTimes.emplace(id, now);
+}
+
+void OctreeSharedStrings::define(quint32 id, const QString& value) {
+    _strings[id] = value;
+}
+
+bool OctreeSharedStrings::lookup(quint32 id, QString& value) const {
+    auto itr = _strings.constFind(id);
+    if (itr == _strings.constEnd()) {
+        return false;
+    }
+    value = itr.value();
+    return true;
+}
+
+void OctreeSharedStrings::takeUnresolved(QVector<quint32>& ids, QVector<QUuid>& entityIDs) {
+    ids += _unknownIDs;
+    entityIDs += _unresolvedEntities;
+    _unknownIDs.clear();
+    _unresolvedEntities.clear();
+}
+
+QByteArray OctreeSharedStrings::writeResendRequest(const QVector<quint32>& ids, const QVector<QUuid>& entityIDs) {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << ids << entityIDs;
+    return data;
+}
+
+bool OctreeSharedStrings::readResendRequest(const QByteArray& data, QVector<quint32>& ids, QVector<QUuid>& entityIDs) {
+    QDataStream stream(data);
+    stream >> ids >> entityIDs;
+    if (stream.status() != QDataStream::Ok) {
+        ids.clear();
+        entityIDs.clear();
+        return false;
+    }
+    return true;
+}
+
+void OctreeSharedStrings::clear() {
+    _sentTimes.clear();
+    _strings.clear();
+    _unknownIDs.clear();
+    _unresolvedEntities.clear();
+}
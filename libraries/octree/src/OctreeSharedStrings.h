@@ -0,0 +1,67 @@
+//
+//  OctreeSharedStrings.h
+//  libraries/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSharedStrings_h
+#define hifi_OctreeSharedStrings_h
+
+#include <unordered_map>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+#include <QtCore/QVector>
+
+#include <NumericalConstants.h>
+
+// The strings a server and one of its viewers share, so that a repeated string only crosses the wire once.
+//   The server defines a string with its InternedStrings ID the first times it sends it to the viewer, then refers to it
+//   by that ID.  Octree data packets are unreliable, and a lost definition is only recovered by a nack resend, so the
+//   server keeps defining a string for settleUsecs before it starts referring to it.
+//   On the server one table tracks what was sent to a viewer, on the viewer one table holds what a server defined.
+//   A viewer that still meets a reference it has no definition for asks the server to define the string again and to
+//   resend the entities that referred to it.
+//   OctreeSharedStrings is not thread-safe.
+class OctreeSharedStrings {
+public:
+    static const quint64 DEFAULT_SETTLE_USECS = USECS_PER_SECOND;
+
+    OctreeSharedStrings(quint64 settleUsecs = DEFAULT_SETTLE_USECS) : _settleUsecs(settleUsecs) {}
+
+    // sender side: true when the viewer had time to receive the definition of id
+    bool canReference(quint32 id, quint64 now) const;
+    void markSent(quint32 id, quint64 now);
+    void forget(quint32 id) { _sentTimes.erase(id); }
+
+    // receiver side
+    void define(quint32 id, const QString& value);
+    bool lookup(quint32 id, QString& value) const;
+
+    // receiver side, the references lookup couldn't resolve and the entities they were in
+    void addUnknownReference(quint32 id) { _unknownIDs.push_back(id); }
+    void addUnresolvedEntity(const QUuid& entityID) { _unresolvedEntities.push_back(entityID); }
+    void takeUnresolved(QVector<quint32>& ids, QVector<QUuid>& entityIDs);
+
+    // the payload of the request a viewer sends back for its unresolved references
+    static QByteArray writeResendRequest(const QVector<quint32>& ids, const QVector<QUuid>& entityIDs);
+    static bool readResendRequest(const QByteArray& data, QVector<quint32>& ids, QVector<QUuid>& entityIDs);
+
+    int getNumStrings() const { return (int)_sentTimes.size() + _strings.size(); }
+    void clear();
+
+private:
+    quint64 _settleUsecs;
+    std::unordered_map<quint32, quint64> _sentTimes;
+    QHash<quint32, QString> _strings;
+    QVector<quint32> _unknownIDs;
+    QVector<QUuid> _unresolvedEntities;
+};
+
+#endif // hifi_OctreeSharedStrings_h
@@ -16,6 +16,10 @@ class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // a stateless encoder always produces the same output for the same input,
+    // so its output can be shared by several streams
+    virtual bool isStateless() const { return false; }
 };
 
 class Decoder {
@@ -457,9 +457,9 @@ void DrawStateSortDeferred::run(const RenderContextPointer& renderContext, const
         args->_globalShapeKey = globalKey._flags.to_ulong();
 
         if (_stateSort) {
-            renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey, _multithreaded);
         } else {
-            renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey, _multithreaded);
         }
         args->_batch = nullptr;
         args->_globalShapeKey = 0;
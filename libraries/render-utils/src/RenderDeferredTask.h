@@ -63,6 +63,7 @@ class DrawStateSortConfig : public render::Job::Config {
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
     Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
     Q_PROPERTY(bool stateSort MEMBER stateSort NOTIFY dirty)
+    Q_PROPERTY(bool multithreaded MEMBER multithreaded NOTIFY dirty)
 public:
     int getNumDrawn() { return numDrawn; }
     void setNumDrawn(int num) {
@@ -72,6 +73,8 @@ public:
 
     int maxDrawn{ -1 };
     bool stateSort{ true };
+    // Record the items batch concurrently, off by default until all the payloads render() are thread-safe
+    bool multithreaded{ false };
 
 signals:
     void numDrawnChanged();
@@ -95,6 +98,7 @@ public:
     void configure(const Config& config) {
         _maxDrawn = config.maxDrawn;
         _stateSort = config.stateSort;
+        _multithreaded = config.multithreaded;
     }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
@@ -102,6 +106,7 @@ protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn;  // initialized by Config
     bool _stateSort;
+    bool _multithreaded;
 };
 
 class SetSeparateDeferredDepthBuffer {
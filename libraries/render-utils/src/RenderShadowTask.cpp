@@ -81,41 +81,37 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
     const auto sortedPipelines = task.addJob<PipelineSortShapes>("PipelineSortShadow", culledShadowItems);
     const auto sortedShapes = task.addJob<DepthSortShapes>("DepthSortShadow", sortedPipelines, true);
 
-    render::Varying cascadeFrustums[SHADOW_CASCADE_MAX_COUNT] = {
-        ViewFrustumPointer()
-#if SHADOW_CASCADE_MAX_COUNT>1
-        ,ViewFrustumPointer(),
-        ViewFrustumPointer(),
-        ViewFrustumPointer()
-#endif
-    };
+    // The first cascade is set up before the culling, which only keeps the items passing its filter
+    char jobName[64];
+    const auto firstCascadeSetupOutput = task.addJob<RenderShadowCascadeSetup>("ShadowCascadeSetup0", lightFrame, 0, tagBits, tagMask);
+    const auto receiversFilter = firstCascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(0);
+
+    // Cull the sorted shapes against all the cascades at once
+    const auto cullInputs = CullShadowCascades::Inputs(sortedShapes, lightFrame, receiversFilter).asVarying();
+    const auto culledCascades = task.addJob<CullShadowCascades>("CullShadowCascades", cullInputs);
+    const auto culledCascadeShapes = culledCascades.getN<CullShadowCascades::Outputs>(0);
+    const auto culledCascadeBounds = culledCascades.getN<CullShadowCascades::Outputs>(1);
 
     Output cascadeSceneBBoxes;
 
     for (auto i = 0; i < SHADOW_CASCADE_MAX_COUNT; i++) {
-        char jobName[64];
-        sprintf(jobName, "ShadowCascadeSetup%d", i);
-        const auto cascadeSetupOutput = task.addJob<RenderShadowCascadeSetup>(jobName, lightFrame, i, tagBits, tagMask);
-        const auto shadowFilter = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(0);
-        auto antiFrustum = render::Varying(ViewFrustumPointer());
-        cascadeFrustums[i] = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(1);
-        if (i > 1) {
-            antiFrustum = cascadeFrustums[i - 2];
+        render::Varying cascadeSetupOutput = firstCascadeSetupOutput;
+        if (i > 0) {
+            sprintf(jobName, "ShadowCascadeSetup%d", i);
+            cascadeSetupOutput = task.addJob<RenderShadowCascadeSetup>(jobName, lightFrame, i, tagBits, tagMask);
         }
-
-        const auto cullInputs = CullShadowBounds::Inputs(sortedShapes, shadowFilter, antiFrustum, lightFrame, cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(2)).asVarying();
-        sprintf(jobName, "CullShadowCascade%d", i);
-        const auto culledShadowItemsAndBounds = task.addJob<CullShadowBounds>(jobName, cullInputs);
+        const auto shadowFilter = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(0);
+        const auto cascadeShapes = culledCascadeShapes.getN<CullShadowCascades::CascadeShapes>(i);
+        const auto cascadeBounds = culledCascadeBounds.getN<CullShadowCascades::CascadeBounds>(i);
 
         // GPU jobs: Render to shadow map
         sprintf(jobName, "RenderShadowMap%d", i);
-        const auto shadowInputs = RenderShadowMap::Inputs(culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(0),
-            culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(1), lightFrame).asVarying();
+        const auto shadowInputs = RenderShadowMap::Inputs(cascadeShapes, cascadeBounds, lightFrame).asVarying();
         task.addJob<RenderShadowMap>(jobName, shadowInputs, shapePlumber, i);
         sprintf(jobName, "ShadowCascadeTeardown%d", i);
         task.addJob<RenderShadowCascadeTeardown>(jobName, shadowFilter);
 
-        cascadeSceneBBoxes[i] = culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(1);
+        cascadeSceneBBoxes[i] = cascadeBounds;
     }
 
     output = render::Varying(cascadeSceneBBoxes);
@@ -424,6 +420,18 @@ void RenderShadowSetup::run(const render::RenderContextPointer& renderContext, c
     }
 }
 
+RenderShadowTask::CullFunctor RenderShadowTask::CullFunctor::forCascade(const LightStage::Shadow::Cascade& cascade) {
+    CullFunctor cullFunctor;
+    const auto& cascadeFrustum = cascade.getFrustum();
+    auto texelSize = glm::min(cascadeFrustum->getHeight(), cascadeFrustum->getWidth()) / cascade.framebuffer->getSize().x;
+    // Set the cull threshold to 24 shadow texels. This is totally arbitrary
+    const auto minTexelCount = 24.0f;
+    // TODO : maybe adapt that with LOD management system?
+    texelSize *= minTexelCount;
+    cullFunctor._minSquareSize = texelSize * texelSize;
+    return cullFunctor;
+}
+
 void RenderShadowCascadeSetup::run(const render::RenderContextPointer& renderContext, const Inputs& input, Outputs& output) {
     auto lightStage = renderContext->_scene->getStage<LightStage>();
     const auto& lightFrame = *input;
@@ -432,8 +440,6 @@ void RenderShadowCascadeSetup::run(const render::RenderContextPointer& renderCon
     // Cache old render args
     RenderArgs* args = renderContext->args;
 
-    RenderShadowTask::CullFunctor cullFunctor;
-
     const auto globalShadow = lightStage->getCurrentKeyShadow(lightFrame);
     if (globalShadow && _cascadeIndex < globalShadow->getCascadeCount()) {
         // Second item filter is to filter items to keep in shadow frustum computation (here we need to keep shadow receivers)
@@ -443,19 +449,12 @@ void RenderShadowCascadeSetup::run(const render::RenderContextPointer& renderCon
         auto& cascade = globalShadow->getCascade(_cascadeIndex);
         auto& cascadeFrustum = cascade.getFrustum();
         args->pushViewFrustum(*cascadeFrustum);
-        auto texelSize = glm::min(cascadeFrustum->getHeight(), cascadeFrustum->getWidth()) / cascade.framebuffer->getSize().x;
-        // Set the cull threshold to 24 shadow texels. This is totally arbitrary
-        const auto minTexelCount = 24.0f;
-        // TODO : maybe adapt that with LOD management system?
-        texelSize *= minTexelCount;
-        cullFunctor._minSquareSize = texelSize * texelSize;
 
         output.edit1() = cascadeFrustum;
     } else {
         output.edit0() = ItemFilter::Builder::nothing();
         output.edit1() = ViewFrustumPointer();
     }
-    output.edit2() = cullFunctor;
 }
 
 void RenderShadowCascadeTeardown::run(const render::RenderContextPointer& renderContext, const Input& input) {
@@ -496,85 +495,115 @@ static AABox& merge(AABox& box, const AABox& otherBox, const glm::vec3& dir) {
     return box;
 }
 
-void CullShadowBounds::run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
+void CullShadowCascades::run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
-    assert(renderContext->args->hasViewFrustum());
     RenderArgs* args = renderContext->args;
 
     const auto& inShapes = inputs.get0();
-    const auto& filter = inputs.get1();
-    ViewFrustumPointer antiFrustum;
-    auto& outShapes = outputs.edit0();
-    auto& outBounds = outputs.edit1();
+    const auto& lightFrame = *inputs.get1();
+    const auto& receiversFilter = inputs.get2();
+    auto& outCascadeShapes = outputs.edit0();
+    auto& outCascadeBounds = outputs.edit1();
+
+    for (auto i = 0; i < SHADOW_CASCADE_MAX_COUNT; i++) {
+        outCascadeShapes[i].edit<ShapeBounds>().clear();
+        outCascadeBounds[i].edit<AABox>() = AABox();
+    }
+
+    auto lightStage = renderContext->_scene->getStage<LightStage>();
+    assert(lightStage);
+    const auto globalShadow = lightStage->getCurrentKeyShadow(lightFrame);
+    if (!globalShadow || receiversFilter.selectsNothing()) {
+        return;
+    }
 
-    if (!inputs[3].isNull()) {
-        antiFrustum = inputs.get2();
+    const int numCascades = (int)glm::min(globalShadow->getCascadeCount(), (unsigned int)SHADOW_CASCADE_MAX_COUNT);
+    const ViewFrustum* cascadeFrustums[SHADOW_CASCADE_MAX_COUNT];
+    RenderShadowTask::CullFunctor cullFunctors[SHADOW_CASCADE_MAX_COUNT];
+    ShapeBounds* outShapes[SHADOW_CASCADE_MAX_COUNT];
+    AABox* outBounds[SHADOW_CASCADE_MAX_COUNT];
+    for (auto i = 0; i < numCascades; i++) {
+        const auto& cascade = globalShadow->getCascade(i);
+        cascadeFrustums[i] = cascade.getFrustum().get();
+        cullFunctors[i] = RenderShadowTask::CullFunctor::forCascade(cascade);
+        outShapes[i] = &outCascadeShapes[i].edit<ShapeBounds>();
+        outBounds[i] = &outCascadeBounds[i].edit<AABox>();
     }
-    outShapes.clear();
-    outBounds = AABox();
-
-    const auto& lightFrame = *inputs.get3();
-    auto cullFunctor = inputs.get4();
-
-    render::CullFunctor shadowCullFunctor = [cullFunctor](const RenderArgs* args, const AABox& bounds) {
-        return cullFunctor(args, bounds);
-    };
-
-    if (!filter.selectsNothing()) {
-        auto& details = args->_details.edit(RenderDetails::SHADOW);
-        render::CullTest test(shadowCullFunctor, args, details, antiFrustum);
-        auto scene = args->_scene;
-        auto lightStage = renderContext->_scene->getStage<LightStage>();
-        assert(lightStage);
-        const auto globalLightDir = lightStage->getCurrentKeyLight(lightFrame)->getDirection();
-        auto castersFilter = render::ItemFilter::Builder(filter).withShadowCaster().build();
-        const auto& receiversFilter = filter;
-
-        for (auto& inItems : inShapes) {
-            auto key = inItems.first;
-            auto outItems = outShapes.find(key);
-            if (outItems == outShapes.end()) {
-                outItems = outShapes.insert(std::make_pair(key, ItemBounds{})).first;
-                outItems->second.reserve(inItems.second.size());
+
+    auto& details = args->_details.edit(RenderDetails::SHADOW);
+    auto scene = args->_scene;
+    const auto globalLightDir = lightStage->getCurrentKeyLight(lightFrame)->getDirection();
+    const auto castersFilter = render::ItemFilter::Builder(receiversFilter).withShadowCaster().build();
+
+    for (auto& inItems : inShapes) {
+        const auto& key = inItems.first;
+        const auto& items = inItems.second;
+        const size_t numItems = items.size();
+
+        // One pass over the bounds for all the cascade frustums
+        _bounds.clear();
+        _bounds.reserve(numItems);
+        for (auto& item : items) {
+            _bounds.push_back(item.bound);
+        }
+        _intersectMasks.resize(numItems);
+        _insideMasks.resize(numItems);
+        _bounds.testFrustums(cascadeFrustums, numCascades, _intersectMasks.data(), _insideMasks.data());
+
+        ItemBounds* outItems[SHADOW_CASCADE_MAX_COUNT];
+        for (auto i = 0; i < numCascades; i++) {
+            outItems[i] = &(*outShapes[i])[key];
+            outItems[i]->reserve(numItems);
+        }
+
+        details._considered += (int)numItems * numCascades;
+
+        for (size_t j = 0; j < numItems; j++) {
+            const auto& item = items[j];
+            // Cascade i is skipped for the items that are fully inside cascade i - 2, which already renders them
+            const uint8_t visibleMask = _intersectMasks[j] & (uint8_t)~(_insideMasks[j] << 2);
+
+            uint8_t cascadeMask = 0;
+            for (auto i = 0; i < numCascades; i++) {
+                if (!cullFunctors[i](args, item.bound)) {
+                    details._tooSmall++;
+                } else if (visibleMask & (1 << i)) {
+                    cascadeMask |= (uint8_t)(1 << i);
+                } else {
+                    details._outOfView++;
+                }
+            }
+            if (!cascadeMask) {
+                continue;
             }
 
-            details._considered += (int)inItems.second.size();
-
-            if (antiFrustum == nullptr) {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (castersFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                            outBounds += item.bound;
-                        } else if (receiversFilter.test(shapeKey)) {
-                            // Receivers are not rendered but they still increase the bounds of the shadow scene
-                            // although only in the direction of the light direction so as to have a correct far
-                            // distance without decreasing the near distance.
-                            merge(outBounds, item.bound, globalLightDir);
-                        }
+            const auto shapeKey = scene->getItem(item.id).getKey();
+            if (castersFilter.test(shapeKey)) {
+                for (auto i = 0; i < numCascades; i++) {
+                    if (cascadeMask & (1 << i)) {
+                        outItems[i]->emplace_back(item);
+                        *outBounds[i] += item.bound;
                     }
                 }
-            } else {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (castersFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                            outBounds += item.bound;
-                        } else if (receiversFilter.test(shapeKey)) {
-                            // Receivers are not rendered but they still increase the bounds of the shadow scene
-                            // although only in the direction of the light direction so as to have a correct far
-                            // distance without decreasing the near distance.
-                            merge(outBounds, item.bound, globalLightDir);
-                        }
+            } else if (receiversFilter.test(shapeKey)) {
+                // Receivers are not rendered but they still increase the bounds of the shadow scene
+                // although only in the direction of the light direction so as to have a correct far
+                // distance without decreasing the near distance.
+                for (auto i = 0; i < numCascades; i++) {
+                    if (cascadeMask & (1 << i)) {
+                        merge(*outBounds[i], item.bound, globalLightDir);
                     }
                 }
             }
-            details._rendered += (int)outItems->second.size();
         }
 
-        for (auto& items : outShapes) {
+        for (auto i = 0; i < numCascades; i++) {
+            details._rendered += (int)outItems[i]->size();
+        }
+    }
+
+    for (auto i = 0; i < numCascades; i++) {
+        for (auto& items : *outShapes[i]) {
             items.second.shrink_to_fit();
         }
     }
@@ -66,6 +66,8 @@ public:
             const auto boundsSquareRadius = glm::dot(bounds.getDimensions(), bounds.getDimensions());
             return boundsSquareRadius > _minSquareSize;
         }
+
+        static CullFunctor forCascade(const LightStage::Shadow::Cascade& cascade);
     };
 
     CullFunctor _cullFunctor;
@@ -124,7 +126,7 @@ private:
 class RenderShadowCascadeSetup {
 public:
     using Inputs = LightStage::FramePointer;
-    using Outputs = render::VaryingSet3<render::ItemFilter, ViewFrustumPointer, RenderShadowTask::CullFunctor>;
+    using Outputs = render::VaryingSet2<render::ItemFilter, ViewFrustumPointer>;
     using JobModel = render::Job::ModelIO<RenderShadowCascadeSetup, Inputs, Outputs>;
 
     RenderShadowCascadeSetup(unsigned int cascadeIndex, uint8_t tagBits = 0x00, uint8_t tagMask = 0x00) :
@@ -152,13 +154,25 @@ public:
     void run(const render::RenderContextPointer& renderContext, const Input& input);
 };
 
-class CullShadowBounds {
+// Culls the shadow shapes against all the cascades in a single pass
+//   Each item is tested once against every cascade frustum (and its anti-frustum, the cascade two levels below) and
+//   the resulting per-item cascade bitmask dispatches it to the ShapeBounds of each cascade it is visible in.
+//   The items are filtered with the item filter of the first RenderShadowCascadeSetup, the casters are rendered and
+//   the other receivers only extend the cascade bounds.
+class CullShadowCascades {
 public:
-    using Inputs = render::VaryingSet5<render::ShapeBounds, render::ItemFilter, ViewFrustumPointer, LightStage::FramePointer, RenderShadowTask::CullFunctor>;
-    using Outputs = render::VaryingSet2<render::ShapeBounds, AABox>;
-    using JobModel = render::Job::ModelIO<CullShadowBounds, Inputs, Outputs>;
+    using CascadeShapes = render::VaryingArray<render::ShapeBounds, SHADOW_CASCADE_MAX_COUNT>;
+    using CascadeBounds = render::VaryingArray<AABox, SHADOW_CASCADE_MAX_COUNT>;
+    using Inputs = render::VaryingSet3<render::ShapeBounds, LightStage::FramePointer, render::ItemFilter>;
+    using Outputs = render::VaryingSet2<CascadeShapes, CascadeBounds>;
+    using JobModel = render::Job::ModelIO<CullShadowCascades, Inputs, Outputs>;
 
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs);
+
+private:
+    render::ItemBoundsSoA _bounds;
+    std::vector<uint8_t> _intersectMasks;
+    std::vector<uint8_t> _insideMasks;
 };
 
 #endif // hifi_RenderShadowTask_h
@@ -14,11 +14,101 @@
 #include <algorithm>
 #include <assert.h>
 
+#include <tbb/parallel_for.h>
+
 #include <PerfStat.h>
 #include <OctreeUtils.h>
 
 using namespace render;
 
+void ItemBoundsSoA::clear() {
+    _minX.clear();
+    _minY.clear();
+    _minZ.clear();
+    _maxX.clear();
+    _maxY.clear();
+    _maxZ.clear();
+}
+
+void ItemBoundsSoA::reserve(size_t size) {
+    _minX.reserve(size);
+    _minY.reserve(size);
+    _minZ.reserve(size);
+    _maxX.reserve(size);
+    _maxY.reserve(size);
+    _maxZ.reserve(size);
+}
+
+void ItemBoundsSoA::push_back(const AABox& bound) {
+    const glm::vec3& corner = bound.getCorner();
+    const glm::vec3 farCorner = bound.calcTopFarLeft();
+    _minX.push_back(corner.x);
+    _minY.push_back(corner.y);
+    _minZ.push_back(corner.z);
+    _maxX.push_back(farCorner.x);
+    _maxY.push_back(farCorner.y);
+    _maxZ.push_back(farCorner.z);
+}
+
+void ItemBoundsSoA::testFrustum(const ViewFrustum& frustum, uint8_t* inView) const {
+    const size_t numBounds = size();
+    std::fill(inView, inView + numBounds, (uint8_t)1);
+
+    const ::Plane* planes = frustum.getPlanes();
+    for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+        const glm::vec3& normal = planes[p].getNormal();
+        const float d = planes[p].getDCoefficient();
+
+        // the vertex farthest along the normal is picked per axis, as in AABox::getFarthestVertex()
+        const float* x = (normal.x > 0.0f) ? _maxX.data() : _minX.data();
+        const float* y = (normal.y > 0.0f) ? _maxY.data() : _minY.data();
+        const float* z = (normal.z > 0.0f) ? _maxZ.data() : _minZ.data();
+
+        for (size_t i = 0; i < numBounds; i++) {
+            float distance = d + (normal.x * x[i] + normal.y * y[i] + normal.z * z[i]);
+            inView[i] &= (uint8_t)(distance >= 0.0f);
+        }
+    }
+}
+
+void ItemBoundsSoA::testFrustums(const ViewFrustum* const* frustums, int numFrustums, uint8_t* intersectMasks, uint8_t* insideMasks) const {
+    assert(numFrustums <= MAX_FRUSTUMS);
+    const size_t numBounds = size();
+    const uint8_t allFrustums = (uint8_t)((1 << numFrustums) - 1);
+    std::fill(intersectMasks, intersectMasks + numBounds, allFrustums);
+    if (insideMasks) {
+        std::fill(insideMasks, insideMasks + numBounds, allFrustums);
+    }
+
+    for (int f = 0; f < numFrustums; f++) {
+        const uint8_t clearBit = (uint8_t)~(1 << f);
+        const ::Plane* planes = frustums[f]->getPlanes();
+        for (int p = 0; p < NUM_FRUSTUM_PLANES; p++) {
+            const glm::vec3& normal = planes[p].getNormal();
+            const float d = planes[p].getDCoefficient();
+
+            // farthest vertex for the intersection test, nearest vertex for the inside test
+            const float* farX = (normal.x > 0.0f) ? _maxX.data() : _minX.data();
+            const float* farY = (normal.y > 0.0f) ? _maxY.data() : _minY.data();
+            const float* farZ = (normal.z > 0.0f) ? _maxZ.data() : _minZ.data();
+            for (size_t i = 0; i < numBounds; i++) {
+                float distance = d + (normal.x * farX[i] + normal.y * farY[i] + normal.z * farZ[i]);
+                intersectMasks[i] &= (distance >= 0.0f) ? (uint8_t)0xFF : clearBit;
+            }
+
+            if (insideMasks) {
+                const float* nearX = (normal.x < 0.0f) ? _maxX.data() : _minX.data();
+                const float* nearY = (normal.y < 0.0f) ? _maxY.data() : _minY.data();
+                const float* nearZ = (normal.z < 0.0f) ? _maxZ.data() : _minZ.data();
+                for (size_t i = 0; i < numBounds; i++) {
+                    float distance = d + (normal.x * nearX[i] + normal.y * nearY[i] + normal.z * nearZ[i]);
+                    insideMasks[i] &= (distance >= 0.0f) ? (uint8_t)0xFF : clearBit;
+                }
+            }
+        }
+    }
+}
+
 CullTest::CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails, ViewFrustumPointer antiFrustum) :
     _functor(functor),
     _args(pargs),
@@ -173,6 +263,7 @@ void CullSpatialSelection::configure(const Config& config) {
     _justFrozeFrustum = _justFrozeFrustum || (config.freezeFrustum && !_freezeFrustum);
     _freezeFrustum = config.freezeFrustum;
     _skipCulling = config.skipCulling;
+    _multithreaded = config.multithreaded;
 }
 
 void CullSpatialSelection::run(const RenderContextPointer& renderContext,
@@ -195,8 +286,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
     }
 
-    CullTest test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -209,136 +298,31 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
+        // when culling is disabled, all items are only filtered
+        bool cull = !_skipCulling;
 
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-        } else {
-
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
+        // inside & fit items: easy, just filter
+        {
+            PerformanceTimer perfTimer("insideFitItems");
+            cullSelectionItems(args, *scene, filter, inSelection.insideItems, false, false, details, outItems);
+        }
 
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
-            }
+        // inside & subcell items: filter & distance cull
+        {
+            PerformanceTimer perfTimer("insideSmallItems");
+            cullSelectionItems(args, *scene, filter, inSelection.insideSubcellItems, false, cull, details, outItems);
+        }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & fit items: filter & frustum cull
+        {
+            PerformanceTimer perfTimer("partialFitItems");
+            cullSelectionItems(args, *scene, filter, inSelection.partialItems, cull, false, details, outItems);
+        }
 
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            if (test.solidAngleTest(itemBound.bound)) {
-                                outItems.emplace_back(itemBound);
-                                if (item.getKey().isMetaCullGroup()) {
-                                    item.fetchMetaSubItemBounds(outItems, (*scene));
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & subcell items:: filter & frutum cull & solidangle cull
+        {
+            PerformanceTimer perfTimer("partialSmallItems");
+            cullSelectionItems(args, *scene, filter, inSelection.partialSubcellItems, cull, cull, details, outItems);
         }
     }
 
@@ -352,6 +336,89 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     std::static_pointer_cast<Config>(renderContext->jobConfig)->numItems = (int)outItems.size();
 }
 
+void CullSpatialSelection::cullSelectionItems(RenderArgs* args, Scene& scene, const ItemFilter& filter, const ItemIDs& inItems,
+                                              bool testFrustum, bool testSolidAngle, RenderDetails::Item& details, ItemBounds& outItems) {
+    const size_t CHUNK_SIZE = 1024;
+    const size_t numChunks = (inItems.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (numChunks == 0) {
+        return;
+    }
+    if (_chunks.size() < numChunks) {
+        _chunks.resize(numChunks);
+    }
+
+    auto cullRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            size_t offset = i * CHUNK_SIZE;
+            size_t count = std::min(CHUNK_SIZE, inItems.size() - offset);
+            cullChunk(args, scene, filter, inItems.data() + offset, count, testFrustum, testSolidAngle, _chunks[i]);
+        }
+    };
+
+    if (_multithreaded && numChunks > 1) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), [&](const tbb::blocked_range<size_t>& range) {
+            cullRange(range.begin(), range.end());
+        });
+    } else {
+        cullRange(0, numChunks);
+    }
+
+    // gather the chunks in order
+    for (size_t i = 0; i < numChunks; i++) {
+        auto& chunk = _chunks[i];
+        outItems.insert(outItems.end(), chunk.outItems.begin(), chunk.outItems.end());
+        details._outOfView += chunk.outOfView;
+        details._tooSmall += chunk.tooSmall;
+    }
+}
+
+void CullSpatialSelection::cullChunk(RenderArgs* args, Scene& scene, const ItemFilter& filter, const ItemID* inItems, size_t numItems,
+                                     bool testFrustum, bool testSolidAngle, CullChunk& chunk) const {
+    chunk.candidates.clear();
+    chunk.outItems.clear();
+    chunk.outOfView = 0;
+    chunk.tooSmall = 0;
+
+    // filter
+    for (size_t i = 0; i < numItems; i++) {
+        auto id = inItems[i];
+        auto& item = scene.getItem(id);
+        if (filter.test(item.getKey())) {
+            chunk.candidates.emplace_back(id, item.getBound());
+        }
+    }
+
+    // frustum cull all the candidates at once
+    if (testFrustum) {
+        chunk.candidateBounds.clear();
+        chunk.candidateBounds.reserve(chunk.candidates.size());
+        for (auto& candidate : chunk.candidates) {
+            chunk.candidateBounds.push_back(candidate.bound);
+        }
+        chunk.inView.resize(chunk.candidates.size());
+        chunk.candidateBounds.testFrustum(args->getViewFrustum(), chunk.inView.data());
+    }
+
+    // solid angle cull, and expand the meta cull groups
+    for (size_t i = 0; i < chunk.candidates.size(); i++) {
+        const auto& candidate = chunk.candidates[i];
+        if (testFrustum && !chunk.inView[i]) {
+            chunk.outOfView++;
+            continue;
+        }
+        if (testSolidAngle && !_cullFunctor(args, candidate.bound)) {
+            chunk.tooSmall++;
+            continue;
+        }
+
+        chunk.outItems.emplace_back(candidate);
+        auto& item = scene.getItem(candidate.id);
+        if (item.getKey().isMetaCullGroup()) {
+            item.fetchMetaSubItemBounds(chunk.outItems, scene);
+        }
+    }
+}
+
 void CullShapeBounds::run(const RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -22,6 +22,29 @@ namespace render {
     void cullItems(const RenderContextPointer& renderContext, const CullFunctor& cullFunctor, RenderDetails::Item& details,
         const ItemBounds& inItems, ItemBounds& outItems);
 
+    // Item bounds laid out as a structure of arrays, so the frustum test of many bounds vectorizes
+    class ItemBoundsSoA {
+    public:
+        void clear();
+        void reserve(size_t size);
+        void push_back(const AABox& bound);
+        size_t size() const { return _minX.size(); }
+
+        // inView[i] is set to 1 if bound i intersects the frustum (as in ViewFrustum::boxIntersectsFrustum), 0 otherwise
+        void testFrustum(const ViewFrustum& frustum, uint8_t* inView) const;
+
+        // Tests all the bounds against up to MAX_FRUSTUMS frustums in one pass
+        // bit f of intersectMasks[i] is set if bound i intersects frustums[f] (as in ViewFrustum::boxIntersectsFrustum)
+        // bit f of insideMasks[i] is set if bound i is fully inside frustums[f] (as in ViewFrustum::boxInsideFrustum)
+        // insideMasks can be null when only the intersection is needed
+        static const int MAX_FRUSTUMS = 8;
+        void testFrustums(const ViewFrustum* const* frustums, int numFrustums, uint8_t* intersectMasks, uint8_t* insideMasks = nullptr) const;
+
+    private:
+        std::vector<float> _minX, _minY, _minZ;
+        std::vector<float> _maxX, _maxY, _maxZ;
+    };
+
     // Culling Frustum / solidAngle test helper class
     struct CullTest {
         CullFunctor _functor;
@@ -86,15 +109,18 @@ namespace render {
         Q_PROPERTY(int numItems READ getNumItems)
         Q_PROPERTY(bool freezeFrustum MEMBER freezeFrustum WRITE setFreezeFrustum)
         Q_PROPERTY(bool skipCulling MEMBER skipCulling WRITE setSkipCulling)
+        Q_PROPERTY(bool multithreaded MEMBER multithreaded WRITE setMultithreaded)
     public:
         int numItems{ 0 };
         int getNumItems() { return numItems; }
 
         bool freezeFrustum{ false };
         bool skipCulling{ false };
+        bool multithreaded{ true };
     public slots:
         void setFreezeFrustum(bool enabled) { freezeFrustum = enabled; emit dirty(); }
         void setSkipCulling(bool enabled) { skipCulling = enabled; emit dirty(); }
+        void setMultithreaded(bool enabled) { multithreaded = enabled; emit dirty(); }
     signals:
         void dirty();
     };
@@ -103,7 +129,25 @@ namespace render {
         bool _freezeFrustum{ false }; // initialized by Config
         bool _justFrozeFrustum{ false };
         bool _skipCulling{ false };
+        bool _multithreaded{ true };
         ViewFrustum _frozenFrustum;
+
+        // Items are culled in fixed size chunks, possibly across threads,
+        // and the chunk outputs are concatenated in order so the result does not depend on scheduling
+        struct CullChunk {
+            ItemBounds candidates;
+            ItemBoundsSoA candidateBounds;
+            std::vector<uint8_t> inView;
+            ItemBounds outItems;
+            int outOfView{ 0 };
+            int tooSmall{ 0 };
+        };
+        std::vector<CullChunk> _chunks;
+
+        void cullSelectionItems(RenderArgs* args, Scene& scene, const ItemFilter& filter, const ItemIDs& inItems,
+                                bool testFrustum, bool testSolidAngle, RenderDetails::Item& details, ItemBounds& outItems);
+        void cullChunk(RenderArgs* args, Scene& scene, const ItemFilter& filter, const ItemID* inItems, size_t numItems,
+                       bool testFrustum, bool testSolidAngle, CullChunk& chunk) const;
     public:
         using Config = CullSpatialSelectionConfig;
         using Inputs = render::VaryingSet2<ItemSpatialTree::ItemSelection, ItemFilter>;
@@ -13,6 +13,9 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <unordered_set>
+
+#include <tbb/parallel_for.h>
 
 #include <LogHandler.h>
 #include <PerfStat.h>
@@ -42,6 +45,64 @@ void render::renderItems(const RenderContextPointer& renderContext, const ItemBo
 namespace {
     int repeatedInvalidKeyMessageID = 0;
     std::once_flag messageIDFlag;
+
+    // Number of items recorded per batch when recording concurrently
+    const int RECORD_CHUNK_SIZE = 256;
+
+    using RecordChunk = std::function<void(RenderArgs* args, int begin, int end)>;
+
+    // Record chunks of items concurrently, each one with its own copy of the args and a batch acquired from the context,
+    // then append the chunk batches in order to the current batch.
+    // The batches return to the context pool once appended, so their memory is reused from frame to frame.
+    void recordChunks(RenderArgs* args, int numItems, const RecordChunk& recordChunk) {
+        const int numChunks = (numItems + RECORD_CHUNK_SIZE - 1) / RECORD_CHUNK_SIZE;
+        const auto& mainBatch = *args->_batch;
+
+        std::vector<gpu::BatchPointer> batches(numChunks);
+        std::vector<RenderDetails> details(numChunks);
+        tbb::parallel_for(0, numChunks, [&](int chunk) {
+            RenderArgs chunkArgs(*args);
+            auto batch = args->_context->acquireBatch(mainBatch.getName());
+            batch->_currentModel = mainBatch._currentModel;
+            batch->_drawcallUniform = mainBatch._drawcallUniform;
+            batch->_drawcallUniformReset = mainBatch._drawcallUniformReset;
+            batch->_projectionJitter = mainBatch._projectionJitter;
+            chunkArgs._batch = batch.get();
+            chunkArgs._details = RenderDetails();
+
+            int begin = chunk * RECORD_CHUNK_SIZE;
+            recordChunk(&chunkArgs, begin, std::min(begin + RECORD_CHUNK_SIZE, numItems));
+
+            chunkArgs._batch = nullptr;
+            batches[chunk] = batch;
+            details[chunk] = chunkArgs._details;
+        });
+
+        for (int chunk = 0; chunk < numChunks; ++chunk) {
+            args->_batch->append(*batches[chunk]);
+            args->_details._materialSwitches += details[chunk]._materialSwitches;
+            args->_details._trianglesRendered += details[chunk]._trianglesRendered;
+        }
+    }
+
+    // Concurrent recording needs more than one chunk, and stays serial while the performance timers are recording
+    // since they are not thread-safe
+    bool shouldRecordChunks(bool multithreaded, int numItems) {
+        return multithreaded && numItems > RECORD_CHUNK_SIZE && !PerformanceTimer::isActive();
+    }
+
+    // Custom pipelines are created and missing keys are recorded on first pick, so every key is picked once
+    // before the concurrent recording, in a scratch batch
+    template <typename Keys>
+    void preparePipelines(RenderArgs* args, const ShapePlumberPointer& shapeContext, const Keys& keys) {
+        auto mainBatch = args->_batch;
+        auto batch = args->_context->acquireBatch();
+        args->_batch = batch.get();
+        for (const auto& key : keys) {
+            shapeContext->pickPipeline(args, key);
+        }
+        args->_batch = mainBatch;
+    }
 }
 
 void renderShape(RenderArgs* args, const ShapePlumberPointer& shapeContext, const Item& item, const ShapeKey& globalKey) {
@@ -66,7 +127,7 @@ void renderShape(RenderArgs* args, const ShapePlumberPointer& shapeContext, cons
 }
 
 void render::renderShapes(const RenderContextPointer& renderContext,
-    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey) {
+    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey, bool multithreaded) {
     auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
 
@@ -74,6 +135,26 @@ void render::renderShapes(const RenderContextPointer& renderContext,
     if (maxDrawnItems != -1) {
         numItemsToDraw = glm::min(numItemsToDraw, maxDrawnItems);
     }
+
+    if (shouldRecordChunks(multithreaded, numItemsToDraw)) {
+        std::unordered_set<ShapeKey, ShapeKey::Hash, ShapeKey::KeyEqual> keys;
+        for (auto i = 0; i < numItemsToDraw; ++i) {
+            auto key = scene->getItem(inItems[i].id).getShapeKey() | globalKey;
+            if (key.isValid() && !key.hasOwnPipeline()) {
+                keys.insert(key);
+            }
+        }
+        preparePipelines(args, shapeContext, keys);
+
+        recordChunks(args, numItemsToDraw, [&](RenderArgs* chunkArgs, int begin, int end) {
+            for (auto i = begin; i < end; ++i) {
+                auto& item = scene->getItem(inItems[i].id);
+                renderShape(chunkArgs, shapeContext, item, globalKey);
+            }
+        });
+        return;
+    }
+
     for (auto i = 0; i < numItemsToDraw; ++i) {
         auto& item = scene->getItem(inItems[i].id);
         renderShape(args, shapeContext, item, globalKey);
@@ -81,7 +162,7 @@ void render::renderShapes(const RenderContextPointer& renderContext,
 }
 
 void render::renderStateSortShapes(const RenderContextPointer& renderContext,
-    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey) {
+    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey, bool multithreaded) {
     auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
 
@@ -118,6 +199,49 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
     }
 
     // Then render
+    if (shouldRecordChunks(multithreaded, numItemsToDraw)) {
+        preparePipelines(args, shapeContext, sortedPipelines);
+
+        // Flatten the sorted buckets, each chunk picks the pipeline of its first item and again when the key changes
+        std::vector<std::tuple<Item*, ShapeKey>> sortedItems;
+        sortedItems.reserve(numItemsToDraw);
+        for (auto& pipelineKey : sortedPipelines) {
+            for (auto& item : sortedShapes[pipelineKey]) {
+                sortedItems.push_back(std::make_tuple(&item, pipelineKey));
+            }
+        }
+        for (auto& itemAndKey : ownPipelineBucket) {
+            sortedItems.push_back(std::make_tuple(&std::get<0>(itemAndKey), std::get<1>(itemAndKey)));
+        }
+
+        recordChunks(args, (int)sortedItems.size(), [&](RenderArgs* chunkArgs, int begin, int end) {
+            ShapeKey currentKey = ShapeKey::Builder::invalid();
+            for (auto i = begin; i < end; ++i) {
+                auto& item = *std::get<0>(sortedItems[i]);
+                const auto& key = std::get<1>(sortedItems[i]);
+                if (key.hasOwnPipeline()) {
+                    currentKey = ShapeKey::Builder::invalid();
+                    chunkArgs->_shapePipeline = nullptr;
+                    chunkArgs->_itemShapeKey = key._flags.to_ulong();
+                    item.render(chunkArgs);
+                    continue;
+                }
+                if (key._flags != currentKey._flags) {
+                    currentKey = key;
+                    chunkArgs->_shapePipeline = shapeContext->pickPipeline(chunkArgs, key);
+                    chunkArgs->_itemShapeKey = key._flags.to_ulong();
+                }
+                if (chunkArgs->_shapePipeline) {
+                    chunkArgs->_shapePipeline->prepareShapeItem(chunkArgs, key, item);
+                    item.render(chunkArgs);
+                }
+            }
+            chunkArgs->_shapePipeline = nullptr;
+            chunkArgs->_itemShapeKey = 0;
+        });
+        return;
+    }
+
     for (auto& pipelineKey : sortedPipelines) {
         auto& bucket = sortedShapes[pipelineKey];
         args->_shapePipeline = shapeContext->pickPipeline(args, pipelineKey);
@@ -10,8 +10,14 @@
 //
 #include "Scene.h"
 
+#include <algorithm>
 #include <numeric>
+
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
@@ -223,26 +229,42 @@ uint32_t Scene::enqueueFrame() {
     return ++_transactionFrameNumber;
 }
 
- 
-void Scene::processTransactionQueue() {
+
+// Item resets are applied in batches, the time budget being checked in between
+const size_t RESET_BATCH_SIZE = 1024;
+
+// Below that many resets or updated items, the payloads are evaluated serially
+const size_t PARALLEL_TRANSACTION_MIN_ITEMS = 256;
+
+void Scene::processTransactionQueue(uint64_t timeBudget, bool multithreaded) {
     PROFILE_RANGE(render, __FUNCTION__);
 
-    static TransactionFrames queuedFrames;
     {
-        // capture the queued frames and clear the queue
+        // capture the queued frames after the ones left over by the previous call, and clear the queue
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
-        queuedFrames.swap(_transactionFrames);
+        _pendingTransactionFrames.insert(_pendingTransactionFrames.end(),
+            std::make_move_iterator(_transactionFrames.begin()), std::make_move_iterator(_transactionFrames.end()));
+        _transactionFrames.clear();
     }
 
-    // go through the queue of frames and process them
-    for (auto& frame : queuedFrames) {
-        processTransactionFrame(frame);
+    const uint64_t deadline = (timeBudget > 0) ? usecTimestampNow() + timeBudget : 0;
+
+    // go through the queue of frames and process them, until the budget is spent
+    size_t numProcessedFrames = 0;
+    while (numProcessedFrames < _pendingTransactionFrames.size()) {
+        if (!processTransactionFrame(_pendingTransactionFrames[numProcessedFrames], deadline, multithreaded)) {
+            break;
+        }
+        numProcessedFrames++;
+        if (deadline > 0 && usecTimestampNow() > deadline) {
+            break;
+        }
     }
 
-    queuedFrames.clear();
+    _pendingTransactionFrames.erase(_pendingTransactionFrames.begin(), _pendingTransactionFrames.begin() + numProcessedFrames);
 }
 
-void Scene::processTransactionFrame(const Transaction& transaction) {
+bool Scene::processTransactionFrame(Transaction& transaction, uint64_t deadline, bool multithreaded) {
     PROFILE_RANGE(render, __FUNCTION__);
     {
         std::unique_lock<std::mutex> lock(_itemsMutex);
@@ -255,14 +277,30 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         // Now we know for sure that we have enough items in the array to
         // capture anything coming from the transaction
 
-        // resets and potential NEW items
-        resetItems(transaction._resetItems);
+        // resets and potential NEW items, at least one batch per call so the queue always moves forward
+        const size_t numResets = transaction._resetItems.size();
+        size_t numAppliedResets = 0;
+        while (numAppliedResets < numResets) {
+            size_t batchEnd = std::min(numAppliedResets + RESET_BATCH_SIZE, numResets);
+            resetItems(transaction._resetItems, numAppliedResets, batchEnd, multithreaded);
+            numAppliedResets = batchEnd;
+            if (deadline > 0 && numAppliedResets < numResets && usecTimestampNow() > deadline) {
+                break;
+            }
+        }
 
         // Update the numItemsAtomic counter AFTER the reset changes went through
         _numAllocatedItems.exchange(maxID);
 
+        if (numAppliedResets < numResets) {
+            // Out of time, the rest of the frame is carried over
+            auto& resets = transaction._resetItems;
+            resets.erase(resets.begin(), resets.begin() + numAppliedResets);
+            return false;
+        }
+
         // updates
-        updateItems(transaction._updatedItems);
+        updateItems(transaction._updatedItems, multithreaded);
 
         // removes
         removeItems(transaction._removedItems);
@@ -286,29 +324,82 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
     resetHighlights(transaction._highlightResets);
     removeHighlights(transaction._highlightRemoves);
     queryHighlights(transaction._highlightQueries);
-}
+    return true;
+}
+
+void Scene::resetItems(const Transaction::Resets& transactions, size_t begin, size_t end, bool multithreaded) {
+    const size_t numResets = end - begin;
+
+    // Eval the keys, bounds and cell locations of the new payloads first, they are only read so this can run in parallel
+    _resetStates.resize(numResets);
+    auto evalResetStates = [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            const auto& payload = std::get<1>(transactions[begin + i]);
+            auto& state = _resetStates[i];
+            state.key = payload->getKey();
+            if (state.key.isSpatial() && !state.key.isViewSpace()) {
+                state.bound = payload->getBound();
+                state.location = _masterSpatialTree.evalItemLocation(state.bound, state.key);
+            }
+        }
+    };
+    if (multithreaded && numResets >= PARALLEL_TRANSACTION_MIN_ITEMS) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numResets), [&](const tbb::blocked_range<size_t>& range) {
+            evalResetStates(range.begin(), range.end());
+        });
+    } else {
+        evalResetStates(0, numResets);
+    }
 
-void Scene::resetItems(const Transaction::Resets& transactions) {
-    for (auto& reset : transactions) {
+    // Then apply the resets in order, the new spatial items being inserted in the tree in bulk
+    for (size_t i = 0; i < numResets; i++) {
         // Access the true item
-        auto itemId = std::get<0>(reset);
+        auto itemId = std::get<0>(transactions[begin + i]);
         auto& item = _items[itemId];
+
+        // The item was already reset in this batch, its insertion has to go through first
+        if (!_spatialInsertionIDs.empty() && _spatialInsertionIDs.count(itemId)) {
+            insertSpatialItems();
+        }
+
         auto oldKey = item.getKey();
         auto oldCell = item.getCell();
 
         // Reset the item with a new payload
-        item.resetPayload(std::get<1>(reset));
+        item.resetPayload(std::get<1>(transactions[begin + i]));
         auto newKey = item.getKey();
 
         // Update the item's container
         assert((oldKey.isSpatial() == newKey.isSpatial()) || oldKey._flags.none());
         if (newKey.isSpatial()) {
-            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), itemId, newKey);
-            item.resetCell(newCell, newKey.isSmall());
+            const auto& state = _resetStates[i];
+            if (oldCell == Item::INVALID_CELL && !newKey.isViewSpace()) {
+                _spatialInsertions.push_back({ itemId, state.key, state.location });
+                _spatialInsertionIDs.insert(itemId);
+            } else {
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, state.bound, itemId, newKey);
+                item.resetCell(newCell, newKey.isSmall());
+            }
         } else {
             _masterNonspatialSet.insert(itemId);
         }
     }
+
+    insertSpatialItems();
+}
+
+void Scene::insertSpatialItems() {
+    if (_spatialInsertions.empty()) {
+        return;
+    }
+
+    _masterSpatialTree.insertItems(_spatialInsertions);
+    for (const auto& insertion : _spatialInsertions) {
+        _items[insertion.id].resetCell(insertion.cell, insertion.key.isSmall());
+    }
+
+    _spatialInsertions.clear();
+    _spatialInsertionIDs.clear();
 }
 
 void Scene::removeItems(const Transaction::Removes& transactions) {
@@ -333,40 +424,94 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
     }
 }
 
-void Scene::updateItems(const Transaction::Updates& transactions) {
-    for (auto& update : transactions) {
-        auto updateID = std::get<0>(update);
-        if (updateID == Item::INVALID_ITEM_ID) {
-            continue;
+void Scene::updateItems(const Transaction::Updates& transactions, bool multithreaded) {
+    // Group the updates by item, keeping their order for each item
+    _updateOrder.clear();
+    _updateOrder.reserve(transactions.size());
+    for (uint32_t i = 0; i < (uint32_t)transactions.size(); i++) {
+        auto updateID = std::get<0>(transactions[i]);
+        if (updateID != Item::INVALID_ITEM_ID) {
+            _updateOrder.emplace_back(updateID, i);
+        }
+    }
+    if (multithreaded && _updateOrder.size() >= PARALLEL_TRANSACTION_MIN_ITEMS) {
+        tbb::parallel_sort(_updateOrder.begin(), _updateOrder.end());
+    } else {
+        std::sort(_updateOrder.begin(), _updateOrder.end());
+    }
+
+    _updateStates.clear();
+    for (size_t i = 0; i < _updateOrder.size(); i++) {
+        if (_updateStates.empty() || _updateStates.back().id != _updateOrder[i].first) {
+            _updateStates.push_back({ _updateOrder[i].first, i, i });
         }
+        _updateStates.back().end = i + 1;
+    }
 
+    // The update functors run serially, on this thread, as the payloads they touch aren't made to be updated concurrently
+    for (auto& state : _updateStates) {
         // Access the true item
-        auto& item = _items[updateID];
+        auto& item = _items[state.id];
 
         // If item doesn't exist it cannot be updated
-        if (!item.exist()) {
+        state.exists = item.exist();
+        if (!state.exists) {
             continue;
         }
 
-        // Good to go, deal with the update
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
+        state.oldCell = item.getCell();
+        state.oldKey = item.getKey();
 
         // Update the item
-        item.update(std::get<1>(update));
+        for (size_t u = state.begin; u < state.end; u++) {
+            item.update(std::get<1>(transactions[_updateOrder[u].second]));
+        }
+    }
+
+    // The new bounds are only read from the payloads, so they can be evaluated in parallel
+    auto evalBounds = [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            auto& state = _updateStates[i];
+            if (!state.exists) {
+                continue;
+            }
+            auto newKey = _items[state.id].getKey();
+            if (newKey.isSpatial() && !newKey.isViewSpace()) {
+                state.bound = _items[state.id].getBound();
+            }
+        }
+    };
+    if (multithreaded && _updateStates.size() >= PARALLEL_TRANSACTION_MIN_ITEMS) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, _updateStates.size()), [&](const tbb::blocked_range<size_t>& range) {
+            evalBounds(range.begin(), range.end());
+        });
+    } else {
+        evalBounds(0, _updateStates.size());
+    }
+
+    // Then update the containers serially
+    for (const auto& state : _updateStates) {
+        if (!state.exists) {
+            continue;
+        }
+
+        auto updateID = state.id;
+        auto& item = _items[updateID];
+        const auto& oldCell = state.oldCell;
+        const auto& oldKey = state.oldKey;
         auto newKey = item.getKey();
 
         // Update the item's container
         if (oldKey.isSpatial() == newKey.isSpatial()) {
             if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, state.bound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             }
         } else {
             if (newKey.isSpatial()) {
                 _masterNonspatialSet.erase(updateID);
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, state.bound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             } else {
                 _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
@@ -12,6 +12,8 @@
 #ifndef hifi_render_Scene_h
 #define hifi_render_Scene_h
 
+#include <unordered_set>
+
 #include "Item.h"
 #include "SpatialTree.h"
 #include "Stage.h"
@@ -145,7 +147,14 @@ public:
     uint32_t enqueueFrame();
 
     // Process the pending transactions queued
-    void processTransactionQueue();
+    // With a time budget (in usecs), the item resets left when the budget is spent are carried over, along with the rest
+    // of their frame and the following frames, to the next call. A zero budget processes everything.
+    // When multithreaded, the keys and bounds of the reset and updated items are evaluated in parallel, the update
+    // functors still run serially.
+    void processTransactionQueue(uint64_t timeBudget = 0, bool multithreaded = false);
+
+    // Number of transaction frames enqueued but not processed yet
+    size_t getNumPendingTransactionFrames() const { return _pendingTransactionFrames.size(); }
 
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
@@ -199,8 +208,12 @@ protected:
     TransactionFrames _transactionFrames;
     uint32_t _transactionFrameNumber{ 0 };
 
-    // Process one transaction frame 
-    void processTransactionFrame(const Transaction& transaction);
+    // Frames waiting to be processed, only accessed from the processing thread
+    TransactionFrames _pendingTransactionFrames;
+
+    // Process one transaction frame, returns false if it ran out of time before the end of the item resets
+    // in which case the applied resets are removed from the transaction
+    bool processTransactionFrame(Transaction& transaction, uint64_t deadline, bool multithreaded);
 
     // The actual database
     // database of items is protected for editing by a mutex
@@ -209,9 +222,32 @@ protected:
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
 
-    void resetItems(const Transaction::Resets& transactions);
+    void resetItems(const Transaction::Resets& transactions, size_t begin, size_t end, bool multithreaded);
     void removeItems(const Transaction::Removes& transactions);
-    void updateItems(const Transaction::Updates& transactions);
+    void updateItems(const Transaction::Updates& transactions, bool multithreaded);
+    void insertSpatialItems();
+
+    // Scratch state of resetItems and updateItems, kept to avoid reallocations
+    struct ItemResetState {
+        ItemKey key;
+        AABox bound;
+        ItemSpatialTree::Location location;
+    };
+    std::vector<ItemResetState> _resetStates;
+    ItemSpatialTree::ItemInsertions _spatialInsertions;
+    std::unordered_set<ItemID> _spatialInsertionIDs;
+
+    struct ItemUpdateState {
+        ItemID id;
+        size_t begin; // first update of the item in _updateOrder
+        size_t end;
+        bool exists;
+        ItemKey oldKey;
+        ItemCell oldCell;
+        AABox bound;
+    };
+    std::vector<std::pair<ItemID, uint32_t>> _updateOrder;
+    std::vector<ItemUpdateState> _updateStates;
     void transitionItems(const Transaction::TransitionAdds& transactions);
     void reApplyTransitions(const Transaction::TransitionReApplies& transactions);
     void queryTransitionItems(const Transaction::TransitionQueries& transactions);
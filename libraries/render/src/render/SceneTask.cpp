@@ -10,12 +10,22 @@
 //
 #include "SceneTask.h"
 
+#include <algorithm>
+
+#include <NumericalConstants.h>
+
 
 using namespace render;
 
 void PerformSceneTransaction::configure(const Config& config) {
+    _timeBudget = (uint64_t)(std::max(config.timeBudget, 0.0f) * USECS_PER_MSEC);
+    _multithreaded = config.multithreaded;
 }
 
 void PerformSceneTransaction::run(const RenderContextPointer& renderContext) {
-    renderContext->_scene->processTransactionQueue();
+    auto& scene = renderContext->_scene;
+    scene->processTransactionQueue(_timeBudget, _multithreaded);
+
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+    config->numPendingFrames = (int)scene->getNumPendingTransactionFrames();
 }
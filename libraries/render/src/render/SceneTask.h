@@ -18,7 +18,20 @@ namespace render {
 
     class PerformSceneTransactionConfig : public Job::Config {
         Q_OBJECT
+        Q_PROPERTY(float timeBudget MEMBER timeBudget WRITE setTimeBudget) // in ms, 0 for no budget
+        Q_PROPERTY(bool multithreaded MEMBER multithreaded WRITE setMultithreaded)
+        Q_PROPERTY(int numPendingFrames READ getNumPendingFrames)
     public:
+        float timeBudget{ 4.0f };
+        bool multithreaded{ true };
+
+        int numPendingFrames{ 0 };
+        int getNumPendingFrames() { return numPendingFrames; }
+
+    public slots:
+        void setTimeBudget(float budget) { timeBudget = budget; emit dirty(); }
+        void setMultithreaded(bool enabled) { multithreaded = enabled; emit dirty(); }
+
     signals:
         void dirty();
 
@@ -33,6 +46,8 @@ namespace render {
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext);
     protected:
+        uint64_t _timeBudget{ 0 }; // initialized by Config, in usecs
+        bool _multithreaded{ true };
     };
 
 
@@ -13,6 +13,10 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
 #include <ViewFrustum.h>
 
 using namespace render;
@@ -28,26 +32,32 @@ struct ItemBoundSort {
     ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
 };
 
+// ties are broken by id, so the order does not depend on the sort algorithm or the number of threads
 struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
+    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) const {
+        return (left._centerDepth < right._centerDepth) ||
+            (left._centerDepth == right._centerDepth && left._id < right._id);
     }
 };
 
 struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
+    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) const {
+        return (left._centerDepth > right._centerDepth) ||
+            (left._centerDepth == right._centerDepth && left._id < right._id);
     }
 };
 
+// below this many items, the depth sort stays on the calling thread
+const size_t PARALLEL_SORT_MIN_ITEMS = 4096;
+
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, 
                             const ItemBounds& inItems, ItemBounds& outItems, AABox* bounds) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
-
+    const ViewFrustum& frustum = args->getViewFrustum();
+    const bool parallel = inItems.size() >= PARALLEL_SORT_MIN_ITEMS;
 
     // Allocate and simply copy
     outItems.clear();
@@ -55,24 +65,39 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
 
 
     // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
+    std::vector<ItemBoundSort> itemBoundSorts(inItems.size());
 
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound();
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
+    auto computeDepths = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const auto& itemDetails = inItems[i];
+            float distanceSquared = frustum.distanceToCameraSquared(itemDetails.bound.calcCenter());
+            itemBoundSorts[i] = ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, itemDetails.bound);
+        }
+    };
 
-        itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
+    if (parallel) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, inItems.size()), [&](const tbb::blocked_range<size_t>& range) {
+            computeDepths(range.begin(), range.end());
+        });
+    } else {
+        computeDepths(0, inItems.size());
     }
 
     // sort against Z
     if (frontToBack) {
         FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
+        if (parallel) {
+            tbb::parallel_sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
+        } else {
+            std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
+        }
     } else {
         BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
+        if (parallel) {
+            tbb::parallel_sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
+        } else {
+            std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
+        }
     }
 
     // Finally once sorted result to a list of itemID and keep uniques
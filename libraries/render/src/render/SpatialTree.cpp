@@ -10,6 +10,9 @@
 //
 #include "SpatialTree.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include <ViewFrustum.h>
 
 using namespace render;
@@ -379,23 +382,61 @@ bool ItemSpatialTree::removeItem(Index cellIdx, const ItemKey& key, const ItemID
     return success;
 }
 
+ItemSpatialTree::Location ItemSpatialTree::evalItemLocation(const AABox& bound, ItemKey& key) const {
+    Coord3f minCoordf, maxCoordf;
+    auto location = evalLocation(bound, minCoordf, maxCoordf);
+
+    // Compare range size vs cell location size and tag itemKey accordingly
+    // If Item bound fits in sub cell then tag as small
+    auto rangeSizef = maxCoordf - minCoordf;
+    float cellHalfSize = 0.5f * getCellWidth(location.depth);
+    bool subcellItem = std::max(std::max(rangeSizef.x, rangeSizef.y), rangeSizef.z) < cellHalfSize;
+    key.setSmaller(subcellItem);
+
+    return location;
+}
+
+void ItemSpatialTree::insertItems(ItemInsertions& insertions) {
+    // Sort by location, keeping the insertion order within a cell
+    std::vector<uint32_t> order(insertions.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t left, uint32_t right) {
+        const auto& leftLoc = insertions[left].location;
+        const auto& rightLoc = insertions[right].location;
+        if (leftLoc.depth != rightLoc.depth) {
+            return leftLoc.depth < rightLoc.depth;
+        }
+        if (leftLoc.pos.x != rightLoc.pos.x) {
+            return leftLoc.pos.x < rightLoc.pos.x;
+        }
+        if (leftLoc.pos.y != rightLoc.pos.y) {
+            return leftLoc.pos.y < rightLoc.pos.y;
+        }
+        return leftLoc.pos.z < rightLoc.pos.z;
+    });
+
+    // Then walk down the tree once per location
+    Location cellLocation;
+    Index cell = INVALID_CELL;
+    bool cellIndexed = false;
+    for (auto index : order) {
+        auto& insertion = insertions[index];
+        if (!cellIndexed || !(insertion.location == cellLocation)) {
+            cellLocation = insertion.location;
+            cell = indexCell(cellLocation);
+            cellIndexed = true;
+        }
+        if (cell != INVALID_CELL) {
+            insertItem(cell, insertion.key, insertion.id);
+        }
+        insertion.cell = cell;
+    }
+}
+
 ItemSpatialTree::Index ItemSpatialTree::resetItem(Index oldCell, const ItemKey& oldKey, const AABox& bound, const ItemID& item, ItemKey& newKey) {
     auto newCell = INVALID_CELL;
     if (!newKey.isViewSpace()) {
-        Coord3f minCoordf, maxCoordf;
-        auto location = evalLocation(bound, minCoordf, maxCoordf);
-
-        // Compare range size vs cell location size and tag itemKey accordingly
-        // If Item bound fits in sub cell then tag as small
-        auto rangeSizef = maxCoordf - minCoordf;
-        float cellHalfSize = 0.5f * getCellWidth(location.depth);
-        bool subcellItem = std::max(std::max(rangeSizef.x, rangeSizef.y), rangeSizef.z) < cellHalfSize;
-        if (subcellItem) {
-            newKey.setSmaller(subcellItem);
-        } else {
-            newKey.setSmaller(false);
-        }
-
+        auto location = evalItemLocation(bound, newKey);
         newCell = indexCell(location);
     } else {
         // A very rare case, if we were adding items with boundary semantic expressed in view space
@@ -446,6 +446,22 @@ namespace render {
 
         Index resetItem(Index oldCell, const ItemKey& oldKey, const AABox& bound, const ItemID& item, ItemKey& newKey);
 
+        // Eval the cell location of an item bound and tag the key as small if the bound fits in a subcell, as resetItem does
+        // This is a const call so it can run concurrently for many items
+        Location evalItemLocation(const AABox& bound, ItemKey& key) const;
+
+        // Bulk insertion of items not in the tree yet, at their precomputed locations
+        // The insertions are grouped by location so each cell is indexed only once, the resulting cell of each item
+        // is returned in the insertion (INVALID_CELL if it couldn't be allocated)
+        struct ItemInsertion {
+            ItemID id;
+            ItemKey key;
+            Location location;
+            Index cell { INVALID_CELL };
+        };
+        using ItemInsertions = std::vector<ItemInsertion>;
+        void insertItems(ItemInsertions& insertions);
+
         // Selection and traverse
         int selectCells(CellSelection& selection, const ViewFrustum& frustum, float threshold) const;
 
@@ -720,6 +720,7 @@ void ScriptEngine::init() {
 
     registerGlobalObject("Entities", entityScriptingInterface.data());
     registerFunction("Entities", "getMultipleEntityProperties", EntityScriptingInterface::getMultipleEntityProperties);
+    registerFunction("Entities", "getPackedEntityProperties", EntityScriptingInterface::getPackedEntityProperties);
     registerGlobalObject("Quat", &_quatLibrary);
     registerGlobalObject("Vec3", &_vec3Library);
     registerGlobalObject("Mat4", &_mat4Library);
@@ -1030,7 +1031,10 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
     }
 
     // Check syntax
-    auto syntaxError = lintScript(sourceCode, fileName);
+    QScriptValue syntaxError;
+    ScriptProgramCache::Entry cacheEntry;
+    auto programKey = ScriptProgramCache::hashProgram(sourceCode, fileName, lineNumber);
+    QScriptProgram program = getProgram(programKey, sourceCode, fileName, lineNumber, syntaxError, cacheEntry);
     if (syntaxError.isError()) {
         if (!isEvaluating()) {
             syntaxError.setProperty("detail", "evaluate");
@@ -1039,7 +1043,6 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
         maybeEmitUncaughtException("lint");
         return syntaxError;
     }
-    QScriptProgram program { sourceCode, fileName, lineNumber };
     if (program.isNull()) {
         // can this happen?
         auto err = makeError("could not create QScriptProgram for " + fileName);
@@ -1048,6 +1051,19 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
         return err;
     }
 
+    return evaluateProgram(program);
+}
+
+QScriptValue ScriptEngine::evaluateProgram(const QScriptProgram& program) {
+    if (DependencyManager::get<ScriptEngines>()->isStopped()) {
+        return QScriptValue(); // bail early
+    }
+
+    if (QThread::currentThread() != thread()) {
+        // the compiled form of a program belongs to the thread that evaluated it, so hand over its source instead
+        return evaluate(program.sourceCode(), program.fileName(), program.firstLineNumber());
+    }
+
     QScriptValue result;
     {
         result = BaseScriptEngine::evaluate(program);
@@ -1056,6 +1072,35 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
     return result;
 }
 
+QScriptProgram ScriptEngine::getProgram(const ScriptProgramCache::Key& key, const QString& sourceCode, const QString& fileName,
+                                        int lineNumber, QScriptValue& syntaxError, ScriptProgramCache::Entry& cacheEntry) {
+    auto& programCache = ScriptProgramCache::instance();
+    if (programCache.find(key, cacheEntry)) {
+        // already checked, possibly by another engine.  reuse our compiled copy if we have one.
+        QScriptProgram* cachedProgram = _programs.object(key);
+        if (cachedProgram) {
+            return *cachedProgram;
+        }
+        QScriptProgram program { sourceCode, fileName, lineNumber };
+        if (!program.isNull()) {
+            _programs.insert(key, new QScriptProgram(program));
+        }
+        return program;
+    }
+
+    quint64 start = usecTimestampNow();
+    syntaxError = lintScript(sourceCode, fileName);
+    if (syntaxError.isError()) {
+        return QScriptProgram();
+    }
+    QScriptProgram program { sourceCode, fileName, lineNumber };
+    if (!program.isNull()) {
+        programCache.insert(key, usecTimestampNow() - start);
+        _programs.insert(key, new QScriptProgram(program));
+    }
+    return program;
+}
+
 void ScriptEngine::run() {
     auto filenameParts = _fileNameString.split("/");
     auto name = filenameParts.size() > 0 ? filenameParts[filenameParts.size() - 1] : "unknown";
@@ -1982,6 +2027,11 @@ int ScriptEngine::getNumRunningEntityScripts() const {
     return sum;
 }
 
+QHash<EntityItemID, quint64> ScriptEngine::getEntityScriptUsecs() const {
+    QReadLocker locker { &_entityScriptsLock };
+    return _entityScriptUsecs;
+}
+
 void ScriptEngine::setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details) {
     {
         QWriteLocker locker { &_entityScriptsLock };
@@ -2210,7 +2260,10 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
     }
 
     // SYNTAX ERRORS
-    auto syntaxError = lintScript(contents, fileName);
+    QScriptValue syntaxError;
+    ScriptProgramCache::Entry cacheEntry;
+    auto programKey = ScriptProgramCache::hashProgram(contents, fileName, 1);
+    QScriptProgram program = getProgram(programKey, contents, fileName, 1, syntaxError, cacheEntry);
     if (syntaxError.isError()) {
         auto message = syntaxError.property("formatted").toString();
         if (message.isEmpty()) {
@@ -2221,7 +2274,6 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         emit unhandledException(syntaxError);
         return;
     }
-    QScriptProgram program { contents, fileName };
     if (program.isNull()) {
         setError("Bad program (isNull)", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
         emit unhandledException(makeError("program.isNull"));
@@ -2233,61 +2285,67 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
     }
 
     // SANITY/PERFORMANCE CHECK USING SANDBOX
-    const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
-    BaseScriptEngine sandbox;
-    sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
-    QScriptValue testConstructor, exception;
-    {
-        QTimer timeout;
-        timeout.setSingleShot(true);
-        timeout.start(SANDBOX_TIMEOUT);
-        connect(&timeout, &QTimer::timeout, [=, &sandbox]{
-                qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout";
-
-                // Guard against infinite loops and non-performant code
-                sandbox.raiseException(
-                    sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
-                );
-        });
+    // identical sources already passed this check when they were first loaded, so only new sources are run here.
+    if (!cacheEntry.preflightPassed) {
+        const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
+        BaseScriptEngine sandbox;
+        sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
+        QScriptValue testConstructor, exception;
+        {
+            QTimer timeout;
+            timeout.setSingleShot(true);
+            timeout.start(SANDBOX_TIMEOUT);
+            connect(&timeout, &QTimer::timeout, [=, &sandbox]{
+                    qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout";
+
+                    // Guard against infinite loops and non-performant code
+                    sandbox.raiseException(
+                        sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
+                    );
+            });
 
-        testConstructor = sandbox.evaluate(program);
+            // evaluate a separate program, so the cached one stays compiled for this engine
+            testConstructor = sandbox.evaluate(QScriptProgram(contents, fileName));
 
-        if (sandbox.hasUncaughtException()) {
-            exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
-            sandbox.clearExceptions();
-        } else if (testConstructor.isError()) {
-            exception = testConstructor;
+            if (sandbox.hasUncaughtException()) {
+                exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
+                sandbox.clearExceptions();
+            } else if (testConstructor.isError()) {
+                exception = testConstructor;
+            }
         }
-    }
-
-    if (exception.isError()) {
-        // create a local copy using makeError to decouple from the sandbox engine
-        exception = makeError(exception);
-        setError(formatException(exception, _enableExtendedJSExceptions.get()), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(exception);
-        return;
-    }
 
-    // CONSTRUCTOR VIABILITY
-    if (!testConstructor.isFunction()) {
-        QString testConstructorType = QString(testConstructor.toVariant().typeName());
-        if (testConstructorType == "") {
-            testConstructorType = "empty";
-        }
-        QString testConstructorValue = testConstructor.toString();
-        if (testConstructorValue.size() > MAX_DEBUG_VALUE_LENGTH) {
-            testConstructorValue = testConstructorValue.mid(0, MAX_DEBUG_VALUE_LENGTH) + "...";
+        if (exception.isError()) {
+            // create a local copy using makeError to decouple from the sandbox engine
+            exception = makeError(exception);
+            setError(formatException(exception, _enableExtendedJSExceptions.get()), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            emit unhandledException(exception);
+            return;
         }
-        auto message = QString("failed to load entity script -- expected a function, got %1, %2")
-            .arg(testConstructorType).arg(testConstructorValue);
 
-        auto err = makeError(message);
-        err.setProperty("fileName", scriptOrURL);
-        err.setProperty("detail", "(constructor " + entityID.toString() + ")");
+        // CONSTRUCTOR VIABILITY
+        if (!testConstructor.isFunction()) {
+            QString testConstructorType = QString(testConstructor.toVariant().typeName());
+            if (testConstructorType == "") {
+                testConstructorType = "empty";
+            }
+            QString testConstructorValue = testConstructor.toString();
+            if (testConstructorValue.size() > MAX_DEBUG_VALUE_LENGTH) {
+                testConstructorValue = testConstructorValue.mid(0, MAX_DEBUG_VALUE_LENGTH) + "...";
+            }
+            auto message = QString("failed to load entity script -- expected a function, got %1, %2")
+                .arg(testConstructorType).arg(testConstructorValue);
+
+            auto err = makeError(message);
+            err.setProperty("fileName", scriptOrURL);
+            err.setProperty("detail", "(constructor " + entityID.toString() + ")");
 
-        setError("Could not find constructor (" + testConstructorType + ")", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(err);
-        return; // done processing script
+            setError("Could not find constructor (" + testConstructorType + ")", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            emit unhandledException(err);
+            return; // done processing script
+        }
+
+        ScriptProgramCache::instance().setPreflightPassed(programKey);
     }
 
     // (this feeds into refreshFileScript)
@@ -2301,7 +2359,7 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
     QScriptValue entityScriptConstructor, entityScriptObject;
     QUrl sandboxURL = currentSandboxURL.isEmpty() ? scriptOrURL : currentSandboxURL;
     auto initialization = [&]{
-        entityScriptConstructor = evaluate(contents, fileName);
+        entityScriptConstructor = evaluateProgram(program);
         entityScriptObject = entityScriptConstructor.construct();
 
         if (hasUncaughtException()) {
@@ -2377,6 +2435,7 @@ void ScriptEngine::unloadEntityScript(const EntityItemID& entityID, bool shouldR
             {
                 QWriteLocker locker { &_entityScriptsLock };
                 _entityScripts.remove(entityID);
+                _totalEntityScriptUsecs -= _entityScriptUsecs.take(entityID);
             }
             emit entityScriptDetailsUpdated();
         } else if (oldDetails.status != EntityScriptStatus::UNLOADED) {
@@ -2416,6 +2475,8 @@ void ScriptEngine::unloadAllEntityScripts() {
     {
         QWriteLocker locker{ &_entityScriptsLock };
         _entityScripts.clear();
+        _entityScriptUsecs.clear();
+        _totalEntityScriptUsecs = 0;
     }
     emit entityScriptDetailsUpdated();
 
@@ -2466,6 +2527,10 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     currentEntityIdentifier = entityID;
     currentSandboxURL = sandboxURL;
 
+    // nested calls are already accounted for by the outermost entity
+    bool accountTime = !entityID.isNull() && oldIdentifier.isNull();
+    quint64 start = accountTime ? usecTimestampNow() : 0;
+
 #if DEBUG_CURRENT_ENTITY
     QScriptValue oldData = this->globalObject().property("debugEntityID");
     this->globalObject().setProperty("debugEntityID", entityID.toScriptValue(this)); // Make the entityID available to javascript as a global.
@@ -2475,6 +2540,14 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     operation();
 #endif
     maybeEmitUncaughtException(!entityID.isNull() ? entityID.toString() : __FUNCTION__);
+
+    if (accountTime) {
+        quint64 elapsed = usecTimestampNow() - start;
+        QWriteLocker locker { &_entityScriptsLock };
+        _entityScriptUsecs[entityID] += elapsed;
+        _totalEntityScriptUsecs += elapsed;
+    }
+
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
 }
@@ -40,6 +40,7 @@
 #include "Quat.h"
 #include "Mat4.h"
 #include "ScriptCache.h"
+#include "ScriptProgramCache.h"
 #include "ScriptUUID.h"
 #include "Vec3.h"
 #include "ConsoleScriptingInterface.h"
@@ -53,6 +54,7 @@ static const QString NO_SCRIPT("");
 static const int SCRIPT_FPS = 60;
 static const int DEFAULT_MAX_ENTITY_PPS = 9000;
 static const int DEFAULT_ENTITY_PPS_PER_SCRIPT = 900;
+static const int MAX_CACHED_PROGRAMS = 1024;
 
 class ScriptEngines;
 
@@ -560,6 +562,11 @@ public:
     void scriptPrintedMessage(const QString& message);
     void clearDebugLogWindow();
     int getNumRunningEntityScripts() const;
+
+    // Wall clock microseconds spent running code on behalf of each loaded entity script (callbacks, timers and
+    // method calls), and their sum.
+    QHash<EntityItemID, quint64> getEntityScriptUsecs() const;
+    quint64 getTotalEntityScriptUsecs() const { return _totalEntityScriptUsecs; }
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
 
@@ -740,6 +747,15 @@ protected:
     Q_INVOKABLE QString _requireResolve(const QString& moduleId, const QString& relativeTo = QString());
 
     QString logException(const QScriptValue& exception);
+
+    // Returns the program for sourceCode, reusing this engine's compiled copy when the same source was loaded before.
+    // Sources not seen by any engine yet are syntax checked first, on error a null program is returned and syntaxError set.
+    QScriptProgram getProgram(const ScriptProgramCache::Key& key, const QString& sourceCode, const QString& fileName,
+                              int lineNumber, QScriptValue& syntaxError, ScriptProgramCache::Entry& cacheEntry);
+
+    // Evaluates a program returned by getProgram, with the same stopped and thread checks as evaluate.
+    QScriptValue evaluateProgram(const QScriptProgram& program);
+
     void timerFired();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
@@ -782,6 +798,9 @@ protected:
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
+    QHash<EntityItemID, quint64> _entityScriptUsecs;
+    std::atomic<quint64> _totalEntityScriptUsecs { 0 }; // changed with _entityScriptsLock write locked
+    QCache<ScriptProgramCache::Key, QScriptProgram> _programs { MAX_CACHED_PROGRAMS };
     EntityScriptContentAvailableMap _contentAvailableQueue;
 
     bool _isThreaded { false };
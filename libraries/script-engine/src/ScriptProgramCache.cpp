@@ -0,0 +1,69 @@
+//
+//  ScriptProgramCache.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProgramCache.h"
+
+#include <QtCore/QCryptographicHash>
+
+ScriptProgramCache& ScriptProgramCache::instance() {
+    static ScriptProgramCache _instance;
+    return _instance;
+}
+
+ScriptProgramCache::Key ScriptProgramCache::hashProgram(const QString& sourceCode, const QString& fileName, int lineNumber) {
+    // the file name and line number are part of the program, they show up in errors and stack traces.
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(sourceCode.toUtf8());
+    hash.addData(fileName.toUtf8());
+    hash.addData(QByteArray::number(lineNumber));
+    return hash.result();
+}
+
+bool ScriptProgramCache::find(const Key& key, Entry& entry) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry* cached = _entries.object(key);
+    if (!cached) {
+        _misses++;
+        return false;
+    }
+    _hits++;
+    _savedUsecs += cached->checkUsecs;
+    entry = *cached;
+    return true;
+}
+
+void ScriptProgramCache::insert(const Key& key, quint64 checkUsecs) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _checkUsecs += checkUsecs;
+    if (!_entries.contains(key)) {
+        Entry* entry = new Entry();
+        entry->checkUsecs = checkUsecs;
+        _entries.insert(key, entry);
+    }
+}
+
+void ScriptProgramCache::setPreflightPassed(const Key& key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry* cached = _entries.object(key);
+    if (cached) {
+        cached->preflightPassed = true;
+    }
+}
+
+QJsonObject ScriptProgramCache::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    QJsonObject stats;
+    stats["programs"] = _entries.size();
+    stats["hits"] = (qint64)_hits;
+    stats["misses"] = (qint64)_misses;
+    stats["syntax_check_usecs"] = (qint64)_checkUsecs;
+    stats["syntax_check_usecs_saved"] = (qint64)_savedUsecs;
+    return stats;
+}
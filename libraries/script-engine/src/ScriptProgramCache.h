@@ -0,0 +1,57 @@
+//
+//  ScriptProgramCache.h
+//  libraries/script-engine/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptProgramCache_h
+#define hifi_ScriptProgramCache_h
+
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCache>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+// Process wide record of every script source that has already been syntax checked, keyed by a hash of its contents.
+// QtScript compiles a QScriptProgram when it is first evaluated, and keeps the compiled form for the engine that last
+// evaluated it, so the programs themselves are cached per ScriptEngine.  This cache holds what can be shared between
+// engines and threads: the syntax check, and whether an entity script constructor already passed its sandbox preflight.
+class ScriptProgramCache {
+public:
+    using Key = QByteArray;
+
+    struct Entry {
+        quint64 checkUsecs { 0 };       // time spent on the syntax check
+        bool preflightPassed { false };
+    };
+
+    static ScriptProgramCache& instance();
+
+    static Key hashProgram(const QString& sourceCode, const QString& fileName, int lineNumber);
+
+    // returns true, and fills entry, if the source has already been checked by any engine.
+    bool find(const Key& key, Entry& entry);
+    void insert(const Key& key, quint64 checkUsecs);
+    void setPreflightPassed(const Key& key);
+
+    QJsonObject getStats() const;
+
+private:
+    // bounds the memory held for sources that are edited and reloaded many times.
+    static const int MAX_ENTRIES { 4096 };
+
+    mutable std::mutex _mutex;
+    QCache<Key, Entry> _entries { MAX_ENTRIES };
+    quint64 _hits { 0 };
+    quint64 _misses { 0 };
+    quint64 _checkUsecs { 0 };
+    quint64 _savedUsecs { 0 };
+};
+
+#endif // hifi_ScriptProgramCache_h
@@ -0,0 +1,77 @@
+//
+//  InternedStrings.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "InternedStrings.h"
+
+QReadWriteLock InternedStrings::_lock;
+QHash<QString, quint32> InternedStrings::_strings;
+quint32 InternedStrings::_nextID { 1 };
+
+QString InternedStrings::intern(const QString& value) {
+    if (value.isEmpty()) {
+        // empty strings are already shared
+        return value;
+    }
+    QString interned;
+    quint32 id;
+    find(value, interned, id);
+    return interned;
+}
+
+quint32 InternedStrings::getID(const QString& value) {
+    if (value.isEmpty()) {
+        return 0;
+    }
+    QString interned;
+    quint32 id;
+    find(value, interned, id);
+    return id;
+}
+
+void InternedStrings::find(const QString& value, QString& interned, quint32& id) {
+    {
+        QReadLocker locker(&_lock);
+        auto itr = _strings.constFind(value);
+        if (itr != _strings.constEnd()) {
+            interned = itr.key();
+            id = itr.value();
+            return;
+        }
+    }
+
+    QWriteLocker locker(&_lock);
+    auto itr = _strings.constFind(value);
+    if (itr == _strings.constEnd()) {
+        itr = _strings.insert(value, _nextID++);
+    }
+    interned = itr.key();
+    id = itr.value();
+}
+
+int InternedStrings::purge() {
+    QWriteLocker locker(&_lock);
+    int numPurged = 0;
+    auto itr = _strings.begin();
+    while (itr != _strings.end()) {
+        // a detached string isn't shared with anybody else
+        if (itr.key().isDetached()) {
+            itr = _strings.erase(itr);
+            numPurged++;
+        } else {
+            ++itr;
+        }
+    }
+    return numPurged;
+}
+
+int InternedStrings::size() {
+    QReadLocker locker(&_lock);
+    return _strings.size();
+}
@@ -0,0 +1,44 @@
+//
+//  InternedStrings.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_InternedStrings_h
+#define hifi_InternedStrings_h
+
+#include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QString>
+
+// Process-wide table of strings that many objects hold the same value of, like the URLs and names of entities.
+//   intern() returns the table's copy of an equal string, so that every holder of that value shares a single buffer
+//   through the implicit sharing of QString.  Strings no longer held outside of the table are dropped by purge().
+//   Each string also gets an ID, never reused by the process, so that it can be referred to over the wire.
+//   InternedStrings is thread-safe.
+class InternedStrings {
+public:
+    static QString intern(const QString& value);
+
+    // interns value and returns its ID, the empty string is 0
+    static quint32 getID(const QString& value);
+
+    // drops the strings only referenced by the table, and returns how many were dropped
+    static int purge();
+
+    static int size();
+
+private:
+    // copies the interned string and its ID while the table is locked, as inserts can move the entries
+    static void find(const QString& value, QString& interned, quint32& id);
+
+    static QReadWriteLock _lock;
+    static QHash<QString, quint32> _strings;
+    static quint32 _nextID;
+};
+
+#endif // hifi_InternedStrings_h
@@ -16,6 +16,8 @@
 // When profiling something that may happen many times per frame, use a xxx_detail category so that they may easily be filtered out of trace results
 Q_DECLARE_LOGGING_CATEGORY(trace_app)
 Q_DECLARE_LOGGING_CATEGORY(trace_app_detail)
+Q_DECLARE_LOGGING_CATEGORY(trace_audio)
+Q_DECLARE_LOGGING_CATEGORY(trace_audio_detail)
 Q_DECLARE_LOGGING_CATEGORY(trace_metadata)
 Q_DECLARE_LOGGING_CATEGORY(trace_network)
 Q_DECLARE_LOGGING_CATEGORY(trace_render)
@@ -39,6 +39,8 @@ public:
         encodedBuffer = decodedBuffer;
     }
 
+    virtual bool isStateless() const override { return true; }
+
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
         decodedBuffer = encodedBuffer;
     }
@@ -76,6 +78,8 @@ public:
         encodedBuffer = qCompress(decodedBuffer);
     }
 
+    virtual bool isStateless() const override { return true; }
+
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
         decodedBuffer = qUncompress(encodedBuffer);
     }
@@ -15,12 +15,14 @@
 #include <AnimVariant.h>
 #include <AnimExpression.h>
 #include <AnimUtil.h>
+#include <GLMHelpers.h>
 #include <NodeList.h>
 #include <AddressManager.h>
 #include <AccountManager.h>
 #include <ResourceManager.h>
 #include <StatTracker.h>
 #include <test-utils/QTestExtensions.h>
+#include <QElapsedTimer>
 
 QTEST_MAIN(AnimTests)
 
@@ -443,6 +445,178 @@ void AnimTests::testAnimPose() {
     }
 }
 
+// q and -q are the same rotation, so compare the components themselves to catch sign flips.
+static bool quatComponentsEqual(const glm::quat& a, const glm::quat& b, float epsilon) {
+    return fabsf(a.x - b.x) < epsilon && fabsf(a.y - b.y) < epsilon && fabsf(a.z - b.z) < epsilon && fabsf(a.w - b.w) < epsilon;
+}
+
+// the sign chosen by glm::quat_cast(), with the largest component positive.
+static glm::quat largestComponentPositive(const glm::quat& q) {
+    float biggest = q.w;
+    for (float component : { q.x, q.y, q.z }) {
+        if (fabsf(component) > fabsf(biggest)) {
+            biggest = component;
+        }
+    }
+    return biggest < 0.0f ? -q : q;
+}
+
+void AnimTests::testAnimPoseMultiply() {
+    const float PI = (float)M_PI;
+    const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    const glm::quat ROT_Y_180 = glm::angleAxis(PI, glm::vec3(0.0f, 1.0, 0.0f));
+    const glm::quat ROT_Z_30 = glm::angleAxis(PI / 6.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+
+    // uniform positive parent scales take the direct composition path, the rest go through glm::mat4.
+    std::vector<glm::vec3> scaleVec = {
+        glm::vec3(1.0f),
+        glm::vec3(0.5f),
+        glm::vec3(2.0f, 0.5f, 1.5f),
+        glm::vec3(-2.0f, 0.5f, 1.5f)
+    };
+
+    std::vector<glm::quat> rotVec = {
+        glm::quat(),
+        ROT_X_90,
+        ROT_Y_180,
+        ROT_X_90 * ROT_Y_180 * ROT_Z_30,
+        -ROT_Y_180
+    };
+
+    std::vector<glm::vec3> transVec = {
+        glm::vec3(),
+        glm::vec3(10.0f, 5.0f, 7.5f),
+        glm::vec3(-10.0f, 5.0f, -7.5f)
+    };
+
+    for (auto& parentScale : scaleVec) {
+        for (auto& parentRot : rotVec) {
+            for (auto& childScale : scaleVec) {
+                for (auto& childRot : rotVec) {
+                    for (auto& trans : transVec) {
+                        AnimPose parent(parentScale, parentRot, trans);
+                        AnimPose child(childScale, childRot, -trans);
+
+                        glm::mat4 rawMat = (glm::mat4)parent * (glm::mat4)child;
+                        AnimPose expected(rawMat);
+                        AnimPose result = parent * child;
+
+                        QCOMPARE_WITH_ABS_ERROR(result.scale(), expected.scale(), TEST_EPSILON);
+                        QCOMPARE_WITH_ABS_ERROR(result.trans(), expected.trans(), TEST_EPSILON);
+
+                        // the direct composition is checked against the scalar product of the rotations, with the sign
+                        // of the matrix path, and must give the same matrix. the matrix path decomposes the product
+                        // of the matrices, as AnimPose composition always did.
+                        bool isDirect = parentScale.x == parentScale.y && parentScale.x == parentScale.z &&
+                            parentScale.x > 0.0f && childScale.x > 0.0f && childScale.y > 0.0f && childScale.z > 0.0f;
+                        glm::quat expectedRot;
+                        if (isDirect) {
+                            expectedRot = largestComponentPositive(glm::normalize(parentRot * childRot));
+                            QCOMPARE_WITH_ABS_ERROR((glm::mat4)result, rawMat, TEST_EPSILON);
+                        } else {
+                            glm::mat4 productMat;
+                            glm_mat4u_mul(parent, child, productMat);
+                            expectedRot = AnimPose(productMat).rot();
+                        }
+                        QVERIFY(quatComponentsEqual(result.rot(), expectedRot, TEST_EPSILON));
+                    }
+                }
+            }
+        }
+    }
+}
+
+static AnimPoseVec buildRandomPoses(size_t numPoses) {
+    AnimPoseVec poses;
+    poses.reserve(numPoses);
+    for (size_t i = 0; i < numPoses; i++) {
+        glm::vec3 scale(randFloatInRange(0.5f, 2.0f), randFloatInRange(0.5f, 2.0f), randFloatInRange(0.5f, 2.0f));
+        glm::quat rot = glm::normalize(glm::quat(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f),
+                                                 randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)));
+        glm::vec3 trans(randFloatInRange(-10.0f, 10.0f), randFloatInRange(-10.0f, 10.0f), randFloatInRange(-10.0f, 10.0f));
+        poses.push_back(AnimPose(scale, rot, trans));
+    }
+    return poses;
+}
+
+void AnimTests::testBlend() {
+    // cover the vectorized blocks of four as well as the scalar remainder.
+    for (size_t numPoses = 0; numPoses < 19; numPoses++) {
+        AnimPoseVec a = buildRandomPoses(numPoses);
+        AnimPoseVec b = buildRandomPoses(numPoses);
+        std::vector<float> weights;
+        for (size_t i = 0; i < numPoses; i++) {
+            weights.push_back((float)(i % 3) / 2.0f);
+        }
+
+        for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+            AnimPoseVec result(numPoses);
+            AnimPoseVec weightedResult(numPoses);
+            if (numPoses > 0) {
+                ::blend(numPoses, &a[0], &b[0], alpha, &result[0]);
+                ::blend(numPoses, &a[0], &b[0], &weights[0], alpha, &weightedResult[0]);
+            }
+
+            for (size_t i = 0; i < numPoses; i++) {
+                AnimPose expected;
+                expected.scale() = lerp(a[i].scale(), b[i].scale(), alpha);
+                expected.rot() = safeLerp(a[i].rot(), b[i].rot(), alpha);
+                expected.trans() = lerp(a[i].trans(), b[i].trans(), alpha);
+
+                QCOMPARE_WITH_ABS_ERROR(result[i].scale(), expected.scale(), TEST_EPSILON);
+                QCOMPARE_WITH_ABS_ERROR(result[i].trans(), expected.trans(), TEST_EPSILON);
+                QVERIFY(quatComponentsEqual(result[i].rot(), expected.rot(), TEST_EPSILON));
+
+                float weightedAlpha = weights[i] * alpha;
+                expected.scale() = lerp(a[i].scale(), b[i].scale(), weightedAlpha);
+                expected.rot() = safeLerp(a[i].rot(), b[i].rot(), weightedAlpha);
+                expected.trans() = lerp(a[i].trans(), b[i].trans(), weightedAlpha);
+
+                QCOMPARE_WITH_ABS_ERROR(weightedResult[i].scale(), expected.scale(), TEST_EPSILON);
+                QCOMPARE_WITH_ABS_ERROR(weightedResult[i].trans(), expected.trans(), TEST_EPSILON);
+                QVERIFY(quatComponentsEqual(weightedResult[i].rot(), expected.rot(), TEST_EPSILON));
+            }
+        }
+    }
+}
+
+void AnimTests::testBlendPerformance() {
+    const size_t NUM_JOINTS = 128;  // roughly the size of a full avatar skeleton, with fingers.
+    const int NUM_ITERATIONS = 10000;
+
+    AnimPoseVec a = buildRandomPoses(NUM_JOINTS);
+    AnimPoseVec b = buildRandomPoses(NUM_JOINTS);
+    AnimPoseVec result(NUM_JOINTS);
+    std::vector<float> weights(NUM_JOINTS, 0.75f);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        ::blend(NUM_JOINTS, &a[0], &b[0], 0.5f, &result[0]);
+    }
+    qint64 blendNsecs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        ::blend(NUM_JOINTS, &a[0], &b[0], &weights[0], 0.5f, &result[0]);
+    }
+    qint64 weightedBlendNsecs = timer.nsecsElapsed();
+
+    // a chain of joints, each parented to the previous, as in AnimSkeleton::convertRelativePosesToAbsolute
+    timer.restart();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        for (size_t j = 1; j < NUM_JOINTS; j++) {
+            result[j] = result[j - 1] * a[j];
+        }
+    }
+    qint64 accumulateNsecs = timer.nsecsElapsed();
+
+    const double NUM_SAMPLES = (double)NUM_JOINTS * NUM_ITERATIONS;
+    qDebug() << "blend:" << (double)blendNsecs / NUM_SAMPLES << "ns per joint";
+    qDebug() << "weighted blend:" << (double)weightedBlendNsecs / NUM_SAMPLES << "ns per joint";
+    qDebug() << "relative to absolute:" << (double)accumulateNsecs / NUM_SAMPLES << "ns per joint";
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
@@ -0,0 +1,143 @@
+//
+//  AudioEncodedMixesTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioEncodedMixesTests.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <plugins/CodecPlugin.h>
+
+#include "AudioConstants.h"
+#include "AudioEncodedMixes.h"
+
+QTEST_MAIN(AudioEncodedMixesTests)
+
+// counts its encodes, and prefixes its output with a tag so that the output of each encoder can be told apart
+class CountingEncoder : public Encoder {
+public:
+    CountingEncoder(char tag, bool isStateless) : _tag(tag), _isStateless(isStateless) {}
+
+    virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override {
+        ++numEncodes;
+        encodedBuffer = _tag + decodedBuffer;
+    }
+    virtual bool isStateless() const override { return _isStateless; }
+
+    std::atomic<int> numEncodes { 0 };
+
+private:
+    char _tag;
+    bool _isStateless;
+};
+
+static QByteArray createMix(int16_t value) {
+    std::vector<int16_t> samples(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO, value);
+    return QByteArray(reinterpret_cast<const char*>(samples.data()), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+}
+
+void AudioEncodedMixesTests::identicalMixesShareEncode() {
+    const int NUM_LISTENERS = 10;
+    AudioEncodedMixes encodedMixes;
+    CountingEncoder encoder('a', true);
+    QByteArray mix = createMix(100);
+
+    int numShared = 0;
+    for (int i = 0; i < NUM_LISTENERS; i++) {
+        QByteArray encoded;
+        numShared += (int)encodedMixes.encode("codec", &encoder, mix, encoded);
+        QCOMPARE(encoded, 'a' + mix);
+    }
+    QCOMPARE((int)encoder.numEncodes, 1);
+    QCOMPARE(numShared, NUM_LISTENERS - 1);
+
+    // the mixes of the previous frame are not reused
+    encodedMixes.clear();
+    QByteArray encoded;
+    QVERIFY(!encodedMixes.encode("codec", &encoder, mix, encoded));
+    QCOMPARE((int)encoder.numEncodes, 2);
+}
+
+void AudioEncodedMixesTests::distinctMixesAndCodecs() {
+    AudioEncodedMixes encodedMixes;
+    CountingEncoder encoderA('a', true);
+    CountingEncoder encoderB('b', true);
+    QByteArray mix = createMix(100);
+    QByteArray otherMix = createMix(-100);
+
+    QByteArray encoded;
+    QVERIFY(!encodedMixes.encode("a", &encoderA, mix, encoded));
+    QVERIFY(!encodedMixes.encode("a", &encoderA, otherMix, encoded));
+    QCOMPARE(encoded, 'a' + otherMix);
+
+    // the same mix is encoded once per codec
+    QVERIFY(!encodedMixes.encode("b", &encoderB, mix, encoded));
+    QCOMPARE(encoded, 'b' + mix);
+    QVERIFY(encodedMixes.encode("a", &encoderA, mix, encoded));
+    QCOMPARE(encoded, 'a' + mix);
+    QVERIFY(encodedMixes.encode("b", &encoderB, mix, encoded));
+    QCOMPARE(encoded, 'b' + mix);
+    QCOMPARE((int)encoderA.numEncodes, 2);
+    QCOMPARE((int)encoderB.numEncodes, 1);
+
+    // without an encoder the mix is sent as is, and shared as well
+    QVERIFY(!encodedMixes.encode("", nullptr, mix, encoded));
+    QCOMPARE(encoded, mix);
+    QVERIFY(encodedMixes.encode("", nullptr, mix, encoded));
+    QCOMPARE(encoded, mix);
+}
+
+void AudioEncodedMixesTests::statefulEncoder() {
+    const int NUM_LISTENERS = 10;
+    AudioEncodedMixes encodedMixes;
+    QByteArray mix = createMix(100);
+
+    // each listener has its own encoder, whose output depends on what it encoded before
+    std::vector<std::unique_ptr<CountingEncoder>> encoders;
+    for (int i = 0; i < NUM_LISTENERS; i++) {
+        encoders.emplace_back(new CountingEncoder('a', false));
+        QByteArray encoded;
+        QVERIFY(!encodedMixes.encode("codec", encoders.back().get(), mix, encoded));
+        QCOMPARE((int)encoders.back()->numEncodes, 1);
+    }
+}
+
+void AudioEncodedMixesTests::concurrentListeners() {
+    const int NUM_THREADS = 4;
+    const int NUM_LISTENERS_PER_THREAD = 100;
+    const int NUM_DISTINCT_MIXES = 3;
+    AudioEncodedMixes encodedMixes;
+    CountingEncoder encoder('a', true);
+
+    std::atomic<int> numShared { 0 };
+    std::atomic<int> numWrong { 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < NUM_LISTENERS_PER_THREAD; i++) {
+                QByteArray mix = createMix((int16_t)((t + i) % NUM_DISTINCT_MIXES));
+                QByteArray encoded;
+                numShared += (int)encodedMixes.encode("codec", &encoder, mix, encoded);
+                numWrong += (int)(encoded != 'a' + mix);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // a mix may be encoded concurrently by several threads before its output is shared
+    QCOMPARE((int)numWrong, 0);
+    QVERIFY(encoder.numEncodes >= NUM_DISTINCT_MIXES);
+    QVERIFY(encoder.numEncodes <= NUM_DISTINCT_MIXES * NUM_THREADS);
+    QCOMPARE((int)numShared + (int)encoder.numEncodes, NUM_THREADS * NUM_LISTENERS_PER_THREAD);
+}
@@ -0,0 +1,25 @@
+//
+//  AudioEncodedMixesTests.h
+//  tests/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioEncodedMixesTests_h
+#define hifi_AudioEncodedMixesTests_h
+
+#include <QtTest/QtTest>
+
+class AudioEncodedMixesTests : public QObject {
+    Q_OBJECT
+private slots:
+    void identicalMixesShareEncode();
+    void distinctMixesAndCodecs();
+    void statefulEncoder();
+    void concurrentListeners();
+};
+
+#endif // hifi_AudioEncodedMixesTests_h
@@ -0,0 +1,202 @@
+//
+//  AudioFarFieldBedTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioFarFieldBedTests.h"
+
+#include <cmath>
+#include <vector>
+
+#include "AudioConstants.h"
+#include "AudioFarFieldBed.h"
+
+QTEST_MAIN(AudioFarFieldBedTests)
+
+namespace {
+
+const int NUM_FRAME_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+const glm::vec3 LISTENER_POSITION(1.0f, 2.0f, 3.0f);
+const float MASTER_AVATAR_GAIN = 0.8f;
+
+struct Source {
+    std::vector<int16_t> samples;
+    glm::vec3 position;
+    glm::vec3 forward;
+};
+
+Source createSource(int index, const glm::vec3& position, const glm::vec3& forward) {
+    Source source { std::vector<int16_t>(NUM_FRAME_SAMPLES), position, forward };
+    for (int i = 0; i < NUM_FRAME_SAMPLES; i++) {
+        source.samples[i] = (int16_t)(8000.0f * sinf(0.05f * (index + 1) * i));
+    }
+    return source;
+}
+
+float computeDistanceAttenuation(const glm::vec3& sourcePosition, float distance) {
+    return 1.0f / distance;
+}
+
+// adds the sources to the bed as the mixer does, each with the gain it would get from its own HRTF
+void addSources(AudioFarFieldBed& bed, const std::vector<Source>& sources, const std::vector<int>& clusters) {
+    for (size_t i = 0; i < sources.size(); i++) {
+        const auto& source = sources[i];
+        glm::vec3 relativePosition = source.position - LISTENER_POSITION;
+        float distance = glm::length(relativePosition);
+        glm::vec3 direction = relativePosition / distance;
+        float gain = AudioFarFieldBed::computeSourceGain(computeDistanceAttenuation(source.position, distance), true,
+                                                         source.forward, direction, MASTER_AVATAR_GAIN);
+        bed.addSource(source.samples.data(), gain, direction, clusters[i]);
+    }
+}
+
+void compareBeds(const float* bed, const float* expectedBed) {
+    const float TOLERANCE = 1.0e-5f;
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC; i++) {
+        if (fabsf(bed[i] - expectedBed[i]) > TOLERANCE) {
+            QFAIL(qPrintable(QString("bed sample %1 is %2, expected %3").arg(i).arg(bed[i]).arg(expectedBed[i])));
+        }
+    }
+}
+
+}
+
+void AudioFarFieldBedTests::distantQuietSourcesInBed() {
+    AudioFarFieldBed::Settings settings;
+    settings.enabled = true;
+    settings.distance = 10.0f;
+    settings.maxHRTFStreams = 2;
+
+    AudioFarFieldBed bed;
+    std::vector<float> volumes = { 0.1f, 0.5f, 0.3f, 0.05f, 0.4f };
+    bed.prepare(settings, volumes);
+
+    // the two loudest sources keep their own HRTF, wherever they are
+    QVERIFY(!bed.contains(0.5f, 100.0f));
+    QVERIFY(!bed.contains(0.4f, 100.0f));
+
+    // the quieter ones go in the bed beyond the distance only
+    QVERIFY(bed.contains(0.3f, 100.0f));
+    QVERIFY(bed.contains(0.05f, settings.distance));
+    QVERIFY(!bed.contains(0.05f, 0.5f * settings.distance));
+
+    // with no more sources than maxHRTFStreams, every source keeps its own HRTF
+    volumes = { 0.1f, 0.0f };
+    bed.prepare(settings, volumes);
+    QVERIFY(!bed.contains(0.0f, 100.0f));
+    QVERIFY(bed.isEmpty());
+}
+
+void AudioFarFieldBedTests::clustersByCellAndFacing() {
+    AudioFarFieldClusters clusters;
+    clusters.clear(8.0f);
+
+    const glm::vec3 FORWARD(0.0f, 0.0f, -1.0f);
+    const glm::vec3 BACKWARD(0.0f, 0.0f, 1.0f);
+    Source source = createSource(0, glm::vec3(0.0f), FORWARD);
+
+    int first = clusters.addSource(source.samples.data(), 1.0f, glm::vec3(1.0f, 1.0f, 1.0f), FORWARD, true);
+    int sameCell = clusters.addSource(source.samples.data(), 1.0f, glm::vec3(3.0f, 1.0f, 5.0f), FORWARD, true);
+    int otherCell = clusters.addSource(source.samples.data(), 1.0f, glm::vec3(9.0f, 1.0f, 1.0f), FORWARD, true);
+    int otherFacing = clusters.addSource(source.samples.data(), 1.0f, glm::vec3(1.0f, 1.0f, 1.0f), BACKWARD, true);
+    int injector = clusters.addSource(source.samples.data(), 0.5f, glm::vec3(1.0f, 1.0f, 1.0f), FORWARD, false);
+    clusters.finish();
+
+    QCOMPARE(sameCell, first);
+    QVERIFY(otherCell != first);
+    QVERIFY(otherFacing != first);
+    QVERIFY(injector != first);
+    QCOMPARE((int)clusters.getClusters().size(), 4);
+
+    const auto& cluster = clusters.getClusters()[first];
+    QCOMPARE(cluster.numStreams, 2);
+    QVERIFY(cluster.isMicrophone);
+    QVERIFY(!clusters.getClusters()[injector].isMicrophone);
+    QCOMPARE(cluster.position, glm::vec3(2.0f, 1.0f, 3.0f));
+    QCOMPARE(cluster.forward, FORWARD);
+    for (int i = 0; i < NUM_FRAME_SAMPLES; i++) {
+        QCOMPARE(cluster.samples[i], 2.0f * source.samples[i] / 32768.0f);
+    }
+}
+
+void AudioFarFieldBedTests::clusterGainMatchesSources() {
+    // avatars far away, at the same place and facing the same way, so that the cluster is exact
+    const glm::vec3 POSITION(41.0f, 2.5f, -37.0f);
+    const glm::vec3 FORWARD = glm::normalize(glm::vec3(1.0f, 0.0f, 1.0f));
+    std::vector<Source> sources;
+    for (int i = 0; i < 3; i++) {
+        sources.push_back(createSource(i, POSITION, FORWARD));
+    }
+
+    AudioFarFieldClusters clusters;
+    clusters.clear(8.0f);
+    std::vector<int> clusterIndices;
+    for (const auto& source : sources) {
+        clusterIndices.push_back(clusters.addSource(source.samples.data(), 1.0f, source.position, source.forward, true));
+    }
+    clusters.finish();
+    QCOMPARE(clusters.getClusters().size(), (size_t)1);
+
+    // encoded from the shared cluster mix
+    AudioFarFieldBed clusteredBed;
+    addSources(clusteredBed, sources, clusterIndices);
+    QCOMPARE(clusteredBed.encode(clusters, LISTENER_POSITION, MASTER_AVATAR_GAIN, computeDistanceAttenuation), 1);
+    QVERIFY(clusteredBed.isEmpty());
+
+    // encoded one source at a time
+    AudioFarFieldBed sourceBed;
+    addSources(sourceBed, sources, std::vector<int>(sources.size(), -1));
+    QCOMPARE(sourceBed.encode(clusters, LISTENER_POSITION, MASTER_AVATAR_GAIN, computeDistanceAttenuation), 0);
+
+    compareBeds(clusteredBed.getBed(), sourceBed.getBed());
+
+    // the bed is not silent, and its W channel carries the sum of the attenuated sources
+    glm::vec3 relativePosition = POSITION - LISTENER_POSITION;
+    float distance = glm::length(relativePosition);
+    float gain = AudioFarFieldBed::computeSourceGain(1.0f / distance, true, FORWARD, relativePosition / distance,
+                                                     MASTER_AVATAR_GAIN);
+    QVERIFY(gain < 1.0f / distance);
+    for (int i = 0; i < NUM_FRAME_SAMPLES; i++) {
+        float expected = 0.0f;
+        for (const auto& source : sources) {
+            expected += source.samples[i] * gain / 32768.0f;
+        }
+        QVERIFY(fabsf(clusteredBed.getBed()[4 * i] - expected) < 1.0e-5f);
+    }
+}
+
+void AudioFarFieldBedTests::partialClusterUsesSources() {
+    const glm::vec3 POSITION(-30.0f, 0.0f, 52.0f);
+    const glm::vec3 FORWARD(0.0f, 0.0f, -1.0f);
+    std::vector<Source> sources;
+    for (int i = 0; i < 3; i++) {
+        sources.push_back(createSource(i, POSITION, FORWARD));
+    }
+
+    AudioFarFieldClusters clusters;
+    clusters.clear(8.0f);
+    std::vector<int> clusterIndices;
+    for (const auto& source : sources) {
+        clusterIndices.push_back(clusters.addSource(source.samples.data(), 1.0f, source.position, source.forward, true));
+    }
+    clusters.finish();
+
+    // one of the sources is near this listener, so it gets its own HRTF and the cluster can't be used
+    sources.pop_back();
+    clusterIndices.pop_back();
+
+    AudioFarFieldBed clusteredBed;
+    addSources(clusteredBed, sources, clusterIndices);
+    QCOMPARE(clusteredBed.encode(clusters, LISTENER_POSITION, MASTER_AVATAR_GAIN, computeDistanceAttenuation), 0);
+
+    AudioFarFieldBed sourceBed;
+    addSources(sourceBed, sources, std::vector<int>(sources.size(), -1));
+    sourceBed.encode(clusters, LISTENER_POSITION, MASTER_AVATAR_GAIN, computeDistanceAttenuation);
+
+    compareBeds(clusteredBed.getBed(), sourceBed.getBed());
+}
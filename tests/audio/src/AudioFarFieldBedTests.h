@@ -0,0 +1,25 @@
+//
+//  AudioFarFieldBedTests.h
+//  tests/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioFarFieldBedTests_h
+#define hifi_AudioFarFieldBedTests_h
+
+#include <QtTest/QtTest>
+
+class AudioFarFieldBedTests : public QObject {
+    Q_OBJECT
+private slots:
+    void distantQuietSourcesInBed();
+    void clustersByCellAndFacing();
+    void clusterGainMatchesSources();
+    void partialClusterUsesSources();
+};
+
+#endif // hifi_AudioFarFieldBedTests_h
@@ -0,0 +1,127 @@
+//
+//  AudioHRTFTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioHRTFTests.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <NumericalConstants.h>
+
+#include "AudioHRTF.h"
+
+QTEST_MAIN(AudioHRTFTests)
+
+// an odd count, so the unpaired source is covered too
+const int NUM_STREAMS = 33;
+const int HRTF_INDEX = 1;
+
+struct HRTFStreams {
+    std::vector<std::unique_ptr<AudioHRTF>> hrtfs;
+    std::vector<std::vector<int16_t>> inputs;
+    std::vector<AudioHRTF::Source> sources;
+
+    HRTFStreams(int numStreams) {
+        for (int i = 0; i < numStreams; i++) {
+            hrtfs.emplace_back(new AudioHRTF);
+            inputs.emplace_back(HRTF_BLOCK);
+            sources.push_back({ hrtfs.back().get(), inputs.back().data(), 0.0f, 1.0f, 1.0f });
+        }
+    }
+
+    // new input and parameters for every stream
+    void update(int frame) {
+        for (size_t i = 0; i < sources.size(); i++) {
+            for (int j = 0; j < HRTF_BLOCK; j++) {
+                inputs[i][j] = (int16_t)(8192.0f * sinf(0.01f * (float)((i + 1) * (frame * HRTF_BLOCK + j))));
+            }
+            sources[i].azimuth = remainderf(0.37f * (float)i + 0.1f * (float)frame, TWO_PI);
+            sources[i].distance = 0.5f + 0.25f * (float)i;
+            sources[i].gain = 1.0f / (1.0f + 0.1f * (float)frame);
+        }
+    }
+};
+
+void AudioHRTFTests::batchedRender() {
+    HRTFStreams single(NUM_STREAMS);
+    HRTFStreams batched(NUM_STREAMS);
+
+    for (int frame = 0; frame < 10; frame++) {
+        float singleOutput[2 * HRTF_BLOCK] = {};
+        float batchedOutput[2 * HRTF_BLOCK] = {};
+
+        single.update(frame);
+        batched.update(frame);
+
+        for (auto& source : single.sources) {
+            source.hrtf->render(source.input, singleOutput, HRTF_INDEX,
+                                source.azimuth, source.distance, source.gain, HRTF_BLOCK);
+        }
+        AudioHRTF::render(batched.sources.data(), NUM_STREAMS, batchedOutput, HRTF_INDEX, HRTF_BLOCK);
+
+        // the paired FIR may sum taps in a different order
+        for (int i = 0; i < 2 * HRTF_BLOCK; i++) {
+            QVERIFY(fabsf(singleOutput[i] - batchedOutput[i]) < 1e-4f);
+        }
+    }
+}
+
+void AudioHRTFTests::benchmarkRender() {
+    HRTFStreams streams(NUM_STREAMS);
+    streams.update(0);
+    float output[2 * HRTF_BLOCK] = {};
+
+    QBENCHMARK {
+        for (auto& source : streams.sources) {
+            source.hrtf->render(source.input, output, HRTF_INDEX,
+                                source.azimuth, source.distance, source.gain, HRTF_BLOCK);
+        }
+    }
+}
+
+void AudioHRTFTests::benchmarkBatchedRender() {
+    HRTFStreams streams(NUM_STREAMS);
+    streams.update(0);
+    float output[2 * HRTF_BLOCK] = {};
+
+    QBENCHMARK {
+        AudioHRTF::render(streams.sources.data(), NUM_STREAMS, output, HRTF_INDEX, HRTF_BLOCK);
+    }
+}
+
+// streams rendered per millisecond on a single core
+void AudioHRTFTests::throughput() {
+    const int NUM_FRAMES = 1000;
+
+    HRTFStreams streams(NUM_STREAMS);
+    streams.update(0);
+    float output[2 * HRTF_BLOCK] = {};
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        for (auto& source : streams.sources) {
+            source.hrtf->render(source.input, output, HRTF_INDEX,
+                                source.azimuth, source.distance, source.gain, HRTF_BLOCK);
+        }
+    }
+    double singleTime = (double)timer.nsecsElapsed();
+
+    timer.restart();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        AudioHRTF::render(streams.sources.data(), NUM_STREAMS, output, HRTF_INDEX, HRTF_BLOCK);
+    }
+    double batchedTime = (double)timer.nsecsElapsed();
+
+    double numRenders = (double)NUM_STREAMS * NUM_FRAMES;
+    qDebug() << "single:" << numRenders / (singleTime / 1e6) << "streams/ms";
+    qDebug() << "batched:" << numRenders / (batchedTime / 1e6) << "streams/ms";
+}
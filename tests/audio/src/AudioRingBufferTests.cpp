@@ -11,6 +11,10 @@
 
 #include "AudioRingBufferTests.h"
 
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
 #include "SharedUtil.h"
 
 // Adds an implicit cast to make sure that actual and expected are of the same type.
@@ -125,3 +129,145 @@ void AudioRingBufferTests::runAllTests() {
         assertBufferSize(ringBuffer, 0);
     }
 }
+
+void AudioRingBufferTests::spans() {
+    AudioRingBuffer ringBuffer(10, 10); // makes buffer of 100 int16_t samples
+
+    int16_t writeData[100];
+    for (int i = 0; i < 100; i++) { writeData[i] = i; }
+
+    // move the positions close to the edge of the ring
+    ringBuffer.writeSamples(writeData, 95);
+    ringBuffer.skipSamples(95);
+    assertBufferSize(ringBuffer, 0);
+
+    // the room wraps around the edge
+    auto writeSpans = ringBuffer.writeSpans(20);
+    QCOMPARE(writeSpans.size(), 20);
+    QVERIFY(writeSpans.firstSize > 0 && writeSpans.secondSize > 0);
+    memcpy(writeSpans.first, writeData, writeSpans.firstSize * sizeof(int16_t));
+    memcpy(writeSpans.second, writeData + writeSpans.firstSize, writeSpans.secondSize * sizeof(int16_t));
+
+    // nothing is available until it is committed
+    assertBufferSize(ringBuffer, 0);
+    ringBuffer.commitWrite(writeSpans.size());
+    assertBufferSize(ringBuffer, 20);
+
+    // writing never overwrites unread samples
+    QCOMPARE(ringBuffer.writeSpans(1000).size(), 80);
+
+    // the samples read in place match the ones written
+    auto readSpans = ringBuffer.readSpans(1000);
+    QCOMPARE(readSpans.size(), 20);
+    for (int i = 0; i < readSpans.firstSize; i++) {
+        QCOMPARE(readSpans.first[i], writeData[i]);
+    }
+    for (int i = 0; i < readSpans.secondSize; i++) {
+        QCOMPARE(readSpans.second[i], writeData[readSpans.firstSize + i]);
+    }
+
+    // reading in place does not consume
+    assertBufferSize(ringBuffer, 20);
+    ringBuffer.shiftReadPosition(readSpans.size());
+    assertBufferSize(ringBuffer, 0);
+    QCOMPARE(ringBuffer.readSpans(1000).size(), 0);
+}
+
+void AudioRingBufferTests::threadedTransfer() {
+    // a single producer and consumer, using the ring as a lock-free pipe
+    const int NUM_SAMPLES = 1000000;
+    AudioRingBuffer ringBuffer(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+
+    std::thread producer([&] {
+        int16_t block[97];
+        int written = 0;
+        while (written < NUM_SAMPLES) {
+            int numSamples = std::min((int)(sizeof(block) / sizeof(block[0])), NUM_SAMPLES - written);
+            numSamples = std::min(numSamples, ringBuffer.getSampleCapacity() - ringBuffer.samplesAvailable());
+            for (int i = 0; i < numSamples; i++) {
+                block[i] = (int16_t)(written + i);
+            }
+            written += ringBuffer.writeSamples(block, numSamples);
+        }
+    });
+
+    int16_t block[113];
+    int read = 0;
+    bool inOrder = true;
+    while (read < NUM_SAMPLES) {
+        int numSamples = ringBuffer.readSamples(block, sizeof(block) / sizeof(block[0]));
+        for (int i = 0; i < numSamples; i++) {
+            inOrder = inOrder && (block[i] == (int16_t)(read + i));
+        }
+        read += numSamples;
+    }
+    producer.join();
+
+    QVERIFY(inOrder);
+    QCOMPARE(ringBuffer.getOverflowCount(), 0);
+    assertBufferSize(ringBuffer, 0);
+}
+
+void AudioRingBufferTests::kernels() {
+    // odd sizes, to cover the scalar tails
+    const int NUM_SAMPLES = 487;
+    int16_t src[NUM_SAMPLES];
+    float srcFloat[NUM_SAMPLES];
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        src[i] = (int16_t)((i * 7919) % 65536 - 32768);
+        srcFloat[i] = (float)src[i] * 1.5f;
+    }
+
+    const float gain = 0.25f;
+    float toFloat[NUM_SAMPLES];
+    float accumulated[NUM_SAMPLES];
+    std::fill(accumulated, accumulated + NUM_SAMPLES, 1.0f);
+    convertSamplesToFloat(src, toFloat, gain, NUM_SAMPLES);
+    accumulateSamplesWithGain(src, accumulated, gain, NUM_SAMPLES);
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        QCOMPARE(toFloat[i], (float)src[i] * gain);
+        QVERIFY(fabsf(accumulated[i] - (1.0f + (float)src[i] * gain)) < 1e-3f);
+    }
+
+    // int16 accumulation wraps around, like the scalar +=
+    int16_t sum[NUM_SAMPLES];
+    memcpy(sum, src, sizeof(sum));
+    accumulateSamples(src, sum, NUM_SAMPLES);
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        QCOMPARE(sum[i], (int16_t)(src[i] + src[i]));
+    }
+
+    float floatSum[NUM_SAMPLES];
+    memcpy(floatSum, srcFloat, sizeof(floatSum));
+    accumulateSamples(srcFloat, floatSum, NUM_SAMPLES);
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        QCOMPARE(floatSum[i], srcFloat[i] * 2.0f);
+    }
+}
+
+void AudioRingBufferTests::benchmarkReadWrite() {
+    AudioRingBuffer ringBuffer(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+    int16_t frame[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] = {};
+
+    QBENCHMARK {
+        // offset the positions so that reads and writes wrap around the edge
+        for (int i = 0; i < 100; i++) {
+            ringBuffer.writeSamples(frame, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO - 3);
+            ringBuffer.readSamples(frame, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO - 3);
+        }
+    }
+}
+
+void AudioRingBufferTests::benchmarkAccumulateWithGain() {
+    int16_t frame[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    float mix[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO] = {};
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+        frame[i] = (int16_t)(i * 31);
+    }
+
+    QBENCHMARK {
+        for (int i = 0; i < 100; i++) {
+            accumulateSamplesWithGain(frame, mix, 1 / 32768.0f, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+        }
+    }
+}
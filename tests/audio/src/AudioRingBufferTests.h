@@ -21,6 +21,11 @@ class AudioRingBufferTests : public QObject {
     Q_OBJECT
 private slots:
     void runAllTests();
+    void spans();
+    void threadedTransfer();
+    void kernels();
+    void benchmarkReadWrite();
+    void benchmarkAccumulateWithGain();
 private:
     void assertBufferSize(const AudioRingBuffer& buffer, int samples);
 };
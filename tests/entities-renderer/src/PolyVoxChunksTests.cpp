@@ -0,0 +1,181 @@
+//
+//  PolyVoxChunksTests.cpp
+//  tests/entities-renderer/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunksTests.h"
+
+#include <memory>
+
+#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
+
+#include <PolyVoxChunks.h>
+
+QTEST_MAIN(PolyVoxChunksTests)
+
+namespace {
+
+using Volume = PolyVoxChunks::Volume;
+
+const uint8_t SOLID_VOXEL = 255;
+
+std::unique_ptr<Volume> createVolume(int size) {
+    PolyVox::Region region(PolyVox::Vector3DInt32(0, 0, 0), PolyVox::Vector3DInt32(size, size, size));
+    std::unique_ptr<Volume> volume(new Volume(region));
+    volume->setBorderValue(0);
+    return volume;
+}
+
+void setSphere(Volume& volume, const glm::vec3& center, float radius, uint8_t value, PolyVoxChunks* chunks = nullptr) {
+    glm::ivec3 low = glm::max(glm::ivec3(glm::floor(center - radius)), glm::ivec3(0));
+    glm::ivec3 high = glm::min(glm::ivec3(glm::ceil(center + radius)), glm::ivec3(volume.getWidth() - 1));
+    glm::ivec3 v;
+    for (v.z = low.z; v.z <= high.z; v.z++) {
+        for (v.y = low.y; v.y <= high.y; v.y++) {
+            for (v.x = low.x; v.x <= high.x; v.x++) {
+                if (glm::distance(glm::vec3(v), center) <= radius && volume.getVoxelAt(v.x, v.y, v.z) != value) {
+                    volume.setVoxelAt(v.x, v.y, v.z, value);
+                    if (chunks) {
+                        chunks->markDirty(v);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// the number of triangles extracted from the volume in one piece, as RenderablePolyVoxEntityItem used to
+size_t extractWholeVolume(Volume& volume) {
+    PolyVox::SurfaceMesh<PolyVoxChunks::Vertex> surface;
+    PolyVox::MarchingCubesSurfaceExtractor<Volume> surfaceExtractor(&volume, volume.getEnclosingRegion(), &surface);
+    surfaceExtractor.execute();
+    return surface.getIndices().size() / 3;
+}
+
+size_t extractChunks(Volume& volume, PolyVoxChunks& chunks) {
+    chunks.extractSurfaces(&volume, true);
+    std::vector<PolyVoxChunks::Vertex> vertices;
+    std::vector<uint32_t> indices;
+    chunks.mergeSurfaces(vertices, indices);
+    for (uint32_t index : indices) {
+        if (index >= vertices.size()) {
+            return 0;
+        }
+    }
+    return indices.size() / 3;
+}
+
+}
+
+void PolyVoxChunksTests::testChunkLayout() {
+    const int VOLUME_SIZE = 40;
+    auto volume = createVolume(VOLUME_SIZE);
+
+    PolyVoxChunks chunks;
+    chunks.reset(volume->getEnclosingRegion());
+    QCOMPARE(chunks.getNumChunks(), 3 * 3 * 3);
+    QVERIFY(chunks.hasDirtySurfaces());
+    QCOMPARE(chunks.extractSurfaces(volume.get(), true), 3 * 3 * 3);
+    QVERIFY(!chunks.hasDirtySurfaces());
+
+    // a volume smaller than a chunk is still one chunk
+    auto smallVolume = createVolume(1);
+    chunks.reset(smallVolume->getEnclosingRegion());
+    QCOMPARE(chunks.getNumChunks(), 1);
+}
+
+void PolyVoxChunksTests::testMarkDirty() {
+    const int VOLUME_SIZE = 64;
+    const int CHUNK_SIZE = PolyVoxChunks::CHUNK_SIZE;
+    auto volume = createVolume(VOLUME_SIZE);
+
+    PolyVoxChunks chunks;
+    chunks.reset(volume->getEnclosingRegion());
+    chunks.extractSurfaces(volume.get(), true);
+
+    // a voxel inside a chunk only dirties its chunk
+    chunks.markDirty(glm::ivec3(CHUNK_SIZE / 2));
+    QCOMPARE(chunks.extractSurfaces(volume.get(), true), 1);
+
+    // a voxel on a face, or next to it, dirties the chunks on both sides
+    chunks.markDirty(glm::ivec3(CHUNK_SIZE, CHUNK_SIZE / 2, CHUNK_SIZE / 2));
+    QCOMPARE(chunks.extractSurfaces(volume.get(), true), 2);
+    chunks.markDirty(glm::ivec3(CHUNK_SIZE - 1, CHUNK_SIZE / 2, CHUNK_SIZE / 2));
+    QCOMPARE(chunks.extractSurfaces(volume.get(), true), 2);
+
+    // a voxel on a corner dirties the eight chunks around it
+    chunks.markDirty(glm::ivec3(CHUNK_SIZE));
+    QCOMPARE(chunks.extractSurfaces(volume.get(), true), 8);
+
+    // the voxels on the faces of the volume don't dirty chunks outside of it
+    chunks.markDirty(glm::ivec3(0));
+    QCOMPARE(chunks.extractSurfaces(volume.get(), true), 1);
+    chunks.markDirty(glm::ivec3(VOLUME_SIZE));
+    QCOMPARE(chunks.extractSurfaces(volume.get(), true), 1);
+
+    chunks.markAllDirty();
+    QCOMPARE(chunks.extractSurfaces(volume.get(), true), chunks.getNumChunks());
+}
+
+void PolyVoxChunksTests::testSurfacesMatchWholeVolume() {
+    const int VOLUME_SIZE = 64;
+    auto volume = createVolume(VOLUME_SIZE);
+    setSphere(*volume, glm::vec3(VOLUME_SIZE / 2), VOLUME_SIZE / 3.0f, SOLID_VOXEL);
+
+    PolyVoxChunks chunks;
+    chunks.reset(volume->getEnclosingRegion());
+    size_t numTriangles = extractChunks(*volume, chunks);
+    QVERIFY(numTriangles > 0);
+    QCOMPARE(numTriangles, extractWholeVolume(*volume));
+
+    // carve a hole across several chunks, and only re-extract these
+    setSphere(*volume, glm::vec3(VOLUME_SIZE / 2, VOLUME_SIZE / 2, VOLUME_SIZE / 6), VOLUME_SIZE / 8.0f, 0, &chunks);
+    numTriangles = extractChunks(*volume, chunks);
+    QCOMPARE(numTriangles, extractWholeVolume(*volume));
+
+    // each triangle of the surfaces becomes a hull
+    QCOMPARE(chunks.buildHulls(volume.get(), true, volume->getEnclosingRegion()), chunks.getNumChunks());
+    ShapeInfo::PointCollection hulls;
+    AABox box;
+    chunks.getHulls(glm::mat4(), hulls, box);
+    QCOMPARE((size_t)hulls.size(), numTriangles);
+    QCOMPARE(chunks.buildHulls(volume.get(), true, volume->getEnclosingRegion()), 0);
+}
+
+void PolyVoxChunksTests::benchmarkSculpt_data() {
+    QTest::addColumn<bool>("chunked");
+
+    QTest::newRow("whole volume") << false;
+    QTest::newRow("dirty chunks") << true;
+}
+
+void PolyVoxChunksTests::benchmarkSculpt() {
+    QFETCH(bool, chunked);
+
+    const int VOLUME_SIZE = 128;
+    auto volume = createVolume(VOLUME_SIZE);
+    setSphere(*volume, glm::vec3(VOLUME_SIZE / 2), VOLUME_SIZE / 3.0f, SOLID_VOXEL);
+
+    PolyVoxChunks chunks;
+    chunks.reset(volume->getEnclosingRegion());
+    extractChunks(*volume, chunks);
+
+    // each edit adds or removes a small sphere on the surface, as a sculpting brush would, then re-meshes
+    const glm::vec3 BRUSH_CENTER(VOLUME_SIZE / 2, VOLUME_SIZE / 2, VOLUME_SIZE / 6);
+    const float BRUSH_RADIUS = 3.0f;
+    bool add = true;
+    QBENCHMARK {
+        setSphere(*volume, BRUSH_CENTER, BRUSH_RADIUS, add ? SOLID_VOXEL : 0, &chunks);
+        add = !add;
+        if (chunked) {
+            extractChunks(*volume, chunks);
+        } else {
+            extractWholeVolume(*volume);
+        }
+    }
+}
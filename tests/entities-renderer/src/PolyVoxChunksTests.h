@@ -0,0 +1,29 @@
+//
+//  PolyVoxChunksTests.h
+//  tests/entities-renderer/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunksTests_h
+#define hifi_PolyVoxChunksTests_h
+
+#include <QtTest/QtTest>
+
+class PolyVoxChunksTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testChunkLayout();
+    void testMarkDirty();
+    void testSurfacesMatchWholeVolume();
+
+    // re-meshing after a small edit, the whole volume against the dirty chunks
+    void benchmarkSculpt_data();
+    void benchmarkSculpt();
+};
+
+#endif // hifi_PolyVoxChunksTests_h
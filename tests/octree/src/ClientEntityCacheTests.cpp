@@ -0,0 +1,111 @@
+//
+//  ClientEntityCacheTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ClientEntityCacheTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <ClientEntityCache.h>
+#include <EntityTree.h>
+#include <ModelEntityItem.h>
+
+QTEST_MAIN(ClientEntityCacheTests)
+
+namespace {
+
+const quint64 SERVER_LAST_EDITED = 1000000;
+
+EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    return tree;
+}
+
+// adds a model as if the server had sent it
+EntityItemPointer addModel(const EntityTreePointer& tree, const QString& modelURL, quint64 lastEditedFromRemote,
+                           entity::HostType hostType = entity::HostType::DOMAIN) {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Model);
+    properties.setModelURL(modelURL);
+    properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    properties.setEntityHostType(hostType);
+    EntityItemPointer entity;
+    tree->withWriteLock([&] {
+        entity = tree->addCachedEntity(EntityItemID(QUuid::createUuid()), properties, lastEditedFromRemote);
+    });
+    return entity;
+}
+
+}
+
+void ClientEntityCacheTests::testManifest() {
+    QHash<QUuid, quint64> manifest;
+    for (quint64 i = 0; i < 100; i++) {
+        manifest.insert(QUuid::createUuid(), SERVER_LAST_EDITED + i);
+    }
+
+    QHash<QUuid, quint64> readManifest;
+    QVERIFY(ClientEntityCache::readManifest(ClientEntityCache::writeManifest(manifest), readManifest));
+    QCOMPARE(readManifest, manifest);
+
+    // a truncated manifest is dropped
+    QByteArray data = ClientEntityCache::writeManifest(manifest);
+    data.chop(10);
+    QVERIFY(!ClientEntityCache::readManifest(data, readManifest));
+    QVERIFY(readManifest.isEmpty());
+}
+
+void ClientEntityCacheTests::testSaveAndLoad() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    ClientEntityCache cache(directory.path());
+    QUuid domainID = QUuid::createUuid();
+
+    auto tree = createTree();
+    auto model = addModel(tree, "https://example.com/model.fbx", SERVER_LAST_EDITED);
+    QVERIFY(model);
+    addModel(tree, "https://example.com/local.fbx", 0);
+    addModel(tree, "https://example.com/avatar.fbx", SERVER_LAST_EDITED, entity::HostType::AVATAR);
+
+    // only the domain entities which came from the server are cached
+    QCOMPARE(ClientEntityCache::getManifest(tree).size(), 2);
+    QCOMPARE(cache.save(domainID, tree), 2);
+
+    auto loadedTree = createTree();
+    QCOMPARE(cache.load(QUuid::createUuid(), loadedTree), 0);
+    QCOMPARE(cache.load(domainID, loadedTree), 2);
+
+    auto loadedModel = std::dynamic_pointer_cast<ModelEntityItem>(loadedTree->findEntityByID(model->getID()));
+    QVERIFY(loadedModel);
+    QCOMPARE(loadedModel->getModelURL(), QString("https://example.com/model.fbx"));
+    QCOMPARE(loadedModel->getWorldPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+    QCOMPARE(loadedModel->getLastEditedFromRemoteInRemoteTime(), SERVER_LAST_EDITED);
+
+    // the manifest sent to the server matches the one the cache was saved from
+    QCOMPARE(ClientEntityCache::getManifest(loadedTree), ClientEntityCache::getManifest(tree));
+}
+
+void ClientEntityCacheTests::testLoadKeepsNewerEntities() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    ClientEntityCache cache(directory.path());
+    QUuid domainID = QUuid::createUuid();
+
+    auto tree = createTree();
+    auto model = addModel(tree, "https://example.com/old.fbx", SERVER_LAST_EDITED);
+    QCOMPARE(cache.save(domainID, tree), 1);
+
+    // entities already received from the server aren't replaced by their cached version
+    model->setLastEditedFromRemoteInRemoteTime(SERVER_LAST_EDITED + 1);
+    std::static_pointer_cast<ModelEntityItem>(model)->setModelURL("https://example.com/new.fbx");
+    QCOMPARE(cache.load(domainID, tree), 0);
+    QCOMPARE(std::static_pointer_cast<ModelEntityItem>(model)->getModelURL(), QString("https://example.com/new.fbx"));
+    QCOMPARE(ClientEntityCache::getManifest(tree).value(model->getID()), SERVER_LAST_EDITED + 1);
+}
@@ -0,0 +1,25 @@
+//
+//  ClientEntityCacheTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ClientEntityCacheTests_h
+#define hifi_ClientEntityCacheTests_h
+
+#include <QtTest/QtTest>
+
+class ClientEntityCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testManifest();
+    void testSaveAndLoad();
+    void testLoadKeepsNewerEntities();
+};
+
+#endif // hifi_ClientEntityCacheTests_h
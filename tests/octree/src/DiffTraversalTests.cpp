@@ -0,0 +1,134 @@
+//
+//  DiffTraversalTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DiffTraversalTests.h"
+
+#include <random>
+#include <vector>
+
+#include <DiffTraversal.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <ModelEntityItem.h>
+#include <OctreeConstants.h>
+
+QTEST_MAIN(DiffTraversalTests)
+
+namespace {
+
+const float SMALL_CUBE_SCALE = (float)TREE_SCALE / 1024.0f;
+const uint64_t NO_TIME_BUDGET = (uint64_t)-1;
+
+// creates a tree with an entity in each of numElements small elements, and returns these elements
+EntityTreePointer createTree(int numElements, std::vector<EntityTreeElementPointer>& elements) {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> coordinate((float)-HALF_TREE_SCALE + SMALL_CUBE_SCALE,
+                                                     (float)HALF_TREE_SCALE - SMALL_CUBE_SCALE);
+    for (int i = 0; i < numElements; i++) {
+        glm::vec3 center(coordinate(generator), coordinate(generator), coordinate(generator));
+        AACube cube(center - glm::vec3(SMALL_CUBE_SCALE / 2.0f), SMALL_CUBE_SCALE);
+        auto element = std::static_pointer_cast<EntityTreeElement>(tree->getOrCreateChildElementContaining(cube));
+        if (!element->hasEntities()) {
+            element->addEntityItem(std::make_shared<ModelEntityItem>(EntityItemID(QUuid::createUuid())));
+            elements.push_back(element);
+        }
+    }
+    return tree;
+}
+
+// makes sure the next timestamps are later than the ones taken so far
+void waitForNextTimestamp() {
+    uint64_t now = usecTimestampNow();
+    while (usecTimestampNow() <= now) {
+    }
+}
+
+// runs a complete traversal and returns the elements it scanned
+std::vector<EntityTreeElementPointer> traverse(DiffTraversal& traversal, const EntityTreePointer& tree,
+                                               DiffTraversal::Type& type) {
+    std::vector<EntityTreeElementPointer> scanned;
+    type = traversal.prepareNewTraversal(DiffTraversal::View(), std::static_pointer_cast<EntityTreeElement>(tree->getRoot()));
+    traversal.setScanCallback([&](DiffTraversal::VisibleElement& next) {
+        scanned.push_back(next.element);
+    });
+    while (!traversal.finished()) {
+        traversal.traverse(NO_TIME_BUDGET);
+    }
+    return scanned;
+}
+
+}
+
+void DiffTraversalTests::testSubtreeLastChanged() {
+    std::vector<EntityTreeElementPointer> elements;
+    EntityTreePointer tree = createTree(100, elements);
+    auto root = std::static_pointer_cast<EntityTreeElement>(tree->getRoot());
+    QVERIFY(root->getSubtreeLastChanged() > 0);
+
+    waitForNextTimestamp();
+    uint64_t before = usecTimestampNow();
+    waitForNextTimestamp();
+
+    EntityTreeElementPointer changed = elements.front();
+    changed->bumpChangedContent();
+    QVERIFY(changed->getSubtreeLastChanged() > before);
+
+    // the ancestors of the element are bumped, the other children of the root aren't
+    int changedChild = root->getMyChildContaining(changed->getAACube());
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        auto child = std::static_pointer_cast<EntityTreeElement>(root->getChildAtIndex(i));
+        if (child) {
+            QCOMPARE(child->getSubtreeLastChanged() > before, i == changedChild);
+        }
+    }
+    QVERIFY(root->getSubtreeLastChanged() > before);
+}
+
+void DiffTraversalTests::testRepeatSkipsUnchangedSubtrees() {
+    std::vector<EntityTreeElementPointer> elements;
+    EntityTreePointer tree = createTree(1000, elements);
+
+    DiffTraversal traversal;
+    DiffTraversal::Type type;
+    auto scanned = traverse(traversal, tree, type);
+    QCOMPARE(type, DiffTraversal::First);
+    QCOMPARE(scanned.size(), elements.size());
+
+    // nothing changed
+    waitForNextTimestamp();
+    scanned = traverse(traversal, tree, type);
+    QCOMPARE(type, DiffTraversal::Repeat);
+    QVERIFY(scanned.empty());
+
+    // only the changed element is scanned
+    waitForNextTimestamp();
+    EntityTreeElementPointer changed = elements[elements.size() / 2];
+    changed->bumpChangedContent();
+    waitForNextTimestamp();
+    scanned = traverse(traversal, tree, type);
+    QCOMPARE(type, DiffTraversal::Repeat);
+    QCOMPARE((int)scanned.size(), 1);
+    QCOMPARE(scanned.front(), changed);
+}
+
+void DiffTraversalTests::benchmarkIdleRepeatTraversal() {
+    std::vector<EntityTreeElementPointer> elements;
+    EntityTreePointer tree = createTree(10000, elements);
+
+    DiffTraversal traversal;
+    DiffTraversal::Type type;
+    traverse(traversal, tree, type);
+    QBENCHMARK {
+        traverse(traversal, tree, type);
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  DiffTraversalTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DiffTraversalTests_h
+#define hifi_DiffTraversalTests_h
+
+#include <QtTest/QtTest>
+
+class DiffTraversalTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSubtreeLastChanged();
+    void testRepeatSkipsUnchangedSubtrees();
+
+    // a repeat traversal of a large tree that didn't change
+    void benchmarkIdleRepeatTraversal();
+};
+
+#endif // hifi_DiffTraversalTests_h
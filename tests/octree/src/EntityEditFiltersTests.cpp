@@ -0,0 +1,76 @@
+//
+//  EntityEditFiltersTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditFiltersTests.h"
+
+#include <EntityEditFilters.h>
+#include <EntityTree.h>
+
+QTEST_MAIN(EntityEditFiltersTests)
+
+namespace {
+
+// rejects the deletes and the edits moving entities below the ground, and only looks at the positions of the edits
+const QString FILTER_SCRIPT =
+    "function filter(properties, type) {\n"
+    "    if (type === Entities.DELETE_FILTER_TYPE) {\n"
+    "        return false;\n"
+    "    }\n"
+    "    if (properties.position && properties.position.y < 0) {\n"
+    "        return false;\n"
+    "    }\n"
+    "    return properties;\n"
+    "}\n"
+    "filter.wantsToFilterDelete = true;\n"
+    "filter.wantsProperties = [\"position\"];\n";
+
+// the global filter, of the null zone ID
+std::shared_ptr<EntityEditFilters> createFilters(const EntityTreePointer& tree) {
+    auto filters = std::make_shared<EntityEditFilters>(tree);
+    filters->addFilterScript(EntityItemID(), FILTER_SCRIPT, "filter.js");
+    return filters;
+}
+
+bool filter(EntityEditFilters& filters, EntityItemProperties& properties, EntityTree::FilterType filterType) {
+    glm::vec3 position = properties.getPosition();
+    EntityItemID entityID(QUuid::createUuid());
+    EntityItemPointer existingEntity;
+    bool wasChanged = false;
+    return filters.filter(position, properties, properties, wasChanged, filterType, entityID, existingEntity);
+}
+
+}
+
+void EntityEditFiltersTests::testWantedPropertiesSkipEdits() {
+    auto tree = std::make_shared<EntityTree>();
+    auto filters = createFilters(tree);
+
+    // an edit of a wanted property goes through the filter
+    EntityItemProperties moveBelowGround;
+    moveBelowGround.setPosition(glm::vec3(0.0f, -1.0f, 0.0f));
+    QVERIFY(!filter(*filters, moveBelowGround, EntityTree::FilterType::Edit));
+    EntityItemProperties moveAboveGround;
+    moveAboveGround.setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    QVERIFY(filter(*filters, moveAboveGround, EntityTree::FilterType::Edit));
+
+    // an edit of other properties skips it
+    EntityItemProperties rename;
+    rename.setName("renamed");
+    QVERIFY(filter(*filters, rename, EntityTree::FilterType::Edit));
+}
+
+void EntityEditFiltersTests::testWantedPropertiesKeepDeletes() {
+    auto tree = std::make_shared<EntityTree>();
+    auto filters = createFilters(tree);
+
+    // the deletes have no properties, they still go through a filter declaring the properties it wants
+    EntityItemProperties deleteProperties;
+    QVERIFY(!filter(*filters, deleteProperties, EntityTree::FilterType::Delete));
+}
@@ -0,0 +1,141 @@
+//
+//  EntityEditPipelineTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditPipelineTests.h"
+
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <LimitedNodeList.h>
+#include <NLPacket.h>
+#include <Node.h>
+#include <NodeList.h>
+#include <ReceivedMessage.h>
+#include <StatTracker.h>
+
+QTEST_MAIN(EntityEditPipelineTests)
+
+namespace {
+
+struct Packet {
+    QVector<EntityItemID> ids;
+    QSharedPointer<ReceivedMessage> message;
+};
+
+EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+SharedNodePointer createSender() {
+    SharedNodePointer sender(new Node(QUuid::createUuid(), NodeType::Agent, HifiSockAddr(), HifiSockAddr()));
+    NodePermissions permissions;
+    permissions.set(NodePermissions::Permission::canRezPermanentEntities);
+    sender->setPermissions(permissions);
+    return sender;
+}
+
+// an add packet of boxes, with an add of an entity type which doesn't exist in place of the box at badIndex
+Packet createAddPacket(int numEdits, int badIndex) {
+    Packet packet;
+    auto nlPacket = NLPacket::create(PacketType::EntityAdd);
+    for (int i = 0; i < numEdits; i++) {
+        EntityItemProperties properties;
+        properties.setType(i == badIndex ? (EntityTypes::EntityType)(EntityTypes::NUM_TYPES + 1) : EntityTypes::Box);
+        properties.setPosition(glm::vec3((float)i, 1.0f, 1.0f));
+        properties.setDimensions(glm::vec3(0.5f));
+        properties.setLastEdited(usecTimestampNow());
+
+        EntityItemID id(QUuid::createUuid());
+        QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityAdd), 0);
+        EntityPropertyFlags didntFitProperties;
+        EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, id, properties, buffer,
+                                                     properties.getChangedProperties(), didntFitProperties);
+        nlPacket->write(buffer);
+        packet.ids.push_back(id);
+    }
+    packet.message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+    return packet;
+}
+
+// the way the edit packets are processed without the pipeline, one record at a time with the tree write locked
+int processSerially(const EntityTreePointer& tree, ReceivedMessage& message, const SharedNodePointer& sender) {
+    int numEditRecords = 0;
+    while (message.getBytesLeftToRead() > 0) {
+        auto editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+        int maxSize = message.getBytesLeftToRead();
+        int editDataBytesRead = 0;
+        tree->withWriteLock([&] {
+            editDataBytesRead = tree->processEditPacketData(message, editData, maxSize, sender);
+        });
+        numEditRecords++;
+        message.seek(message.getPosition() + editDataBytesRead);
+    }
+    return numEditRecords;
+}
+
+}
+
+void EntityEditPipelineTests::initTestCase() {
+    DependencyManager::set<StatTracker>();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntityEditPipelineTests::testBadEditMidPacket() {
+    const int NUM_EDITS = 3;
+    const int BAD_INDEX = 1;
+    Packet packet = createAddPacket(NUM_EDITS, BAD_INDEX);
+    auto tree = createTree();
+
+    // every record is counted and decoded, the bad one only fails once applied
+    OctreeDecodedEdits edits;
+    QCOMPARE(tree->decodeEditPacket(*packet.message, createSender(), edits), NUM_EDITS);
+    QCOMPARE((int)edits.size(), NUM_EDITS);
+    QCOMPARE(packet.message->getBytesLeftToRead(), (qint64)0);
+
+    quint64 lockWaitTime = 0;
+    quint64 processTime = 0;
+    tree->processDecodedEdits(edits, lockWaitTime, processTime);
+
+    for (int i = 0; i < NUM_EDITS; i++) {
+        QCOMPARE((bool)tree->findEntityByEntityItemID(packet.ids[i]), i != BAD_INDEX);
+    }
+    // the sender is told the bad add failed
+    QVERIFY(tree->getRecentlyDeletedEntityIDs().values().contains(packet.ids[BAD_INDEX]));
+}
+
+void EntityEditPipelineTests::testMatchesSerial() {
+    const int NUM_EDITS = 20;
+    const int BAD_INDEX = 7;
+    Packet packet = createAddPacket(NUM_EDITS, BAD_INDEX);
+    auto sender = createSender();
+
+    auto serialTree = createTree();
+    QCOMPARE(processSerially(serialTree, *packet.message, sender), NUM_EDITS);
+
+    packet.message->seek(0);
+    auto pipelinedTree = createTree();
+    OctreeDecodedEdits edits;
+    QCOMPARE(pipelinedTree->decodeEditPacket(*packet.message, sender, edits), NUM_EDITS);
+    quint64 lockWaitTime = 0;
+    quint64 processTime = 0;
+    pipelinedTree->processDecodedEdits(edits, lockWaitTime, processTime);
+
+    for (const auto& id : packet.ids) {
+        auto serialEntity = serialTree->findEntityByEntityItemID(id);
+        auto pipelinedEntity = pipelinedTree->findEntityByEntityItemID(id);
+        QCOMPARE((bool)pipelinedEntity, (bool)serialEntity);
+        if (serialEntity) {
+            QCOMPARE(pipelinedEntity->getWorldPosition(), serialEntity->getWorldPosition());
+        }
+    }
+}
@@ -0,0 +1,26 @@
+//
+//  EntityEditPipelineTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditPipelineTests_h
+#define hifi_EntityEditPipelineTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditPipelineTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void testBadEditMidPacket();
+    void testMatchesSerial();
+};
+
+#endif // hifi_EntityEditPipelineTests_h
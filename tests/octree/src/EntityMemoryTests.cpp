@@ -0,0 +1,107 @@
+//
+//  EntityMemoryTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityMemoryTests.h"
+
+#include <vector>
+
+#include <InternedStrings.h>
+#include <ModelEntityItem.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(EntityMemoryTests)
+
+namespace {
+
+const int NUM_URLS = 8;
+
+QString modelURL(int i) {
+    // built at runtime so that each call makes a separate buffer
+    return QString("https://example.com/models/model%1.fbx").arg(i % NUM_URLS);
+}
+
+std::shared_ptr<ModelEntityItem> createModel(int i) {
+    auto entity = std::make_shared<ModelEntityItem>(EntityItemID(QUuid::createUuid()));
+    entity->setModelURL(modelURL(i));
+    entity->setName(QString("model%1").arg(i % NUM_URLS));
+    return entity;
+}
+
+}
+
+void EntityMemoryTests::testInternedStrings() {
+    QString first = InternedStrings::intern(QString("interned") + QString::number(1));
+    QString second = InternedStrings::intern(QString("interned") + QString::number(1));
+    QCOMPARE(first, second);
+    QCOMPARE(first.constData(), second.constData());
+
+    // empty strings aren't kept in the table
+    int size = InternedStrings::size();
+    QVERIFY(InternedStrings::intern(QString()).isEmpty());
+    QCOMPARE(InternedStrings::size(), size);
+
+    // the strings are kept as long as somebody holds them
+    InternedStrings::purge();
+    QCOMPARE(InternedStrings::intern(QString("interned1")).constData(), first.constData());
+    first.clear();
+    second.clear();
+    QVERIFY(InternedStrings::purge() >= 1);
+    QCOMPARE(InternedStrings::size(), size - 1);
+}
+
+void EntityMemoryTests::testSharedURLs() {
+    auto first = createModel(0);
+    auto second = createModel(NUM_URLS);
+    QCOMPARE(first->getModelURL(), second->getModelURL());
+    QCOMPARE(first->getModelURL().constData(), second->getModelURL().constData());
+    QCOMPARE(first->getName().constData(), second->getName().constData());
+
+    auto other = createModel(1);
+    QVERIFY(first->getModelURL().constData() != other->getModelURL().constData());
+}
+
+void EntityMemoryTests::testSparseProperties() {
+    auto entity = createModel(0);
+    QCOMPARE(entity->getHref(), QString());
+    QCOMPARE(entity->getItemName(), ENTITY_ITEM_DEFAULT_ITEM_NAME);
+    QCOMPARE(entity->getLimitedRun(), ENTITY_ITEM_DEFAULT_LIMITED_RUN);
+    QCOMPARE(entity->getMarketplaceID(), ENTITY_ITEM_DEFAULT_MARKETPLACE_ID);
+
+    entity->setItemName("item");
+    entity->setLimitedRun(10);
+    QCOMPARE(entity->getItemName(), QString("item"));
+    QCOMPARE(entity->getLimitedRun(), (quint32)10);
+    QCOMPARE(entity->getMarketplaceID(), ENTITY_ITEM_DEFAULT_MARKETPLACE_ID);
+
+    // the other entities still read the defaults
+    auto other = createModel(1);
+    QCOMPARE(other->getItemName(), ENTITY_ITEM_DEFAULT_ITEM_NAME);
+    QCOMPARE(other->getLimitedRun(), ENTITY_ITEM_DEFAULT_LIMITED_RUN);
+}
+
+void EntityMemoryTests::testMemoryPerEntity() {
+    const int NUM_ENTITIES = 10000;
+
+    MemoryInfo before;
+    if (!getMemoryInfo(before)) {
+        QSKIP("no memory info on this platform");
+    }
+
+    std::vector<std::shared_ptr<ModelEntityItem>> entities;
+    entities.reserve(NUM_ENTITIES);
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        entities.push_back(createModel(i));
+    }
+
+    MemoryInfo after;
+    QVERIFY(getMemoryInfo(after));
+    qDebug() << "sizeof(ModelEntityItem):" << sizeof(ModelEntityItem)
+        << "process bytes per entity:" << (double)(after.processUsedMemoryBytes - before.processUsedMemoryBytes) / NUM_ENTITIES;
+}
@@ -0,0 +1,28 @@
+//
+//  EntityMemoryTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityMemoryTests_h
+#define hifi_EntityMemoryTests_h
+
+#include <QtTest/QtTest>
+
+class EntityMemoryTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testInternedStrings();
+    void testSharedURLs();
+    void testSparseProperties();
+
+    // reports the bytes used by each of many model entities sharing a few urls
+    void testMemoryPerEntity();
+};
+
+#endif // hifi_EntityMemoryTests_h
@@ -0,0 +1,156 @@
+//
+//  EntityPackedPropertiesTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPackedPropertiesTests.h"
+
+#include <cmath>
+
+#include <DependencyManager.h>
+#include <EntityScriptingInterface.h>
+#include <EntityTree.h>
+#include <LimitedNodeList.h>
+#include <NodeList.h>
+#include <StatTracker.h>
+
+QTEST_MAIN(EntityPackedPropertiesTests)
+
+namespace {
+
+// rotation, an unsupported name, then position and dimensions
+const QStringList PROPERTY_NAMES = { "rotation", "notAProperty", "position", "dimensions" };
+const int ROTATION_OFFSET = 0;
+const int POSITION_OFFSET = 4;
+const int DIMENSIONS_OFFSET = 7;
+const int STRIDE = 10;
+
+EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+EntityItemID addBox(const EntityTreePointer& tree, const glm::vec3& position, const glm::quat& rotation,
+                    const glm::vec3& dimensions) {
+    EntityItemID id(QUuid::createUuid());
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(position);
+    properties.setRotation(rotation);
+    properties.setDimensions(dimensions);
+    tree->withWriteLock([&] {
+        tree->addEntity(id, properties);
+    });
+    return id;
+}
+
+void verifyMissing(const QVector<float>& data, int entityIndex) {
+    for (int i = 0; i < STRIDE; i++) {
+        QVERIFY(std::isnan(data[entityIndex * STRIDE + i]));
+    }
+}
+
+}
+
+void EntityPackedPropertiesTests::initTestCase() {
+    DependencyManager::set<StatTracker>();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+}
+
+void EntityPackedPropertiesTests::testStride() {
+    EntityScriptingInterface entities(false);
+    QVector<int> offsets;
+    QCOMPARE(entities.getPackedEntityPropertiesStride(PROPERTY_NAMES, offsets), STRIDE);
+    QCOMPARE(offsets, QVector<int>({ ROTATION_OFFSET, -1, POSITION_OFFSET, DIMENSIONS_OFFSET }));
+
+    QCOMPARE(entities.getPackedEntityPropertiesStride({ "notAProperty" }, offsets), 0);
+    QCOMPARE(offsets, QVector<int>({ -1 }));
+}
+
+void EntityPackedPropertiesTests::testPackedLayout() {
+    auto tree = createTree();
+    EntityScriptingInterface entities(false);
+    entities.setEntityTree(tree);
+
+    const glm::vec3 position(1.0f, 2.0f, 3.0f);
+    const glm::quat rotation = glm::angleAxis(0.5f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f)));
+    const glm::vec3 dimensions(0.5f, 1.5f, 2.5f);
+    auto first = addBox(tree, position, rotation, dimensions);
+    auto second = addBox(tree, -position, glm::quat(), 2.0f * dimensions);
+
+    // entities are packed in the order asked for, repeats included
+    QVector<QUuid> ids = { second, first, second };
+    QVector<float> data(STRIDE * ids.size());
+    QVector<int> offsets;
+    QCOMPARE(entities.getPackedEntityPropertiesInternal(ids, PROPERTY_NAMES, offsets, data.data(), data.size()), STRIDE);
+    QCOMPARE(offsets[1], -1);
+
+    for (int i = 0; i < ids.size(); i++) {
+        bool isFirst = ids[i] == first;
+        glm::quat expectedRotation = isFirst ? rotation : glm::quat();
+        glm::vec3 expectedPosition = isFirst ? position : -position;
+        glm::vec3 expectedDimensions = isFirst ? dimensions : 2.0f * dimensions;
+
+        const float* values = data.data() + i * STRIDE;
+        QCOMPARE(values[ROTATION_OFFSET], expectedRotation.x);
+        QCOMPARE(values[ROTATION_OFFSET + 1], expectedRotation.y);
+        QCOMPARE(values[ROTATION_OFFSET + 2], expectedRotation.z);
+        QCOMPARE(values[ROTATION_OFFSET + 3], expectedRotation.w);
+        QCOMPARE(values[POSITION_OFFSET], expectedPosition.x);
+        QCOMPARE(values[POSITION_OFFSET + 1], expectedPosition.y);
+        QCOMPARE(values[POSITION_OFFSET + 2], expectedPosition.z);
+        QCOMPARE(values[DIMENSIONS_OFFSET], expectedDimensions.x);
+        QCOMPARE(values[DIMENSIONS_OFFSET + 1], expectedDimensions.y);
+        QCOMPARE(values[DIMENSIONS_OFFSET + 2], expectedDimensions.z);
+    }
+}
+
+void EntityPackedPropertiesTests::testMissingEntities() {
+    auto tree = createTree();
+    EntityScriptingInterface entities(false);
+    entities.setEntityTree(tree);
+
+    auto kept = addBox(tree, glm::vec3(1.0f), glm::quat(), glm::vec3(1.0f));
+    auto deleted = addBox(tree, glm::vec3(2.0f), glm::quat(), glm::vec3(1.0f));
+    tree->withWriteLock([&] {
+        tree->deleteEntity(deleted, true);
+    });
+
+    QVector<QUuid> ids = { deleted, kept, QUuid::createUuid(), QUuid() };
+    QVector<float> data(STRIDE * ids.size(), 0.0f);
+    QVector<int> offsets;
+    entities.getPackedEntityPropertiesInternal(ids, PROPERTY_NAMES, offsets, data.data(), data.size());
+
+    verifyMissing(data, 0);
+    for (int i = 0; i < STRIDE; i++) {
+        QVERIFY(!std::isnan(data[STRIDE + i]));
+    }
+    QCOMPARE(data[STRIDE + POSITION_OFFSET], 1.0f);
+    verifyMissing(data, 2);
+    verifyMissing(data, 3);
+}
+
+void EntityPackedPropertiesTests::testWithoutTree() {
+    EntityScriptingInterface entities(false);
+
+    QVector<QUuid> ids = { QUuid::createUuid(), QUuid::createUuid() };
+    QVector<float> data(STRIDE * ids.size(), 0.0f);
+    QVector<int> offsets;
+    QCOMPARE(entities.getPackedEntityPropertiesInternal(ids, PROPERTY_NAMES, offsets, data.data(), data.size()), STRIDE);
+    verifyMissing(data, 0);
+    verifyMissing(data, 1);
+
+    // a buffer too small for the entities is left alone
+    QVector<float> smallData(STRIDE, 0.0f);
+    QCOMPARE(entities.getPackedEntityPropertiesInternal(ids, PROPERTY_NAMES, offsets, smallData.data(), smallData.size()),
+             STRIDE);
+    QCOMPARE(smallData, QVector<float>(STRIDE, 0.0f));
+}
@@ -0,0 +1,28 @@
+//
+//  EntityPackedPropertiesTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPackedPropertiesTests_h
+#define hifi_EntityPackedPropertiesTests_h
+
+#include <QtTest/QtTest>
+
+class EntityPackedPropertiesTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void testStride();
+    void testPackedLayout();
+    void testMissingEntities();
+    void testWithoutTree();
+};
+
+#endif // hifi_EntityPackedPropertiesTests_h
@@ -0,0 +1,214 @@
+//
+//  EntitySimulationTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySimulationTests.h"
+
+#include <random>
+
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <LimitedNodeList.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SimpleEntitySimulation.h>
+#include <SpatialParentFinder.h>
+#include <StatTracker.h>
+
+QTEST_MAIN(EntitySimulationTests)
+
+namespace {
+
+const int NUM_FREE_ENTITIES = 500;
+const int NUM_CHILDREN = 3;
+const int NUM_STEPS = 10;
+const uint64_t STEP_USECS = USECS_PER_SECOND / 60;
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    SpatiallyNestableWeakPointer find(QUuid parentID, bool& success, SpatialParentTree* entityTree) const override {
+        if (parentID.isNull()) {
+            success = true;
+            return SpatiallyNestableWeakPointer();
+        }
+        SpatiallyNestableWeakPointer parent;
+        if (entityTree) {
+            parent = entityTree->findByID(parentID);
+        }
+        success = !parent.expired();
+        return parent;
+    }
+};
+
+class TestEntitySimulation : public SimpleEntitySimulation {
+public:
+    using EntitySimulation::canMoveConcurrently;
+
+    void addSimpleKinematic(const EntityItemPointer& entity) { _simpleKinematicEntities.insert(entity); }
+    bool isSimpleKinematic(const EntityItemPointer& entity) const { return _simpleKinematicEntities.contains(entity); }
+    bool needsSort(const EntityItemPointer& entity) const { return _entitiesToSort.contains(entity); }
+};
+
+struct Content {
+    QVector<EntityItemID> ids;
+    QVector<EntityItemProperties> properties;
+    int stoppedIndex { -1 };
+    QVector<int> parentIndices;
+    QVector<int> childIndices;
+};
+
+EntityItemProperties createBox(std::mt19937& generator, bool moving) {
+    std::uniform_real_distribution<float> positionDistribution(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> velocityDistribution(-2.0f, 2.0f);
+
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(glm::vec3(positionDistribution(generator), positionDistribution(generator),
+        positionDistribution(generator)));
+    properties.setDimensions(glm::vec3(1.0f));
+    if (moving) {
+        properties.setVelocity(glm::vec3(velocityDistribution(generator), velocityDistribution(generator),
+            velocityDistribution(generator)));
+        properties.setAngularVelocity(glm::vec3(0.0f, velocityDistribution(generator), 0.0f));
+    }
+    return properties;
+}
+
+int addBox(Content& content, const EntityItemProperties& properties) {
+    content.ids.push_back(EntityItemID(QUuid::createUuid()));
+    content.properties.push_back(properties);
+    return content.ids.size() - 1;
+}
+
+// free boxes, one box that does not move, a moving parent with moving children and a moving child of a static parent
+Content createContent(std::mt19937& generator) {
+    Content content;
+    for (int i = 0; i < NUM_FREE_ENTITIES; i++) {
+        addBox(content, createBox(generator, true));
+    }
+    content.stoppedIndex = addBox(content, createBox(generator, false));
+
+    int movingParent = addBox(content, createBox(generator, true));
+    int staticParent = addBox(content, createBox(generator, false));
+    content.parentIndices = { movingParent, staticParent };
+    for (int parent : content.parentIndices) {
+        for (int i = 0; i < NUM_CHILDREN; i++) {
+            EntityItemProperties properties = createBox(generator, true);
+            properties.setParentID(content.ids[parent]);
+            content.childIndices.push_back(addBox(content, properties));
+        }
+    }
+    return content;
+}
+
+QVector<EntityItemPointer> addContent(const EntityTreePointer& tree, const Content& content, uint64_t start) {
+    QVector<EntityItemPointer> entities;
+    tree->withWriteLock([&] {
+        for (int i = 0; i < content.ids.size(); i++) {
+            entities.push_back(tree->addEntity(content.ids[i], content.properties[i]));
+        }
+    });
+    for (const auto& entity : entities) {
+        // registers the children with their parents
+        bool success;
+        entity->getParentPointer(success);
+        entity->setLastSimulated(start);
+    }
+    return entities;
+}
+
+EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+// the kinematic step as it was before moveSimpleKinematics was split between the worker threads
+void stepSerially(QVector<EntityItemPointer>& entities, uint64_t now) {
+    for (const auto& entity : entities) {
+        bool ancestryIsKnown;
+        entity->getMaximumAACube(ancestryIsKnown);
+        bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
+        if (entity->isMovingRelativeToParent() && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
+            entity->simulate(now);
+        }
+    }
+}
+
+}
+
+void EntitySimulationTests::initTestCase() {
+    DependencyManager::set<StatTracker>();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+    DependencyManager::registerInheritance<SpatialParentFinder, TestParentFinder>();
+    DependencyManager::set<TestParentFinder>();
+}
+
+void EntitySimulationTests::testNestedEntitiesMoveSerially() {
+    std::mt19937 generator(1);
+    Content content = createContent(generator);
+    auto tree = createTree();
+    auto entities = addContent(tree, content, usecTimestampNow());
+
+    for (int i = 0; i < NUM_FREE_ENTITIES; i++) {
+        QVERIFY(TestEntitySimulation::canMoveConcurrently(entities[i]));
+    }
+    QVERIFY(TestEntitySimulation::canMoveConcurrently(entities[content.stoppedIndex]));
+    for (int parent : content.parentIndices) {
+        QVERIFY(entities[parent]->hasChildren());
+        QVERIFY(!TestEntitySimulation::canMoveConcurrently(entities[parent]));
+    }
+    for (int child : content.childIndices) {
+        QVERIFY(!TestEntitySimulation::canMoveConcurrently(entities[child]));
+    }
+}
+
+void EntitySimulationTests::testMoveMatchesSerialStep() {
+    std::mt19937 generator(2);
+    Content content = createContent(generator);
+    uint64_t start = usecTimestampNow();
+
+    auto tree = createTree();
+    auto entities = addContent(tree, content, start);
+    auto serialTree = createTree();
+    auto serialEntities = addContent(serialTree, content, start);
+
+    TestEntitySimulation simulation;
+    for (const auto& entity : entities) {
+        simulation.addSimpleKinematic(entity);
+    }
+
+    for (int step = 1; step <= NUM_STEPS; step++) {
+        uint64_t now = start + step * STEP_USECS;
+        simulation.moveSimpleKinematics(now);
+        stepSerially(serialEntities, now);
+    }
+
+    for (int i = 0; i < entities.size(); i++) {
+        glm::vec3 position = entities[i]->getWorldPosition();
+        glm::vec3 expectedPosition = serialEntities[i]->getWorldPosition();
+        QCOMPARE(position.x, expectedPosition.x);
+        QCOMPARE(position.y, expectedPosition.y);
+        QCOMPARE(position.z, expectedPosition.z);
+
+        glm::quat orientation = entities[i]->getWorldOrientation();
+        glm::quat expectedOrientation = serialEntities[i]->getWorldOrientation();
+        QCOMPARE(orientation.x, expectedOrientation.x);
+        QCOMPARE(orientation.y, expectedOrientation.y);
+        QCOMPARE(orientation.z, expectedOrientation.z);
+        QCOMPARE(orientation.w, expectedOrientation.w);
+
+        // the box without velocity and the static parent drop out of the kinematic set on the first step
+        bool moved = i != content.stoppedIndex && i != content.parentIndices.back();
+        QCOMPARE(simulation.isSimpleKinematic(entities[i]), moved);
+        QCOMPARE(simulation.needsSort(entities[i]), moved);
+    }
+}
@@ -0,0 +1,210 @@
+//
+//  EntityTreeBulkLoadTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeBulkLoadTests.h"
+
+#include <random>
+
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <LimitedNodeList.h>
+#include <NodeList.h>
+#include <OctalCode.h>
+#include <OctreeConstants.h>
+#include <StatTracker.h>
+
+QTEST_MAIN(EntityTreeBulkLoadTests)
+
+namespace {
+
+struct Content {
+    QVector<EntityItemID> ids;
+    QVector<EntityItemProperties> properties;
+};
+
+EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+// boxes of every size across and beyond the tree, some parented to entities listed after them, and one repeated ID
+Content createContent(int numEntities, std::mt19937& generator) {
+    std::uniform_real_distribution<float> positionDistribution(-1.1f * HALF_TREE_SCALE, 1.1f * HALF_TREE_SCALE);
+    std::uniform_real_distribution<float> scaleExponentDistribution(-12.0f, 14.0f);
+
+    Content content;
+    for (int i = 0; i < numEntities; i++) {
+        content.ids.push_back(EntityItemID(QUuid::createUuid()));
+    }
+    for (int i = 0; i < numEntities; i++) {
+        glm::vec3 position(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+        float size = powf(2.0f, scaleExponentDistribution(generator));
+        if (i % 10 == 0) {
+            // across the planes splitting the tree
+            position = glm::vec3(0.0f);
+        }
+
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setPosition(position);
+        properties.setDimensions(glm::vec3(size));
+        if (i % 7 == 3) {
+            // the query cube of a child is saved with it, as its parent may not have been added yet
+            properties.setParentID(content.ids[(i + 1) % numEntities]);
+            properties.setQueryAACube(AACube(position - glm::vec3(size / 2.0f), size));
+        }
+        content.properties.push_back(properties);
+    }
+    content.ids.push_back(content.ids.front());
+    content.properties.push_back(content.properties.back());
+    return content;
+}
+
+QVector<EntityItemPointer> addEntitiesOneAtATime(const EntityTreePointer& tree, const Content& content) {
+    QVector<EntityItemPointer> entities;
+    tree->withWriteLock([&] {
+        for (int i = 0; i < content.ids.size(); i++) {
+            entities.push_back(tree->addEntity(content.ids[i], content.properties[i]));
+        }
+    });
+    return entities;
+}
+
+QVector<EntityItemPointer> addEntitiesAtOnce(const EntityTreePointer& tree, const Content& content) {
+    QVector<EntityItemPointer> entities;
+    tree->withWriteLock([&] {
+        entities = tree->addEntities(content.ids, content.properties);
+    });
+    return entities;
+}
+
+// every element of the tree by its octal code, with the IDs of its entities in order
+QMap<QString, QVector<QUuid>> describeTree(const EntityTreePointer& tree) {
+    QMap<QString, QVector<QUuid>> description;
+    tree->withReadLock([&] {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+            QVector<QUuid>& ids = description[octalCodeToHexString(element->getOctalCode())];
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](EntityItemPointer entity) {
+                ids.push_back(entity->getID());
+            });
+            return true;
+        });
+    });
+    return description;
+}
+
+void compareAdded(const QVector<EntityItemPointer>& entities, const QVector<EntityItemPointer>& expectedEntities) {
+    QCOMPARE(entities.size(), expectedEntities.size());
+    for (int i = 0; i < entities.size(); i++) {
+        QCOMPARE((bool)entities[i], (bool)expectedEntities[i]);
+        if (entities[i]) {
+            QCOMPARE(entities[i]->getID(), expectedEntities[i]->getID());
+        }
+    }
+}
+
+}
+
+void EntityTreeBulkLoadTests::initTestCase() {
+    DependencyManager::set<StatTracker>();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntityTreeBulkLoadTests::testMatchesIncremental() {
+    std::mt19937 generator(1);
+    Content content = createContent(5000, generator);
+
+    auto incrementalTree = createTree();
+    auto incrementalEntities = addEntitiesOneAtATime(incrementalTree, content);
+    auto bulkTree = createTree();
+    auto bulkEntities = addEntitiesAtOnce(bulkTree, content);
+
+    // the repeated ID is only added the first time
+    QVERIFY(!bulkEntities.back());
+    compareAdded(bulkEntities, incrementalEntities);
+
+    auto description = describeTree(bulkTree);
+    QCOMPARE(description, describeTree(incrementalTree));
+    QVERIFY(description.size() > 1);
+    for (const auto& entity : bulkEntities) {
+        if (entity) {
+            QCOMPARE(bulkTree->findEntityByEntityItemID(entity->getEntityItemID()), entity);
+        }
+    }
+}
+
+void EntityTreeBulkLoadTests::testAddToExistingTree() {
+    std::mt19937 generator(2);
+    Content existingContent = createContent(1000, generator);
+    Content content = createContent(1000, generator);
+
+    // some of the entities are already in the tree
+    content.ids[10] = existingContent.ids[20];
+
+    auto incrementalTree = createTree();
+    addEntitiesOneAtATime(incrementalTree, existingContent);
+    auto incrementalEntities = addEntitiesOneAtATime(incrementalTree, content);
+    auto bulkTree = createTree();
+    addEntitiesOneAtATime(bulkTree, existingContent);
+    auto bulkEntities = addEntitiesAtOnce(bulkTree, content);
+
+    QVERIFY(!bulkEntities[10]);
+    compareAdded(bulkEntities, incrementalEntities);
+    QCOMPARE(describeTree(bulkTree), describeTree(incrementalTree));
+}
+
+void EntityTreeBulkLoadTests::testReadFromMap() {
+    std::mt19937 generator(3);
+    Content content = createContent(2000, generator);
+    content.ids.pop_back();
+    content.properties.pop_back();
+
+    auto incrementalTree = createTree();
+    addEntitiesOneAtATime(incrementalTree, content);
+
+    QVariantMap map;
+    map["Version"] = (int)incrementalTree->expectedVersion();
+    QVERIFY(incrementalTree->writeToMap(map, incrementalTree->getRoot(), true, false));
+    QCOMPARE(map["Entities"].toList().size(), content.ids.size());
+
+    auto loadedTree = createTree();
+    bool success = false;
+    loadedTree->withWriteLock([&] {
+        success = loadedTree->readFromMap(map);
+    });
+    QVERIFY(success);
+    QCOMPARE(describeTree(loadedTree), describeTree(incrementalTree));
+}
+
+void EntityTreeBulkLoadTests::benchmarkAddEntities_data() {
+    QTest::addColumn<bool>("atOnce");
+
+    QTest::newRow("one at a time") << false;
+    QTest::newRow("at once") << true;
+}
+
+void EntityTreeBulkLoadTests::benchmarkAddEntities() {
+    QFETCH(bool, atOnce);
+
+    std::mt19937 generator(4);
+    Content content = createContent(50000, generator);
+    QBENCHMARK_ONCE {
+        auto tree = createTree();
+        if (atOnce) {
+            addEntitiesAtOnce(tree, content);
+        } else {
+            addEntitiesOneAtATime(tree, content);
+        }
+    }
+}
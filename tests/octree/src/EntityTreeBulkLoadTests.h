@@ -0,0 +1,31 @@
+//
+//  EntityTreeBulkLoadTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeBulkLoadTests_h
+#define hifi_EntityTreeBulkLoadTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeBulkLoadTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void testMatchesIncremental();
+    void testAddToExistingTree();
+    void testReadFromMap();
+
+    // adding the entities at once against one at a time
+    void benchmarkAddEntities_data();
+    void benchmarkAddEntities();
+};
+
+#endif // hifi_EntityTreeBulkLoadTests_h
@@ -0,0 +1,199 @@
+//
+//  OctreeShardTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeShardTests.h"
+
+#include <atomic>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <Octree.h>
+#include <OctreeConstants.h>
+
+QTEST_MAIN(OctreeShardTests)
+
+namespace {
+
+const float SMALL_CUBE_SCALE = (float)TREE_SCALE / 1024.0f;
+
+AACube smallCubeAt(const glm::vec3& center) {
+    return AACube(center - glm::vec3(SMALL_CUBE_SCALE / 2.0f), SMALL_CUBE_SCALE);
+}
+
+// the centers of the eight octants of the tree
+std::vector<glm::vec3> octantCenters() {
+    std::vector<glm::vec3> centers;
+    const float QUARTER_TREE_SCALE = (float)HALF_TREE_SCALE / 2.0f;
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        centers.push_back(glm::vec3((i & 1) ? QUARTER_TREE_SCALE : -QUARTER_TREE_SCALE,
+                                    (i & 2) ? QUARTER_TREE_SCALE : -QUARTER_TREE_SCALE,
+                                    (i & 4) ? QUARTER_TREE_SCALE : -QUARTER_TREE_SCALE));
+    }
+    return centers;
+}
+
+EntityTreePointer createTree(int numElements) {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        tree->getRoot()->addChildAtIndex(i);
+    }
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> coordinate((float)-HALF_TREE_SCALE + SMALL_CUBE_SCALE,
+                                                     (float)HALF_TREE_SCALE - SMALL_CUBE_SCALE);
+    for (int i = 0; i < numElements; i++) {
+        glm::vec3 center(coordinate(generator), coordinate(generator), coordinate(generator));
+        tree->getOrCreateChildElementContaining(smallCubeAt(center));
+    }
+    return tree;
+}
+
+bool countElementsOperation(const OctreeElementPointer& element, void* extraData) {
+    (*static_cast<int*>(extraData))++;
+    return true;
+}
+
+}
+
+void OctreeShardTests::testShardIndex() {
+    EntityTreePointer tree = createTree(0);
+
+    // each octant is its own shard, the shards of the children of the root
+    std::set<int> shards;
+    for (const auto& center : octantCenters()) {
+        int shard = tree->getShardIndex(smallCubeAt(center));
+        QVERIFY(shard >= 0 && shard < NUMBER_OF_CHILDREN);
+        QCOMPARE(tree->getRoot()->getMyChildContaining(smallCubeAt(center)), shard);
+        shards.insert(shard);
+    }
+    QCOMPARE((int)shards.size(), NUMBER_OF_CHILDREN);
+
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        QCOMPARE(tree->getShardIndex(tree->getRoot()->getChildAtIndex(i)->getAACube()), i);
+    }
+
+    // the cubes spanning several octants belong to the root
+    QCOMPARE(tree->getShardIndex(smallCubeAt(glm::vec3(0.0f))), (int)Octree::ROOT_SHARD);
+    QCOMPARE(tree->getShardIndex(tree->getRoot()->getAACube()), (int)Octree::ROOT_SHARD);
+    QCOMPARE(tree->getShardIndex(AACube(glm::vec3(0.0f), (float)HALF_TREE_SCALE * 1.5f)), (int)Octree::ROOT_SHARD);
+}
+
+void OctreeShardTests::testShardSections() {
+    EntityTreePointer tree = createTree(0);
+    auto root = tree->getRoot();
+
+    QVERIFY(tree->canChangeElement(*root));
+    QVERIFY(tree->canChangeElement(*root->getChildAtIndex(1)));
+
+    tree->withShardsWriteLock(Octree::shardBit(0), [&] {
+        QVERIFY(!tree->canChangeElement(*root));
+        QVERIFY(tree->canChangeElement(*root->getChildAtIndex(0)));
+        QVERIFY(!tree->canChangeElement(*root->getChildAtIndex(1)));
+
+        // the elements of the other shards are not pruned
+        std::static_pointer_cast<EntityTreeElement>(root)->pruneChildren();
+        QVERIFY((bool)root->getChildAtIndex(1));
+    });
+
+    tree->withShardsWriteLock(Octree::shardBit(Octree::ROOT_SHARD), [&] {
+        QVERIFY(tree->canChangeElement(*root));
+    });
+
+    QVERIFY(tree->canChangeElement(*root->getChildAtIndex(1)));
+}
+
+void OctreeShardTests::testShardLocking() {
+    EntityTreePointer tree = createTree(0);
+
+    std::atomic<bool> locked { false };
+    std::atomic<bool> release { false };
+    std::thread writer([&] {
+        tree->withShardsWriteLock(Octree::shardBit(0), [&] {
+            locked = true;
+            while (!release) {
+                std::this_thread::yield();
+            }
+        });
+    });
+    while (!locked) {
+        std::this_thread::yield();
+    }
+
+    // the writers of the other shards are not blocked
+    bool wroteOtherShard = false;
+    tree->withShardsWriteLock(Octree::shardBit(1), [&] {
+        wroteOtherShard = true;
+    });
+    QVERIFY(wroteOtherShard);
+
+    bool readOtherShard = false;
+    tree->withShardsReadLock(Octree::shardBit(1), [&] {
+        readOtherShard = true;
+    });
+    QVERIFY(readOtherShard);
+
+    // the readers and writers of the whole tree are
+    QVERIFY(!tree->withTryReadLock([] {}));
+    QVERIFY(!tree->withTryWriteLock([] {}));
+
+    release = true;
+    writer.join();
+
+    QVERIFY(tree->withTryReadLock([] {}));
+    QVERIFY(tree->withTryWriteLock([] {}));
+}
+
+void OctreeShardTests::benchmarkShardContention_data() {
+    QTest::addColumn<int>("numThreads");
+    QTest::addColumn<bool>("sharded");
+
+    for (int numThreads = 1; numThreads <= NUMBER_OF_CHILDREN; numThreads *= 2) {
+        QTest::newRow(qPrintable(QString("%1 threads, tree lock").arg(numThreads))) << numThreads << false;
+        QTest::newRow(qPrintable(QString("%1 threads, shard locks").arg(numThreads))) << numThreads << true;
+    }
+}
+
+void OctreeShardTests::benchmarkShardContention() {
+    QFETCH(int, numThreads);
+    QFETCH(bool, sharded);
+
+    const int NUM_ELEMENTS = 4096;
+    const int NUM_ITERATIONS = 64;
+    EntityTreePointer tree = createTree(NUM_ELEMENTS);
+
+    // each thread repeatedly walks the subtree of its own shard, under the lock of its shard or of the whole tree
+    QBENCHMARK {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numThreads; i++) {
+            threads.emplace_back([&, i] {
+                OctreeElementPointer subtree = tree->getRoot()->getChildAtIndex(i);
+                int numElements = 0;
+                auto walkSubtree = [&] {
+                    tree->recurseElementWithOperation(subtree, countElementsOperation, &numElements);
+                };
+                for (int iteration = 0; iteration < NUM_ITERATIONS; iteration++) {
+                    if (sharded) {
+                        tree->withShardsWriteLock(Octree::shardBit(i), walkSubtree);
+                    } else {
+                        tree->withWriteLock(walkSubtree);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  OctreeShardTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeShardTests_h
+#define hifi_OctreeShardTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeShardTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testShardIndex();
+    void testShardSections();
+    void testShardLocking();
+
+    // the writers of different shards against the writers of the whole tree, by number of threads
+    void benchmarkShardContention_data();
+    void benchmarkShardContention();
+};
+
+#endif // hifi_OctreeShardTests_h
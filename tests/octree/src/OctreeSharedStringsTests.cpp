@@ -0,0 +1,216 @@
+//
+//  OctreeSharedStringsTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSharedStringsTests.h"
+
+#include <InternedStrings.h>
+#include <OctreePacketData.h>
+#include <OctreeSharedStrings.h>
+
+QTEST_MAIN(OctreeSharedStringsTests)
+
+namespace {
+
+const QString MODEL_URL { "https://example.com/models/shared.fbx" };
+const QString SCRIPT_URL { "https://example.com/scripts/shared.js" };
+
+// reads the strings in the stream with the shared strings of a viewer, and returns how many were found
+int readStrings(OctreePacketData& packetData, int numStrings, OctreeSharedStrings& viewerStrings, QStringList& strings) {
+    const unsigned char* dataAt = packetData.getUncompressedData();
+    int numFound = 0;
+    for (int i = 0; i < numStrings; i++) {
+        QString string;
+        bool found;
+        dataAt += OctreePacketData::unpackSharedStringFromBytes(dataAt, string, &viewerStrings, found);
+        if (found) {
+            numFound++;
+        }
+        strings << string;
+    }
+    return numFound;
+}
+
+}
+
+void OctreeSharedStringsTests::testInternedIDs() {
+    quint32 id = InternedStrings::getID(MODEL_URL);
+    QVERIFY(id != 0);
+    QCOMPARE(InternedStrings::getID(QString("https://example.com/models/") + "shared.fbx"), id);
+    QVERIFY(InternedStrings::getID(SCRIPT_URL) != id);
+    QCOMPARE(InternedStrings::getID(QString()), (quint32)0);
+}
+
+void OctreeSharedStringsTests::testDefineThenReference() {
+    OctreeSharedStrings serverStrings(0);
+    OctreeSharedStrings viewerStrings;
+    OctreePacketData packetData;
+    packetData.setSharedStrings(&serverStrings);
+
+    // a string repeated in a stream is defined once then referred to
+    QVERIFY(packetData.appendSharedString(MODEL_URL));
+    int definitionSize = packetData.getUncompressedSize();
+    QVERIFY(packetData.appendSharedString(MODEL_URL));
+    int referenceSize = packetData.getUncompressedSize() - definitionSize;
+    QVERIFY(referenceSize < definitionSize);
+    QVERIFY(referenceSize < MODEL_URL.size());
+
+    QStringList strings;
+    QCOMPARE(readStrings(packetData, 2, viewerStrings, strings), 2);
+    QCOMPARE(strings, QStringList() << MODEL_URL << MODEL_URL);
+
+    // once the stream is sent, the next streams only refer to it
+    packetData.commitSharedStrings();
+    packetData.reset();
+    QVERIFY(packetData.appendSharedString(MODEL_URL));
+    QCOMPARE(packetData.getUncompressedSize(), referenceSize);
+
+    strings.clear();
+    QCOMPARE(readStrings(packetData, 1, viewerStrings, strings), 1);
+    QCOMPARE(strings, QStringList() << MODEL_URL);
+}
+
+void OctreeSharedStringsTests::testDiscardedDefinition() {
+    OctreeSharedStrings serverStrings(0);
+    OctreeSharedStrings viewerStrings;
+    OctreePacketData packetData;
+    packetData.setSharedStrings(&serverStrings);
+
+    // a definition that didn't make it into the stream isn't sent
+    LevelDetails level = packetData.startLevel();
+    QVERIFY(packetData.appendSharedString(SCRIPT_URL));
+    packetData.discardLevel(level);
+    QVERIFY(packetData.appendSharedString(SCRIPT_URL));
+
+    QStringList strings;
+    QCOMPARE(readStrings(packetData, 1, viewerStrings, strings), 1);
+    QCOMPARE(strings, QStringList() << SCRIPT_URL);
+
+    // nor is a stream that was reset before being sent
+    OctreeSharedStrings otherServerStrings(0);
+    packetData.setSharedStrings(&otherServerStrings);
+    packetData.reset();
+    QVERIFY(packetData.appendSharedString(MODEL_URL));
+    packetData.reset();
+    packetData.commitSharedStrings();
+    QVERIFY(!otherServerStrings.canReference(InternedStrings::getID(MODEL_URL), usecTimestampNow()));
+}
+
+void OctreeSharedStringsTests::testSettleTime() {
+    const quint64 SETTLE_USECS = USECS_PER_SECOND;
+    OctreeSharedStrings serverStrings(SETTLE_USECS);
+    quint32 id = InternedStrings::getID(MODEL_URL);
+    quint64 now = usecTimestampNow();
+
+    QVERIFY(!serverStrings.canReference(id, now));
+    serverStrings.markSent(id, now);
+    QVERIFY(!serverStrings.canReference(id, now + SETTLE_USECS / 2));
+    QVERIFY(serverStrings.canReference(id, now + SETTLE_USECS));
+
+    // sending it again doesn't delay the references
+    serverStrings.markSent(id, now + SETTLE_USECS / 2);
+    QVERIFY(serverStrings.canReference(id, now + SETTLE_USECS));
+
+    serverStrings.clear();
+    QVERIFY(!serverStrings.canReference(id, now + SETTLE_USECS));
+}
+
+void OctreeSharedStringsTests::testUnknownReference() {
+    OctreeSharedStrings serverStrings(0);
+    OctreePacketData packetData;
+    packetData.setSharedStrings(&serverStrings);
+    QVERIFY(packetData.appendSharedString(MODEL_URL));
+    packetData.commitSharedStrings();
+    packetData.reset();
+    QVERIFY(packetData.appendSharedString(MODEL_URL));
+    QVERIFY(packetData.appendValue(QString("after")));
+
+    // a viewer that missed the definition skips the reference
+    OctreeSharedStrings viewerStrings;
+    const unsigned char* dataAt = packetData.getUncompressedData();
+    QString string;
+    bool found;
+    dataAt += OctreePacketData::unpackSharedStringFromBytes(dataAt, string, &viewerStrings, found);
+    QVERIFY(!found);
+    OctreePacketData::unpackDataFromBytes(dataAt, string);
+    QCOMPARE(string, QString("after"));
+
+    // and asks the server to define it again and resend the entity
+    QUuid entityID = QUuid::createUuid();
+    viewerStrings.addUnresolvedEntity(entityID);
+    QVector<quint32> ids;
+    QVector<QUuid> entityIDs;
+    viewerStrings.takeUnresolved(ids, entityIDs);
+    QByteArray request = OctreeSharedStrings::writeResendRequest(ids, entityIDs);
+
+    QVector<quint32> requestedIDs;
+    QVector<QUuid> requestedEntityIDs;
+    QVERIFY(OctreeSharedStrings::readResendRequest(request, requestedIDs, requestedEntityIDs));
+    QCOMPARE(requestedIDs, QVector<quint32>() << InternedStrings::getID(MODEL_URL));
+    QCOMPARE(requestedEntityIDs, QVector<QUuid>() << entityID);
+    QVERIFY(!OctreeSharedStrings::readResendRequest(request.left(request.size() - 1), requestedIDs, requestedEntityIDs));
+
+    for (auto id : ids) {
+        serverStrings.forget(id);
+    }
+    packetData.reset();
+    QVERIFY(packetData.appendSharedString(MODEL_URL));
+    QStringList strings;
+    QCOMPARE(readStrings(packetData, 1, viewerStrings, strings), 1);
+    QCOMPARE(strings, QStringList() << MODEL_URL);
+
+    // what was taken is not asked for again
+    ids.clear();
+    entityIDs.clear();
+    viewerStrings.takeUnresolved(ids, entityIDs);
+    QVERIFY(ids.isEmpty());
+    QVERIFY(entityIDs.isEmpty());
+}
+
+void OctreeSharedStringsTests::testRegularStrings() {
+    // without shared strings, or for empty strings, the stream holds regular strings
+    OctreePacketData packetData;
+    QVERIFY(packetData.appendSharedString(MODEL_URL));
+    OctreeSharedStrings serverStrings(0);
+    packetData.setSharedStrings(&serverStrings);
+    QVERIFY(packetData.appendSharedString(QString()));
+
+    const unsigned char* dataAt = packetData.getUncompressedData();
+    QString string;
+    dataAt += OctreePacketData::unpackDataFromBytes(dataAt, string);
+    QCOMPARE(string, MODEL_URL);
+    OctreePacketData::unpackDataFromBytes(dataAt, string);
+    QVERIFY(string.isEmpty());
+}
+
+void OctreeSharedStringsTests::testLongStrings() {
+    // room for strings longer than the markers of the shared strings
+    const int PACKET_SIZE = 0x30000;
+    OctreePacketData packetData(false, PACKET_SIZE);
+
+    // the longest regular string is read back as such by the shared string reader
+    QString longString(0xFF00 - 1, QChar('a'));
+    QVERIFY(packetData.appendValue(longString));
+    QString string;
+    bool found = false;
+    int bytes = OctreePacketData::unpackSharedStringFromBytes(packetData.getUncompressedData(), string, nullptr, found);
+    QVERIFY(found);
+    QCOMPARE(bytes, packetData.getUncompressedSize());
+    QCOMPARE(string, longString);
+
+    // longer strings are not written, in particular those whose length would read as a marker, or wrap around
+    int size = packetData.getUncompressedSize();
+    const int TOO_LONG_LENGTHS[] = { 0xFF01, 0xFFFE, 0xFFFF, 0x10000 }; // including NULL
+    for (int length : TOO_LONG_LENGTHS) {
+        QString tooLongString(length - 1, QChar('b'));
+        QVERIFY(!packetData.appendValue(tooLongString));
+        QVERIFY(!packetData.appendSharedString(tooLongString));
+        QCOMPARE(packetData.getUncompressedSize(), size);
+    }
+}
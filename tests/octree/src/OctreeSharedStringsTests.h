@@ -0,0 +1,29 @@
+//
+//  OctreeSharedStringsTests.h
+//  tests/octree/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSharedStringsTests_h
+#define hifi_OctreeSharedStringsTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeSharedStringsTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testInternedIDs();
+    void testDefineThenReference();
+    void testDiscardedDefinition();
+    void testSettleTime();
+    void testUnknownReference();
+    void testRegularStrings();
+    void testLongStrings();
+};
+
+#endif // hifi_OctreeSharedStringsTests_h
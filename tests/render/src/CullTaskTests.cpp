@@ -0,0 +1,321 @@
+//
+//  CullTaskTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullTaskTests.h"
+
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <render/CullTask.h>
+#include <render/Scene.h>
+#include <render/SortTask.h>
+
+QTEST_MAIN(CullTaskTests)
+
+using namespace render;
+
+// a synthetic render item, only carrying its bound
+struct TestShape {
+    using Payload = render::Payload<TestShape>;
+    using Pointer = Payload::DataPointer;
+
+    TestShape(const AABox& bound) : bound(bound) {}
+    AABox bound;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const TestShape::Pointer& shape) {
+        return ItemKey::Builder::opaqueShape().build();
+    }
+    template <> const Item::Bound payloadGetBound(const TestShape::Pointer& shape) {
+        return shape->bound;
+    }
+}
+
+const int NUM_TEST_ITEMS = 50000;
+const float SCENE_SIZE = 1000.0f;
+
+static ScenePointer scene;
+static RenderArgs args;
+static RenderContextPointer renderContext;
+
+static AABox randomBox(std::mt19937& generator) {
+    std::uniform_real_distribution<float> position(-SCENE_SIZE / 2.0f, SCENE_SIZE / 2.0f);
+    std::exponential_distribution<float> size(2.0f);
+    glm::vec3 scale(0.01f + size(generator), 0.01f + size(generator), 0.01f + size(generator));
+    return AABox(glm::vec3(position(generator), position(generator), position(generator)), scale);
+}
+
+static ViewFrustum makeFrustum() {
+    ViewFrustum frustum;
+    frustum.setProjection(glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, SCENE_SIZE));
+    frustum.setPosition(glm::vec3(0.0f, 10.0f, 0.0f));
+    frustum.setOrientation(glm::angleAxis(glm::radians(30.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    frustum.calculate();
+    return frustum;
+}
+
+const int NUM_TEST_CASCADES = 4;
+
+// nested orthographic frustums looking down a light direction, as the shadow cascades
+static void makeCascadeFrustums(ViewFrustum frustums[NUM_TEST_CASCADES]) {
+    float size = SCENE_SIZE / 16.0f;
+    for (int i = 0; i < NUM_TEST_CASCADES; i++) {
+        frustums[i].setProjection(glm::ortho(-size, size, -size, size, -SCENE_SIZE, SCENE_SIZE));
+        frustums[i].setPosition(glm::vec3(0.0f, 10.0f, 0.0f));
+        frustums[i].setOrientation(glm::angleAxis(glm::radians(-60.0f), glm::vec3(1.0f, 0.0f, 0.0f)));
+        frustums[i].calculate();
+        size *= 2.0f;
+    }
+}
+
+static std::vector<AABox> randomBoxes(std::mt19937& generator, int numBoxes, ItemBoundsSoA& bounds) {
+    std::vector<AABox> boxes;
+    for (int i = 0; i < numBoxes; i++) {
+        boxes.push_back(randomBox(generator));
+        bounds.push_back(boxes.back());
+    }
+    return boxes;
+}
+
+static bool solidAngleCull(const RenderArgs* args, const AABox& bound) {
+    return bound.getLargestDimension() > 0.1f;
+}
+
+static ItemBounds cull(const ItemSpatialTree::ItemSelection& selection, bool multithreaded, RenderDetails::Item& details) {
+    auto config = std::make_shared<CullSpatialSelectionConfig>();
+    config->multithreaded = multithreaded;
+    renderContext->jobConfig = config;
+
+    CullSpatialSelection job(solidAngleCull, RenderDetails::ITEM);
+    job.configure(*config);
+
+    args._details = RenderDetails();
+    CullSpatialSelection::Inputs inputs(Varying(selection), Varying(ItemFilter::Builder::opaqueShape().build()));
+    ItemBounds outItems;
+    job.run(renderContext, inputs, outItems);
+    details = args._details._item;
+
+    renderContext->jobConfig.reset();
+    return outItems;
+}
+
+static ItemSpatialTree::ItemSelection select() {
+    ItemSpatialTree::ItemSelection selection;
+    scene->getSpatialTree().selectCellItems(selection, ItemFilter::Builder::opaqueShape().build(),
+                                            args.getViewFrustum(), args._lodAngleHalfTan);
+    return selection;
+}
+
+void CullTaskTests::initTestCase() {
+    scene = std::make_shared<Scene>(glm::vec3(-SCENE_SIZE), 2.0f * SCENE_SIZE);
+
+    std::mt19937 generator(1);
+    Transaction transaction;
+    for (int i = 0; i < NUM_TEST_ITEMS; i++) {
+        auto shape = std::make_shared<TestShape>(randomBox(generator));
+        transaction.resetItem(scene->allocateID(), std::make_shared<TestShape::Payload>(shape));
+    }
+    scene->enqueueTransaction(transaction);
+    scene->processTransactionQueue();
+
+    args.setViewFrustum(makeFrustum());
+
+    renderContext = std::make_shared<RenderContext>();
+    renderContext->args = &args;
+    renderContext->_scene = scene;
+}
+
+void CullTaskTests::cleanupTestCase() {
+    renderContext.reset();
+    scene.reset();
+}
+
+void CullTaskTests::testFrustumSoA() {
+    ViewFrustum frustum = makeFrustum();
+
+    std::mt19937 generator(2);
+    std::vector<AABox> boxes;
+    ItemBoundsSoA bounds;
+    for (int i = 0; i < 10000; i++) {
+        boxes.push_back(randomBox(generator));
+        bounds.push_back(boxes.back());
+    }
+
+    std::vector<uint8_t> inView(bounds.size());
+    bounds.testFrustum(frustum, inView.data());
+
+    int numInView = 0;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        QCOMPARE((bool)inView[i], frustum.boxIntersectsFrustum(boxes[i]));
+        numInView += inView[i];
+    }
+    QVERIFY(numInView > 0 && numInView < (int)boxes.size());
+}
+
+void CullTaskTests::testMultiFrustumSoA() {
+    ViewFrustum frustums[NUM_TEST_CASCADES];
+    makeCascadeFrustums(frustums);
+    const ViewFrustum* frustumPointers[NUM_TEST_CASCADES] = { &frustums[0], &frustums[1], &frustums[2], &frustums[3] };
+
+    std::mt19937 generator(4);
+    ItemBoundsSoA bounds;
+    std::vector<AABox> boxes = randomBoxes(generator, 10000, bounds);
+
+    std::vector<uint8_t> intersectMasks(bounds.size());
+    std::vector<uint8_t> insideMasks(bounds.size());
+    bounds.testFrustums(frustumPointers, NUM_TEST_CASCADES, intersectMasks.data(), insideMasks.data());
+
+    int numInside = 0;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        for (int f = 0; f < NUM_TEST_CASCADES; f++) {
+            QCOMPARE((bool)(intersectMasks[i] & (1 << f)), frustums[f].boxIntersectsFrustum(boxes[i]));
+            QCOMPARE((bool)(insideMasks[i] & (1 << f)), frustums[f].boxInsideFrustum(boxes[i]));
+        }
+        numInside += (insideMasks[i] != 0);
+    }
+    QVERIFY(numInside > 0);
+
+    // the inside masks are optional
+    std::vector<uint8_t> intersectOnlyMasks(bounds.size());
+    bounds.testFrustums(frustumPointers, NUM_TEST_CASCADES, intersectOnlyMasks.data());
+    QVERIFY(intersectOnlyMasks == intersectMasks);
+}
+
+void CullTaskTests::testCullDeterminism() {
+    auto selection = select();
+    QVERIFY(selection.partialNumItems() > 0);
+
+    RenderDetails::Item serialDetails;
+    RenderDetails::Item parallelDetails;
+    ItemBounds serialItems = cull(selection, false, serialDetails);
+    QVERIFY(!serialItems.empty());
+
+    for (int i = 0; i < 5; i++) {
+        ItemBounds parallelItems = cull(selection, true, parallelDetails);
+
+        QCOMPARE(parallelItems.size(), serialItems.size());
+        for (size_t j = 0; j < serialItems.size(); j++) {
+            QCOMPARE(parallelItems[j].id, serialItems[j].id);
+            QVERIFY(parallelItems[j].bound == serialItems[j].bound);
+        }
+        QCOMPARE(parallelDetails._outOfView, serialDetails._outOfView);
+        QCOMPARE(parallelDetails._tooSmall, serialDetails._tooSmall);
+        QCOMPARE(parallelDetails._rendered, serialDetails._rendered);
+    }
+}
+
+void CullTaskTests::testDepthSortDeterminism() {
+    // many items, with duplicated depths, so the parallel sort and the tie breaks are exercised
+    std::mt19937 generator(3);
+    ItemBounds inItems;
+    for (ItemID id = 1; id <= (ItemID)NUM_TEST_ITEMS; id++) {
+        AABox bound = randomBox(generator);
+        if (id % 3 == 0) {
+            bound = inItems.back().bound;
+        }
+        inItems.emplace_back(id, bound);
+    }
+
+    ItemBounds sorted;
+    depthSortItems(renderContext, true, inItems, sorted);
+    QCOMPARE(sorted.size(), inItems.size());
+
+    const ViewFrustum& frustum = args.getViewFrustum();
+    for (size_t i = 1; i < sorted.size(); i++) {
+        float previousDepth = frustum.distanceToCameraSquared(sorted[i - 1].bound.calcCenter());
+        float depth = frustum.distanceToCameraSquared(sorted[i].bound.calcCenter());
+        QVERIFY(previousDepth < depth || (previousDepth == depth && sorted[i - 1].id < sorted[i].id));
+    }
+
+    ItemBounds sortedAgain;
+    depthSortItems(renderContext, true, inItems, sortedAgain);
+    for (size_t i = 0; i < sorted.size(); i++) {
+        QCOMPARE(sortedAgain[i].id, sorted[i].id);
+    }
+}
+
+void CullTaskTests::benchmarkCullSerial() {
+    auto selection = select();
+    RenderDetails::Item details;
+    QBENCHMARK {
+        cull(selection, false, details);
+    }
+}
+
+void CullTaskTests::benchmarkCullMultithreaded() {
+    auto selection = select();
+    RenderDetails::Item details;
+    QBENCHMARK {
+        cull(selection, true, details);
+    }
+}
+
+void CullTaskTests::benchmarkDepthSort() {
+    auto selection = select();
+    RenderDetails::Item details;
+    ItemBounds culled = cull(selection, true, details);
+    ItemBounds sorted;
+    QBENCHMARK {
+        depthSortItems(renderContext, true, culled, sorted);
+    }
+}
+
+// the shadow cascades culled one frustum at a time, as before CullShadowCascades
+void CullTaskTests::benchmarkCascadeCullPerFrustum() {
+    ViewFrustum frustums[NUM_TEST_CASCADES];
+    makeCascadeFrustums(frustums);
+
+    std::mt19937 generator(5);
+    ItemBoundsSoA bounds;
+    std::vector<AABox> boxes = randomBoxes(generator, NUM_TEST_ITEMS, bounds);
+
+    std::vector<ItemBounds> cascadeItems(NUM_TEST_CASCADES);
+    QBENCHMARK {
+        for (int f = 0; f < NUM_TEST_CASCADES; f++) {
+            cascadeItems[f].clear();
+            for (size_t i = 0; i < boxes.size(); i++) {
+                if (frustums[f].boxIntersectsFrustum(boxes[i]) && (f < 2 || !frustums[f - 2].boxInsideFrustum(boxes[i]))) {
+                    cascadeItems[f].emplace_back((ItemID)i, boxes[i]);
+                }
+            }
+        }
+    }
+}
+
+// the shadow cascades culled in one pass with per item cascade bitmasks
+void CullTaskTests::benchmarkCascadeCullShared() {
+    ViewFrustum frustums[NUM_TEST_CASCADES];
+    makeCascadeFrustums(frustums);
+    const ViewFrustum* frustumPointers[NUM_TEST_CASCADES] = { &frustums[0], &frustums[1], &frustums[2], &frustums[3] };
+
+    std::mt19937 generator(5);
+    ItemBoundsSoA bounds;
+    std::vector<AABox> boxes = randomBoxes(generator, NUM_TEST_ITEMS, bounds);
+
+    std::vector<uint8_t> intersectMasks(bounds.size());
+    std::vector<uint8_t> insideMasks(bounds.size());
+    std::vector<ItemBounds> cascadeItems(NUM_TEST_CASCADES);
+    QBENCHMARK {
+        bounds.testFrustums(frustumPointers, NUM_TEST_CASCADES, intersectMasks.data(), insideMasks.data());
+        for (int f = 0; f < NUM_TEST_CASCADES; f++) {
+            cascadeItems[f].clear();
+        }
+        for (size_t i = 0; i < boxes.size(); i++) {
+            const uint8_t visibleMask = intersectMasks[i] & (uint8_t)~(insideMasks[i] << 2);
+            for (int f = 0; f < NUM_TEST_CASCADES; f++) {
+                if (visibleMask & (1 << f)) {
+                    cascadeItems[f].emplace_back((ItemID)i, boxes[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,32 @@
+//
+//  CullTaskTests.h
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CullTaskTests_h
+#define hifi_CullTaskTests_h
+
+#include <QtTest/QtTest>
+
+class CullTaskTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testFrustumSoA();
+    void testMultiFrustumSoA();
+    void testCullDeterminism();
+    void testDepthSortDeterminism();
+    void benchmarkCullSerial();
+    void benchmarkCullMultithreaded();
+    void benchmarkDepthSort();
+    void benchmarkCascadeCullPerFrustum();
+    void benchmarkCascadeCullShared();
+};
+
+#endif // hifi_CullTaskTests_h
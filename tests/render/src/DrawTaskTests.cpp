@@ -0,0 +1,193 @@
+//
+//  DrawTaskTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DrawTaskTests.h"
+
+#include <random>
+
+#include <gpu/Context.h>
+#include <render/DrawTask.h>
+#include <render/Scene.h>
+
+QTEST_MAIN(DrawTaskTests)
+
+using namespace render;
+
+// a synthetic shape with its own pipeline, recording a draw call like the model payloads do
+struct DrawnShape {
+    using Payload = render::Payload<DrawnShape>;
+    using Pointer = Payload::DataPointer;
+
+    DrawnShape(const AABox& bound, const gpu::BufferPointer& vertices) : bound(bound), vertices(vertices) {}
+    AABox bound;
+    gpu::BufferPointer vertices;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const DrawnShape::Pointer& shape) {
+        return ItemKey::Builder::opaqueShape().build();
+    }
+    template <> const Item::Bound payloadGetBound(const DrawnShape::Pointer& shape) {
+        return shape->bound;
+    }
+    template <> void payloadRender(const DrawnShape::Pointer& shape, RenderArgs* args) {
+        Transform model;
+        model.setTranslation(shape->bound.calcCenter());
+        model.setScale(shape->bound.getScale());
+        args->_batch->setModelTransform(model);
+        args->_batch->setInputBuffer(0, shape->vertices, 0, sizeof(glm::vec3));
+        args->_batch->draw(gpu::TRIANGLES, 36);
+        args->_details._trianglesRendered += 12;
+    }
+}
+
+const int NUM_TEST_ITEMS = 20000;
+const float SCENE_SIZE = 1000.0f;
+
+// both batches must hold the same commands, referring to the same cached objects
+static void compareBatches(const gpu::Batch& expected, const gpu::Batch& actual) {
+    QCOMPARE(actual.getCommands().size(), expected.getCommands().size());
+    QVERIFY(actual.getCommands() == expected.getCommands());
+    QVERIFY(actual.getCommandOffsets() == expected.getCommandOffsets());
+
+    QCOMPARE(actual.getParams().size(), expected.getParams().size());
+    for (size_t i = 0; i < expected.getParams().size(); i++) {
+        QCOMPARE(actual.getParams()[i]._uint, expected.getParams()[i]._uint);
+    }
+
+    QCOMPARE(actual._data.size(), expected._data.size());
+    QVERIFY(actual._data == expected._data);
+
+    QCOMPARE(actual._buffers.size(), expected._buffers.size());
+    for (size_t i = 0; i < expected._buffers.size(); i++) {
+        QVERIFY(actual._buffers.get((uint32_t)i) == expected._buffers.get((uint32_t)i));
+    }
+    QCOMPARE(actual._lambdas.size(), expected._lambdas.size());
+    QCOMPARE(actual._profileRanges.size(), expected._profileRanges.size());
+    for (size_t i = 0; i < expected._profileRanges.size(); i++) {
+        QCOMPARE(actual._profileRanges.get((uint32_t)i), expected._profileRanges.get((uint32_t)i));
+    }
+
+    QCOMPARE(actual._objects.size(), expected._objects.size());
+    for (size_t i = 0; i < expected._objects.size(); i++) {
+        QVERIFY(actual._objects[i]._model == expected._objects[i]._model);
+    }
+
+    QCOMPARE(actual._drawCallInfos.size(), expected._drawCallInfos.size());
+    for (size_t i = 0; i < expected._drawCallInfos.size(); i++) {
+        QCOMPARE(actual._drawCallInfos[i].index, expected._drawCallInfos[i].index);
+        QCOMPARE(actual._drawCallInfos[i].unused, expected._drawCallInfos[i].unused);
+    }
+}
+
+static void recordPart(gpu::Batch& batch, int part, const gpu::BufferPointer& buffer) {
+    batch.pushProfileRange(part == 0 ? "first" : "second");
+    batch.setViewportTransform(glm::ivec4(0, 0, 100 * (part + 1), 100));
+    batch.setStateScissorRect(glm::ivec4(0, 0, 50, 50 * (part + 1)));
+    batch.setUniformBuffer(part, buffer, 0, sizeof(glm::vec4));
+    batch.runLambda([] {});
+    for (int i = 0; i < 10; i++) {
+        Transform model;
+        model.setTranslation(glm::vec3((float)(part * 10 + i)));
+        batch.setModelTransform(model);
+        batch.setInputBuffer(0, buffer, 0, sizeof(glm::vec3));
+        batch.setDrawcallUniform((uint16_t)i);
+        batch.draw(gpu::TRIANGLES, 3);
+    }
+    batch.popProfileRange();
+}
+
+void DrawTaskTests::testBatchAppend() {
+    auto buffer = std::make_shared<gpu::Buffer>();
+
+    gpu::Batch serialBatch;
+    recordPart(serialBatch, 0, buffer);
+    recordPart(serialBatch, 1, buffer);
+
+    gpu::Batch firstBatch;
+    gpu::Batch secondBatch;
+    recordPart(firstBatch, 0, buffer);
+    recordPart(secondBatch, 1, buffer);
+    firstBatch.append(secondBatch);
+
+    compareBatches(serialBatch, firstBatch);
+}
+
+struct DrawTestScene {
+    DrawTestScene() {
+        scene = std::make_shared<Scene>(glm::vec3(-SCENE_SIZE), 2.0f * SCENE_SIZE);
+        auto vertices = std::make_shared<gpu::Buffer>();
+
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> position(-SCENE_SIZE / 2.0f, SCENE_SIZE / 2.0f);
+        Transaction transaction;
+        for (int i = 0; i < NUM_TEST_ITEMS; i++) {
+            AABox bound(glm::vec3(position(generator), position(generator), position(generator)), glm::vec3(1.0f));
+            auto id = scene->allocateID();
+            transaction.resetItem(id, std::make_shared<DrawnShape::Payload>(std::make_shared<DrawnShape>(bound, vertices)));
+            items.emplace_back(id, bound);
+        }
+        scene->enqueueTransaction(transaction);
+        scene->processTransactionQueue();
+
+        // a context without backend records batches but never renders them
+        args._context = std::make_shared<gpu::Context>();
+        renderContext = std::make_shared<RenderContext>();
+        renderContext->args = &args;
+        renderContext->_scene = scene;
+        shapePlumber = std::make_shared<ShapePlumber>();
+    }
+
+    gpu::BatchPointer record(bool stateSort, bool multithreaded) {
+        auto batch = args._context->acquireBatch("DrawTaskTests");
+        args._batch = batch.get();
+        args._details = RenderDetails();
+        if (stateSort) {
+            renderStateSortShapes(renderContext, shapePlumber, items, -1, ShapeKey(), multithreaded);
+        } else {
+            renderShapes(renderContext, shapePlumber, items, -1, ShapeKey(), multithreaded);
+        }
+        args._batch = nullptr;
+        return batch;
+    }
+
+    ScenePointer scene;
+    ItemBounds items;
+    RenderArgs args;
+    RenderContextPointer renderContext;
+    ShapePlumberPointer shapePlumber;
+};
+
+void DrawTaskTests::testMultithreadedRecording() {
+    DrawTestScene testScene;
+
+    for (bool stateSort : { false, true }) {
+        auto serialBatch = testScene.record(stateSort, false);
+        int serialTriangles = testScene.args._details._trianglesRendered;
+        auto multithreadedBatch = testScene.record(stateSort, true);
+
+        QCOMPARE(testScene.args._details._trianglesRendered, serialTriangles);
+        compareBatches(*serialBatch, *multithreadedBatch);
+    }
+}
+
+void DrawTaskTests::benchmarkRecordingSerial() {
+    DrawTestScene testScene;
+    QBENCHMARK {
+        testScene.record(true, false);
+    }
+}
+
+void DrawTaskTests::benchmarkRecordingMultithreaded() {
+    DrawTestScene testScene;
+    QBENCHMARK {
+        testScene.record(true, true);
+    }
+}
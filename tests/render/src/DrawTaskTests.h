@@ -0,0 +1,25 @@
+//
+//  DrawTaskTests.h
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DrawTaskTests_h
+#define hifi_DrawTaskTests_h
+
+#include <QtTest/QtTest>
+
+class DrawTaskTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testBatchAppend();
+    void testMultithreadedRecording();
+    void benchmarkRecordingSerial();
+    void benchmarkRecordingMultithreaded();
+};
+
+#endif // hifi_DrawTaskTests_h
@@ -0,0 +1,231 @@
+//
+//  SceneTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SceneTests.h"
+
+#include <atomic>
+#include <random>
+#include <thread>
+
+#include <render/Scene.h>
+
+QTEST_MAIN(SceneTests)
+
+using namespace render;
+
+// a synthetic render item, which can be moved or hidden through updates
+struct MovingShape {
+    using Payload = render::Payload<MovingShape>;
+    using Pointer = Payload::DataPointer;
+
+    MovingShape(const AABox& bound) : bound(bound) {}
+    AABox bound;
+    bool visible { true };
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const MovingShape::Pointer& shape) {
+        auto builder = ItemKey::Builder::opaqueShape();
+        if (!shape->visible) {
+            builder.withInvisible();
+        }
+        return builder.build();
+    }
+    template <> const Item::Bound payloadGetBound(const MovingShape::Pointer& shape) {
+        return shape->bound;
+    }
+}
+
+const int NUM_TEST_ITEMS = 50000;
+const float SCENE_SIZE = 1000.0f;
+
+static AABox randomBox(std::mt19937& generator) {
+    std::uniform_real_distribution<float> position(-SCENE_SIZE / 2.0f, SCENE_SIZE / 2.0f);
+    std::exponential_distribution<float> size(2.0f);
+    glm::vec3 scale(0.01f + size(generator), 0.01f + size(generator), 0.01f + size(generator));
+    return AABox(glm::vec3(position(generator), position(generator), position(generator)), scale);
+}
+
+static ScenePointer makeScene() {
+    return std::make_shared<Scene>(glm::vec3(-SCENE_SIZE), 2.0f * SCENE_SIZE);
+}
+
+// resets NUM_TEST_ITEMS new items, with some of them reset twice
+static Transaction makeResets(const ScenePointer& scene, ItemIDs& ids) {
+    std::mt19937 generator(1);
+    Transaction transaction;
+    ids.clear();
+    for (int i = 0; i < NUM_TEST_ITEMS; i++) {
+        auto id = scene->allocateID();
+        ids.push_back(id);
+        transaction.resetItem(id, std::make_shared<MovingShape::Payload>(std::make_shared<MovingShape>(randomBox(generator))));
+        if (i % 100 == 99) {
+            transaction.resetItem(ids[i - 1], std::make_shared<MovingShape::Payload>(std::make_shared<MovingShape>(randomBox(generator))));
+        }
+    }
+    return transaction;
+}
+
+// moves all the items, several times for some of them, and hides a few
+static Transaction makeUpdates(const ItemIDs& ids) {
+    std::mt19937 generator(2);
+    Transaction transaction;
+    for (size_t i = 0; i < ids.size(); i++) {
+        AABox bound = randomBox(generator);
+        transaction.updateItem<MovingShape>(ids[i], [bound](MovingShape& shape) {
+            shape.bound = bound;
+        });
+        if (i % 7 == 0) {
+            glm::vec3 offset(1.0f, 2.0f, 3.0f);
+            transaction.updateItem<MovingShape>(ids[i], [offset](MovingShape& shape) {
+                shape.bound.translate(offset);
+            });
+        }
+        if (i % 50 == 0) {
+            transaction.updateItem<MovingShape>(ids[i], [](MovingShape& shape) {
+                shape.visible = false;
+            });
+        }
+    }
+    return transaction;
+}
+
+static void compareScenes(const Scene& left, const Scene& right, const ItemIDs& ids) {
+    for (auto id : ids) {
+        const auto& leftItem = left.getItem(id);
+        const auto& rightItem = right.getItem(id);
+        QVERIFY(leftItem.getKey()._flags == rightItem.getKey()._flags);
+        QCOMPARE(leftItem.getCell(), rightItem.getCell());
+        QVERIFY(leftItem.getBound() == rightItem.getBound());
+    }
+}
+
+void SceneTests::testMultithreadedTransactions() {
+    auto serialScene = makeScene();
+    auto parallelScene = makeScene();
+
+    ItemIDs ids;
+    serialScene->enqueueTransaction(makeResets(serialScene, ids));
+    serialScene->enqueueFrame();
+    serialScene->processTransactionQueue(0, false);
+    parallelScene->enqueueTransaction(makeResets(parallelScene, ids));
+    parallelScene->enqueueFrame();
+    parallelScene->processTransactionQueue(0, true);
+    compareScenes(*serialScene, *parallelScene, ids);
+
+    serialScene->enqueueTransaction(makeUpdates(ids));
+    serialScene->enqueueFrame();
+    serialScene->processTransactionQueue(0, false);
+    parallelScene->enqueueTransaction(makeUpdates(ids));
+    parallelScene->enqueueFrame();
+    parallelScene->processTransactionQueue(0, true);
+    compareScenes(*serialScene, *parallelScene, ids);
+
+    // the moved items are where their bounds are
+    for (auto id : ids) {
+        const auto& item = parallelScene->getItem(id);
+        QVERIFY(item.getCell() != Item::INVALID_CELL);
+        ItemKey key = item.getKey();
+        auto location = parallelScene->getSpatialTree().evalItemLocation(item.getBound(), key);
+        QCOMPARE(item.getKey().isSmall(), key.isSmall());
+        QVERIFY(parallelScene->getSpatialTree().getConcreteCell(item.getCell()).getlocation() == location);
+    }
+}
+
+void SceneTests::testUpdatesRunSerially() {
+    auto scene = makeScene();
+
+    ItemIDs ids;
+    scene->enqueueTransaction(makeResets(scene, ids));
+    scene->enqueueFrame();
+    scene->processTransactionQueue(0, true);
+
+    // the payloads of the render items aren't made to be updated concurrently, so the functors all run on this thread
+    const auto thisThread = std::this_thread::get_id();
+    std::atomic<int> numOtherThreadUpdates { 0 };
+    Transaction transaction;
+    for (auto id : ids) {
+        transaction.updateItem<MovingShape>(id, [&](MovingShape& shape) {
+            if (std::this_thread::get_id() != thisThread) {
+                numOtherThreadUpdates++;
+            }
+            shape.bound.translate(glm::vec3(1.0f));
+        });
+    }
+    scene->enqueueTransaction(transaction);
+    scene->enqueueFrame();
+    scene->processTransactionQueue(0, true);
+    QCOMPARE(numOtherThreadUpdates.load(), 0);
+}
+
+void SceneTests::testTimeBudget() {
+    auto scene = makeScene();
+
+    ItemIDs ids;
+    scene->enqueueTransaction(makeResets(scene, ids));
+    scene->enqueueFrame();
+
+    Transaction removes;
+    removes.removeItem(ids.front());
+    scene->enqueueTransaction(removes);
+    scene->enqueueFrame();
+
+    // with a budget already spent, only one batch of resets goes through, the rest waits for the next call
+    scene->processTransactionQueue(1, true);
+    QCOMPARE(scene->getNumPendingTransactionFrames(), (size_t)2);
+    QVERIFY(scene->getItem(ids.front()).exist());
+    QVERIFY(!scene->getItem(ids.back()).exist());
+
+    // the frames are processed in order and completely when there is no budget
+    scene->processTransactionQueue();
+    QCOMPARE(scene->getNumPendingTransactionFrames(), (size_t)0);
+    QVERIFY(!scene->getItem(ids.front()).exist());
+    QVERIFY(scene->getItem(ids.back()).exist());
+}
+
+static void benchmarkResets(bool multithreaded) {
+    QBENCHMARK {
+        auto scene = makeScene();
+        ItemIDs ids;
+        scene->enqueueTransaction(makeResets(scene, ids));
+        scene->enqueueFrame();
+        scene->processTransactionQueue(0, multithreaded);
+    }
+}
+
+static void benchmarkUpdates(bool multithreaded) {
+    auto scene = makeScene();
+    ItemIDs ids;
+    scene->enqueueTransaction(makeResets(scene, ids));
+    scene->enqueueFrame();
+    scene->processTransactionQueue();
+
+    QBENCHMARK {
+        scene->enqueueTransaction(makeUpdates(ids));
+        scene->enqueueFrame();
+        scene->processTransactionQueue(0, multithreaded);
+    }
+}
+
+void SceneTests::benchmarkResetSerial() {
+    benchmarkResets(false);
+}
+
+void SceneTests::benchmarkResetMultithreaded() {
+    benchmarkResets(true);
+}
+
+void SceneTests::benchmarkUpdateSerial() {
+    benchmarkUpdates(false);
+}
+
+void SceneTests::benchmarkUpdateMultithreaded() {
+    benchmarkUpdates(true);
+}